@@ -37,12 +37,20 @@ namespace FG
 		EQueueType		queueType	= EQueueType::Graphics;
 		EDebugFlags		debugFlags	= Default;
 		StringView		name;
+		bool			reorderTasks	= false;	// group independent tasks to record them under a single pipeline barrier
+		bool			splitBarriers	= false;	// use events instead of pipeline barriers if producer was recorded long before consumer
+		bool			reuseSchedule	= false;	// reuse task execution order from previous frame if task graph is not changed
+		bool			persistentState	= false;	// keep last layout and access state of resources for the next command buffer instead of full barrier
 		
 				 CommandBufferDesc () {}
 		explicit CommandBufferDesc (EQueueType type) : queueType{type} {}
 
 		CommandBufferDesc&  SetDebugFlags (EDebugFlags value)	{ debugFlags = value;  return *this; }
 		CommandBufferDesc&  SetDebugName (StringView value)		{ name = value;  return *this; }
+		CommandBufferDesc&  SetReorderTasks (bool value = true)	{ reorderTasks = value;  return *this; }
+		CommandBufferDesc&  SetSplitBarriers (bool value = true){ splitBarriers = value;  return *this; }
+		CommandBufferDesc&  SetReuseSchedule (bool value = true){ reuseSchedule = value;  return *this; }
+		CommandBufferDesc&  SetPersistentState (bool value = true){ persistentState = value;  return *this; }
 	};
 
 
@@ -87,6 +95,15 @@ namespace FG
 		// Buffer may be in immutable or mutable state, immutable state disables barrier placement that increases performance on CPU.
 		virtual void		AcquireBuffer (RawBufferID id, bool makeMutable) = 0;
 
+		// Create device local image or buffer that is used only in current command buffer.
+		// Resource will be destroyed when command buffer has completed execution, content is undefined at first use.
+		// After 'ReleaseTransient()' memory may be reused by the next transient resource,
+		// so all tasks that use the resource (including render pass submission) must be added before releasing.
+		ND_ virtual RawImageID	CreateTransientImage (const ImageDesc &desc, StringView dbgName = Default) = 0;
+		ND_ virtual RawBufferID	CreateTransientBuffer (const BufferDesc &desc, StringView dbgName = Default) = 0;
+			virtual bool		ReleaseTransient (RawImageID id) = 0;
+			virtual bool		ReleaseTransient (RawBufferID id) = 0;
+
 	// tasks //
 		virtual Task		AddTask (const SubmitRenderPass &) = 0;
 		virtual Task		AddTask (const DispatchCompute &) = 0;
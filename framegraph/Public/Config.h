@@ -32,6 +32,8 @@ namespace FG
 	
 	// memory
 	static constexpr unsigned	FG_VkDevicePageSizeMb		= 64;
+	static constexpr unsigned	FG_MaxFreeMemoryBlocksMb	= 128;	// max size of released memory blocks that are kept for reuse
+	static constexpr unsigned	FG_StagingRingSize			= 32 << 20;	// size of persistently mapped buffer for uploads, one per queue, 0 - disabled
 
 # else
 
@@ -51,6 +53,8 @@ namespace FG
 
 	// memory
 	static constexpr unsigned	FG_VkDevicePageSizeMb		= 256;
+	static constexpr unsigned	FG_MaxFreeMemoryBlocksMb	= 1024;	// max size of released memory blocks that are kept for reuse
+	static constexpr unsigned	FG_StagingRingSize			= 128 << 20;	// size of persistently mapped buffer for uploads, one per queue, 0 - disabled
 
 # endif
 
@@ -62,10 +66,19 @@ namespace FG
 	static constexpr unsigned	FG_MaxPushConstants			= 8;
 	static constexpr unsigned	FG_MaxPushConstantsSize		= 128;	// bytes
 	static constexpr unsigned	FG_MaxSpecConstants			= 8;
+	static constexpr unsigned	FG_PipelineCompilerThreads	= 2;	// used only if async compilation is enabled, see 'VulkanDeviceInfo::asyncPipelineCompilation'
 	static constexpr unsigned	FG_DebugDescriptorSet		= FG_MaxDescriptorSets-1;
+	static constexpr unsigned	FG_BindlessDescriptorSet	= FG_MaxDescriptorSets-2;	// used only if bindless mode is enabled, see 'VulkanDeviceInfo::enableBindless'
+	static constexpr unsigned	FG_MaxBindlessImages		= 1u << 14;	// may be reduced to device limits
+	static constexpr unsigned	FG_MaxBindlessSamplers		= 1u << 10;
+	static constexpr unsigned	FG_MaxBindlessBuffers		= 1u << 14;
+
+	// memory
+	static constexpr unsigned	FG_FreeMemoryBlockLifetime	= 64;	// number of submissions during which released memory block can be reused
 
 	// queue
 	static constexpr unsigned	FG_MaxQueueFamilies			= 32;
+	static constexpr unsigned	FG_MaxPendingBatches		= 64;	// size of lock-free queue for executed command batches, must be power of 2
 
 	// task
 	static constexpr unsigned	FG_MaxTaskDependencies		= 8;
@@ -74,6 +87,15 @@ namespace FG
 	static constexpr unsigned	FG_MaxBlitRegions			= 8;
 	static constexpr unsigned	FG_MaxResolveRegions		= 8;
 	static constexpr unsigned	FG_MaxDrawCommands			= 4;
+	static constexpr unsigned	FG_TaskReorderWindow		= 32;	// max number of ready tasks that are checked when task batch is built
+	static constexpr unsigned	FG_MaxTaskSchedules			= 64;	// max number of cached task execution orders, see 'CommandBufferDesc::reuseSchedule'
+
+	// command buffer
+	static constexpr unsigned	FG_MaxRecordingThreads		= 8;	// max number of secondary command buffers per subpass
+	static constexpr unsigned	FG_MinDrawTasksPerThread	= 256;	// subpass is split into chunks of at least this number of draw tasks
+	static constexpr unsigned	FG_MinSplitBarrierDistance	= 4;	// min number of tasks between producer and consumer to replace pipeline barrier by event
+	static constexpr unsigned	FG_TransientMemoryBlockSize	= 256 << 20;	// min size of memory block for transient resources
+	static constexpr unsigned	FG_StagingRingChunkSize		= 1 << 20;	// min size of staging ring part that is acquired by command batch
 
 
 }	// FG
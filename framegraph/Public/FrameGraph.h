@@ -47,6 +47,10 @@ namespace FG
 			uint		descriptorBinds				= 0;
 			uint		pushConstants				= 0;
 			uint		pipelineBarriers			= 0;
+			uint		batchedTasks				= 0;	// tasks that share pipeline barrier with previous task, see 'CommandBufferDesc::reorderTasks'
+			uint		splitBarriers				= 0;	// buffer and image barriers that wait for event, see 'CommandBufferDesc::splitBarriers'
+			uint		reusedSchedules				= 0;	// command buffers that are recorded with cached task order, see 'CommandBufferDesc::reuseSchedule'
+			uint		aliasingFences				= 0;	// global barriers before reusing memory of transient resource, see 'ICommandBuffer::CreateTransientImage'
 			uint		transferOps					= 0;
 
 			uint		indexBufferBindings			= 0;
@@ -71,6 +75,7 @@ namespace FG
 
 			Nanoseconds submitingTime				{0};
 			Nanoseconds waitingTime					{0};
+			uint		queueSubmits				= 0;	// number of 'vkQueueSubmit' calls, batches that are ready at the same time are submitted together
 		};
 
 		struct ResourceStatistics
@@ -78,6 +83,11 @@ namespace FG
 			uint		newGraphicsPipelineCount	= 0;
 			uint		newComputePipelineCount		= 0;
 			uint		newRayTracingPipelineCount	= 0;
+			uint		memoryBlockReuses			= 0;	// number of device memory blocks that were reused instead of 'vkAllocateMemory' call
+			uint		memoryBlockAllocations		= 0;	// number of 'vkAllocateMemory' calls by memory manager
+			uint		memoryBlockReleases			= 0;	// number of 'vkFreeMemory' calls by memory manager
+			uint		asyncGraphicsPipelineCount	= 0;	// number of graphics pipelines that were compiled on background threads
+			uint		pipelineHitchesAvoided		= 0;	// number of draw tasks that were skipped or drawn with fallback pipeline instead of waiting for compilation
 		};
 
 		struct Statistics
@@ -117,6 +127,8 @@ namespace FG
 			uint	maxDrawIndirectCount;					// max value of 'DrawCmd::drawCount' in DrawVerticesIndirect, DrawIndexedIndirect
 															// and max value of 'DrawCmd::maxDrawCount' in DrawVerticesIndirectCount, DrawIndexedIndirectCount.
 			uint	maxDrawIndexedIndexValue;				// max value of 'DrawCmd::indexCount' in draw commands.
+			BytesU	maxUploadSize;							// number of bytes that always can be uploaded by a single command buffer,
+															// larger uploads may fail, use 'UploadScheduler' to split them between frames.
 		};
 
 		static constexpr auto	MaxTimeout = Nanoseconds{60'000'000'000};
@@ -149,6 +161,12 @@ namespace FG
 			// calling 'Task::EnableDebugTrace' and shader compiled with 'EShaderLangFormat::EnableDebugTrace' flag.
 			virtual bool			SetShaderDebugCallback (ShaderDebugCallback_t &&) = 0;
 
+			// Enable or disable background thread that waits for submitted command buffers,
+			// runs 'ReadBuffer::Callback', 'ReadImage::Callback' and shader debug callback and releases staging buffers.
+			// Callbacks will be called on the background thread, so they must be thread safe.
+			// Waits for all submitted command buffers, must not be called while other threads submit command buffers.
+			virtual bool			SetCompletionThreadEnabled (bool enabled) = 0;
+
 			// Returns device info with which framegraph has been crated.
 		ND_ virtual DeviceInfo_t	GetDeviceInfo () const = 0;
 
@@ -213,6 +231,13 @@ namespace FG
 		//ND_ virtual SamplerDesc const&	GetDescription (RawSamplerID &id) const = 0;
 		ND_ virtual ExternalBufferDesc_t GetApiSpecificDescription (RawBufferID id) const = 0;
 		ND_ virtual ExternalImageDesc_t  GetApiSpecificDescription (RawImageID id) const = 0;
+
+			// Returns index of the resource in the global descriptor heap ('FG_BindlessDescriptorSet'),
+			// returns 'UMax' if bindless mode is disabled or resource is not added to the heap.
+			// Images must have 'Sampled' usage and buffers must have 'Storage' usage.
+		ND_ virtual uint			GetBindlessIndex (RawImageID id) const = 0;
+		ND_ virtual uint			GetBindlessIndex (RawBufferID id) const = 0;
+		ND_ virtual uint			GetBindlessIndex (RawSamplerID id) const = 0;
 		
 			// Returns 'true' if resource is not deleted.
 		ND_	virtual bool			IsResourceAlive (RawGPipelineID id) const = 0;
@@ -186,12 +186,14 @@ namespace _fg_hidden_
 
 	// variables
 		RawGPipelineID			pipeline;
+		RawGPipelineID			fallbackPipeline;	// used while 'pipeline' is compiled on background thread, must have the same pipeline layout
 		
 		VertexInputState		vertexInput;
 		Buffers_t				vertexBuffers;
 
 		EPrimitive				topology			= Default;
 		bool					primitiveRestart	= false;	// if 'true' then index with -1 value will restarting the assembly of primitives
+		bool					warmUp				= false;	// if 'true' then pipeline instance is compiled but draw commands are not recorded
 
 
 	// methods
@@ -200,6 +202,8 @@ namespace _fg_hidden_
 
 		TaskType&  SetTopology (EPrimitive value)					{ topology = value;  return static_cast<TaskType &>( *this ); }
 		TaskType&  SetPipeline (RawGPipelineID ppln)				{ ASSERT( ppln );  pipeline = ppln;  return static_cast<TaskType &>( *this ); }
+		TaskType&  SetFallbackPipeline (RawGPipelineID ppln)		{ ASSERT( ppln );  fallbackPipeline = ppln;  return static_cast<TaskType &>( *this ); }
+		TaskType&  SetWarmUp (bool value = true)					{ warmUp = value;  return static_cast<TaskType &>( *this ); }
 
 		TaskType&  SetVertexInput (const VertexInputState &value)	{ vertexInput = value;  return static_cast<TaskType &>( *this ); }
 		TaskType&  SetPrimitiveRestartEnabled (bool value)			{ primitiveRestart = value;  return static_cast<TaskType &>( *this ); }
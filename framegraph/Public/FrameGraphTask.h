@@ -664,10 +664,20 @@ namespace FG
 	struct UpdateBuffer final : _fg_hidden_::BaseTask<UpdateBuffer>
 	{
 	// types
+		using Callback_t	= std::function< void (void* dst, BytesU offset, BytesU size) >;
+
 		struct Region
 		{
 			BytesU				offset;
 			ArrayView<uint8_t>	data;
+			BytesU				size;		// only for 'writer'
+			Callback_t			writer;		// if not null then 'data' is ignored
+
+			Region () {}
+			Region (BytesU off, ArrayView<uint8_t> src) : offset{off}, data{src} {}
+			Region (BytesU off, BytesU dataSize, Callback_t &&fn) : offset{off}, size{dataSize}, writer{std::move(fn)} {}
+
+			ND_ BytesU  Size () const	{ return writer ? size : ArraySizeOf(data); }
 		};
 		using Regions_t	= FixedArray< Region, FG_MaxCopyRegions >;
 
@@ -718,6 +728,15 @@ namespace FG
 			regions.emplace_back( bufferOffset, ArrayView{ Cast<uint8_t>(ptr), size_t(size) });
 			return *this;
 		}
+
+		// 'fn' writes data directly to the mapped staging memory to avoid additional copy,
+		// it is called inside 'AddTask' one or more times, 'offset' is relative to the beginning of the region.
+		template <typename FN>
+		UpdateBuffer&  AddDataWriter (FN &&fn, BytesU size, BytesU bufferOffset = 0_b)
+		{
+			regions.emplace_back( bufferOffset, size, Callback_t{ std::forward<FN>(fn) });
+			return *this;
+		}
 	};
 
 
@@ -764,6 +783,9 @@ namespace FG
 	//
 	struct UpdateImage final : _fg_hidden_::BaseTask<UpdateImage>
 	{
+	// types
+		using Callback_t	= std::function< void (void* dst, BytesU offset, BytesU size) >;
+
 	// variables
 		RawImageID			dstImage;
 		int3				imageOffset;
@@ -774,6 +796,7 @@ namespace FG
 		BytesU				dataSlicePitch;
 		EImageAspect		aspectMask	= EImageAspect::Color;	// must only have a single bit set
 		ArrayView<uint8_t>	data;
+		Callback_t			writer;		// if not null then 'data' is ignored
 
 		
 	// methods
@@ -836,6 +859,20 @@ namespace FG
 		{
 			return SetData( ArrayView<uint8_t>{ Cast<uint8_t>(ptr), count*sizeof(T) }, dimension, rowPitch, slicePitch );
 		}
+		
+		// 'fn' writes data directly to the mapped staging memory to avoid additional copy,
+		// it is called inside 'AddTask' one or more times with whole rows or slices,
+		// 'offset' is relative to the beginning of the image data with specified pitches.
+		template <typename FN>
+		UpdateImage&  SetDataWriter (FN &&fn, const uint3 &dimension, BytesU rowPitch = 0_b, BytesU slicePitch = 0_b)
+		{
+			writer			= std::forward<FN>(fn);
+			data			= Default;
+			imageSize		= dimension;
+			dataRowPitch	= rowPitch;
+			dataSlicePitch	= slicePitch;
+			return *this;
+		}
 	};
 
 
@@ -857,6 +894,9 @@ namespace FG
 		MipmapLevel		mipmapLevel;
 		EImageAspect	aspectMask	= EImageAspect::Color;	// must only have a single bit set
 		Callback_t		callback;							// may be called from any thread
+		bool			contiguous	= false;				// read image into a single buffer, see 'SetContiguous()'
+		BytesU			dataRowPitch;
+		BytesU			dataSlicePitch;
 
 		
 	// methods
@@ -900,6 +940,16 @@ namespace FG
 			callback = std::move(value);
 			return *this;
 		}
+
+		// image is copied into a single host cached buffer with specified pitches (minimal if zero),
+		// callback receives view of the mapped memory without intermediate copy, buffer is released after callback returns.
+		ReadImage&  SetContiguous (BytesU rowPitch = 0_b, BytesU slicePitch = 0_b)
+		{
+			contiguous		= true;
+			dataRowPitch	= rowPitch;
+			dataSlicePitch	= slicePitch;
+			return *this;
+		}
 	};
 
 
@@ -148,6 +148,7 @@ namespace FG
 			UniformID		id;
 			EDescriptorType	resType		= Default;
 			uint16_t		offset		= 0;
+			HashVal			elementsHash;		// sum of element hashes, updated for each changed element
 
 			// for sorting and searching
 			ND_ bool  operator == (const UniformID &rhs) const	{ return id == rhs; }
@@ -266,6 +267,7 @@ namespace FG
 		ND_ uint &					_GetDynamicOffset (uint i)		{ ASSERT( _dataPtr and i < _dataPtr->dynamicOffsetsCount );  return _dataPtr->DynamicOffsets()[i]; }
 
 		template <typename T> T *	_GetResource (const UniformID &id);
+		template <typename T> T *	_GetResource (const UniformID &id, OUT Uniform* &un);
 		template <typename T> bool	_HasResource (const UniformID &id) const;
 	};
 
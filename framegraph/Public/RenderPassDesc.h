@@ -61,7 +61,7 @@ namespace FG
 		PipelineResourceSet			perPassResources;	// this resources will be added for all draw tasks
 
 
-		//bool						useSecondaryCmdbuf	= false;	// CPU optimization
+		bool						useSecondaryCmdbuf	= false;	// (optimization) draw tasks will be recorded into secondary command buffers on worker threads
 
 		//bool						parallelExecution	= true;		// (optimization) if 'false' all draw and compute tasks will be executed in initial order
 		//bool						canBeMerged			= true;		// (optimization) g-buffer render passes can be merged, but don't merge conditional passes
@@ -156,6 +156,9 @@ namespace FG
 		RenderPassDesc&  SetAlphaToOneEnabled (bool value);
 
 		RenderPassDesc&  SetShadingRateImage (RawImageID image, ImageLayer layer = Default, MipmapLevel level = Default);
+
+		// optimization
+		RenderPassDesc&  SetSecondaryCmdbufEnabled (bool value);
 		
 		RenderPassDesc&  AddResources (const DescriptorSetID &id, const PipelineResources *res);
 		RenderPassDesc&  AddResources (const DescriptorSetID &id, PipelineResources &res)	{ return AddResources( id, &res ); }
@@ -533,6 +536,17 @@ namespace FG
 		return *this;
 	}
 	
+/*
+=================================================
+	SetSecondaryCmdbufEnabled
+=================================================
+*/
+	inline RenderPassDesc&  RenderPassDesc::SetSecondaryCmdbufEnabled (bool value)
+	{
+		useSecondaryCmdbuf = value;
+		return *this;
+	}
+
 /*
 =================================================
 	AddResources
@@ -0,0 +1,135 @@
+// Copyright (c) 2018-2020,  Zhirnov Andrey. For more information see 'LICENSE'
+/*
+	Upload scheduler splits large buffer and image uploads into parts and records them
+	into transfer command buffers so that each 'Update()' call uploads no more than
+	specified number of bytes and no more than 'DeviceProperties::maxUploadSize'.
+	So uploads of any size are streamed through the staging memory across several frames.
+	If staging memory is exhausted by other command buffers then the part is uploaded
+	in the next 'Update()' call, writer may be called again for the same part in this case.
+
+	Requests with higher priority are uploaded first, requests with the same priority
+	are uploaded in the order they were added.
+	Scheduler is not thread safe, but 'Future' can be checked from any thread.
+*/
+
+#pragma once
+
+#include "framegraph/Public/FrameGraph.h"
+
+namespace FG
+{
+
+	//
+	// Upload Scheduler
+	//
+
+	class UploadScheduler final
+	{
+	// types
+	public:
+		enum class EPriority : uint
+		{
+			Low,
+			Normal,
+			High,
+			_Count
+		};
+
+		// writes data directly to the staging memory, see 'UpdateBuffer::AddDataWriter()'
+		using Writer_t	= std::function< void (void* dst, BytesU offset, BytesU size) >;
+
+	private:
+		struct Request;
+		using RequestPtr	= SharedPtr< Request >;
+		using Requests_t	= Deque< RequestPtr >;
+
+		static constexpr uint	MaxAttempts	= 8;	// request is failed if it can not be recorded in this number of frames
+
+		struct InFlight
+		{
+			CommandBuffer			cmd;
+			Array< RequestPtr >		completed;	// requests that will be completed with this command buffer
+		};
+
+	public:
+		class Future
+		{
+			friend class UploadScheduler;
+		private:
+			RequestPtr	_request;
+
+		public:
+			Future () {}
+
+			// returns 'true' when all data is uploaded and transfer commands have completed on the GPU
+			ND_ bool  IsComplete () const;
+			ND_ bool  IsFailed () const;
+
+			// returns number of bytes that are recorded into command buffers
+			ND_ BytesU  Uploaded () const;
+			ND_ BytesU  Size () const;
+
+			ND_ explicit operator bool () const		{ return _request != null; }
+		};
+
+
+	// variables
+	private:
+		FrameGraph				_frameGraph;
+		EQueueType				_queue			= EQueueType::Graphics;
+		BytesU					_budget			= 8_Mb;
+		BytesU					_maxUploadSize	= ~0_b;		// staging memory that is available for single command buffer
+		Requests_t				_requests [uint(EPriority::_Count)];
+		Deque< InFlight >		_inFlight;
+
+
+	// methods
+	public:
+		UploadScheduler ();
+		~UploadScheduler ();
+
+		// uploads are recorded to the async transfer queue if it is available, otherwise to the graphics queue,
+		// resources must be created with queue mask that contains this queue and the queues where resources are used.
+		bool  Initialize (const FrameGraph &fg, BytesU budgetPerFrame = 8_Mb);
+		bool  Initialize (const FrameGraph &fg, EQueueType queue, BytesU budgetPerFrame);
+
+		// waits for all in-flight uploads, requests that are not uploaded yet will be failed
+		void  Deinitialize ();
+
+		void  SetBudget (BytesU budgetPerFrame);
+
+		// 'data' must be valid until request is complete, 'writer' is called inside 'Update()'
+		ND_ Future  Upload (RawBufferID buffer, BytesU offset, ArrayView<uint8_t> data, EPriority priority = EPriority::Normal);
+		ND_ Future  Upload (RawBufferID buffer, BytesU offset, BytesU size, Writer_t &&writer, EPriority priority = EPriority::Normal);
+
+		// image data is split by rows, 'rowPitch' and 'slicePitch' have the same meaning as in 'UpdateImage'
+		ND_ Future  Upload (RawImageID image, const int3 &offset, const uint3 &size, ArrayView<uint8_t> data, BytesU rowPitch = 0_b, BytesU slicePitch = 0_b,
+							MipmapLevel mipmap = Default, ImageLayer layer = Default, EPriority priority = EPriority::Normal);
+		ND_ Future  Upload (RawImageID image, const int3 &offset, const uint3 &size, Writer_t &&writer, BytesU rowPitch = 0_b, BytesU slicePitch = 0_b,
+							MipmapLevel mipmap = Default, ImageLayer layer = Default, EPriority priority = EPriority::Normal);
+
+		// call once per frame, records transfer tasks within budget, executes and submits command buffer,
+		// 'cmd' can be used as dependency for command buffers that use uploaded resources.
+		bool  Update ();
+		bool  Update (OUT CommandBuffer &cmd);
+
+		ND_ bool		HasPendingRequests () const;
+		ND_ EQueueType	GetQueueType ()		const	{ return _queue; }
+		ND_ BytesU		GetBudget ()		const	{ return _budget; }
+
+	private:
+		void  _CompleteInFlight ();
+
+		ND_ BytesU  _FrameBudget () const	{ return Min( _budget, _maxUploadSize ); }
+
+		bool  _RecordRequest (const CommandBuffer &cmd, Request &req, INOUT BytesU &budget);
+		bool  _RecordBuffer (const CommandBuffer &cmd, Request &req, INOUT BytesU &budget);
+		bool  _RecordImage (const CommandBuffer &cmd, Request &req, INOUT BytesU &budget);
+
+		ND_ Future		_AddRequest (RequestPtr &&req, EPriority priority);
+		ND_ RequestPtr	_CreateImageRequest (RawImageID image, const int3 &offset, const uint3 &size, BytesU rowPitch,
+											 BytesU slicePitch, MipmapLevel mipmap, ImageLayer layer) const;
+	};
+
+
+}	// FG
@@ -62,6 +62,18 @@ namespace FG
 
 		BytesU				maxStagingBufferMemory	= ~0_b;	// you can limit max size of host visible memory that may be used by FrameGraph, by default used max available size.
 		BytesU				stagingBufferSize		= 0_b;	// max size of single staging buffer (needed for tests), 0 - auto
+		
+		// global descriptor set with all sampled images, samplers and storage buffers, requires descriptor indexing with update-after-bind,
+		// it is bound to 'FG_BindlessDescriptorSet' if pipeline uses this set, see 'IFrameGraph::GetBindlessIndex()'.
+		bool				enableBindless			= false;
+
+		// if not empty then pipeline cache is loaded from this file in 'Initialize()' and saved in 'Deinitialize()',
+		// file is ignored if it was created for another device or driver version.
+		StringView			pipelineCacheFile;
+
+		// graphics pipeline instances are compiled on background threads, draw task that uses not compiled instance
+		// is skipped or drawn with fallback pipeline, see 'DrawVertices::SetFallbackPipeline()' and 'DrawVertices::SetWarmUp()'.
+		bool				asyncPipelineCompilation	= false;
 	};
 
 
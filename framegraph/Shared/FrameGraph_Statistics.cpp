@@ -15,6 +15,10 @@ namespace FG
 		dst.descriptorBinds				+= src.descriptorBinds;
 		dst.pushConstants				+= src.pushConstants;
 		dst.pipelineBarriers			+= src.pipelineBarriers;
+		dst.batchedTasks				+= src.batchedTasks;
+		dst.splitBarriers				+= src.splitBarriers;
+		dst.reusedSchedules				+= src.reusedSchedules;
+		dst.aliasingFences				+= src.aliasingFences;
 		dst.transferOps					+= src.transferOps;
 
 		dst.indexBufferBindings			+= src.indexBufferBindings;
@@ -35,6 +39,7 @@ namespace FG
 
 		dst.gpuTime						+= src.gpuTime;
 		dst.cpuTime						+= src.cpuTime;
+		dst.queueSubmits				+= src.queueSubmits;
 	}
 	
 /*
@@ -47,6 +52,11 @@ namespace FG
 		dst.newComputePipelineCount		+= src.newComputePipelineCount;
 		dst.newGraphicsPipelineCount	+= src.newGraphicsPipelineCount;
 		dst.newRayTracingPipelineCount	+= src.newRayTracingPipelineCount;
+		dst.memoryBlockReuses			+= src.memoryBlockReuses;
+		dst.memoryBlockAllocations		+= src.memoryBlockAllocations;
+		dst.memoryBlockReleases			+= src.memoryBlockReleases;
+		dst.asyncGraphicsPipelineCount	+= src.asyncGraphicsPipelineCount;
+		dst.pipelineHitchesAvoided		+= src.pipelineHitchesAvoided;
 	}
 
 /*
@@ -21,6 +21,36 @@ namespace FG
 		using Value_t		= uint;
 		using SubRange_t	= ResourceDataRange< Value_t >;
 
+		//
+		// Region of mipmap level in texels
+		//
+		struct RegionU
+		{
+		// variables
+			uint3	begin	{ 0u };
+			uint3	end		{ ~0u };
+			
+		// methods
+			RegionU () {}
+			RegionU (const uint3 &begin, const uint3 &end) : begin{begin}, end{end} {}
+
+			ND_ bool	IsWhole ()							const	{ return All( begin == uint3{0u} ) and All( end == uint3{~0u} ); }
+
+			ND_ bool	operator == (const RegionU &rhs)	const	{ return All( begin == rhs.begin ) and All( end == rhs.end ); }
+			ND_ bool	operator != (const RegionU &rhs)	const	{ return not (*this == rhs); }
+			
+			// regions that have common border are not intersected
+			ND_ bool	IsIntersects (const RegionU &other)	const	{ return All( begin < other.end ) and All( other.begin < end ); }
+
+			// bounding box of both regions
+			RegionU&	Merge (const RegionU &other)
+			{
+				begin	= Min( begin, other.begin );
+				end		= Max( end, other.end );
+				return *this;
+			}
+		};
+
 	private:
 		using RangeU		= ResourceDataRange< uint >;
 
@@ -29,6 +59,7 @@ namespace FG
 	private:
 		RangeU		_layers;
 		RangeU		_mipmaps;
+		RegionU		_region;		// same region for all layers and mipmaps
 
 
 	// methods
@@ -45,15 +76,23 @@ namespace FG
 			_mipmaps = RangeU{ 0, levelCount } + baseLevel.Get();
 		}
 
+		ImageDataRange (ImageLayer baseLayer, uint layerCount, MipmapLevel baseLevel, uint levelCount, const RegionU &region) :
+			ImageDataRange{ baseLayer, layerCount, baseLevel, levelCount }
+		{
+			_region = region;
+		}
+
 		ND_ RangeU const&	Layers ()						const	{ return _layers; }
 		ND_ RangeU const&	Mipmaps ()						const	{ return _mipmaps; }
+		ND_ RegionU const&	Region ()						const	{ return _region; }
 		
 		ND_ bool		IsWholeLayers ()					const	{ return _layers.IsWhole(); }
 		ND_ bool		IsWholeMipmaps ()					const	{ return _mipmaps.IsWhole(); }
+		ND_ bool		IsWholeRegion ()					const	{ return _region.IsWhole(); }
 		
 		ND_ bool		IsEmpty ()							const	{ return _layers.IsEmpty() or _mipmaps.IsEmpty(); }
 		
-		ND_ bool		operator == (const Self &rhs)		const	{ return _layers == rhs._layers and _mipmaps == rhs._mipmaps; }
+		ND_ bool		operator == (const Self &rhs)		const	{ return _layers == rhs._layers and _mipmaps == rhs._mipmaps and _region == rhs._region; }
 		ND_ bool		operator != (const Self &rhs)		const	{ return not (*this == rhs); }
 
 
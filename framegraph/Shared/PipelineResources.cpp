@@ -27,19 +27,19 @@ namespace {
 /*
 =================================================
 	HashOf (Buffer)
+----
+	elements are hashed separately, see 'HashOfElement'
 =================================================
 */
 	inline HashVal  HashOf (const FG::PipelineResources::Buffer &buf)
 	{
-		HashVal	result = FGC::HashOf( buf.index ) + FGC::HashOf( buf.state ) +
-						 FGC::HashOf( buf.dynamicOffsetIndex ) + FGC::HashOf( buf.elementCount );
+		return	FGC::HashOf( buf.index ) + FGC::HashOf( buf.state ) +
+				FGC::HashOf( buf.dynamicOffsetIndex ) + FGC::HashOf( buf.elementCount );
+	}
 
-		for (uint16_t i = 0; i < buf.elementCount; ++i)
-		{
-			auto&	elem = buf.elements[i];
-			result << (FGC::HashOf( elem.bufferId ) + FGC::HashOf( elem.offset ) + FGC::HashOf( elem.size ));
-		}
-		return result;
+	inline HashVal  HashOf (const FG::PipelineResources::Buffer::Element &elem)
+	{
+		return FGC::HashOf( elem.bufferId ) + FGC::HashOf( elem.offset ) + FGC::HashOf( elem.size );
 	}
 
 /*
@@ -49,14 +49,12 @@ namespace {
 */
 	inline HashVal  HashOf (const FG::PipelineResources::TexelBuffer &buf)
 	{
-		HashVal	result = FGC::HashOf( buf.index ) + FGC::HashOf( buf.state );
+		return FGC::HashOf( buf.index ) + FGC::HashOf( buf.state ) + FGC::HashOf( buf.elementCount );
+	}
 
-		for (uint16_t i = 0; i < buf.elementCount; ++i)
-		{
-			auto&	elem = buf.elements[i];
-			result << (FGC::HashOf( elem.bufferId ) + FGC::HashOf( elem.desc ));
-		}
-		return result;
+	inline HashVal  HashOf (const FG::PipelineResources::TexelBuffer::Element &elem)
+	{
+		return FGC::HashOf( elem.bufferId ) + FGC::HashOf( elem.desc );
 	}
 	
 /*
@@ -66,15 +64,13 @@ namespace {
 */
 	inline HashVal  HashOf (const FG::PipelineResources::Image &img)
 	{
-		HashVal	result = FGC::HashOf( img.index ) + FGC::HashOf( img.state ) +
-						 FGC::HashOf( img.imageType ) + FGC::HashOf( img.elementCount );
+		return	FGC::HashOf( img.index ) + FGC::HashOf( img.state ) +
+				FGC::HashOf( img.imageType ) + FGC::HashOf( img.elementCount );
+	}
 
-		for (uint16_t i = 0; i < img.elementCount; ++i)
-		{
-			auto&	elem = img.elements[i];
-			result << (FGC::HashOf( elem.imageId ) + (elem.hasDesc ? FGC::HashOf( elem.desc ) : HashVal{}));
-		}
-		return result;
+	inline HashVal  HashOf (const FG::PipelineResources::Image::Element &elem)
+	{
+		return FGC::HashOf( elem.imageId ) + (elem.hasDesc ? FGC::HashOf( elem.desc ) : HashVal{});
 	}
 	
 /*
@@ -84,16 +80,14 @@ namespace {
 */
 	inline HashVal  HashOf (const FG::PipelineResources::Texture &tex)
 	{
-		HashVal	result = FGC::HashOf( tex.index ) + FGC::HashOf( tex.state ) +
-						 FGC::HashOf( tex.samplerType ) + FGC::HashOf( tex.elementCount );
+		return	FGC::HashOf( tex.index ) + FGC::HashOf( tex.state ) +
+				FGC::HashOf( tex.samplerType ) + FGC::HashOf( tex.elementCount );
+	}
 
-		for (uint16_t i = 0; i < tex.elementCount; ++i)
-		{
-			auto&	elem = tex.elements[i];
-			result << (FGC::HashOf( elem.imageId ) + FGC::HashOf( elem.samplerId ) +
-					   (elem.hasDesc ? FGC::HashOf( elem.desc ) : HashVal{}));
-		}
-		return result;
+	inline HashVal  HashOf (const FG::PipelineResources::Texture::Element &elem)
+	{
+		return	FGC::HashOf( elem.imageId ) + FGC::HashOf( elem.samplerId ) +
+				(elem.hasDesc ? FGC::HashOf( elem.desc ) : HashVal{});
 	}
 	
 /*
@@ -103,13 +97,12 @@ namespace {
 */
 	inline HashVal  HashOf (const FG::PipelineResources::Sampler &samp)
 	{
-		HashVal	result = FGC::HashOf( samp.index ) + FGC::HashOf( samp.elementCount );
+		return FGC::HashOf( samp.index ) + FGC::HashOf( samp.elementCount );
+	}
 
-		for (uint16_t i = 0; i < samp.elementCount; ++i)
-		{
-			result << FGC::HashOf( samp.elements[i].samplerId );
-		}
-		return result;
+	inline HashVal  HashOf (const FG::PipelineResources::Sampler::Element &elem)
+	{
+		return FGC::HashOf( elem.samplerId );
 	}
 
 /*
@@ -119,13 +112,69 @@ namespace {
 */
 	inline HashVal  HashOf (const FG::PipelineResources::RayTracingScene &rts)
 	{
-		HashVal	result = FGC::HashOf( rts.index ) + FGC::HashOf( rts.elementCount );
+		return FGC::HashOf( rts.index ) + FGC::HashOf( rts.elementCount );
+	}
 
-		for (uint16_t i = 0; i < rts.elementCount; ++i)
-		{
-			result << FGC::HashOf( rts.elements[i].sceneId );
+	inline HashVal  HashOf (const FG::PipelineResources::RayTracingScene::Element &elem)
+	{
+		return FGC::HashOf( elem.sceneId );
+	}
+
+/*
+=================================================
+	HashOfElement
+----
+	element hashes are summed, so single element
+	can be replaced without rehashing whole array.
+=================================================
+*/
+	template <typename T>
+	ND_ inline size_t  HashOfElement (const T &res, uint16_t index)
+	{
+		return size_t( HashOf( res.elements[index] ) << FGC::HashOf( index ));
+	}
+
+/*
+=================================================
+	HashOfElements
+=================================================
+*/
+	template <typename T>
+	ND_ inline HashVal  HashOfElements (const T &res)
+	{
+		size_t	result = 0;
+		for (uint16_t i = 0; i < res.elementCount; ++i) {
+			result += HashOfElement( res, i );
 		}
-		return result;
+		return HashVal{ result };
+	}
+
+/*
+=================================================
+	BeginElementUpdate / EndElementUpdate
+----
+	must be called before and after element is changed,
+	elements between old and new element count are added to the hash.
+=================================================
+*/
+	template <typename T>
+	inline void  BeginElementUpdate (INOUT FG::PipelineResources::Uniform &un, const T &res, uint16_t index)
+	{
+		size_t	hash = size_t(un.elementsHash);
+
+		if ( index < res.elementCount )
+			hash -= HashOfElement( res, index );
+		
+		for (uint16_t i = res.elementCount; i < index; ++i) {
+			hash += HashOfElement( res, i );
+		}
+		un.elementsHash = HashVal{ hash };
+	}
+
+	template <typename T>
+	inline void  EndElementUpdate (INOUT FG::PipelineResources::Uniform &un, const T &res, uint16_t index)
+	{
+		un.elementsHash = HashVal{ size_t(un.elementsHash) + HashOfElement( res, index )};
 	}
 
 }	// namespace
@@ -166,7 +215,7 @@ namespace FG
 =================================================
 */
 	template <typename T>
-	ND_ inline T*  PipelineResources::_GetResource (const UniformID &id)
+	ND_ inline T*  PipelineResources::_GetResource (const UniformID &id, OUT Uniform* &un)
 	{
 		SHAREDLOCK( _drCheck );
 		
@@ -177,15 +226,22 @@ namespace FG
 		
 			if ( index < _dataPtr->uniformCount )
 			{
-				auto&	un = uniforms[ index ];
-				ASSERT( un.resType == T::TypeId );
+				un = &uniforms[ index ];
+				ASSERT( un->resType == T::TypeId );
 
-				return Cast<T>( _dataPtr.get() + BytesU{un.offset} );
+				return Cast<T>( _dataPtr.get() + BytesU{un->offset} );
 			}
 		}
 		return null;
 	}
 	
+	template <typename T>
+	ND_ inline T*  PipelineResources::_GetResource (const UniformID &id)
+	{
+		Uniform*	un = null;
+		return _GetResource<T>( id, OUT un );
+	}
+	
 /*
 =================================================
 	_HasResource
@@ -225,7 +281,8 @@ namespace FG
 		EXLOCK( _drCheck );
 		UNIFORM_EXISTS( HasImage( id ));
 
-		if ( auto* res = _GetResource<Image>( id ))
+		Uniform*	un = null;
+		if ( auto* res = _GetResource<Image>( id, OUT un ))
 		{
 			auto&	img = res->elements[ index ];
 			ASSERT( index < res->elementCapacity );
@@ -233,9 +290,11 @@ namespace FG
 			if ( img.imageId != image or img.hasDesc or res->elementCount <= index )
 				_ResetCachedID();
 		
+			BeginElementUpdate( *un, *res, uint16_t(index) );
 			res->elementCount	= Max( uint16_t(index+1), res->elementCount );
 			img.imageId			= image;
 			img.hasDesc			= false;
+			EndElementUpdate( *un, *res, uint16_t(index) );
 		}
 		return *this;
 	}
@@ -245,7 +304,8 @@ namespace FG
 		EXLOCK( _drCheck );
 		UNIFORM_EXISTS( HasImage( id ));
 
-		if ( auto* res = _GetResource<Image>( id ))
+		Uniform*	un = null;
+		if ( auto* res = _GetResource<Image>( id, OUT un ))
 		{
 			auto&	img = res->elements[ index ];
 			ASSERT( index < res->elementCapacity );
@@ -253,10 +313,12 @@ namespace FG
 			if ( img.imageId != image or not img.hasDesc or not (img.desc == desc) or res->elementCount <= index )
 				_ResetCachedID();
 		
+			BeginElementUpdate( *un, *res, uint16_t(index) );
 			res->elementCount	= Max( uint16_t(index+1), res->elementCount );
 			img.imageId			= image;
 			img.desc			= desc;
 			img.hasDesc			= true;
+			EndElementUpdate( *un, *res, uint16_t(index) );
 		}
 		return *this;
 	}
@@ -271,7 +333,8 @@ namespace FG
 		EXLOCK( _drCheck );
 		UNIFORM_EXISTS( HasImage( id ));
 
-		if ( auto* res = _GetResource<Image>( id ))
+		Uniform*	un = null;
+		if ( auto* res = _GetResource<Image>( id, OUT un ))
 		{
 			bool	changed	= res->elementCount != images.size();
 		
@@ -287,6 +350,7 @@ namespace FG
 				img.imageId	= images[i];
 				img.hasDesc	= false;
 			}
+			un->elementsHash = HashOfElements( *res );
 
 			if ( changed )
 				_ResetCachedID();
@@ -310,7 +374,8 @@ namespace FG
 		EXLOCK( _drCheck );
 		UNIFORM_EXISTS( HasTexture( id ));
 
-		if ( auto* res = _GetResource<Texture>( id ))
+		Uniform*	un = null;
+		if ( auto* res = _GetResource<Texture>( id, OUT un ))
 		{
 			auto&	tex = res->elements[ index ];
 			ASSERT( index < res->elementCapacity );
@@ -318,10 +383,12 @@ namespace FG
 			if ( tex.imageId != image or tex.samplerId != sampler or tex.hasDesc or res->elementCount <= index )
 				_ResetCachedID();
 		
+			BeginElementUpdate( *un, *res, uint16_t(index) );
 			res->elementCount	= Max( uint16_t(index+1), res->elementCount );
 			tex.imageId			= image;
 			tex.samplerId		= sampler;
 			tex.hasDesc			= false;
+			EndElementUpdate( *un, *res, uint16_t(index) );
 		}
 		return *this;
 	}
@@ -331,7 +398,8 @@ namespace FG
 		EXLOCK( _drCheck );
 		UNIFORM_EXISTS( HasTexture( id ));
 
-		if ( auto* res = _GetResource<Texture>( id ))
+		Uniform*	un = null;
+		if ( auto* res = _GetResource<Texture>( id, OUT un ))
 		{
 			auto&	tex = res->elements[ index ];
 			ASSERT( index < res->elementCapacity );
@@ -339,11 +407,13 @@ namespace FG
 			if ( tex.imageId != image or tex.samplerId != sampler or not tex.hasDesc or not (tex.desc == desc) or res->elementCount <= index )
 				_ResetCachedID();
 		
+			BeginElementUpdate( *un, *res, uint16_t(index) );
 			res->elementCount	= Max( uint16_t(index+1), res->elementCount );
 			tex.imageId			= image;
 			tex.samplerId		= sampler;
 			tex.desc			= desc;
 			tex.hasDesc			= true;
+			EndElementUpdate( *un, *res, uint16_t(index) );
 		}
 		return *this;
 	}
@@ -364,7 +434,8 @@ namespace FG
 		EXLOCK( _drCheck );
 		UNIFORM_EXISTS( HasTexture( id ));
 
-		if ( auto* res = _GetResource<Texture>( id ))
+		Uniform*	un = null;
+		if ( auto* res = _GetResource<Texture>( id, OUT un ))
 		{
 			bool	changed = res->elementCount != images.size();
 
@@ -381,6 +452,7 @@ namespace FG
 				tex.samplerId	= sampler;
 				tex.hasDesc		= false;
 			}
+			un->elementsHash = HashOfElements( *res );
 
 			if ( changed )
 				_ResetCachedID();
@@ -398,7 +470,8 @@ namespace FG
 		EXLOCK( _drCheck );
 		UNIFORM_EXISTS( HasSampler( id ));
 
-		if ( auto* res = _GetResource<Sampler>( id ))
+		Uniform*	un = null;
+		if ( auto* res = _GetResource<Sampler>( id, OUT un ))
 		{
 			auto&	samp = res->elements[ index ];
 			ASSERT( index < res->elementCapacity );
@@ -406,8 +479,10 @@ namespace FG
 			if ( samp.samplerId != sampler or res->elementCount <= index )
 				_ResetCachedID();
 		
+			BeginElementUpdate( *un, *res, uint16_t(index) );
 			res->elementCount	= Max( uint16_t(index+1), res->elementCount );
 			samp.samplerId		= sampler;
+			EndElementUpdate( *un, *res, uint16_t(index) );
 		}
 		return *this;
 	}
@@ -428,7 +503,8 @@ namespace FG
 		EXLOCK( _drCheck );
 		UNIFORM_EXISTS( HasSampler( id ));
 
-		if ( auto* res = _GetResource<Sampler>( id ))
+		Uniform*	un = null;
+		if ( auto* res = _GetResource<Sampler>( id, OUT un ))
 		{
 			bool	changed = res->elementCount != samplers.size();
 		
@@ -443,6 +519,7 @@ namespace FG
 
 				samp.samplerId = samplers[i];
 			}
+			un->elementsHash = HashOfElements( *res );
 
 			if ( changed )
 				_ResetCachedID();
@@ -465,7 +542,8 @@ namespace FG
 		EXLOCK( _drCheck );
 		UNIFORM_EXISTS( HasBuffer( id ));
 
-		if ( auto* res = _GetResource<Buffer>( id ))
+		Uniform*	un = null;
+		if ( auto* res = _GetResource<Buffer>( id, OUT un ))
 		{
 			auto&	buf	= res->elements[ index ];
 
@@ -474,6 +552,8 @@ namespace FG
 
 			bool	changed = (buf.bufferId != buffer or buf.size != size or res->elementCount <= index);
 		
+			BeginElementUpdate( *un, *res, uint16_t(index) );
+
 			if ( res->dynamicOffsetIndex == PipelineDescription::STATIC_OFFSET )
 			{
 				changed		|= (buf.offset != offset);
@@ -491,6 +571,7 @@ namespace FG
 			res->elementCount	= Max( uint16_t(index+1), res->elementCount );
 			buf.bufferId		= buffer;
 			buf.size			= size;
+			EndElementUpdate( *un, *res, uint16_t(index) );
 		}
 		return *this;
 	}
@@ -511,7 +592,8 @@ namespace FG
 		EXLOCK( _drCheck );
 		UNIFORM_EXISTS( HasBuffer( id ));
 		
-		if ( auto* res = _GetResource<Buffer>( id ))
+		Uniform*	un = null;
+		if ( auto* res = _GetResource<Buffer>( id, OUT un ))
 		{
 			bool	changed = res->elementCount != buffers.size();
 			BytesU	offset	= 0_b;
@@ -540,6 +622,7 @@ namespace FG
 				buf.bufferId = buffers[i];
 				buf.size	 = size;
 			}
+			un->elementsHash = HashOfElements( *res );
 		
 			if ( changed )
 				_ResetCachedID();
@@ -557,12 +640,14 @@ namespace FG
 		EXLOCK( _drCheck );
 		UNIFORM_EXISTS( HasBuffer( id ));
 
-		if ( auto* res = _GetResource<Buffer>( id ))
+		Uniform*	un = null;
+		if ( auto* res = _GetResource<Buffer>( id, OUT un ))
 		{
 			auto&	buf		= res->elements[ index ];
 			bool	changed	= res->elementCount <= index;
 
 			ASSERT( index < res->elementCapacity );
+			BeginElementUpdate( *un, *res, uint16_t(index) );
 			res->elementCount = Max( uint16_t(index+1), res->elementCount );
 
 			if ( res->dynamicOffsetIndex != PipelineDescription::STATIC_OFFSET )
@@ -571,6 +656,7 @@ namespace FG
 				_GetDynamicOffset( res->dynamicOffsetIndex + index ) = uint(uint64_t(_GetDynamicOffset( res->dynamicOffsetIndex + index ) + buf.offset - offset) & 0xFFFFFFFFull);
 				buf.offset = offset;
 			}
+			EndElementUpdate( *un, *res, uint16_t(index) );
 		
 			if ( changed )
 				_ResetCachedID();
@@ -588,7 +674,8 @@ namespace FG
 		EXLOCK( _drCheck );
 		UNIFORM_EXISTS( HasTexelBuffer( name ));
 
-		if ( auto* res = _GetResource<TexelBuffer>( name ))
+		Uniform*	un = null;
+		if ( auto* res = _GetResource<TexelBuffer>( name, OUT un ))
 		{
 			auto&	texbuf  = res->elements[ index ];
 			bool	changed	= res->elementCount <= index;
@@ -596,10 +683,12 @@ namespace FG
 			changed |= ((texbuf.bufferId != buffer) or not (texbuf.desc == desc));
 
 			ASSERT( index < res->elementCapacity );
+			BeginElementUpdate( *un, *res, uint16_t(index) );
 			res->elementCount = Max( uint16_t(index+1), res->elementCount );
 
 			texbuf.bufferId	= buffer;
 			texbuf.desc		= desc;
+			EndElementUpdate( *un, *res, uint16_t(index) );
 			
 			if ( changed )
 				_ResetCachedID();
@@ -617,15 +706,18 @@ namespace FG
 		EXLOCK( _drCheck );
 		UNIFORM_EXISTS( HasRayTracingScene( id ));
 
-		if ( auto* res = _GetResource<RayTracingScene>( id ))
+		Uniform*	un = null;
+		if ( auto* res = _GetResource<RayTracingScene>( id, OUT un ))
 		{
 			auto&	rts		= res->elements[ index ];
 			bool	changed	= (res->elementCount <= index) or (rts.sceneId != scene);
 
 			ASSERT( index < res->elementCapacity );
 
+			BeginElementUpdate( *un, *res, uint16_t(index) );
 			res->elementCount	= Max( uint16_t(index+1), res->elementCount );
 			rts.sceneId			= scene;
+			EndElementUpdate( *un, *res, uint16_t(index) );
 
 			if ( changed )
 				_ResetCachedID();
@@ -665,6 +757,7 @@ namespace FG
 		}
 		END_ENUM_CHECKS();
 		
+		un.elementsHash = HashVal{};
 		_ResetCachedID();
 	}
 	
@@ -679,6 +772,10 @@ namespace FG
 		CHECK_ERRV( _dataPtr );
 
 		_dataPtr->ForEachUniform( [](auto&, auto& data) { data.elementCount = 0; });
+
+		for (uint i = 0; i < _dataPtr->uniformCount; ++i) {
+			_dataPtr->Uniforms()[i].elementsHash = HashVal{};
+		}
 		_ResetCachedID();
 	}
 //-----------------------------------------------------------------------------
@@ -836,12 +933,23 @@ namespace {
 /*
 =================================================
 	CalcHash
+----
+	element hashes are updated in 'Bind***' methods,
+	so complexity depends only on number of uniforms.
 =================================================
 */
 	HashVal  PipelineResources::DynamicData::CalcHash () const
 	{
-		HashVal	result;
-		ForEachUniform( [&result] (const UniformID &id, auto& res) { result << HashOf(id) << HashOf(res); });
+		HashVal			result;
+		Uniform const*	uniforms = Uniforms();
+		uint			i		 = 0;
+
+		ForEachUniform( [&] (const UniformID &id, auto& res)
+						{
+							ASSERT( uniforms[i].elementsHash == HashOfElements( res ));
+							result << HashOf(id) << HashOf(res) << uniforms[i].elementsHash;
+							++i;
+						});
 		return result;
 	}
 
@@ -866,8 +974,10 @@ namespace {
 			void const*	rhs_ptr = (&rhs + BytesU{rhs_un.offset});
 			bool		equals	= true;
 
-			if ( lhs_un.id		!= rhs_un.id	or
-				 lhs_un.resType != rhs_un.resType )
+			// element hashes are compared first, so elements are compared only if hashes are equal
+			if ( lhs_un.id				!= rhs_un.id		or
+				 lhs_un.resType			!= rhs_un.resType	or
+				 lhs_un.elementsHash	!= rhs_un.elementsHash )
 				return false;
 
 			BEGIN_ENUM_CHECKS();
@@ -1065,6 +1175,9 @@ namespace {
 		std::sort( uniforms_ptr, uniforms_ptr + data->uniformCount,
 				   [] (auto& lhs, auto& rhs) { return lhs.id < rhs.id; });
 
+		un_index = 0;
+		data->ForEachUniform( [&] (auto&, auto& res) { uniforms_ptr[ un_index++ ].elementsHash = HashOfElements( res ); });
+
 		ASSERT( dbo_count == bufferDynamicOffsetCount );
 		return DynamicDataPtr{ data };
 	}
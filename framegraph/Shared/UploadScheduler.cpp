@@ -0,0 +1,507 @@
+// Copyright (c) 2018-2020,  Zhirnov Andrey. For more information see 'LICENSE'
+
+#include "framegraph/Public/UploadScheduler.h"
+#include "framegraph/Shared/EnumUtils.h"
+
+namespace FG
+{
+
+	//
+	// Upload Request
+	//
+	struct UploadScheduler::Request
+	{
+	// types
+		enum class EState : uint
+		{
+			Pending,
+			Recorded,		// all parts are recorded, waiting for command buffer completion
+			Complete,
+			Failed,
+		};
+
+	// variables
+		Atomic< EState >		state		{ EState::Pending };
+		Atomic< uint64_t >		uploaded	{ 0 };
+		BytesU					size;
+		ArrayView<uint8_t>		data;
+		Writer_t				writer;
+
+		// buffer
+		RawBufferID				buffer;
+		BytesU					bufferOffset;
+
+		// image
+		RawImageID				image;
+		int3					imageOffset;
+		uint3					imageSize;
+		MipmapLevel				mipmap;
+		ImageLayer				layer;
+		BytesU					rowPitch;
+		BytesU					slicePitch;
+		uint					blockHeight	= 1;
+		uint					slice		= 0;	// current slice
+		uint					row			= 0;	// current row in slice, in pixels
+		uint					attempts	= 0;	// number of failed attempts to record part of the request
+	};
+//-----------------------------------------------------------------------------
+
+
+/*
+=================================================
+	Future
+=================================================
+*/
+	bool  UploadScheduler::Future::IsComplete () const
+	{
+		return _request and _request->state.load( memory_order_acquire ) == Request::EState::Complete;
+	}
+
+	bool  UploadScheduler::Future::IsFailed () const
+	{
+		return not _request or _request->state.load( memory_order_relaxed ) == Request::EState::Failed;
+	}
+
+	BytesU  UploadScheduler::Future::Uploaded () const
+	{
+		return _request ? BytesU{ _request->uploaded.load( memory_order_relaxed )} : 0_b;
+	}
+
+	BytesU  UploadScheduler::Future::Size () const
+	{
+		return _request ? _request->size : 0_b;
+	}
+//-----------------------------------------------------------------------------
+
+
+/*
+=================================================
+	constructor
+=================================================
+*/
+	UploadScheduler::UploadScheduler ()
+	{}
+
+/*
+=================================================
+	destructor
+=================================================
+*/
+	UploadScheduler::~UploadScheduler ()
+	{
+		CHECK( not _frameGraph );
+	}
+
+/*
+=================================================
+	Initialize
+=================================================
+*/
+	bool  UploadScheduler::Initialize (const FrameGraph &fg, BytesU budgetPerFrame)
+	{
+		CHECK_ERR( fg );
+
+		const EQueueType	queue = AllBits( fg->GetAvilableQueues(), EQueueUsage::AsyncTransfer ) ? EQueueType::AsyncTransfer : EQueueType::Graphics;
+
+		return Initialize( fg, queue, budgetPerFrame );
+	}
+
+	bool  UploadScheduler::Initialize (const FrameGraph &fg, EQueueType queue, BytesU budgetPerFrame)
+	{
+		CHECK_ERR( fg and not _frameGraph );
+		CHECK_ERR( AllBits( fg->GetAvilableQueues(), EQueueUsage(1u << uint(queue)) ));
+
+		_frameGraph		= fg;
+		_queue			= queue;
+		_maxUploadSize	= Max( fg->GetDeviceProperties().maxUploadSize, 1_b );
+		SetBudget( budgetPerFrame );
+		return true;
+	}
+
+/*
+=================================================
+	Deinitialize
+=================================================
+*/
+	void  UploadScheduler::Deinitialize ()
+	{
+		if ( not _frameGraph )
+			return;
+
+		for (auto& frame : _inFlight) {
+			CHECK( _frameGraph->Wait({ frame.cmd }));
+		}
+		_CompleteInFlight();
+		ASSERT( _inFlight.empty() );
+
+		for (auto& requests : _requests)
+		{
+			for (auto& req : requests) {
+				req->state.store( Request::EState::Failed, memory_order_relaxed );
+			}
+			requests.clear();
+		}
+
+		_frameGraph = null;
+	}
+
+/*
+=================================================
+	SetBudget
+=================================================
+*/
+	void  UploadScheduler::SetBudget (BytesU budgetPerFrame)
+	{
+		ASSERT( budgetPerFrame > 0 );
+		_budget = Max( budgetPerFrame, 1_b );
+	}
+
+/*
+=================================================
+	Upload (buffer)
+=================================================
+*/
+	UploadScheduler::Future  UploadScheduler::Upload (RawBufferID buffer, BytesU offset, ArrayView<uint8_t> data, EPriority priority)
+	{
+		CHECK_ERR( buffer and data.size() );
+
+		auto	req = MakeShared<Request>();
+		req->buffer			= buffer;
+		req->bufferOffset	= offset;
+		req->data			= data;
+		req->size			= ArraySizeOf( data );
+
+		return _AddRequest( std::move(req), priority );
+	}
+
+	UploadScheduler::Future  UploadScheduler::Upload (RawBufferID buffer, BytesU offset, BytesU size, Writer_t &&writer, EPriority priority)
+	{
+		CHECK_ERR( buffer and size > 0 and writer );
+
+		auto	req = MakeShared<Request>();
+		req->buffer			= buffer;
+		req->bufferOffset	= offset;
+		req->writer			= std::move(writer);
+		req->size			= size;
+
+		return _AddRequest( std::move(req), priority );
+	}
+
+/*
+=================================================
+	Upload (image)
+=================================================
+*/
+	UploadScheduler::Future  UploadScheduler::Upload (RawImageID image, const int3 &offset, const uint3 &size, ArrayView<uint8_t> data,
+													  BytesU rowPitch, BytesU slicePitch, MipmapLevel mipmap, ImageLayer layer, EPriority priority)
+	{
+		auto	req = _CreateImageRequest( image, offset, size, rowPitch, slicePitch, mipmap, layer );
+		CHECK_ERR( req );
+		CHECK_ERR( ArraySizeOf(data) == req->size );
+
+		req->data = data;
+		return _AddRequest( std::move(req), priority );
+	}
+
+	UploadScheduler::Future  UploadScheduler::Upload (RawImageID image, const int3 &offset, const uint3 &size, Writer_t &&writer,
+													  BytesU rowPitch, BytesU slicePitch, MipmapLevel mipmap, ImageLayer layer, EPriority priority)
+	{
+		CHECK_ERR( writer );
+
+		auto	req = _CreateImageRequest( image, offset, size, rowPitch, slicePitch, mipmap, layer );
+		CHECK_ERR( req );
+
+		req->writer = std::move(writer);
+		return _AddRequest( std::move(req), priority );
+	}
+
+/*
+=================================================
+	_CreateImageRequest
+=================================================
+*/
+	UploadScheduler::RequestPtr  UploadScheduler::_CreateImageRequest (RawImageID image, const int3 &offset, const uint3 &size, BytesU rowPitch,
+																	   BytesU slicePitch, MipmapLevel mipmap, ImageLayer layer) const
+	{
+		CHECK_ERR( _frameGraph and image );
+		CHECK_ERR( Any( size > Zero ));
+
+		ImageDesc const&	desc		= _frameGraph->GetDescription( image );
+		const uint3			image_size	= Max( size, 1u );
+		const auto&			fmt_info	= EPixelFormat_GetInfo( desc.format );
+		const auto&			block_dim	= fmt_info.blockSize;
+		const uint			block_size	= fmt_info.bitsPerBlock;
+		const BytesU		row_pitch	= Max( rowPitch, BytesU(image_size.x * block_size + block_dim.x-1) / (block_dim.x * 8) );
+		const BytesU		min_slice	= (image_size.y * row_pitch + block_dim.y-1) / block_dim.y;
+		const BytesU		slice_pitch	= Max( slicePitch, min_slice );
+
+		CHECK_ERR( AllBits( desc.usage, EImageUsage::TransferDst ));
+		CHECK_ERR( row_pitch <= _maxUploadSize );	// at least one row must be uploaded in a single command buffer
+
+		auto	req = MakeShared<Request>();
+		req->image			= image;
+		req->imageOffset	= offset;
+		req->imageSize		= image_size;
+		req->mipmap			= mipmap;
+		req->layer			= layer;
+		req->rowPitch		= row_pitch;
+		req->slicePitch		= slice_pitch;
+		req->blockHeight	= block_dim.y;
+		req->size			= image_size.z > 1 ? slice_pitch * image_size.z : min_slice;
+		return req;
+	}
+
+/*
+=================================================
+	_AddRequest
+=================================================
+*/
+	UploadScheduler::Future  UploadScheduler::_AddRequest (RequestPtr &&req, EPriority priority)
+	{
+		CHECK_ERR( _frameGraph );
+		CHECK_ERR( priority < EPriority::_Count );
+
+		Future	result;
+		result._request = req;
+
+		_requests[ uint(priority) ].push_back( std::move(req) );
+		return result;
+	}
+
+/*
+=================================================
+	HasPendingRequests
+=================================================
+*/
+	bool  UploadScheduler::HasPendingRequests () const
+	{
+		for (auto& requests : _requests) {
+			if ( requests.size() )
+				return true;
+		}
+		return not _inFlight.empty();
+	}
+
+/*
+=================================================
+	Update
+=================================================
+*/
+	bool  UploadScheduler::Update ()
+	{
+		CommandBuffer	cmd;
+		return Update( OUT cmd );
+	}
+
+	bool  UploadScheduler::Update (OUT CommandBuffer &outCmd)
+	{
+		CHECK_ERR( _frameGraph );
+
+		outCmd = CommandBuffer{};
+		_CompleteInFlight();
+
+		bool	has_requests = false;
+		for (auto& requests : _requests) {
+			has_requests |= not requests.empty();
+		}
+
+		if ( not has_requests )
+			return true;
+
+		CommandBuffer	cmd = _frameGraph->Begin( CommandBufferDesc{ _queue }.SetDebugName( "UploadScheduler" ));
+		CHECK_ERR( cmd );
+
+		InFlight		frame;
+		BytesU			budget	= _FrameBudget();
+		Requests_t*		partial	= null;		// request that is partially recorded into this command buffer
+
+		// from high to low priority
+		for (uint p = uint(EPriority::_Count); p-- > 0 and budget > 0;)
+		{
+			auto&	requests = _requests[p];
+
+			for (; requests.size() and budget > 0;)
+			{
+				auto&	req = *requests.front();
+
+				if ( not _RecordRequest( cmd, req, INOUT budget ))
+				{
+					// staging memory may be used by other command buffers, try again in the next frame
+					if ( ++req.attempts < MaxAttempts )
+					{
+						partial	= &requests;
+						budget	= 0_b;
+						break;
+					}
+
+					req.state.store( Request::EState::Failed, memory_order_relaxed );
+					requests.pop_front();
+					continue;
+				}
+				req.attempts = 0;
+
+				// budget is exhausted
+				if ( BytesU{req.uploaded.load( memory_order_relaxed )} < req.size )
+				{
+					partial = &requests;
+					break;
+				}
+
+				req.state.store( Request::EState::Recorded, memory_order_relaxed );
+				frame.completed.push_back( std::move(requests.front()) );
+				requests.pop_front();
+			}
+		}
+
+		// submit immediately to start transfer as soon as possible
+		if ( not (_frameGraph->Execute( INOUT cmd ) and _frameGraph->Flush( EQueueUsage(1u << uint(_queue)) )) )
+		{
+			// recorded data may be lost, so requests can not be completed
+			for (auto& req : frame.completed) {
+				req->state.store( Request::EState::Failed, memory_order_relaxed );
+			}
+			if ( partial )
+			{
+				partial->front()->state.store( Request::EState::Failed, memory_order_relaxed );
+				partial->pop_front();
+			}
+			RETURN_ERR( "failed to submit upload commands" );
+		}
+
+		frame.cmd = cmd;
+		outCmd    = cmd;
+		_inFlight.push_back( std::move(frame) );
+		return true;
+	}
+
+/*
+=================================================
+	_CompleteInFlight
+----
+	command buffers are submitted to the same queue,
+	so they are completed in submission order
+=================================================
+*/
+	void  UploadScheduler::_CompleteInFlight ()
+	{
+		for (; _inFlight.size();)
+		{
+			auto&	frame = _inFlight.front();
+
+			if ( not _frameGraph->Wait( {frame.cmd}, Nanoseconds{0} ))
+				break;
+
+			for (auto& req : frame.completed) {
+				req->state.store( Request::EState::Complete, memory_order_release );
+			}
+			_inFlight.pop_front();
+		}
+	}
+
+/*
+=================================================
+	_RecordRequest
+=================================================
+*/
+	bool  UploadScheduler::_RecordRequest (const CommandBuffer &cmd, Request &req, INOUT BytesU &budget)
+	{
+		if ( req.buffer )
+			return _RecordBuffer( cmd, req, INOUT budget );
+
+		if ( req.image )
+			return _RecordImage( cmd, req, INOUT budget );
+
+		RETURN_ERR( "unknown request type" );
+	}
+
+/*
+=================================================
+	_RecordBuffer
+=================================================
+*/
+	bool  UploadScheduler::_RecordBuffer (const CommandBuffer &cmd, Request &req, INOUT BytesU &budget)
+	{
+		const BytesU	offset	= BytesU{ req.uploaded.load( memory_order_relaxed )};
+		const BytesU	size	= Min( req.size - offset, budget );
+		UpdateBuffer	task;
+
+		task.SetBuffer( req.buffer ).SetName( "UploadScheduler::Buffer" );
+
+		if ( req.writer )
+			task.AddDataWriter( [&req, offset] (void* dst, BytesU off, BytesU sz) { req.writer( dst, offset + off, sz ); },
+								size, req.bufferOffset + offset );
+		else
+			task.AddData( req.data.section( size_t(offset), size_t(size) ), req.bufferOffset + offset );
+
+		CHECK_ERR( cmd->AddTask( task ));
+
+		req.uploaded.store( uint64_t(offset + size), memory_order_relaxed );
+		budget -= size;
+		return true;
+	}
+
+/*
+=================================================
+	_RecordImage
+----
+	image is uploaded by rows, at least one row is
+	uploaded per frame even if it exceeds budget
+=================================================
+*/
+	bool  UploadScheduler::_RecordImage (const CommandBuffer &cmd, Request &req, INOUT BytesU &budget)
+	{
+		const bool	is_first	= (budget == _FrameBudget());
+		const uint	block_h		= req.blockHeight;
+
+		for (; req.slice < req.imageSize.z and budget > 0;)
+		{
+			const uint	rows_left	= req.imageSize.y - req.row;
+			uint		block_rows	= Min( (rows_left + block_h-1) / block_h, uint(budget / req.rowPitch) );
+
+			if ( block_rows == 0 )
+			{
+				if ( not is_first )
+					break;
+
+				block_rows = 1;
+			}
+
+			const uint		height		= Min( block_rows * block_h, rows_left );
+			const BytesU	data_off	= req.slice * req.slicePitch + (req.row / block_h) * req.rowPitch;
+			const BytesU	data_size	= block_rows * req.rowPitch;
+			UpdateImage		task;
+
+			task.SetName( "UploadScheduler::Image" );
+			task.dstImage		= req.image;
+			task.imageOffset	= req.imageOffset + int3{ 0, int(req.row), int(req.slice) };
+			task.arrayLayer		= req.layer;
+			task.mipmapLevel	= req.mipmap;
+
+			if ( req.writer )
+				task.SetDataWriter( [&req, data_off] (void* dst, BytesU off, BytesU sz) { req.writer( dst, data_off + off, sz ); },
+									uint3{ req.imageSize.x, height, 1u }, req.rowPitch );
+			else
+				task.SetData( req.data.section( size_t(data_off), size_t(data_size) ), uint3{ req.imageSize.x, height, 1u }, req.rowPitch );
+
+			CHECK_ERR( cmd->AddTask( task ));
+
+			req.uploaded.fetch_add( uint64_t(data_size), memory_order_relaxed );
+			budget -= Min( budget, data_size );
+
+			req.row += height;
+			if ( req.row >= req.imageSize.y )
+			{
+				req.row = 0;
+				++req.slice;
+			}
+		}
+
+		// last slice may be smaller than slice pitch
+		if ( req.slice >= req.imageSize.z )
+			req.uploaded.store( uint64_t(req.size), memory_order_relaxed );
+
+		return true;
+	}
+
+
+}	// FG
@@ -135,6 +135,7 @@ namespace FG
 		_readAccessMask		= GetAllBufferReadAccessMasks( info.usage );
 		_queueFamilyMask	= queueFamilyMask;
 		_debugName			= dbgName;
+		_canKeepState		= not uint(memObj.MemoryType() & EMemoryTypeExt::HostVisible);
 
 		return true;
 	}
@@ -213,6 +214,11 @@ namespace FG
 		_desc				= Default;
 		_queueFamilyMask	= Default;
 		_onRelease			= {};
+		_canKeepState		= false;
+		_lastState			= {};
+		_lastStateOwner		= null;
+		_lastStateBatch.store( null, memory_order_relaxed );
+		_hasLastState.store( false, memory_order_relaxed );
 		
 		_debugName.clear();
 	}
@@ -279,6 +285,111 @@ namespace FG
 		return not AnyBits( _desc.usage, EBufferUsage::TransferDst | EBufferUsage::StorageTexel | EBufferUsage::Storage | EBufferUsage::RayTracing );
 	}
 	
+/*
+=================================================
+	GetLastState
+=================================================
+*/
+	VBuffer::LastState  VBuffer::GetLastState () const
+	{
+		EXLOCK( _lastStateGuard );
+		return _lastState;
+	}
+	
+/*
+=================================================
+	AcquireLastState
+----
+	local buffer becomes owner of the state until 'ReleaseLastState()' is called,
+	other command buffers wait until state is released, so stale state is never loaded.
+	Owner releases the state at the end of its '_BuildCommandBuffers()' and never waits
+	for other command buffers while it owns the state, so the wait is bounded by
+	the recording time of one command buffer.
+	All command buffers must acquire resources in the same order to avoid deadlock.
+	Batch that stored the state is added as dependency, so batches are submitted
+	in the same order as state is stored, if dependency can not be added then
+	state is not acquired and command buffer must fail.
+=================================================
+*/
+	bool  VBuffer::AcquireLastState (void const* owner, Ptr<VCmdBatch> batch, OUT LastState &result) const
+	{
+		ASSERT( owner );
+
+		std::unique_lock	lock{ _lastStateGuard };
+		_lastStateCV.wait( lock, [this, owner] () { ASSERT( _lastStateOwner != owner );  Unused( owner );  return _lastStateOwner == null; });
+
+		// batch can not be recycled while it is referenced by '_lastStateBatch', see 'ResetLastStateBatch()'
+		if ( auto*  prev = _lastStateBatch.load( memory_order_relaxed ); prev and batch )
+		{
+			CHECK_ERR( batch->AddDependency( prev ));
+		}
+
+		_lastStateOwner	= owner;
+		result			= _lastState;
+		return true;
+	}
+	
+/*
+=================================================
+	ReleaseLastState
+----
+	keep the state that was loaded
+=================================================
+*/
+	void  VBuffer::ReleaseLastState (void const* owner) const
+	{
+		{
+			EXLOCK( _lastStateGuard );
+			ASSERT( _lastStateOwner == owner );
+			Unused( owner );
+
+			_lastStateOwner = null;
+		}
+		_lastStateCV.notify_all();
+	}
+	
+/*
+=================================================
+	ReleaseLastState
+----
+	store the new state, it is valid for the next command buffer
+	that is submitted after 'batch'
+=================================================
+*/
+	void  VBuffer::ReleaseLastState (void const* owner, Ptr<VCmdBatch> batch, const LastState &value) const
+	{
+		{
+			EXLOCK( _lastStateGuard );
+			ASSERT( _lastStateOwner == owner );
+			ASSERT( _canKeepState or value.queue == null );
+			Unused( owner );
+
+			_lastState		= value;
+			_lastStateOwner	= null;
+			_lastStateBatch.store( value.queue ? batch.get() : null, memory_order_relaxed );
+			_hasLastState.store( value.queue != null, memory_order_relaxed );
+		}
+		_lastStateCV.notify_all();
+	}
+	
+/*
+=================================================
+	ResetLastStateBatch
+----
+	called when batch is complete, the next command buffer doesn't need to depend on it
+=================================================
+*/
+	void  VBuffer::ResetLastStateBatch (const VCmdBatch *batch) const
+	{
+		if ( _lastStateBatch.load( memory_order_relaxed ) != batch )
+			return;
+
+		EXLOCK( _lastStateGuard );
+
+		if ( _lastStateBatch.load( memory_order_relaxed ) == batch )
+			_lastStateBatch.store( null, memory_order_relaxed );
+	}
+	
 /*
 =================================================
 	GetApiSpecificDescription
@@ -6,6 +6,7 @@
 #include "framegraph/Public/MemoryDesc.h"
 #include "framegraph/Public/FrameGraph.h"
 #include "VCommon.h"
+#include <condition_variable>
 
 namespace FG
 {
@@ -19,6 +20,15 @@ namespace FG
 		friend class VBufferUnitTest;
 
 	// types
+	public:
+		// last known state of the whole buffer, see 'CommandBufferDesc::persistentState'
+		struct LastState
+		{
+			VDeviceQueueInfoPtr		queue;				// null if all writes are visible
+			VkPipelineStageFlagBits	stages		= Zero;
+			VkAccessFlagBits		access		= Zero;
+		};
+
 	private:
 		using OnRelease_t		= IFrameGraph::OnExternalBufferReleased_t;
 		using BufferViewMap_t	= HashMap< BufferViewDesc, VkBufferView >;
@@ -39,6 +49,14 @@ namespace FG
 		DebugName_t					_debugName;
 		OnRelease_t					_onRelease;
 
+		mutable Mutex				_lastStateGuard;
+		mutable std::condition_variable	_lastStateCV;	// notified when '_lastStateOwner' is reset
+		mutable LastState			_lastState;
+		mutable void const*			_lastStateOwner		= null;		// local buffer that loaded state and has not stored it yet
+		mutable Atomic<VCmdBatch *>	_lastStateBatch		{null};	// batch that stored state, reset when batch is complete
+		mutable Atomic<bool>		_hasLastState		{false};
+		bool						_canKeepState		= false;	// false for external and host visible buffers
+
 		RWDataRaceCheck				_drCheck;
 
 
@@ -64,6 +82,13 @@ namespace FG
 
 		ND_ bool				IsReadOnly ()			const;
 
+		ND_ LastState			GetLastState ()			const;
+		ND_ bool				AcquireLastState (void const* owner, Ptr<VCmdBatch> batch, OUT LastState &) const;
+			void				ReleaseLastState (void const* owner) const;
+			void				ReleaseLastState (void const* owner, Ptr<VCmdBatch> batch, const LastState &) const;
+			void				ResetLastStateBatch (const VCmdBatch *batch) const;
+		ND_ bool				HasLastState ()			const	{ return _hasLastState.load( memory_order_relaxed ); }
+
 		ND_ VkBuffer			Handle ()				const	{ SHAREDLOCK( _drCheck );  return _buffer; }
 		ND_ RawMemoryID			GetMemoryID ()			const	{ SHAREDLOCK( _drCheck );  return _memoryId.Get(); }
 
@@ -75,6 +100,7 @@ namespace FG
 		ND_ bool				IsExclusiveSharing ()	const	{ SHAREDLOCK( _drCheck );  return _queueFamilyMask == Default; }
 		ND_ EQueueFamilyMask	GetQueueFamilyMask ()	const	{ SHAREDLOCK( _drCheck );  return _queueFamilyMask; }
 		ND_ StringView			GetDebugName ()			const	{ SHAREDLOCK( _drCheck );  return _debugName; }
+		ND_ bool				CanKeepState ()			const	{ SHAREDLOCK( _drCheck );  return _canKeepState; }
 
 		ND_ static bool  IsSupported (const VDevice &dev, const BufferDesc &desc, EMemoryType memType);
 		ND_ bool		 IsSupported (const VDevice &dev, const BufferViewDesc &desc) const;
@@ -24,7 +24,7 @@ namespace FG
 	Create
 =================================================
 */
-	bool VLocalBuffer::Create (const VBuffer *bufferData)
+	bool VLocalBuffer::Create (const VBuffer *bufferData, LinearAllocator<> &allocator)
 	{
 		CHECK_ERR( _bufferData == null );
 		CHECK_ERR( bufferData );
@@ -32,6 +32,10 @@ namespace FG
 		_bufferData		= bufferData;
 		_isImmutable	= _bufferData->IsReadOnly();
 
+		_pendingAccesses.SetAllocator( allocator );
+		_accessForWrite.SetAllocator( allocator );
+		_accessForRead.SetAllocator( allocator );
+
 		return true;
 	}
 	
@@ -42,6 +46,8 @@ namespace FG
 */
 	void VLocalBuffer::Destroy ()
 	{
+		ASSERT( not _ownsLastState );
+
 		_bufferData	= null;
 
 		// check for uncommited barriers
@@ -49,9 +55,10 @@ namespace FG
 		ASSERT( _accessForWrite.empty() );
 		ASSERT( _accessForRead.empty() );
 
-		_pendingAccesses.clear();
-		_accessForWrite.clear();
-		_accessForRead.clear();
+		// memory will be discarded by command buffer allocator
+		_pendingAccesses.Release();
+		_accessForWrite.Release();
+		_accessForRead.Release();
 	}
 
 /*
@@ -226,8 +233,7 @@ namespace FG
 	{
 		// buffer must be in initial state
 		ASSERT( _pendingAccesses.empty() );
-		ASSERT( _accessForWrite.empty() );
-		ASSERT( _accessForRead.empty() );
+		ASSERT( _accessForWrite.empty() and _accessForRead.empty() );
 
 		_isImmutable = immutable;
 	}
@@ -297,6 +303,11 @@ namespace FG
 	{
 		ASSERT( _pendingAccesses.empty() and "you must commit all pending states before reseting" );
 		
+		if ( _ownsLastState )
+			_bufferData->ReleaseLastState( this, null, {} );
+
+		_ownsLastState = false;
+
 		if ( _isImmutable )
 			return;
 
@@ -320,6 +331,122 @@ namespace FG
 		_accessForRead.clear();
 	}
 
+/*
+=================================================
+	LoadLastState
+----
+	continue from the state that was stored by previous command buffer,
+	on other queue batch dependency (semaphore) is used instead of barrier.
+	Called when command buffer is executed, state is owned by this buffer
+	until 'StoreLastState()' or 'ResetState()' is called.
+	Returns 'false' if state is not acquired.
+=================================================
+*/
+	bool VLocalBuffer::LoadLastState (VDeviceQueueInfoPtr queue, Ptr<VCmdBatch> batch) const
+	{
+		ASSERT( _accessForWrite.empty() and _accessForRead.empty() );
+		ASSERT( not _ownsLastState );
+
+		// read-only buffer never requires barrier
+		if ( _bufferData->IsReadOnly() or not _bufferData->CanKeepState() )
+			return true;
+
+		VBuffer::LastState	last;
+		CHECK_ERR( _bufferData->AcquireLastState( this, batch, OUT last ));
+
+		_ownsLastState = true;
+
+		if ( last.queue == null )
+			return true;
+
+		// buffer that was kept in last state may require barrier
+		_isImmutable = false;
+
+		if ( last.queue != queue )
+			return true;
+
+		BufferAccess	initial;
+		initial.range		= BufferRange{ 0, VkDeviceSize(Size()) };
+		initial.stages		= last.stages;
+		initial.access		= last.access;
+		initial.index		= ExeOrderIndex::Initial;
+		initial.isReadable	= (last.access == 0);
+		initial.isWritable	= (last.access != 0);
+
+		if ( initial.isWritable )
+			_accessForWrite.push_back( initial );
+		else
+			_accessForRead.push_back( initial );
+
+		return true;
+	}
+
+/*
+=================================================
+	DiscardLastState
+----
+	release state without changes, used when command buffer failed to load states
+=================================================
+*/
+	void VLocalBuffer::DiscardLastState () const
+	{
+		if ( not _ownsLastState )
+			return;
+
+		_bufferData->ReleaseLastState( this );
+		_ownsLastState = false;
+	}
+
+/*
+=================================================
+	StoreLastState
+----
+	keep stages of the last accesses for the next command buffer instead of full pipeline barrier.
+	Returns 'false' if state is reset and full barrier is required.
+=================================================
+*/
+	bool VLocalBuffer::StoreLastState (VDeviceQueueInfoPtr queue, Ptr<VCmdBatch> batch, VBarrierManager &barrierMngr, Ptr<VLocalDebugger> debugger) const
+	{
+		ASSERT( _pendingAccesses.empty() and "you must commit all pending states before reseting" );
+		ASSERT( queue );
+
+		if ( not _ownsLastState )
+		{
+			ResetState( ExeOrderIndex::Final, barrierMngr, debugger );
+			return _isImmutable;
+		}
+		
+		if ( _isImmutable )
+		{
+			_bufferData->ReleaseLastState( this );
+			_ownsLastState = false;
+			return true;
+		}
+
+		// ranges are merged, so the next access will wait for all accesses in this command buffer
+		VBuffer::LastState	last;
+		last.queue = queue;
+
+		for (auto& rec : _accessForWrite) {
+			last.stages |= rec.stages;
+			last.access |= rec.access;
+		}
+		for (auto& rec : _accessForRead) {
+			last.stages |= rec.stages;
+		}
+
+		// buffer was not accessed on this queue
+		if ( last.stages == 0 )
+			last.queue = null;
+
+		_bufferData->ReleaseLastState( this, batch, last );
+		_ownsLastState = false;
+
+		_accessForWrite.clear();
+		_accessForRead.clear();
+		return true;
+	}
+
 /*
 =================================================
 	CommitBarrier
@@ -345,7 +472,7 @@ namespace FG
 				barrier.srcQueueFamilyIndex	= VK_QUEUE_FAMILY_IGNORED;
 				barrier.dstQueueFamilyIndex	= VK_QUEUE_FAMILY_IGNORED;
 
-				barrierMngr.AddBufferBarrier( src.stages, dst.stages, barrier );
+				barrierMngr.AddBufferBarrier( src.index, dst.index, src.stages, dst.stages, barrier );
 
 				if ( debugger ) {
 					debugger->AddBufferBarrier( _bufferData.get(), src.index, dst.index, src.stages, dst.stages, 0, barrier );
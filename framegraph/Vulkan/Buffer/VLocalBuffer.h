@@ -4,6 +4,7 @@
 
 #include "framegraph/Public/EResourceState.h"
 #include "framegraph/Shared/ResourceDataRange.h"
+#include "stl/Containers/LinearArray.h"
 #include "VBuffer.h"
 
 namespace FG
@@ -50,7 +51,7 @@ namespace FG
 			BufferAccess () : isReadable{false}, isWritable{false} {}
 		};
 
-		using AccessRecords_t	= Array< BufferAccess >;	// TODO: fixed size array or custom allocator
+		using AccessRecords_t	= LinearArray< BufferAccess >;	// memory is allocated from command buffer allocator
 		using AccessIter_t		= AccessRecords_t::iterator;
 
 
@@ -62,6 +63,7 @@ namespace FG
 		mutable AccessRecords_t		_accessForWrite;
 		mutable AccessRecords_t		_accessForRead;
 		mutable bool				_isImmutable	= false;
+		mutable bool				_ownsLastState	= false;	// state is acquired from global buffer and must be released
 
 
 	// methods
@@ -71,12 +73,15 @@ namespace FG
 		VLocalBuffer (const VLocalBuffer &) = delete;
 		~VLocalBuffer ();
 
-		bool Create (const VBuffer *);
+		bool Create (const VBuffer *, LinearAllocator<> &);
 		void Destroy ();
 		
 		void SetInitialState (bool immutable) const;
 		void AddPendingState (const BufferState &state) const;
 		void ResetState (ExeOrderIndex index, VBarrierManager &barrierMngr, Ptr<VLocalDebugger> debugger) const;
+		bool LoadLastState (VDeviceQueueInfoPtr queue, Ptr<VCmdBatch> batch) const;
+		void DiscardLastState () const;
+		bool StoreLastState (VDeviceQueueInfoPtr queue, Ptr<VCmdBatch> batch, VBarrierManager &barrierMngr, Ptr<VLocalDebugger> debugger) const;
 		void CommitBarrier (VBarrierManager &barrierMngr, Ptr<VLocalDebugger> debugger) const;
 
 		ND_ bool				IsCreated ()	const	{ return _bufferData != null; }
@@ -19,6 +19,15 @@ namespace FG
 		using ImageMemoryBarriers_t		= Array< VkImageMemoryBarrier >;
 		using BufferMemoryBarriers_t	= Array< VkBufferMemoryBarrier >;
 
+		struct SplitEvent
+		{
+			VkEvent					event		= VK_NULL_HANDLE;
+			VkPipelineStageFlags	stages		= 0;
+			uint					commitIdx	= 0;	// index of the commit that waits for this event
+		};
+		using SplitEvents_t				= Array< SplitEvent >;		// index is task execution order
+		using WaitEvents_t				= Array< VkEvent >;
+
 
 	// variables
 	private:
@@ -30,6 +39,16 @@ namespace FG
 		VkPipelineStageFlags		_dstStageMask		= 0;
 		VkDependencyFlags			_dependencyFlags	= 0;
 
+		// split barriers
+		SplitEvents_t				_events;			// events that was set after producer tasks
+		WaitEvents_t				_waitEvents;
+		ImageMemoryBarriers_t		_splitImageBarriers;
+		BufferMemoryBarriers_t		_splitBufferBarriers;
+		VkPipelineStageFlags		_splitSrcStageMask	= 0;
+		VkPipelineStageFlags		_splitDstStageMask	= 0;
+		uint						_splitCommitIdx		= 1;
+		uint						_splitBarrierCount	= 0;
+
 
 	// methods
 	public:
@@ -43,8 +62,11 @@ namespace FG
 		}
 
 
-		void Commit (const VDevice &dev, VkCommandBuffer cmd)
+		// returns 'true' if pipeline barrier was recorded
+		bool Commit (const VDevice &dev, VkCommandBuffer cmd)
 		{
+			_CommitSplitBarriers( dev, cmd );
+
 			const uint	mem_count = !!(_memoryBarrier.srcAccessMask | _memoryBarrier.dstAccessMask);
 
 			if ( mem_count or _bufferBarriers.size() or _imageBarriers.size() )
@@ -54,12 +76,16 @@ namespace FG
 										  uint(_bufferBarriers.size()), _bufferBarriers.data(),
 										  uint(_imageBarriers.size()), _imageBarriers.data() );
 				ClearBarriers();
+				return true;
 			}
+			return false;
 		}
 		
 
-		void ForceCommit (const VDevice &dev, VkCommandBuffer cmd, VkPipelineStageFlags srcStage, VkPipelineStageFlags dstStage)
+		bool ForceCommit (const VDevice &dev, VkCommandBuffer cmd, VkPipelineStageFlags srcStage, VkPipelineStageFlags dstStage)
 		{
+			_CommitSplitBarriers( dev, cmd );
+
 			const uint	mem_count = !!(_memoryBarrier.srcAccessMask | _memoryBarrier.dstAccessMask);
 
 			_srcStageMask |= srcStage;
@@ -72,7 +98,9 @@ namespace FG
 										  uint(_bufferBarriers.size()), _bufferBarriers.data(),
 										  uint(_imageBarriers.size()), _imageBarriers.data() );
 				ClearBarriers();
+				return true;
 			}
+			return false;
 		}
 
 
@@ -112,6 +140,61 @@ namespace FG
 		}
 
 
+		// split barriers //
+
+		void AddBufferBarrier (ExeOrderIndex				srcIndex,
+							   ExeOrderIndex				dstIndex,
+							   VkPipelineStageFlags			srcStageMask,
+							   VkPipelineStageFlags			dstStageMask,
+							   const VkBufferMemoryBarrier	&barrier)
+		{
+			if ( _AddWaitEvent( srcIndex, dstIndex, srcStageMask, dstStageMask ))
+				_splitBufferBarriers.push_back( barrier );
+			else
+				AddBufferBarrier( srcStageMask, dstStageMask, barrier );
+		}
+
+
+		void AddImageBarrier (ExeOrderIndex				srcIndex,
+							  ExeOrderIndex				dstIndex,
+							  VkPipelineStageFlags		srcStageMask,
+							  VkPipelineStageFlags		dstStageMask,
+							  VkDependencyFlags			dependencyFlags,
+							  const VkImageMemoryBarrier	&barrier)
+		{
+			// 'vkCmdWaitEvents' has no dependency flags
+			if ( dependencyFlags == 0 and _AddWaitEvent( srcIndex, dstIndex, srcStageMask, dstStageMask ))
+				_splitImageBarriers.push_back( barrier );
+			else
+				AddImageBarrier( srcStageMask, dstStageMask, dependencyFlags, barrier );
+		}
+
+
+		// event must be set by 'vkCmdSetEvent' after all commands of the task
+		void SetEvent (ExeOrderIndex index, VkEvent event, VkPipelineStageFlags stages)
+		{
+			const size_t	idx = size_t(index);
+
+			if ( idx >= _events.size() )
+				_events.resize( idx+1 );
+
+			ASSERT( _events[idx].event == VK_NULL_HANDLE );
+			_events[idx] = SplitEvent{ event, stages };
+		}
+
+
+		// must be called before recording new command buffer
+		void ClearEvents ()
+		{
+			ASSERT( _waitEvents.empty() );
+			_events.clear();
+			_splitBarrierCount = 0;
+		}
+
+
+		ND_ uint  SplitBarrierCount () const	{ return _splitBarrierCount; }
+
+
 		void AddMemoryBarrier (VkPipelineStageFlags		srcStageMask,
 							   VkPipelineStageFlags		dstStageMask,
 							   const VkMemoryBarrier	&barrier)
@@ -122,6 +205,54 @@ namespace FG
 			_memoryBarrier.srcAccessMask |= barrier.srcAccessMask;
 			_memoryBarrier.dstAccessMask |= barrier.dstAccessMask;
 		}
+
+
+	private:
+		// use event if producer task has been recorded a long time ago
+		ND_ bool _AddWaitEvent (ExeOrderIndex srcIndex, ExeOrderIndex dstIndex, VkPipelineStageFlags srcStageMask, VkPipelineStageFlags dstStageMask)
+		{
+			const size_t	src_idx = size_t(srcIndex);
+
+			if ( src_idx >= _events.size() or size_t(dstIndex) < src_idx + FG_MinSplitBarrierDistance )
+				return false;
+
+			auto&	ev = _events[src_idx];
+
+			// all source stages must be in the first synchronization scope of the event
+			if ( ev.event == VK_NULL_HANDLE or (srcStageMask & ~ev.stages) )
+				return false;
+
+			if ( ev.commitIdx != _splitCommitIdx )
+			{
+				ev.commitIdx = _splitCommitIdx;
+				_waitEvents.push_back( ev.event );
+				_splitSrcStageMask |= ev.stages;
+			}
+			_splitDstStageMask |= dstStageMask;
+			return true;
+		}
+
+
+		void _CommitSplitBarriers (const VDevice &dev, VkCommandBuffer cmd)
+		{
+			if ( _waitEvents.empty() )
+				return;
+
+			dev.vkCmdWaitEvents( cmd, uint(_waitEvents.size()), _waitEvents.data(), _splitSrcStageMask, _splitDstStageMask,
+								 0, null,
+								 uint(_splitBufferBarriers.size()), _splitBufferBarriers.data(),
+								 uint(_splitImageBarriers.size()), _splitImageBarriers.data() );
+
+			_splitBarrierCount += uint(_splitBufferBarriers.size() + _splitImageBarriers.size());
+
+			// event may be used again by the next consumers
+			++_splitCommitIdx;
+
+			_waitEvents.clear();
+			_splitBufferBarriers.clear();
+			_splitImageBarriers.clear();
+			_splitSrcStageMask = _splitDstStageMask = 0;
+		}
 	};
 
 }	// FG
@@ -34,6 +34,15 @@ namespace FG
 	{
 		EXLOCK( _drCheck );
 		CHECK( _counter.load( memory_order_relaxed ) == 0 );
+
+		VDevice const&	dev = _frameGraph.GetDevice();
+
+		for (auto& ev : _events.pool) {
+			dev.vkDestroyEvent( dev.GetVkDevice(), ev, null );
+		}
+		_events.pool.clear();
+
+		_transientHeap.Destroy( _frameGraph.GetResourceManager() );
 	}
 	
 /*
@@ -48,10 +57,12 @@ namespace FG
 
 		ASSERT( _dependencies.empty() );
 		ASSERT( _batch.commands.empty() );
+		ASSERT( _batch.secondaryCommands.empty() );
 		ASSERT( _batch.signalSemaphores.empty() );
 		ASSERT( _batch.waitSemaphores.empty() );
 		ASSERT( _staging.hostToDevice.empty() );
 		ASSERT( _staging.deviceToHost.empty() );
+		ASSERT( _staging.ringChunks.empty() );
 		ASSERT( _staging.onBufferLoadedEvents.empty() );
 		ASSERT( _staging.onImageLoadedEvents.empty() );
 		ASSERT( _resourcesToRelease.empty() );
@@ -68,6 +79,8 @@ namespace FG
 			_supportsQuery = AnyBits( queue->familyFlags, VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT );
 		}
 
+		_staging.ring = _frameGraph.GetResourceManager().GetStagingRing( type );
+
 		_state.store( EState::Initial, memory_order_relaxed );
 		
 		for (auto& dep : dependsOn)
@@ -98,13 +111,13 @@ namespace FG
 	SignalSemaphore
 =================================================
 */
-	void  VCmdBatch::SignalSemaphore (VkSemaphore sem)
+	void  VCmdBatch::SignalSemaphore (VkSemaphore sem, uint64_t timelineValue)
 	{
 		EXLOCK( _drCheck );
 		ASSERT( GetState() < EState::Submitted );
 		CHECK_ERRV( _batch.signalSemaphores.size() < _batch.signalSemaphores.capacity() );
 
-		_batch.signalSemaphores.push_back( sem );
+		_batch.signalSemaphores.push_back( sem, timelineValue );
 	}
 	
 /*
@@ -112,13 +125,13 @@ namespace FG
 	WaitSemaphore
 =================================================
 */
-	void  VCmdBatch::WaitSemaphore (VkSemaphore sem, VkPipelineStageFlags stage)
+	void  VCmdBatch::WaitSemaphore (VkSemaphore sem, VkPipelineStageFlags stage, uint64_t timelineValue)
 	{
 		EXLOCK( _drCheck );
 		ASSERT( GetState() < EState::Submitted );
 		CHECK_ERRV( _batch.waitSemaphores.size() < _batch.waitSemaphores.capacity() );
 
-		_batch.waitSemaphores.push_back( sem, stage );
+		_batch.waitSemaphores.push_back( sem, stage, timelineValue );
 	}
 	
 /*
@@ -144,25 +157,43 @@ namespace FG
 		_batch.commands.push_back( cmd, pool );
 	}
 	
+/*
+=================================================
+	AddSecondaryCommandBuffer
+=================================================
+*/
+	void  VCmdBatch::AddSecondaryCommandBuffer (VkCommandBuffer cmd, const VCommandPool *pool)
+	{
+		EXLOCK( _drCheck );
+		ASSERT( GetState() < EState::Submitted );
+
+		_batch.secondaryCommands.emplace_back( cmd, pool );
+	}
+	
 /*
 =================================================
 	AddDependency
+----
+	returns 'false' if there is no space for the new dependency,
+	the batch must not be submitted in this case.
 =================================================
 */
-	void  VCmdBatch::AddDependency (VCmdBatch *batch)
+	bool  VCmdBatch::AddDependency (VCmdBatch *batch)
 	{
 		EXLOCK( _drCheck );
 		ASSERT( GetState() == EState::Recording );
-		CHECK_ERRV( _dependencies.size() < _dependencies.capacity() );
 
 		// skip duplicates
 		for (auto& dep : _dependencies)
 		{
 			if ( dep == batch )
-				return;
+				return true;
 		}
+		
+		CHECK_ERR( _dependencies.size() < _dependencies.capacity() );
 
 		_dependencies.push_back( batch );
+		return true;
 	}
 	
 /*
@@ -177,6 +208,34 @@ namespace FG
 
 		_readyToDelete.push_back({ type, handle });
 	}
+	
+/*
+=================================================
+	AcquireEvent
+----
+	returns unsignaled event, it will be reset and reused when batch is complete
+=================================================
+*/
+	VkEvent  VCmdBatch::AcquireEvent ()
+	{
+		EXLOCK( _drCheck );
+		ASSERT( GetState() == EState::Recording );
+
+		if ( _events.used < _events.pool.size() )
+			return _events.pool[ _events.used++ ];
+
+		VDevice const&		dev		= _frameGraph.GetDevice();
+		VkEventCreateInfo	info	= {};
+		VkEvent				ev		= VK_NULL_HANDLE;
+
+		info.sType	= VK_STRUCTURE_TYPE_EVENT_CREATE_INFO;
+
+		CHECK_ERR( dev.vkCreateEvent( dev.GetVkDevice(), &info, null, OUT &ev ) == VK_SUCCESS );
+
+		_events.pool.push_back( ev );
+		_events.used = uint(_events.pool.size());
+		return ev;
+	}
 
 /*
 =================================================
@@ -293,12 +352,27 @@ namespace FG
 		submitInfo.pNext				= null;
 		submitInfo.pCommandBuffers		= _batch.commands.get<0>().data();
 		submitInfo.commandBufferCount	= uint(_batch.commands.size());
-		submitInfo.pSignalSemaphores	= _batch.signalSemaphores.data();
+		submitInfo.pSignalSemaphores	= _batch.signalSemaphores.get<0>().data();
 		submitInfo.signalSemaphoreCount	= uint(_batch.signalSemaphores.size());
 		submitInfo.pWaitSemaphores		= _batch.waitSemaphores.get<0>().data();
 		submitInfo.pWaitDstStageMask	= _batch.waitSemaphores.get<1>().data();
 		submitInfo.waitSemaphoreCount	= uint(_batch.waitSemaphores.size());
 
+		#ifdef VK_KHR_timeline_semaphore
+		if ( _frameGraph.GetDevice().GetFeatures().timelineSemaphore )
+		{
+			auto&	info = _batch.timelineInfo;
+			info.sType						= VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO_KHR;
+			info.pNext						= null;
+			info.waitSemaphoreValueCount	= submitInfo.waitSemaphoreCount;
+			info.pWaitSemaphoreValues		= _batch.waitSemaphores.get<2>().data();
+			info.signalSemaphoreValueCount	= submitInfo.signalSemaphoreCount;
+			info.pSignalSemaphoreValues		= _batch.signalSemaphores.get<1>().data();
+
+			submitInfo.pNext = &info;
+		}
+		#endif
+
 
 		// flush mapped memory before submitting
 		FixedArray<VkMappedMemoryRange, 32>		regions;
@@ -323,6 +397,29 @@ namespace FG
 			reg.size	= VkDeviceSize(buf.size);
 		}
 		
+		if ( _staging.ring and not _staging.ring->IsCoherent() )
+		{
+			// ring may be sub-allocated from a memory block, so range is aligned in the memory, not in the buffer,
+			// memory block size is a multiple of 'nonCoherentAtomSize' so aligned range doesn't exceed it
+			const VkDeviceSize	atom_size = Max( dev.GetDeviceLimits().nonCoherentAtomSize, VkDeviceSize(1) );
+
+			for (auto& rc : _staging.ringChunks)
+			{
+				if ( regions.size() == regions.capacity() )
+				{
+					VK_CALL( dev.vkFlushMappedMemoryRanges( dev.GetVkDevice(), uint(regions.size()), regions.data() ));
+					regions.clear();
+				}
+
+				auto&	reg = regions.emplace_back();
+				reg.sType	= VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
+				reg.pNext	= null;
+				reg.memory	= _staging.ring->GetMemory();
+				reg.offset	= AlignToSmaller( VkDeviceSize(_staging.ring->GetMemOffset() + rc.chunk.offset), atom_size );
+				reg.size	= AlignToLarger( VkDeviceSize(_staging.ring->GetMemOffset() + rc.chunk.offset + rc.chunk.size), atom_size ) - reg.offset;
+			}
+		}
+
 		if ( regions.size() )
 			VK_CALL( dev.vkFlushMappedMemoryRanges( dev.GetVkDevice(), uint(regions.size()), regions.data() ));
 
@@ -360,13 +457,13 @@ namespace FG
 		EXLOCK( _drCheck );
 		ASSERT( _submitted );
 
-		_SetState( EState::Complete );
-
 		_FinalizeCommands();
 		_ParseDebugOutput( shaderDbgCallback );
 		_FinalizeStagingBuffers( _frameGraph.GetDevice() );
 		_ReleaseResources();
 		_ReleaseVkObjects();
+		_ResetEvents();
+		_transientHeap.Reset( _frameGraph.GetResourceManager() );
 
 		debugger.AddBatchDump( _debugName, std::move(_debugDump) );
 		debugger.AddBatchGraph( std::move(_debugGraph) );
@@ -390,6 +487,11 @@ namespace FG
 		outStatistic.Merge( _statistic );
 
 		_submitted = null;
+
+		// state is used to wait for completion on other threads (see 'SetCompletionThreadEnabled'),
+		// so all changes must be visible before the state is changed
+		std::atomic_thread_fence( memory_order_release );
+		_SetState( EState::Complete );
 		return true;
 	}
 	
@@ -406,7 +508,12 @@ namespace FG
 				pool->RecyclePrimary( _batch.commands.get<0>()[i] );
 		}
 
+		for (auto& cmd : _batch.secondaryCommands) {
+			cmd.second->RecycleSecondary( cmd.first );
+		}
+
 		_batch.commands.clear();
+		_batch.secondaryCommands.clear();
 		_batch.signalSemaphores.clear();
 		_batch.waitSemaphores.clear();
 	}
@@ -477,6 +584,12 @@ namespace FG
 			FixedArray< ArrayView<T>, MaxImageParts >	data_parts;
 			BytesU										total_size;
 
+			if ( ev.buffer )
+			{
+				_FinalizeImageBuffer( dev, ev );
+				continue;
+			}
+
 			for (auto& part : ev.parts)
 			{
 				ArrayView<T>	view{ Cast<T>(part.buffer->mappedPtr + part.offset), size_t(part.size) };
@@ -505,9 +618,58 @@ namespace FG
 				rm.ReleaseStagingBuffer( sb.index );
 			}
 			_staging.deviceToHost.clear();
+
+			// memory will be reused by the next batches
+			for (auto& rc : _staging.ringChunks) {
+				_staging.ring->Release( rc.chunk );
+			}
+			_staging.ringChunks.clear();
 		}
 	}
 
+/*
+=================================================
+	_FinalizeImageBuffer
+----
+	image data was copied into the dedicated buffer,
+	so callback receives view of the mapped memory.
+=================================================
+*/
+	void  VCmdBatch::_FinalizeImageBuffer (const VDevice &dev, OnImageDataLoadedEvent &ev)
+	{
+		using T = BufferView::value_type;
+
+		auto&					rm	= _frameGraph.GetResourceManager();
+		VBuffer const*			buf	= rm.GetResource( ev.buffer.Get() );
+		VMemoryObj const*		mem	= buf ? rm.GetResource( buf->GetMemoryID() ) : null;
+		VMemoryObj::MemoryInfo	info;
+
+		if ( mem and mem->GetInfo( rm.GetMemoryManager(), OUT info ) and info.mappedPtr )
+		{
+			// invalidate non-cocherent memory before reading
+			if ( not AllBits( info.flags, VK_MEMORY_PROPERTY_HOST_COHERENT_BIT ))
+			{
+				VkMappedMemoryRange	reg = {};
+				reg.sType	= VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
+				reg.memory	= info.mem;
+				reg.offset	= VkDeviceSize(info.offset);
+				reg.size	= VkDeviceSize(info.size);
+
+				VK_CALL( dev.vkInvalidateMappedMemoryRanges( dev.GetVkDevice(), 1, &reg ));
+			}
+
+			ASSERT( info.size >= ev.totalSize );
+
+			ArrayView<T>	data_parts[] = { ArrayView<T>{ Cast<T>(info.mappedPtr), size_t(ev.totalSize) }};
+
+			ev.callback( ImageView{ data_parts, ev.imageSize, ev.rowPitch, ev.slicePitch, ev.format, ev.aspect });
+		}
+		else
+			FG_LOGE( "failed to map image readback buffer" );
+
+		rm.ReleaseResource( ev.buffer.Release() );
+	}
+
 /*
 =================================================
 	_ParseDebugOutput
@@ -618,12 +780,20 @@ namespace FG
 	{
 		auto&	rm = _frameGraph.GetResourceManager();
 
+		// state that was stored by this batch doesn't require dependency anymore
+		const auto	ResetLastState = [this, &rm] (auto id)
+		{
+			if ( auto*  res = rm.GetResource( id, false, true ))
+				res->ResetLastStateBatch( this );
+			return id;
+		};
+
 		for (auto[res, count] : _resourcesToRelease)
 		{
 			switch ( res.GetUID() )
 			{
-				case RawBufferID::GetUID() :			rm.ReleaseResource( RawBufferID{ res.Index(), res.InstanceID() }, count );				break;
-				case RawImageID::GetUID() :				rm.ReleaseResource( RawImageID{ res.Index(), res.InstanceID() }, count );				break;
+				case RawBufferID::GetUID() :			rm.ReleaseResource( ResetLastState( RawBufferID{ res.Index(), res.InstanceID() }), count );	break;
+				case RawImageID::GetUID() :				rm.ReleaseResource( ResetLastState( RawImageID{ res.Index(), res.InstanceID() }), count );		break;
 				case RawGPipelineID::GetUID() :			rm.ReleaseResource( RawGPipelineID{ res.Index(), res.InstanceID() }, count );			break;
 				case RawCPipelineID::GetUID() :			rm.ReleaseResource( RawCPipelineID{ res.Index(), res.InstanceID() }, count );			break;
 				case RawSamplerID::GetUID() :			rm.ReleaseResource( RawSamplerID{ res.Index(), res.InstanceID() }, count );				break;
@@ -652,6 +822,21 @@ namespace FG
 		_resourcesToRelease.clear();
 	}
 	
+/*
+=================================================
+	_ResetEvents
+=================================================
+*/
+	void  VCmdBatch::_ResetEvents ()
+	{
+		VDevice const&	dev = _frameGraph.GetDevice();
+
+		for (uint i = 0; i < _events.used; ++i) {
+			VK_CALL( dev.vkResetEvent( dev.GetVkDevice(), _events.pool[i] ));
+		}
+		_events.used = 0;
+	}
+
 /*
 =================================================
 	_ReleaseVkObjects
@@ -810,6 +995,10 @@ namespace FG
 		ASSERT( blockAlign > 0_b and offsetAlign > 0_b );
 		ASSERT( dstMinSize == AlignToSmaller( dstMinSize, blockAlign ));
 
+		// sub-allocate from the staging ring, staging buffers are used only if ring is full
+		if ( _GetWritableFromRing( srcRequiredSize, blockAlign, offsetAlign, dstMinSize, OUT dstBuffer, OUT dstOffset, OUT outSize, OUT mappedPtr ))
+			return true;
+
 		auto&			staging_buffers = _staging.hostToDevice;
 		const BytesU	stagingbuf_size	= _frameGraph.GetResourceManager().GetHostWriteBufferSize();
 
@@ -873,6 +1062,58 @@ namespace FG
 		return true;
 	}
 	
+/*
+=================================================
+	_GetWritableFromRing
+----
+	data is written to the last chunk by pointer bump,
+	new chunk is acquired only if there is not enough space,
+	so large uploads are split into several chunks
+=================================================
+*/
+	bool  VCmdBatch::_GetWritableFromRing (const BytesU srcRequiredSize, const BytesU blockAlign, const BytesU offsetAlign, const BytesU dstMinSize,
+										   OUT RawBufferID &dstBuffer, OUT BytesU &dstOffset, OUT BytesU &outSize, OUT void* &mappedPtr)
+	{
+		VStagingRing*	ring = _staging.ring;
+		if ( not ring )
+			return false;
+
+		const auto	GetAvailable = [blockAlign, offsetAlign] (const StagingRingChunk &rc)
+		{
+			const BytesU	off	= AlignToLarger( rc.chunk.offset + rc.size, offsetAlign );
+			const BytesU	end	= rc.chunk.offset + rc.chunk.size;
+			return off < end ? AlignToSmaller( end - off, blockAlign ) : 0_b;
+		};
+
+		auto&				chunks		= _staging.ringChunks;
+		StagingRingChunk*	suitable	= chunks.size() ? &chunks.back() : null;
+		BytesU				available	= suitable ? GetAvailable( *suitable ) : 0_b;
+
+		if ( available < srcRequiredSize )
+		{
+			VStagingRing::Chunk	chunk;
+			const BytesU		size	 = Max( srcRequiredSize, BytesU(FG_StagingRingChunkSize) ) + offsetAlign;
+			const BytesU		min_size = Max( dstMinSize, blockAlign ) + offsetAlign;
+
+			if ( ring->Alloc( size, min_size, OUT chunk ))
+			{
+				suitable	= &chunks.emplace_back( StagingRingChunk{ chunk, 0_b });
+				available	= GetAvailable( *suitable );
+			}
+		}
+
+		if ( not suitable or available == 0_b or available < dstMinSize )
+			return false;
+
+		dstOffset	= AlignToLarger( suitable->chunk.offset + suitable->size, offsetAlign );
+		outSize		= Min( available, srcRequiredSize );
+		dstBuffer	= ring->GetBufferID();
+		mappedPtr	= ring->GetMappedPtr() + dstOffset;
+
+		suitable->size = dstOffset + outSize - suitable->chunk.offset;
+		return true;
+	}
+
 /*
 =================================================
 	_AddPendingLoad
@@ -1004,7 +1245,7 @@ namespace FG
 	bool  VCmdBatch::AddDataLoadedEvent (OnImageDataLoadedEvent &&ev)
 	{
 		EXLOCK( _drCheck );
-		CHECK_ERR( ev.callback and not ev.parts.empty() );
+		CHECK_ERR( ev.callback and (not ev.parts.empty() or ev.buffer) );
 
 		_staging.onImageLoadedEvents.push_back( std::move(ev) );
 		return true;
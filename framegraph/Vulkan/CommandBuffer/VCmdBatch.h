@@ -7,6 +7,8 @@
 #include "VDescriptorSetLayout.h"
 #include "VLocalDebugger.h"
 #include "VCommandPool.h"
+#include "VTransientHeap.h"
+#include "VStagingRing.h"
 #include "stl/Containers/FixedTupleArray.h"
 
 namespace FG
@@ -140,6 +142,12 @@ namespace FG
 			ND_ bool	Empty ()	const	{ return size == 0_b; }
 		};
 
+		struct StagingRingChunk
+		{
+			VStagingRing::Chunk		chunk;
+			BytesU					size;		// used bytes
+		};
+
 
 		struct OnBufferDataLoadedEvent
 		{
@@ -175,6 +183,7 @@ namespace FG
 		// variables
 			Callback_t		callback;
 			DataParts_t		parts;
+			BufferID		buffer;		// dedicated host cached buffer, used instead of 'parts', see 'ReadImage::SetContiguous()'
 			BytesU			totalSize;
 			uint3			imageSize;
 			BytesU			rowPitch;
@@ -233,16 +242,19 @@ namespace FG
 		using Dependencies_t		= FixedArray< VCmdBatchPtr, MaxDependencies >;
 
 		static constexpr uint		MaxSwapchains = 8;
+		static constexpr uint		MaxStagingBuffers = 8;	// staging buffers per batch for each direction, ring is used first
 		using Swapchains_t			= FixedArray< VSwapchain const*, MaxSwapchains >;
 
 		using BatchGraph			= VLocalDebugger::BatchGraph;
 
 		static constexpr uint		MaxBatchItems = 8;
 		using CmdBuffers_t			= FixedTupleArray< MaxBatchItems, VkCommandBuffer, VCommandPool const* >;
-		using SignalSemaphores_t	= FixedArray< VkSemaphore, MaxBatchItems >;
-		using WaitSemaphores_t		= FixedTupleArray< MaxBatchItems, VkSemaphore, VkPipelineStageFlags >;
+		using SecondaryCmdBuffers_t	= Array< Pair< VkCommandBuffer, VCommandPool const* >>;
+		using SignalSemaphores_t	= FixedTupleArray< MaxBatchItems, VkSemaphore, uint64_t >;						// semaphore, timeline value
+		using WaitSemaphores_t		= FixedTupleArray< MaxBatchItems, VkSemaphore, VkPipelineStageFlags, uint64_t >;	// semaphore, stage, timeline value
 		
 		using VkResourceArray_t		= Array<Pair< VkObjectType, uint64_t >>;
+		using Events_t				= Array< VkEvent >;
 
 		using Statistic_t			= IFrameGraph::Statistics;
 
@@ -275,18 +287,33 @@ namespace FG
 		// command batch data
 		struct {
 			CmdBuffers_t						commands;
+			SecondaryCmdBuffers_t				secondaryCommands;		// executed by primary command buffers, only for recycling
 			SignalSemaphores_t					signalSemaphores;
 			WaitSemaphores_t					waitSemaphores;
+			#ifdef VK_KHR_timeline_semaphore
+			VkTimelineSemaphoreSubmitInfoKHR	timelineInfo;			// values of timeline semaphores, ignored for binary semaphores
+			#endif
 		}									_batch;
 
 		// staging buffers
 		struct {
-			FixedArray< StagingBuffer, 8 >		hostToDevice;	// CPU write, GPU read
-			FixedArray< StagingBuffer, 8 >		deviceToHost;	// CPU read, GPU write
+			FixedArray< StagingBuffer, MaxStagingBuffers >	hostToDevice;	// CPU write, GPU read
+			FixedArray< StagingBuffer, MaxStagingBuffers >	deviceToHost;	// CPU read, GPU write
+			VStagingRing *						ring		= null;		// CPU write, GPU read, shared between batches of the same queue
+			Array< StagingRingChunk >			ringChunks;
 			Array< OnBufferDataLoadedEvent >	onBufferLoadedEvents;
 			Array< OnImageDataLoadedEvent >		onImageLoadedEvents;
 		}									_staging;
 
+		// events for split barriers, reused when batch is complete
+		struct {
+			Events_t							pool;
+			uint								used		= 0;
+		}									_events;
+
+		// memory for transient resources, reused when batch is complete
+		VTransientHeap						_transientHeap;
+
 		// resources
 		ResourceMap_t						_resourcesToRelease;
 		Swapchains_t						_swapchains;
@@ -330,12 +357,15 @@ namespace FG
 		bool  AfterSubmit (OUT Appendable<VSwapchain const*>, VSubmitted *);
 		bool  OnComplete (VDebugger &, const ShaderDebugCallback_t &, INOUT Statistic_t &);
 
-		void  SignalSemaphore (VkSemaphore sem);
-		void  WaitSemaphore (VkSemaphore sem, VkPipelineStageFlags stage);
+		void  SignalSemaphore (VkSemaphore sem, uint64_t timelineValue = 0);
+		void  WaitSemaphore (VkSemaphore sem, VkPipelineStageFlags stage, uint64_t timelineValue = 0);
 		void  PushFrontCommandBuffer (VkCommandBuffer, const VCommandPool *);
 		void  PushBackCommandBuffer (VkCommandBuffer, const VCommandPool *);
-		void  AddDependency (VCmdBatch *);
+		void  AddSecondaryCommandBuffer (VkCommandBuffer, const VCommandPool *);
+		bool  AddDependency (VCmdBatch *);
 		void  DestroyPostponed (VkObjectType type, uint64_t handle);
+		ND_ VkEvent  AcquireEvent ();
+		ND_ VTransientHeap&  GetTransientHeap ()		{ ASSERT( GetState() == EState::Recording );  return _transientHeap; }
 	
 
 		// shader debugger //
@@ -371,6 +401,7 @@ namespace FG
 		void  _SetState (EState newState);
 		void  _ReleaseResources ();
 		void  _ReleaseVkObjects ();
+		void  _ResetEvents ();
 		void  _FinalizeCommands ();
 
 		
@@ -387,8 +418,11 @@ namespace FG
 		// staging buffer //
 		bool  _AddPendingLoad (const BytesU srcRequiredSize, const BytesU blockAlign, const BytesU offsetAlign, const BytesU dstMinSize,
 							   OUT RawBufferID &dstBuffer, OUT OnBufferDataLoadedEvent::Range &range);
+		bool  _GetWritableFromRing (const BytesU srcRequiredSize, const BytesU blockAlign, const BytesU offsetAlign, const BytesU dstMinSize,
+									OUT RawBufferID &dstBuffer, OUT BytesU &dstOffset, OUT BytesU &outSize, OUT void* &mappedPtr);
 		bool  _MapMemory (INOUT StagingBuffer &) const;
 		void  _FinalizeStagingBuffers (const VDevice &);
+		void  _FinalizeImageBuffer (const VDevice &, OnImageDataLoadedEvent &);
 	};
 
 
@@ -40,10 +40,22 @@ namespace {
 		EXLOCK( _drCheck );
 		CHECK( _state == EState::Initial );
 
-		for (auto& q : _perQueue) {
-			q.Destroy( GetDevice() );
+		for (auto& q : _perQueue)
+		{
+			q.primaryPool.Destroy( GetDevice() );
+
+			for (auto& pool : q.secondaryPools) {
+				pool.Destroy( GetDevice() );
+			}
 		}
 		_perQueue.clear();
+
+		// merge per-thread pipeline cache into the device-wide cache
+		if ( _pipelineCache.IsCreated() )
+		{
+			CHECK( _instance.GetPipelineCache().MergeCache( GetDevice(), _pipelineCache ));
+			_pipelineCache.Deinitialize( GetDevice() );
+		}
 	}
 
 /*
@@ -60,8 +72,13 @@ namespace {
 		_batch			= batch;
 		_dbgFullBarriers= AllBits( desc.debugFlags, EDebugFlags::FullBarrier );
 		_dbgQueueSync	= AllBits( desc.debugFlags, EDebugFlags::QueueSync );
+		_reorderTasks	= desc.reorderTasks;
+		_splitBarriers	= desc.splitBarriers and AnyBits( queue->familyFlags, VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT );
+		_reuseSchedule	= desc.reuseSchedule;
+		_persistentState= desc.persistentState;
 		_state			= EState::Recording;
 		_queueIndex		= queue->familyIndex;
+		_queue			= queue;
 		
 		// create command pool
 		{
@@ -69,13 +86,19 @@ namespace {
 
 			_perQueue.resize( Max( _perQueue.size(), index+1 ));
 			
-			auto&	pool = _perQueue[index];
+			auto&	pool = _perQueue[index].primaryPool;
 
 			if ( not pool.IsCreated() )
 			{
 				CHECK_ERR( pool.Create( GetDevice(), queue ));
 			}
 		}
+
+		// create pipeline cache with pipelines that was loaded from file
+		if ( not _pipelineCache.IsCreated() )
+		{
+			CHECK_ERR( _pipelineCache.Initialize( GetDevice(), _instance.GetPipelineCache() ));
+		}
 		
 		_batch->OnBegin( desc );
 		
@@ -130,6 +153,34 @@ namespace {
 		return true;
 	}
 
+/*
+=================================================
+	AllocSecondaryCommandBuffer
+----
+	each chunk of render pass uses its own command pool,
+	so chunks can be recorded on different threads.
+=================================================
+*/
+	VkCommandBuffer  VCommandBuffer::AllocSecondaryCommandBuffer (uint chunkIndex)
+	{
+		EXLOCK( _drCheck );
+		CHECK_ERR( _state == EState::Compiling, VK_NULL_HANDLE );
+		CHECK_ERR( chunkIndex < FG_MaxRecordingThreads, VK_NULL_HANDLE );
+
+		auto&	pool = _perQueue[ uint(_queueIndex) ].secondaryPools[ chunkIndex ];
+
+		if ( not pool.IsCreated() )
+		{
+			CHECK_ERR( pool.Create( GetDevice(), _queue ), VK_NULL_HANDLE );
+		}
+
+		VkCommandBuffer	cmd = pool.AllocSecondary( GetDevice() );
+		CHECK_ERR( cmd, VK_NULL_HANDLE );
+
+		_batch->AddSecondaryCommandBuffer( cmd, &pool );
+		return cmd;
+	}
+
 /*
 =================================================
 	_AfterCompilation
@@ -155,6 +206,7 @@ namespace {
 			}
 		}
 		_rm.logicalRenderPassCount = 0;
+		_rm.transients.clear();
 	}
 
 /*
@@ -198,7 +250,7 @@ namespace {
 		
 		// create command buffer
 		{
-			auto&	pool = _perQueue[ uint(_queueIndex) ];
+			auto&	pool = _perQueue[ uint(_queueIndex) ].primaryPool;
 			
 			cmd = pool.AllocPrimary( dev );
 			_batch->PushBackCommandBuffer( cmd, &pool );
@@ -220,8 +272,13 @@ namespace {
 			_barrierMngr.AddMemoryBarrier( VK_PIPELINE_STAGE_HOST_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, barrier );
 		}
 
+		auto&	stat = _batch->_statistic.renderer;
+
+		CHECK_ERR( _LoadLastStates() );
+		_barrierMngr.ClearEvents();
+
 		// commit image layout transition and other
-		_barrierMngr.Commit( dev, cmd );
+		stat.pipelineBarriers += uint(_barrierMngr.Commit( dev, cmd ));
 
 		CHECK( _ProcessTasks( cmd ));
 
@@ -234,8 +291,11 @@ namespace {
 			barrier.dstAccessMask	= VK_ACCESS_HOST_READ_BIT;
 			_barrierMngr.AddMemoryBarrier( VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_HOST_BIT, barrier );
 
-			_FlushLocalResourceStates( ExeOrderIndex::Final, _barrierMngr, GetDebugger() );
-			_barrierMngr.ForceCommit( dev, cmd, dev.GetAllWritableStages(), dev.GetAllReadableStages() );
+			if ( _FlushLocalResourceStates( ExeOrderIndex::Final, _barrierMngr, GetDebugger() ))
+				stat.pipelineBarriers += uint(_barrierMngr.ForceCommit( dev, cmd, dev.GetAllWritableStages(), dev.GetAllReadableStages() ));
+			else
+				stat.pipelineBarriers += uint(_barrierMngr.Commit( dev, cmd ));
+			stat.splitBarriers	  += _barrierMngr.SplitBarrierCount();
 		}
 
 		// end
@@ -260,6 +320,106 @@ namespace {
 			_fgThread.GetDebugger()->AddTask( _currTask );
 
 		node->Process( this );
+
+		if ( _batchPass == EBatchPass::None )
+			_SetSplitEvent();
+	}
+	
+/*
+=================================================
+	VTaskProcessor::TryAddToBatch
+----
+	tasks are checked in topological order, each batch contains at least one task.
+	Rejected tasks lock their resources until the end of the batch,
+	so tasks that access the same resources are never reordered.
+=================================================
+*/
+	bool  VTaskProcessor::TryAddToBatch (VTask node)
+	{
+		if ( _batchClosed )
+			return false;
+
+		if ( not node->IsBatchable() )
+		{
+			// resource states are unknown, so task is executed alone and all other tasks must wait
+			_batchClosed = true;
+
+			if ( _batchSize > 0 )
+				return false;
+
+			_batchSize = 1;
+			return true;
+		}
+
+		// collect resource accesses
+		_taskAccesses.clear();
+		_batchPass	= EBatchPass::Collect;
+		_currTask	= node;
+
+		node->Process( this );
+
+		_batchPass	= EBatchPass::None;
+		_currTask	= null;
+
+		bool	compatible = true;
+
+		for (auto& acc : _taskAccesses)
+		{
+			if ( not (_IsCompatible( _batchAccesses, acc ) and _IsCompatible( _rejectedAccesses, acc )))
+			{
+				compatible = false;
+				break;
+			}
+		}
+
+		auto&	dst = (compatible ? _batchAccesses : _rejectedAccesses);
+		dst.insert( dst.end(), _taskAccesses.begin(), _taskAccesses.end() );
+
+		_batchSize += uint(compatible);
+		return compatible;
+	}
+	
+/*
+=================================================
+	VTaskProcessor::RunBatch
+----
+	adds resource states for all tasks in the batch,
+	commits barriers once and then records commands
+=================================================
+*/
+	void  VTaskProcessor::RunBatch (ArrayView<VTask> batch)
+	{
+		// batch size is zero if batch is replayed from cached schedule
+		ASSERT( _batchSize == 0 or batch.size() == _batchSize );
+
+		_batchSize		= 0;
+		_batchClosed	= false;
+		_batchAccesses.clear();
+		_rejectedAccesses.clear();
+		
+		if ( batch.size() == 1 )
+			return Run( batch.front() );
+
+		_batchPass = EBatchPass::Barriers;
+
+		for (auto node : batch)
+		{
+			_currTask = node;
+			node->Process( this );
+		}
+
+		_batchPass = EBatchPass::None;
+		_CommitBarriers();
+
+		_batchPass = EBatchPass::Commands;
+
+		for (auto node : batch) {
+			Run( node );
+		}
+
+		_batchPass = EBatchPass::None;
+		_SetSplitEvent();
+		Stat().batchedTasks += uint(batch.size() - 1);
 	}
 
 /*
@@ -270,53 +430,77 @@ namespace {
 	bool  VCommandBuffer::_ProcessTasks (VkCommandBuffer cmd)
 	{
 		VTaskProcessor	processor{ *this, cmd };
-		uint			visitor_id		= 1;
 		ExeOrderIndex	exe_order_index	= ExeOrderIndex::First;
 
-		TempTaskArray_t		pending{ GetAllocator() };
-		pending.reserve( 128 );
-		pending.assign( _taskGraph.Entries().begin(), _taskGraph.Entries().end() );
+		// local debugger requires unique execution order index for each task
+		const bool		use_batches		= _reorderTasks and not _debugger;
+		const HashVal	schedule_key	= HashCombine( _taskGraph.Hash(), HashOf( use_batches ));
+		
+		// all tasks in the batch share the same index, so their resource states are merged
+		const auto		RunBatch		= [&] (ArrayView<VTask> batch)
+		{
+			++exe_order_index;
+
+			for (auto node : batch) {
+				node->SetExecutionOrder( exe_order_index );
+			}
 
-		for (uint k = 0; k < 10 and not pending.empty(); ++k)
+			if ( use_batches )
+				processor.RunBatch( batch );
+			else
+				processor.Run( batch.front() );
+		};
+
+		// task order depends only on the task graph, so skip ordering and batching if graph has not been changed,
+		// schedule is validated before replay and nothing is visited if it doesn't match the graph
+		if ( _reuseSchedule )
 		{
-			for (size_t i = 0; i < pending.size();)
+			auto	schedule = _instance.GetTaskSchedules().Find( schedule_key );
+
+			if ( schedule and _taskGraph.Replay( GetAllocator(), *schedule, RunBatch ))
 			{
-				auto	node = pending[i];
-				
-				if ( node->VisitorID() == visitor_id ) {
-					++i;
-					continue;
-				}
+				_batch->_statistic.renderer.reusedSchedules ++;
+				return true;
+			}
+		}
 
-				// wait for input
-				bool	input_processed = true;
+		SharedPtr<VTaskSchedule>	new_schedule;
 
-				for (auto in_node : node->Inputs())
-				{
-					if ( in_node->VisitorID() != visitor_id ) {
-						input_processed = false;
-						break;
-					}
-				}
+		if ( _reuseSchedule )
+		{
+			new_schedule = std::make_shared<VTaskSchedule>();
+			new_schedule->order.reserve( _taskGraph.Count() );
+		}
 
-				if ( not input_processed ) {
-					++i;
-					continue;
+		const auto	RecordBatch = [&] (ArrayView<VTask> batch)
+		{
+			if ( new_schedule )
+			{
+				for (auto node : batch) {
+					new_schedule->order.push_back( node->Index() );
 				}
+				new_schedule->batches.push_back( uint(batch.size()) );
+			}
+			RunBatch( batch );
+		};
 
-				node->SetVisitorID( visitor_id );
-				node->SetExecutionOrder( ++exe_order_index );
-				
-				processor.Run( node );
-
-				for (auto out_node : node->Outputs())
+		if ( use_batches )
+		{
+			CHECK_ERR( _taskGraph.VisitBatches( GetAllocator(),
+				[&] (VTask node) { return processor.TryAddToBatch( node ); },
+				RecordBatch ));
+		}
+		else
+		{
+			CHECK_ERR( _taskGraph.Visit( GetAllocator(), [&] (VTask node)
 				{
-					pending.push_back( out_node );
-				}
-
-				pending.erase( pending.begin()+i );
-			}
+					RecordBatch( ArrayView<VTask>{ &node, 1 });
+				}));
 		}
+
+		if ( new_schedule )
+			_instance.GetTaskSchedules().Add( schedule_key, std::move(new_schedule) );
+
 		return true;
 	}
 //-----------------------------------------------------------------------------
@@ -398,8 +582,7 @@ namespace {
 		EXLOCK( _drCheck );
 		CHECK_ERR( _IsRecording() );
 
-		_batch->AddDependency( Cast<VCmdBatch>(cmd.GetBatch()) );
-		return true;
+		return _batch->AddDependency( Cast<VCmdBatch>(cmd.GetBatch()) );
 	}
 	
 /*
@@ -447,6 +630,218 @@ namespace {
 			buffer->SetInitialState( not makeMutable );
 		}
 	}
+	
+/*
+=================================================
+	CreateTransientImage
+----
+	image is registered as external image that owns vulkan handle,
+	memory is owned by command batch.
+=================================================
+*/
+	RawImageID  VCommandBuffer::CreateTransientImage (const ImageDesc &inDesc, StringView dbgName)
+	{
+		EXLOCK( _drCheck );
+		CHECK_ERR( _IsRecording() );
+
+		auto&		dev		= GetDevice();
+		ImageDesc	desc	= inDesc;
+		desc.Validate();
+
+		VkImageCreateInfo	info = {};
+		info.sType			= VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+		info.flags			= VEnumCast( desc.flags );
+		info.imageType		= VEnumCast( desc.imageType );
+		info.format			= VEnumCast( desc.format );
+		info.extent.width	= desc.dimension.x;
+		info.extent.height	= desc.dimension.y;
+		info.extent.depth	= desc.dimension.z;
+		info.mipLevels		= desc.maxLevel.Get();
+		info.arrayLayers	= desc.arrayLayers.Get();
+		info.samples		= VEnumCast( desc.samples );
+		info.tiling			= VK_IMAGE_TILING_OPTIMAL;
+		info.usage			= VEnumCast( desc.usage );
+		info.sharingMode	= VK_SHARING_MODE_EXCLUSIVE;
+		info.initialLayout	= VK_IMAGE_LAYOUT_UNDEFINED;
+
+		VkImage		image = VK_NULL_HANDLE;
+		CHECK_ERR( dev.vkCreateImage( dev.GetVkDevice(), &info, null, OUT &image ) == VK_SUCCESS );
+
+		VkMemoryRequirements		mem_req;
+		VTransientHeap::Allocation	mem;
+		dev.vkGetImageMemoryRequirements( dev.GetVkDevice(), image, OUT &mem_req );
+
+		if ( not (_AllocTransientMemory( mem_req, OUT mem ) and
+				  dev.vkBindImageMemory( dev.GetVkDevice(), image, _batch->GetTransientHeap().GetMemory( mem ), mem.offset ) == VK_SUCCESS ))
+		{
+			dev.vkDestroyImage( dev.GetVkDevice(), image, null );
+			RETURN_ERR( "failed to allocate memory for transient image" );
+		}
+
+		VulkanImageDesc		vk_desc;
+		vk_desc.image			= BitCast<ImageVk_t>( image );
+		vk_desc.imageType		= BitCast<ImageTypeVk_t>( info.imageType );
+		vk_desc.flags			= BitCast<ImageFlagsVk_t>( info.flags );
+		vk_desc.usage			= BitCast<ImageUsageVk_t>( info.usage );
+		vk_desc.format			= BitCast<FormatVk_t>( info.format );
+		vk_desc.currentLayout	= BitCast<ImageLayoutVk_t>( info.initialLayout );
+		vk_desc.samples			= BitCast<SampleCountFlagBitsVk_t>( info.samples );
+		vk_desc.dimension		= desc.dimension;
+		vk_desc.arrayLayers		= desc.arrayLayers.Get();
+		vk_desc.maxLevels		= desc.maxLevel.Get();
+		vk_desc.queueFamily		= VK_QUEUE_FAMILY_IGNORED;
+
+		RawImageID	id = GetResourceManager().CreateImage( vk_desc,
+										[&dev] (const IFrameGraph::ExternalImage_t &img) {
+											if ( auto* vk_img = UnionGetIf<ImageVk_t>( &img ))
+												dev.vkDestroyImage( dev.GetVkDevice(), BitCast<VkImage>( *vk_img ), null );
+										},
+										dbgName );
+		if ( not id )
+		{
+			dev.vkDestroyImage( dev.GetVkDevice(), image, null );
+			_batch->GetTransientHeap().Release( mem );
+			RETURN_ERR( "failed to create transient image" );
+		}
+
+		_rm.transients.insert_or_assign( Resource_t{ id }, mem );
+
+		// image will be destroyed when batch is complete
+		ReleaseResource( id );
+		
+		// transit to undefined layout
+		auto*	local = ToLocal( id );
+		CHECK_ERR( local );
+		local->SetInitialState( false, true );
+
+		return id;
+	}
+	
+/*
+=================================================
+	CreateTransientBuffer
+=================================================
+*/
+	RawBufferID  VCommandBuffer::CreateTransientBuffer (const BufferDesc &desc, StringView dbgName)
+	{
+		EXLOCK( _drCheck );
+		CHECK_ERR( _IsRecording() );
+		CHECK_ERR( desc.size > 0 );
+
+		auto&	dev = GetDevice();
+
+		VkBufferCreateInfo	info = {};
+		info.sType			= VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+		info.usage			= VEnumCast( desc.usage );
+		info.size			= VkDeviceSize( desc.size );
+		info.sharingMode	= VK_SHARING_MODE_EXCLUSIVE;
+
+		VkBuffer	buffer = VK_NULL_HANDLE;
+		CHECK_ERR( dev.vkCreateBuffer( dev.GetVkDevice(), &info, null, OUT &buffer ) == VK_SUCCESS );
+
+		VkMemoryRequirements		mem_req;
+		VTransientHeap::Allocation	mem;
+		dev.vkGetBufferMemoryRequirements( dev.GetVkDevice(), buffer, OUT &mem_req );
+
+		if ( not (_AllocTransientMemory( mem_req, OUT mem ) and
+				  dev.vkBindBufferMemory( dev.GetVkDevice(), buffer, _batch->GetTransientHeap().GetMemory( mem ), mem.offset ) == VK_SUCCESS ))
+		{
+			dev.vkDestroyBuffer( dev.GetVkDevice(), buffer, null );
+			RETURN_ERR( "failed to allocate memory for transient buffer" );
+		}
+
+		VulkanBufferDesc	vk_desc;
+		vk_desc.buffer		= BitCast<BufferVk_t>( buffer );
+		vk_desc.usage		= BitCast<BufferUsageFlagsVk_t>( info.usage );
+		vk_desc.size		= desc.size;
+		vk_desc.queueFamily	= VK_QUEUE_FAMILY_IGNORED;
+
+		RawBufferID	id = GetResourceManager().CreateBuffer( vk_desc,
+										[&dev] (const IFrameGraph::ExternalBuffer_t &buf) {
+											if ( auto* vk_buf = UnionGetIf<BufferVk_t>( &buf ))
+												dev.vkDestroyBuffer( dev.GetVkDevice(), BitCast<VkBuffer>( *vk_buf ), null );
+										},
+										dbgName );
+		if ( not id )
+		{
+			dev.vkDestroyBuffer( dev.GetVkDevice(), buffer, null );
+			_batch->GetTransientHeap().Release( mem );
+			RETURN_ERR( "failed to create transient buffer" );
+		}
+
+		_rm.transients.insert_or_assign( Resource_t{ id }, mem );
+
+		// buffer will be destroyed when batch is complete
+		ReleaseResource( id );
+
+		auto*	local = ToLocal( id );
+		CHECK_ERR( local );
+		local->SetInitialState( false );
+
+		return id;
+	}
+	
+/*
+=================================================
+	ReleaseTransient
+=================================================
+*/
+	bool  VCommandBuffer::ReleaseTransient (RawImageID id)
+	{
+		EXLOCK( _drCheck );
+		CHECK_ERR( _IsRecording() );
+		return _ReleaseTransient( Resource_t{ id });
+	}
+
+	bool  VCommandBuffer::ReleaseTransient (RawBufferID id)
+	{
+		EXLOCK( _drCheck );
+		CHECK_ERR( _IsRecording() );
+		return _ReleaseTransient( Resource_t{ id });
+	}
+	
+/*
+=================================================
+	_ReleaseTransient
+----
+	resource will be destroyed when batch is complete,
+	but its memory can be used by the next transient resource after aliasing fence
+=================================================
+*/
+	bool  VCommandBuffer::_ReleaseTransient (const Resource_t &res)
+	{
+		auto	iter = _rm.transients.find( res );
+		CHECK_ERR( iter != _rm.transients.end() );
+
+		_batch->GetTransientHeap().Release( iter->second );
+		_rm.transients.erase( iter );
+		return true;
+	}
+	
+/*
+=================================================
+	_AllocTransientMemory
+----
+	if new resource uses memory of released resource then all tasks
+	that were added before must be executed before tasks that will be added after,
+	aliasing fence adds these dependencies and global memory barrier
+=================================================
+*/
+	bool  VCommandBuffer::_AllocTransientMemory (const VkMemoryRequirements &memReq, OUT VTransientHeap::Allocation &result)
+	{
+		auto&	heap	= _batch->GetTransientHeap();
+		bool	aliased	= false;
+
+		CHECK_ERR( heap.Alloc( _instance.GetResourceManager(), memReq, OUT result, OUT aliased ));
+
+		if ( aliased )
+		{
+			_taskGraph.AddFence( *this );
+			heap.OnAliasingBarrier();
+			++_batch->_statistic.renderer.aliasingFences;
+		}
+		return true;
+	}
 
 /*
 =================================================
@@ -710,13 +1105,15 @@ namespace {
 		// copy to staging buffer
 		for (auto& reg : task.regions)
 		{
-			for (BytesU readn; readn < ArraySizeOf(reg.data);)
+			const BytesU	reg_size = reg.Size();
+
+			for (BytesU readn; readn < reg_size;)
 			{
 				RawBufferID		src_buffer;
 				BytesU			off, size;
-				CHECK_ERR( _StorePartialData( reg.data, readn, OUT src_buffer, OUT off, OUT size ));
+				CHECK_ERR( _StorePartialData( reg, readn, OUT src_buffer, OUT off, OUT size ));
 			
-				if ( copy.srcBuffer and src_buffer != copy.srcBuffer )
+				if ( copy.srcBuffer and (src_buffer != copy.srcBuffer or copy.regions.size() == copy.regions.capacity()) )
 				{
 					Task	last_task = AddTask( copy );
 					copy.regions.clear();
@@ -774,7 +1171,7 @@ namespace {
 		const BytesU	slice_pitch		= Max( task.dataSlicePitch, min_slice_pitch );
 		const BytesU	total_size		= image_size.z > 1 ? slice_pitch * image_size.z : min_slice_pitch;
 
-		CHECK_ERR( total_size == ArraySizeOf(task.data) );
+		CHECK_ERR( task.writer or total_size == ArraySizeOf(task.data) );
 
 		const BytesU		min_size	= _instance.GetResourceManager().GetHostWriteBufferSize() / 4;
 		const uint			row_length	= CheckCast<uint>((row_pitch * block_dim.x * 8) / block_size);
@@ -797,9 +1194,9 @@ namespace {
 			{
 				RawBufferID		src_buffer;
 				BytesU			off, size;
-				CHECK_ERR( _StoreImageData( task.data, readn, slice_pitch, total_size, OUT src_buffer, OUT off, OUT size ));
+				CHECK_ERR( _StoreImageData( task, readn, total_size - readn, slice_pitch, total_size, OUT src_buffer, OUT off, OUT size ));
 				
-				if ( copy.srcBuffer and src_buffer != copy.srcBuffer )
+				if ( copy.srcBuffer and (src_buffer != copy.srcBuffer or copy.regions.size() == copy.regions.capacity()) )
 				{
 					Task	last_task = AddTask( copy );
 					copy.regions.clear();
@@ -827,16 +1224,17 @@ namespace {
 		// copy to staging buffer row by row
 		for (uint slice = 0; slice < image_size.z; ++slice)
 		{
-			uint				y_offset	= 0;
-			ArrayView<uint8_t>	data		= task.data.section( size_t(slice * slice_pitch), size_t(slice_pitch) );
+			uint			y_offset	= 0;
+			const BytesU	slice_off	= slice * slice_pitch;
+			const BytesU	slice_size	= Min( slice_pitch, total_size - slice_off );
 
-			for (BytesU readn; readn < ArraySizeOf(data);)
+			for (BytesU readn; readn < slice_size;)
 			{
 				RawBufferID		src_buffer;
 				BytesU			off, size;
-				CHECK_ERR( _StoreImageData( data, readn, row_pitch * block_dim.y, total_size, OUT src_buffer, OUT off, OUT size ));
+				CHECK_ERR( _StoreImageData( task, slice_off + readn, slice_size - readn, row_pitch * block_dim.y, total_size, OUT src_buffer, OUT off, OUT size ));
 				
-				if ( copy.srcBuffer and src_buffer != copy.srcBuffer )
+				if ( copy.srcBuffer and (src_buffer != copy.srcBuffer or copy.regions.size() == copy.regions.capacity()) )
 				{
 					Task	last_task = AddTask( copy );
 					copy.regions.clear();
@@ -978,6 +1376,38 @@ namespace {
 		copy.debugColor	= task.debugColor;
 		copy.depends	= task.depends;
 		copy.srcImage	= task.srcImage;
+
+		// copy to the dedicated buffer with specified pitches
+		if ( task.contiguous )
+		{
+			const BytesU	block_bytes		= BytesU(block_size / 8);
+			const BytesU	dst_row_pitch	= Max( task.dataRowPitch, row_pitch );
+			const BytesU	dst_slice_pitch	= Max( task.dataSlicePitch, ((image_size.y + block_dim.y-1) / block_dim.y) * dst_row_pitch );
+			
+			CHECK_ERR( block_size % 8 == 0 );
+			CHECK_ERR( dst_row_pitch % block_bytes == 0 );
+			CHECK_ERR( dst_slice_pitch % dst_row_pitch == 0 );
+
+			load_event.totalSize	= dst_slice_pitch * image_size.z;
+			load_event.rowPitch		= dst_row_pitch;
+			load_event.slicePitch	= dst_slice_pitch;
+			load_event.buffer		= _instance.CreateBuffer( BufferDesc{ load_event.totalSize, EBufferUsage::TransferDst },
+															  MemoryDesc{ EMemoryType::HostRead }, "ReadImageBuffer" );
+			CHECK_ERR( load_event.buffer );
+
+			copy.dstBuffer = load_event.buffer.Get();
+			copy.AddRegion( ImageSubresourceRange{ task.mipmapLevel, task.arrayLayer, 1, task.aspectMask },
+							task.imageOffset, image_size, 0_b,
+							CheckCast<uint>((dst_row_pitch / block_bytes) * block_dim.x),
+							CheckCast<uint>((dst_slice_pitch / dst_row_pitch) * block_dim.y) );
+
+			if ( not _batch->AddDataLoadedEvent( std::move(load_event) ))
+			{
+				_instance.ReleaseResource( load_event.buffer );
+				RETURN_ERR( "failed to add data loaded event" );
+			}
+			return AddTask( copy );
+		}
 		
 		// copy to staging buffer slice by slice
 		if ( total_size < min_size )
@@ -1851,13 +2281,101 @@ namespace {
 //-----------------------------------------------------------------------------
 
 	
+/*
+=================================================
+	_LoadLastStates
+----
+	state is loaded when command buffer is executed and stored at the end of '_BuildCommandBuffers()',
+	so command buffers that are recorded at the same time never see stale state.
+	Command buffer without 'persistentState' loads state only for resources
+	that was not transited to default layout by previous command buffer.
+=================================================
+*/
+	bool  VCommandBuffer::_LoadLastStates ()
+	{
+		// dependency that is not executed yet is submitted before this batch,
+		// but it stores its state later, so loaded state will be stale
+		if ( _persistentState )
+		{
+			for (auto& dep : _batch->GetDependencies())
+			{
+				if ( dep->GetState() == VCmdBatch::EState::Recording )
+				{
+					FG_LOGE( "command buffer is executed before its dependency, persistent state is disabled and resources are transited to default layout" );
+					_persistentState = false;
+					break;
+				}
+			}
+		}
+
+		// dependency on the batch that stored the state can not be added,
+		// other command buffers must not wait for states that will never be stored
+		if ( not (_LoadLastStates( _rm.images ) and _LoadLastStates( _rm.buffers )) )
+		{
+			_DiscardLastStates( _rm.images );
+			_DiscardLastStates( _rm.buffers );
+			return false;
+		}
+		return true;
+	}
+	
+/*
+=================================================
+	_LoadLastStates
+----
+	resources are sorted to acquire them in the same order in all threads
+=================================================
+*/
+	template <typename Res, typename MainPool, size_t MC>
+	bool  VCommandBuffer::_LoadLastStates (INOUT LocalResPool<Res,MainPool,MC> &localRes)
+	{
+		Res const**	sorted	= _mainAllocator.Alloc< Res const* >( localRes.maxLocalIndex );
+		uint		count	= 0;
+
+		for (uint i = 0; i < localRes.maxLocalIndex; ++i)
+		{
+			auto&	res = localRes.pool[ Index_t(i) ];
+
+			if ( not res.IsDestroyed() and (_persistentState or res.Data().ToGlobal()->HasLastState()) )
+				sorted[count++] = &res.Data();
+		}
+
+		std::sort( sorted, sorted + count, [] (Res const* lhs, Res const* rhs) { return lhs->ToGlobal() < rhs->ToGlobal(); });
+
+		for (uint i = 0; i < count; ++i) {
+			CHECK_ERR( sorted[i]->LoadLastState( _queue, _batch.get() ));
+		}
+		return true;
+	}
+	
+/*
+=================================================
+	_DiscardLastStates
+=================================================
+*/
+	template <typename Res, typename MainPool, size_t MC>
+	void  VCommandBuffer::_DiscardLastStates (INOUT LocalResPool<Res,MainPool,MC> &localRes)
+	{
+		for (uint i = 0; i < localRes.maxLocalIndex; ++i)
+		{
+			auto&	res = localRes.pool[ Index_t(i) ];
+
+			if ( not res.IsDestroyed() )
+				res.Data().DiscardLastState();
+		}
+	}
+
 /*
 =================================================
 	_FlushLocalResourceStates
+----
+	returns 'true' if resource states are reset and full pipeline barrier is required
 =================================================
 */
-	void  VCommandBuffer::_FlushLocalResourceStates (ExeOrderIndex index, VBarrierManager &barrierMngr, Ptr<VLocalDebugger> debugger)
+	bool  VCommandBuffer::_FlushLocalResourceStates (ExeOrderIndex index, VBarrierManager &barrierMngr, Ptr<VLocalDebugger> debugger)
 	{
+		bool	full_barrier = not _persistentState;
+
 		// reset state & destroy local images
 		for (uint i = 0; i < _rm.images.maxLocalIndex; ++i)
 		{
@@ -1865,7 +2383,11 @@ namespace {
 
 			if ( not image.IsDestroyed() )
 			{
-				image.Data().ResetState( index, barrierMngr, debugger );
+				if ( _persistentState )
+					full_barrier |= not image.Data().StoreLastState( _queue, _batch.get(), barrierMngr, debugger );
+				else
+					image.Data().ResetState( index, barrierMngr, debugger );
+
 				image.Destroy();
 				_rm.images.pool.Unassign( Index_t(i) );
 			}
@@ -1879,7 +2401,11 @@ namespace {
 
 			if ( not buffer.IsDestroyed() )
 			{
-				buffer.Data().ResetState( index, barrierMngr, debugger );
+				if ( _persistentState )
+					full_barrier |= not buffer.Data().StoreLastState( _queue, _batch.get(), barrierMngr, debugger );
+				else
+					buffer.Data().ResetState( index, barrierMngr, debugger );
+
 				buffer.Destroy();
 				_rm.buffers.pool.Unassign( Index_t(i) );
 			}
@@ -1895,6 +2421,7 @@ namespace {
 				if ( not geometry.IsDestroyed() )
 				{
 					geometry.Data().ResetState( index, barrierMngr, debugger );
+					full_barrier = true;
 					geometry.Destroy();
 					_rm.rtGeometries.pool.Unassign( Index_t(i) );
 				}
@@ -1911,6 +2438,7 @@ namespace {
 				if ( not scene.IsDestroyed() )
 				{
 					scene.Data().ResetState( index, barrierMngr, debugger );
+					full_barrier = true;
 					scene.Destroy();
 					_rm.rtScenes.pool.Unassign( Index_t(i) );
 				}
@@ -1919,6 +2447,7 @@ namespace {
 		#endif
 		
 		_ResetLocalRemaping();
+		return full_barrier;
 	}
 
 /*
@@ -1953,7 +2482,13 @@ namespace {
 		auto&	data = localRes.pool[ local ];
 		Replace( data );
 		
-		if ( not data.Create( res ))
+		bool	created;
+		if constexpr( IsSameTypes< Res, VLocalImage > or IsSameTypes< Res, VLocalBuffer >)
+			created = data.Create( res, _mainAllocator );		// access records are allocated from command buffer memory
+		else
+			created = data.Create( res );
+
+		if ( not created )
 		{
 			localRes.pool.Unassign( local );
 			RETURN_ERR( msg );
@@ -2030,16 +2565,19 @@ namespace {
 	_StorePartialData
 =================================================
 */
-	bool  VCommandBuffer::_StorePartialData (ArrayView<uint8_t> srcData, const BytesU srcOffset, OUT RawBufferID &dstBuffer, OUT BytesU &dstOffset, OUT BytesU &size)
+	bool  VCommandBuffer::_StorePartialData (const UpdateBuffer::Region &srcData, const BytesU srcOffset, OUT RawBufferID &dstBuffer, OUT BytesU &dstOffset, OUT BytesU &size)
 	{
 		// skip blocks less than 1/N of data size
-		const BytesU	src_size	= ArraySizeOf(srcData);
+		const BytesU	src_size	= srcData.Size();
 		const BytesU	min_size	= Min( (src_size + MaxBufferParts-1) / MaxBufferParts, Min( src_size, MinBufferPart ));
 		void *			ptr			= null;
 
 		if ( _batch->GetWritable( src_size - srcOffset, 1_b, 16_b, min_size, OUT dstBuffer, OUT dstOffset, OUT size, OUT ptr ))
 		{
-			MemCopy( ptr, size, srcData.data() + srcOffset, size );
+			if ( srcData.writer )
+				srcData.writer( ptr, srcOffset, size );
+			else
+				MemCopy( ptr, size, srcData.data.data() + srcOffset, size );
 			return true;
 		}
 		return false;
@@ -2048,19 +2586,23 @@ namespace {
 /*
 =================================================
 	_StoreImageData
+----
+	stores up to 'srcSize' bytes of image data starting from 'srcOffset'
 =================================================
 */
-	bool  VCommandBuffer::_StoreImageData (ArrayView<uint8_t> srcData, const BytesU srcOffset, const BytesU srcPitch, const BytesU srcTotalSize,
+	bool  VCommandBuffer::_StoreImageData (const UpdateImage &srcData, const BytesU srcOffset, const BytesU srcSize, const BytesU srcPitch, const BytesU srcTotalSize,
 										   OUT RawBufferID &dstBuffer, OUT BytesU &dstOffset, OUT BytesU &size)
 	{
 		// skip blocks less than 1/N of total data size
-		const BytesU	src_size	= ArraySizeOf(srcData);
-		const BytesU	min_size	= Max( (srcTotalSize + MaxImageParts-1) / MaxImageParts, srcPitch );
+		const BytesU	min_size	= Max( Min( (srcTotalSize + MaxImageParts-1) / MaxImageParts, BytesU(FG_StagingRingChunkSize) ), srcPitch );
 		void *			ptr			= null;
 
-		if ( _batch->GetWritable( src_size - srcOffset, srcPitch, 16_b, min_size, OUT dstBuffer, OUT dstOffset, OUT size, OUT ptr ))
+		if ( _batch->GetWritable( srcSize, srcPitch, 16_b, min_size, OUT dstBuffer, OUT dstOffset, OUT size, OUT ptr ))
 		{
-			MemCopy( ptr, size, srcData.data() + srcOffset, size );
+			if ( srcData.writer )
+				srcData.writer( ptr, srcOffset, size );
+			else
+				MemCopy( ptr, size, srcData.data.data() + srcOffset, size );
 			return true;
 		}
 		return false;
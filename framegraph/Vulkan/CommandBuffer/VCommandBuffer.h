@@ -29,7 +29,6 @@ namespace FG
 			Compiling,
 		};
 
-		using TempTaskArray_t	= std::vector< VTask, StdLinearAllocator<VTask> >;
 		using TaskGraph_t		= VTaskGraph< VTaskProcessor >;
 		using Allocator_t		= LinearAllocator<>;
 		using Statistic_t		= IFrameGraph::Statistics;
@@ -37,13 +36,19 @@ namespace FG
 
 		using Resource_t		= VCmdBatch::Resource;
 		using ResourceMap_t		= VCmdBatch::ResourceMap_t;
+		using TransientMap_t	= std::unordered_map< Resource_t, VTransientHeap::Allocation, VCmdBatch::ResourceHash >;
 		using StagingBuffer		= VCmdBatch::StagingBuffer;
 		
 		static constexpr auto	MaxBufferParts	= VCmdBatch::MaxBufferParts;
 		static constexpr auto	MaxImageParts	= VCmdBatch::MaxImageParts;
 		static constexpr auto	MinBufferPart	= 4_Kb;
 
-		using PerQueueArray_t	= FixedArray< VCommandPool, 4 >;
+		struct PerQueue
+		{
+			VCommandPool										primaryPool;
+			StaticArray< VCommandPool, FG_MaxRecordingThreads >	secondaryPools;		// one pool per render pass chunk, created on demand
+		};
+		using PerQueueArray_t	= FixedArray< PerQueue, 4 >;
 		
 		using Index_t			= VResourceManager::Index_t;
 		
@@ -73,6 +78,7 @@ namespace FG
 		EState					_state;
 		VCmdBatchPtr			_batch;
 		EQueueFamily			_queueIndex;
+		VDeviceQueueInfoPtr		_queue;
 
 		VFrameGraph &			_instance;
 		const uint				_indexInPool;		// index in VFrameGraph::_cmdBufferPool
@@ -87,6 +93,7 @@ namespace FG
 
 		struct {
 			ResourceMap_t			resourceMap;
+			TransientMap_t			transients;		// memory of transient resources that are not released yet
 			LocalImages_t			images;
 			LocalBuffers_t			buffers;
 
@@ -102,6 +109,10 @@ namespace FG
 		PerQueueArray_t			_perQueue;		// TODO: use global command pool manager to minimize memory usage
 		bool					_dbgFullBarriers	= false;
 		bool					_dbgQueueSync		= false;
+		bool					_reorderTasks		= false;
+		bool					_splitBarriers		= false;
+		bool					_reuseSchedule		= false;
+		bool					_persistentState	= false;
 
 		DataRaceCheck			_drCheck;
 
@@ -114,6 +125,8 @@ namespace FG
 		bool  Begin (const CommandBufferDesc &desc, const VCmdBatchPtr &batch, VDeviceQueueInfoPtr queue);
 		bool  Execute ();
 
+		ND_ VkCommandBuffer  AllocSecondaryCommandBuffer (uint chunkIndex);
+
 		void  SignalSemaphore (VkSemaphore sem);
 		void  WaitSemaphore (VkSemaphore sem, VkPipelineStageFlags stage);
 		
@@ -127,6 +140,11 @@ namespace FG
 		void		AcquireImage (RawImageID id, bool makeMutable, bool invalidate) override;
 		void		AcquireBuffer (RawBufferID id, bool makeMutable) override;
 
+		RawImageID	CreateTransientImage (const ImageDesc &desc, StringView dbgName) override;
+		RawBufferID	CreateTransientBuffer (const BufferDesc &desc, StringView dbgName) override;
+		bool		ReleaseTransient (RawImageID id) override;
+		bool		ReleaseTransient (RawBufferID id) override;
+
 
 		// tasks //
 		Task		AddTask (const SubmitRenderPass &) override;
@@ -203,6 +221,7 @@ namespace FG
 		ND_ EQueueFamily			GetQueueFamily ()			const	{ EXLOCK( _drCheck );  return _queueIndex; }
 		ND_ bool					IsDebugFullBarriers ()		const	{ EXLOCK( _drCheck );  return _dbgFullBarriers; }
 		ND_ bool					IsDebugQueueSync ()			const	{ EXLOCK( _drCheck );  return _dbgQueueSync; }
+		ND_ bool					IsSplitBarriersEnabled ()	const	{ EXLOCK( _drCheck );  return _splitBarriers; }
 
 
 	private:
@@ -210,8 +229,8 @@ namespace FG
 		template <typename T>
 		bool  _AllocStorage (size_t count, OUT const VLocalBuffer* &buf, OUT VkDeviceSize &offset, OUT T* &ptr);
 		bool  _StoreData (const void *dataPtr, BytesU dataSize, BytesU offsetAlign, OUT const VLocalBuffer* &buf, OUT VkDeviceSize &offset);
-		bool  _StorePartialData (ArrayView<uint8_t> srcData, BytesU srcOffset, OUT RawBufferID &dstBuffer, OUT BytesU &dstOffset, OUT BytesU &size);
-		bool  _StoreImageData (ArrayView<uint8_t> srcData, BytesU srcOffset, BytesU srcPitch, BytesU srcTotalSize,
+		bool  _StorePartialData (const UpdateBuffer::Region &srcData, BytesU srcOffset, OUT RawBufferID &dstBuffer, OUT BytesU &dstOffset, OUT BytesU &size);
+		bool  _StoreImageData (const UpdateImage &srcData, BytesU srcOffset, BytesU srcSize, BytesU srcPitch, BytesU srcTotalSize,
 							   OUT RawBufferID &dstBuffer, OUT BytesU &dstOffset, OUT BytesU &size);
 		
 		ND_ Task  _AddUpdateBufferTask (const UpdateBuffer &);
@@ -230,9 +249,20 @@ namespace FG
 		template <typename ID, typename Res, typename MainPool, size_t MC>
 		ND_ Res const*  _ToLocal (ID id, INOUT LocalResPool<Res,MainPool,MC> &, StringView msg);
 
-		void  _FlushLocalResourceStates (ExeOrderIndex, VBarrierManager &, Ptr<VLocalDebugger>);
+		bool  _LoadLastStates ();
+
+		template <typename Res, typename MainPool, size_t MC>
+		bool  _LoadLastStates (INOUT LocalResPool<Res,MainPool,MC> &);
+
+		template <typename Res, typename MainPool, size_t MC>
+		void  _DiscardLastStates (INOUT LocalResPool<Res,MainPool,MC> &);
+
+		ND_ bool  _FlushLocalResourceStates (ExeOrderIndex, VBarrierManager &, Ptr<VLocalDebugger>);
 		void  _ResetLocalRemaping ();
 
+		ND_ bool  _AllocTransientMemory (const VkMemoryRequirements &memReq, OUT VTransientHeap::Allocation &);
+		ND_ bool  _ReleaseTransient (const Resource_t &res);
+
 
 	// queue //
 		ND_ EQueueUsage	_GetQueueUsage ()	const	{ return EQueueUsage(0) | _batch->GetQueueType(); }
@@ -74,7 +74,9 @@ namespace FG
 		ArrayView< RectI >						_scissors;
 
 	public:
+		const RawGPipelineID					pipelineId;
 		VGraphicsPipeline const* const			pipeline;
+		VGraphicsPipeline const* const			fallbackPipeline;	// may be null
 		const _fg_hidden_::PushConstants_t		pushConstants;
 
 		const VertexInputState					vertexInput;
@@ -84,8 +86,12 @@ namespace FG
 		
 		const EPrimitive						topology;
 		const bool								primitiveRestart;
+		const bool								warmUp;
 
 		mutable VkDescriptorSets_t				descriptorSets;
+		mutable VDynamicOffsets_t				dynamicOffsets;		// sorted by descriptor set binding index
+		mutable VkPipeline						pipelineInstance	= VK_NULL_HANDLE;	// resolved before recording into secondary command buffer
+		mutable VPipelineLayout const*			pipelineLayout		= null;
 		
 
 	// methods
@@ -237,6 +243,9 @@ namespace FG
 		const _fg_hidden_::DynamicStates		dynamicStates;
 
 		mutable VkDescriptorSets_t				descriptorSets;
+		mutable VDynamicOffsets_t				dynamicOffsets;		// sorted by descriptor set binding index
+		mutable VkPipeline						pipelineInstance	= VK_NULL_HANDLE;	// resolved before recording into secondary command buffer
+		mutable VPipelineLayout const*			pipelineLayout		= null;
 
 
 	// methods
@@ -15,7 +15,11 @@ namespace FG
 	VSubmitted::VSubmitted (uint indexInPool) :
 		_indexInPool{ indexInPool },
 		_fence{ VK_NULL_HANDLE },
-		_queueType{ Default }
+		_timeline{ VK_NULL_HANDLE },
+		_timelineValue{ 0 },
+		_queueType{ Default },
+		_resMngr{ null },
+		_submitIndex{ 0 }
 	{
 	}
 	
@@ -29,6 +33,7 @@ namespace FG
 		ASSERT( not _fence );
 		ASSERT( _semaphores.empty() );
 		ASSERT( _batches.empty() );
+		ASSERT( not _resMngr );
 	}
 	
 /*
@@ -36,11 +41,16 @@ namespace FG
 	Initialize
 =================================================
 */
-	void  VSubmitted::Initialize (const VDevice &dev, EQueueType queue, ArrayView<VCmdBatchPtr> batches, ArrayView<VkSemaphore> semaphores)
+	void  VSubmitted::Initialize (const VDevice &dev, EQueueType queue, ArrayView<VCmdBatchPtr> batches, ArrayView<VkSemaphore> semaphores,
+								  VkSemaphore timeline, uint64_t timelineValue)
 	{
 		EXLOCK( _drCheck );
 
-		if ( not _fence )
+		_timeline		= timeline;
+		_timelineValue	= timelineValue;
+
+		// fence is used only if completion is not tracked by timeline semaphore
+		if ( not _timeline and not _fence )
 		{
 			VkFenceCreateInfo	info = {};
 			info.sType	= VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
@@ -48,6 +58,7 @@ namespace FG
 			VK_CALL( dev.vkCreateFence( dev.GetVkDevice(), &info, null, OUT &_fence ));
 		}
 		else
+		if ( not _timeline )
 			VK_CALL( dev.vkResetFences( dev.GetVkDevice(), 1, &_fence ));
 
 		_batches	= batches;
@@ -55,6 +66,30 @@ namespace FG
 		_queueType	= queue;
 	}
 
+/*
+=================================================
+	IsComplete
+=================================================
+*/
+	bool  VSubmitted::IsComplete (const VDevice &dev) const
+	{
+		EXLOCK( _drCheck );
+
+		#ifdef VK_KHR_timeline_semaphore
+		if ( _timeline )
+		{
+			uint64_t	value = 0;
+			VK_CHECK( dev.vkGetSemaphoreCounterValueKHR( dev.GetVkDevice(), _timeline, OUT &value ));
+			return value >= _timelineValue;
+		}
+		#endif
+
+		if ( _fence )
+			return dev.vkGetFenceStatus( dev.GetVkDevice(), _fence ) == VK_SUCCESS;
+
+		return true;
+	}
+
 /*
 =================================================
 	Release
@@ -75,6 +110,27 @@ namespace FG
 		}
 
 		_batches.clear();
+
+		// may be called twice, resource manager is notified only once
+		if ( _resMngr )
+		{
+			_resMngr->OnSubmitComplete( _submitIndex );
+			_resMngr = null;
+		}
+	}
+	
+/*
+=================================================
+	SetSubmitIndex
+=================================================
+*/
+	void  VSubmitted::SetSubmitIndex (VResourceManager &resMngr, uint submitIndex)
+	{
+		EXLOCK( _drCheck );
+		ASSERT( not _resMngr );
+
+		_resMngr		= &resMngr;
+		_submitIndex	= submitIndex;
 	}
 	
 /*
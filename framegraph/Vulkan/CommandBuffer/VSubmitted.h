@@ -28,8 +28,13 @@ namespace FG
 		const uint			_indexInPool;
 		Batches_t			_batches;
 		Semaphores_t		_semaphores;
-		VkFence				_fence;
+		VkFence				_fence;				// only for binary semaphores
+		VkSemaphore			_timeline;			// timeline semaphore of the queue, batches are complete when it reaches '_timelineValue'
+		uint64_t			_timelineValue;
 		EQueueType			_queueType;
+		
+		VResourceManager *	_resMngr;			// notified when batches are complete
+		uint				_submitIndex;
 
 		DataRaceCheck		_drCheck;
 
@@ -40,11 +45,17 @@ namespace FG
 		~VSubmitted ();
 
 		// called by VFrameGraph
-		void  Initialize (const VDevice &, EQueueType queue, ArrayView<VCmdBatchPtr>, ArrayView<VkSemaphore>);
+		void  Initialize (const VDevice &, EQueueType queue, ArrayView<VCmdBatchPtr>, ArrayView<VkSemaphore>,
+						  VkSemaphore timeline = VK_NULL_HANDLE, uint64_t timelineValue = 0);
 		void  Release (const VDevice &, VDebugger &, const IFrameGraph::ShaderDebugCallback_t &, INOUT Statistic_t &);
 		void  Destroy (const VDevice &);
+		void  SetSubmitIndex (VResourceManager &, uint submitIndex);
+
+		ND_ bool		IsComplete (const VDevice &) const;
 
 		ND_ VkFence		GetFence ()			const	{ EXLOCK( _drCheck );  return _fence; }
+		ND_ VkSemaphore	GetTimeline ()		const	{ EXLOCK( _drCheck );  return _timeline; }
+		ND_ uint64_t	GetTimelineValue ()	const	{ EXLOCK( _drCheck );  return _timelineValue; }
 		ND_ EQueueType	GetQueueType ()		const	{ EXLOCK( _drCheck );  return _queueType; }
 		ND_ uint		GetIndexInPool ()	const	{ return _indexInPool; }
 	};
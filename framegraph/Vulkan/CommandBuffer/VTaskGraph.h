@@ -5,6 +5,7 @@
 #include "framegraph/Public/FrameGraph.h"
 #include "framegraph/Shared/EnumUtils.h"
 #include "VCommon.h"
+#include "VTaskSchedule.h"
 
 namespace FG
 {
@@ -13,6 +14,36 @@ namespace FG
 	class VFgTask;
 
 
+	// tasks that only add resource states before recording commands,
+	// they can be recorded together with other independent tasks under a single pipeline barrier
+	template <typename T>
+	static constexpr bool	IsBatchableTask	=	IsSameTypes< T, DispatchCompute >			or
+												IsSameTypes< T, DispatchComputeIndirect >	or
+												IsSameTypes< T, CopyBuffer >				or
+												IsSameTypes< T, CopyImage >					or
+												IsSameTypes< T, CopyBufferToImage >			or
+												IsSameTypes< T, CopyImageToBuffer >			or
+												IsSameTypes< T, BlitImage >					or
+												IsSameTypes< T, ResolveImage >				or
+												IsSameTypes< T, FillBuffer >				or
+												IsSameTypes< T, ClearColorImage >			or
+												IsSameTypes< T, ClearDepthStencilImage >	or
+												IsSameTypes< T, UpdateBuffer >;
+
+
+	//
+	// Aliasing Fence
+	//
+	// Internal task that is added by command buffer when memory of released transient resource is reused,
+	// all tasks that were added before the fence are executed before all tasks that were added after it.
+	//
+	struct AliasingFence final : _fg_hidden_::BaseTask<AliasingFence>
+	{
+		AliasingFence () :
+			BaseTask<AliasingFence>{ "AliasingFence", HtmlColor::DarkGray } {}
+	};
+
+
 
 	//
 	// Task interface
@@ -22,7 +53,7 @@ namespace FG
 	{
 	// types
 	protected:
-		using Dependencies_t	= FixedArray< VTask, FG_MaxTaskDependencies >;
+		using Dependencies_t	= FixedArray< VTask, FG_MaxTaskDependencies + 1 >;		// +1 for aliasing fence
 		using Name_t			= SubmitRenderPass::TaskName_t;
 		using ProcessFunc_t		= void (*) (void *visitor, const void *taskData);
 
@@ -34,8 +65,10 @@ namespace FG
 		Dependencies_t		_outputs;
 		Name_t				_taskName;
 		RGBA8u				_debugColor;
-		uint				_visitorID		= 0;
+		uint				_pendingInputs	= 0;		// number of unprocessed input nodes, used by scheduler
 		ExeOrderIndex		_exeOrderIdx	= ExeOrderIndex::Initial;
+		uint				_index			= UMax;		// in order of 'VTaskGraph::Add' calls
+		bool				_isBatchable	= false;
 
 
 	// methods
@@ -47,7 +80,8 @@ namespace FG
 		explicit VFrameGraphTask (const _fg_hidden_::BaseTask<T> &task, ProcessFunc_t process) :
 			_processFunc{ process },
 			_taskName{ task.taskName },
-			_debugColor{ task.debugColor }
+			_debugColor{ task.debugColor },
+			_isBatchable{ IsBatchableTask<T> }
 		{
 			_inputs.resize( task.depends.size() );
 
@@ -67,15 +101,20 @@ namespace FG
 	public:
 		ND_ StringView			Name ()				const	{ return _taskName; }
 		ND_ RGBA8u				DebugColor ()		const	{ return _debugColor; }
-		ND_ uint				VisitorID ()		const	{ return _visitorID; }
+		ND_ uint				PendingInputs ()	const	{ return _pendingInputs; }
 		ND_ ExeOrderIndex		ExecutionOrder ()	const	{ return _exeOrderIdx; }
+		ND_ uint				Index ()			const	{ return _index; }
+		ND_ bool				IsBatchable ()		const	{ return _isBatchable; }
 
 		ND_ ArrayView< VTask >	Inputs ()			const	{ return _inputs; }
 		ND_ ArrayView< VTask >	Outputs ()			const	{ return _outputs; }
 
 			void Attach (VTask output)						{ _outputs.push_back( output ); }
-			void SetVisitorID (uint id)						{ _visitorID = id; }
+			void AddInput (VTask input)						{ _inputs.push_back( input ); }
+			void ResetPendingInputs ()						{ _pendingInputs = uint(_inputs.size()); }
+		ND_ bool OnInputProcessed ()						{ ASSERT( _pendingInputs > 0 );  return --_pendingInputs == 0; }
 			void SetExecutionOrder (ExeOrderIndex idx)		{ _exeOrderIdx = idx; }
+			void SetIndex (uint idx)						{ _index = idx; }
 
 			void Process (void *visitor)			const	{ ASSERT( _processFunc );  _processFunc( visitor, this ); }
 	};
@@ -707,6 +746,22 @@ namespace FG
 		ND_ Images_t	GetImages ()	const	{ return _images; }
 		ND_ Buffers_t	GetBuffers ()	const	{ return _buffers; }
 	};
+
+
+
+	//
+	// Aliasing Fence
+	//
+	template <>
+	class VFgTask< AliasingFence > final : public VFrameGraphTask
+	{
+	// methods
+	public:
+		VFgTask (VCommandBuffer &, const AliasingFence &task, ProcessFunc_t process) :
+			VFrameGraphTask{ task, process } {}
+
+		ND_ bool  IsValid () const	{ return true; }
+	};
 	
 
 
@@ -728,6 +783,10 @@ namespace FG
 	private:
 		InPlace<SearchableNodes_t>	_nodes;
 		InPlace<Entries_t>			_entries;
+		InPlace<Entries_t>			_ordered;		// all nodes in order of 'Add' calls
+		HashVal						_hash;			// hash of tasks types, dependencies and resources
+		VTask						_fence;			// the last aliasing fence, all new tasks must depend on it
+		uint						_fenceIndex;	// index of the last fence that was added by 'AddFence', all previous tasks have outputs
 
 
 	// methods
@@ -738,15 +797,29 @@ namespace FG
 		template <typename T>
 		ND_ VFgTask<T>*  Add (VCommandBuffer &cb, const T &task);
 
+		void AddFence (VCommandBuffer &cb);
+
 		void OnStart (Allocator_t &);
 		void OnDiscardMemory ();
 
+		template <typename FnT>
+		ND_ bool  Visit (Allocator_t &alloc, FnT &&fn) const;
+
+		template <typename TryAddFn, typename FlushFn>
+		ND_ bool  VisitBatches (Allocator_t &alloc, TryAddFn &&tryAdd, FlushFn &&flush) const;
+
+		template <typename FlushFn>
+		ND_ bool  Replay (Allocator_t &alloc, const VTaskSchedule &schedule, FlushFn &&flush) const;
+
 		ND_ ArrayView<VTask>	Entries ()		const	{ return *_entries; }
 		ND_ size_t				Count ()		const	{ return _nodes->size(); }
 		ND_ bool				Empty ()		const	{ return _nodes->empty(); }
+		ND_ HashVal				Hash ()			const	{ return _hash; }
 
 
 	private:
+		void _AddFenceDependency (VCommandBuffer &cb, VFrameGraphTask &task);
+
 		template <typename T>
 		static void _Visitor (void *p, const void *task)
 		{
@@ -755,6 +828,193 @@ namespace FG
 	};
 
 
+	//
+	// Visit Tasks In Topological Order
+	//
+	// Kahn's algorithm: every node is visited exactly once and only after all of its inputs,
+	// each edge is processed once, so complexity is O(nodes + edges).
+	// Requires pending input counters to be initialized by 'ResetPendingInputs()'.
+	//
+	template <typename FnT>
+	ND_ inline bool  VisitTasksInOrder (ArrayView<VTask> entries, size_t count, LinearAllocator<> &alloc, FnT &&fn)
+	{
+		using ReadyQueue_t = std::vector< VTask, StdLinearAllocator<VTask> >;
+
+		// each node is pushed exactly once, so queue never reallocates
+		ReadyQueue_t	ready{ alloc };
+		ready.reserve( count );
+		ready.assign( entries.begin(), entries.end() );
+
+		for (size_t i = 0; i < ready.size(); ++i)
+		{
+			VTask	node = ready[i];
+
+			fn( node );
+
+			for (auto out_node : node->Outputs())
+			{
+				if ( out_node->OnInputProcessed() )
+					ready.push_back( out_node );
+			}
+		}
+
+		// all nodes must be reachable from entries
+		CHECK_ERR( ready.size() == count );
+		return true;
+	}
+
+
+	//
+	// Visit Task Batches In Topological Order
+	//
+	// Same as 'VisitTasksInOrder', but ready tasks are grouped into batches.
+	// 'tryAdd(node)' returns 'true' if node was added to the current batch, it must accept the first node of the batch.
+	// 'flush(batch)' is called when all ready tasks were checked, outputs of the batch are released after that,
+	// so tasks in the batch never depend on each other. Rejected tasks keep their order and are checked in the next batch.
+	// Ready tasks are stored in a single queue, only 'window' tasks from the front are checked per batch,
+	// rejected tasks are moved back to the front of the queue and released outputs are appended to the end.
+	// Each batch contains at least one task, so complexity is O(nodes * window + edges).
+	//
+	template <typename TryAddFn, typename FlushFn>
+	ND_ inline bool  VisitTaskBatchesInOrder (ArrayView<VTask> entries, size_t count, size_t window, LinearAllocator<> &alloc,
+											  TryAddFn &&tryAdd, FlushFn &&flush)
+	{
+		using Tasks_t = std::vector< VTask, StdLinearAllocator<VTask> >;
+
+		ASSERT( window > 0 );
+
+		// each node is pushed exactly once, so queue never reallocates
+		Tasks_t		ready	{ alloc };
+		Tasks_t		batch	{ alloc };
+		size_t		first	= 0;
+
+		ready.reserve( count );
+		batch.reserve( Min( count, window ));
+		ready.assign( entries.begin(), entries.end() );
+
+		while ( first < ready.size() )
+		{
+			const size_t	last = first + Min( ready.size() - first, window );
+
+			for (size_t i = first; i < last; ++i)
+			{
+				if ( tryAdd( ready[i] ))
+					batch.push_back( ready[i] );
+			}
+			CHECK_ERR( batch.size() );
+
+			flush( ArrayView<VTask>{ batch });
+
+			// move rejected tasks to the end of checked range, accepted tasks are in the same order in 'batch'
+			size_t	dst = last;
+			size_t	j	= batch.size();
+
+			for (size_t i = last; i > first; --i)
+			{
+				if ( j > 0 and batch[j-1] == ready[i-1] )
+					--j;
+				else
+					ready[--dst] = ready[i-1];
+			}
+			ASSERT( j == 0 );
+			first = dst;
+
+			for (auto node : batch)
+			{
+				for (auto out_node : node->Outputs())
+				{
+					if ( out_node->OnInputProcessed() )
+						ready.push_back( out_node );
+				}
+			}
+			batch.clear();
+		}
+
+		// all nodes must be reachable from entries
+		CHECK_ERR( ready.size() == count );
+		return true;
+	}
+
+
+	//
+	// Replay Task Schedule
+	//
+	// Visits batches in order that was recorded by 'VisitTasksInOrder' or 'VisitTaskBatchesInOrder'.
+	// 'nodes' must be in order of task indices. Schedule is validated before the first 'flush(batch)' call:
+	// every node must be visited once and after all of its inputs, otherwise returns 'false' and nothing is visited.
+	// Pending input counters are not used. Complexity is O(nodes + edges).
+	//
+	template <typename FlushFn>
+	ND_ inline bool  ReplayTaskSchedule (ArrayView<VTask> nodes, const VTaskSchedule &schedule, LinearAllocator<> &alloc, FlushFn &&flush)
+	{
+		using Tasks_t	= std::vector< VTask, StdLinearAllocator<VTask> >;
+		using Indices_t	= std::vector< uint, StdLinearAllocator<uint> >;
+
+		if ( schedule.order.size() != nodes.size() )
+			return false;
+
+		Tasks_t		tasks		{ alloc };
+		Indices_t	batch_idx	{ alloc };		// index of batch where node is visited
+
+		tasks.reserve( nodes.size() );
+		batch_idx.resize( nodes.size(), UMax );
+
+		size_t	pos = 0;
+		for (size_t b = 0; b < schedule.batches.size(); ++b)
+		{
+			const size_t	end = pos + schedule.batches[b];
+
+			if ( schedule.batches[b] == 0 or end > schedule.order.size() )
+				return false;
+
+			for (; pos < end; ++pos)
+			{
+				const uint	idx = schedule.order[pos];
+
+				if ( idx >= nodes.size() or batch_idx[idx] != UMax )
+					return false;
+
+				VTask	node = nodes[idx];
+				ASSERT( node->Index() == idx );
+
+				for (auto in_node : node->Inputs())
+				{
+					// input must be visited in one of the previous batches
+					if ( in_node->Index() >= nodes.size() or batch_idx[in_node->Index()] >= b )
+						return false;
+				}
+
+				batch_idx[idx] = uint(b);
+				tasks.push_back( node );
+			}
+		}
+
+		if ( pos != nodes.size() )
+			return false;
+
+		pos = 0;
+		for (auto size : schedule.batches)
+		{
+			flush( ArrayView<VTask>{ tasks.data() + pos, size });
+			pos += size;
+		}
+		return true;
+	}
+
+
+	//
+	// Hash Combine
+	//
+	// 'HashVal::operator <<' doesn't depend on order of values, but task graph hash must depend on it.
+	//
+	ND_ forceinline HashVal  HashCombine (HashVal seed, HashVal value)
+	{
+		const size_t	s = size_t(seed);
+		return HashVal{ s ^ (size_t(value) + size_t(0x9e3779b97f4a7c15ull) + (s << 6) + (s >> 2)) };
+	}
+
+
+
 	/*
 	//
 	// Render Pass Graph
@@ -785,8 +1045,49 @@ namespace FG
 		_nodes.Create( alloc );
 		_entries.Create( alloc );
 		_entries->reserve( 64 );
+		_ordered.Create( alloc );
+		_ordered->reserve( 64 );
+		_hash = HashVal{};
+		_fence = null;
+		_fenceIndex = 0;
+	}
+	
+/*
+=================================================
+	Visit
+=================================================
+*/
+	template <typename VisitorT>
+	template <typename FnT>
+	inline bool  VTaskGraph<VisitorT>::Visit (Allocator_t &alloc, FnT &&fn) const
+	{
+		return VisitTasksInOrder( Entries(), Count(), alloc, std::forward<FnT>(fn) );
+	}
+	
+/*
+=================================================
+	VisitBatches
+=================================================
+*/
+	template <typename VisitorT>
+	template <typename TryAddFn, typename FlushFn>
+	inline bool  VTaskGraph<VisitorT>::VisitBatches (Allocator_t &alloc, TryAddFn &&tryAdd, FlushFn &&flush) const
+	{
+		return VisitTaskBatchesInOrder( Entries(), Count(), FG_TaskReorderWindow, alloc, std::forward<TryAddFn>(tryAdd), std::forward<FlushFn>(flush) );
 	}
 	
+/*
+=================================================
+	Replay
+=================================================
+*/
+	template <typename VisitorT>
+	template <typename FlushFn>
+	inline bool  VTaskGraph<VisitorT>::Replay (Allocator_t &alloc, const VTaskSchedule &schedule, FlushFn &&flush) const
+	{
+		return ReplayTaskSchedule( *_ordered, schedule, alloc, std::forward<FlushFn>(flush) );
+	}
+
 /*
 =================================================
 	OnDiscardMemory
@@ -797,6 +1098,7 @@ namespace FG
 	{
 		_nodes.Destroy();
 		_entries.Destroy();
+		_ordered.Destroy();
 	}
 
 
@@ -8,9 +8,100 @@
 namespace FG
 {
 
+/*
+=================================================
+	HashOfTaskResources
+----
+	tasks are batched depending on resources that they use,
+	so resources of batchable tasks are part of the task graph hash.
+	Other tasks are always executed alone.
+=================================================
+*/
+	template <typename T>
+	ND_ inline HashVal  HashOfTaskResources (const VFgTask<T> &)
+	{
+		STATIC_ASSERT( not IsBatchableTask<T> );
+		return HashVal{};
+	}
+
+	ND_ inline HashVal  HashOfTaskResources (const VPipelineResourceSet &resources)
+	{
+		HashVal	result;
+		for (auto& res : resources.resources) {
+			result = HashCombine( result, HashOf( res.pplnRes ));
+		}
+		return result;
+	}
+
+	ND_ inline HashVal  HashOfTaskResources (const VFgTask<DispatchCompute> &task)
+	{
+		return HashCombine( HashOf( task.pipeline ), HashOfTaskResources( task.GetResources() ));
+	}
+
+	ND_ inline HashVal  HashOfTaskResources (const VFgTask<DispatchComputeIndirect> &task)
+	{
+		return HashCombine( HashCombine( HashOf( task.pipeline ), HashOfTaskResources( task.GetResources() )), HashOf( task.indirectBuffer->ToGlobal() ));
+	}
+
+	ND_ inline HashVal  HashOfTaskResources (const VFgTask<CopyBuffer> &task)
+	{
+		return HashCombine( HashOf( task.srcBuffer->ToGlobal() ), HashOf( task.dstBuffer->ToGlobal() ));
+	}
+
+	ND_ inline HashVal  HashOfTaskResources (const VFgTask<CopyImage> &task)
+	{
+		return HashCombine( HashCombine( HashOf( task.srcImage->ToGlobal() ), HashOf( task.srcLayout )),
+							HashCombine( HashOf( task.dstImage->ToGlobal() ), HashOf( task.dstLayout )));
+	}
+
+	ND_ inline HashVal  HashOfTaskResources (const VFgTask<CopyBufferToImage> &task)
+	{
+		return HashCombine( HashOf( task.srcBuffer->ToGlobal() ), HashCombine( HashOf( task.dstImage->ToGlobal() ), HashOf( task.dstLayout )));
+	}
+
+	ND_ inline HashVal  HashOfTaskResources (const VFgTask<CopyImageToBuffer> &task)
+	{
+		return HashCombine( HashCombine( HashOf( task.srcImage->ToGlobal() ), HashOf( task.srcLayout )), HashOf( task.dstBuffer->ToGlobal() ));
+	}
+
+	ND_ inline HashVal  HashOfTaskResources (const VFgTask<BlitImage> &task)
+	{
+		return HashCombine( HashCombine( HashOf( task.srcImage->ToGlobal() ), HashOf( task.srcLayout )),
+							HashCombine( HashOf( task.dstImage->ToGlobal() ), HashOf( task.dstLayout )));
+	}
+
+	ND_ inline HashVal  HashOfTaskResources (const VFgTask<ResolveImage> &task)
+	{
+		return HashCombine( HashCombine( HashOf( task.srcImage->ToGlobal() ), HashOf( task.srcLayout )),
+							HashCombine( HashOf( task.dstImage->ToGlobal() ), HashOf( task.dstLayout )));
+	}
+
+	ND_ inline HashVal  HashOfTaskResources (const VFgTask<FillBuffer> &task)
+	{
+		return HashOf( task.dstBuffer->ToGlobal() );
+	}
+
+	ND_ inline HashVal  HashOfTaskResources (const VFgTask<ClearColorImage> &task)
+	{
+		return HashCombine( HashOf( task.dstImage->ToGlobal() ), HashOf( task.dstLayout ));
+	}
+
+	ND_ inline HashVal  HashOfTaskResources (const VFgTask<ClearDepthStencilImage> &task)
+	{
+		return HashCombine( HashOf( task.dstImage->ToGlobal() ), HashOf( task.dstLayout ));
+	}
+
+	ND_ inline HashVal  HashOfTaskResources (const VFgTask<UpdateBuffer> &task)
+	{
+		return HashOf( task.dstBuffer->ToGlobal() );
+	}
+
 /*
 =================================================
 	Add
+----
+	task graph hash depends on task types, dependencies and resources of batchable tasks,
+	task order is the same for graphs with the same hash, see 'VTaskSchedule'.
 =================================================
 */
 	template <typename VisitorT>
@@ -22,7 +113,17 @@ namespace FG
 		PlacementNew< VFgTask<T> >( OUT ptr, cb, task, &_Visitor<T> );
 		CHECK_ERR( ptr->IsValid() );
 
+		if constexpr( not IsSameTypes< T, AliasingFence >)
+			_AddFenceDependency( cb, *ptr );
+
 		_nodes->insert( ptr );
+		ptr->ResetPendingInputs();
+		ptr->SetIndex( uint(_ordered->size()) );
+		_ordered->push_back( ptr );
+
+		_hash = HashCombine( _hash, HashOf( &_Visitor<T> ));
+		_hash = HashCombine( _hash, HashOfTaskResources( *ptr ));
+		_hash = HashCombine( _hash, HashOf( ptr->Inputs().size() ));
 
 		if ( ptr->Inputs().empty() )
 			_entries->push_back( ptr );
@@ -32,9 +133,82 @@ namespace FG
 			ASSERT( !!_nodes->count( in_node ));
 
 			in_node->Attach( ptr );
+			_hash = HashCombine( _hash, HashOf( in_node->Index() ));
 		}
 		return ptr;
 	}
+
+/*
+=================================================
+	AddFence
+----
+	new fence depends on all tasks that have no outputs,
+	tasks that were added before the previous fence already have outputs, so they are skipped.
+	If there are too many tasks then fences are chained.
+=================================================
+*/
+	template <typename VisitorT>
+	inline void  VTaskGraph<VisitorT>::AddFence (VCommandBuffer &cb)
+	{
+		const size_t	first	= _fenceIndex;
+		const size_t	count	= _ordered->size();
+
+		// no tasks after the previous fence
+		if ( _fence and _fence->Index()+1 == count )
+			return;
+
+		AliasingFence	fence;
+
+		for (size_t i = first; i < count; ++i)
+		{
+			VTask	node = (*_ordered)[i];
+
+			if ( not node->Outputs().empty() )
+				continue;
+
+			if ( fence.depends.size() == fence.depends.capacity() )
+			{
+				Task	prev = Add( cb, fence );
+				fence.depends.clear();
+				fence.depends.push_back( prev );
+			}
+			fence.depends.push_back( node.get() );
+		}
+
+		_fence		= Add( cb, fence );
+		_fenceIndex	= _fence->Index();
+	}
+
+/*
+=================================================
+	_AddFenceDependency
+----
+	task must be executed after the last fence,
+	if one of the inputs was added after the fence then this dependency already exists.
+=================================================
+*/
+	template <typename VisitorT>
+	inline void  VTaskGraph<VisitorT>::_AddFenceDependency (VCommandBuffer &cb, VFrameGraphTask &task)
+	{
+		if ( not _fence )
+			return;
+
+		for (auto in_node : task.Inputs())
+		{
+			if ( in_node->Index() >= _fence->Index() )
+				return;
+		}
+
+		// the last output is reserved for the next fence
+		if ( _fence->Outputs().size()+1 == FG_MaxTaskDependencies )
+		{
+			AliasingFence	fence;
+			fence.depends.push_back( _fence.get() );
+			_fence = Add( cb, fence );
+		}
+
+		task.AddInput( _fence );
+	}
 //-----------------------------------------------------------------------------
 
 	
@@ -154,10 +328,12 @@ namespace FG
 	template <typename TaskType>
 	VBaseDrawVerticesTask::VBaseDrawVerticesTask (VLogicalRenderPass &rp, VCommandBuffer &cb, const TaskType &task, ProcessFunc_t pass1, ProcessFunc_t pass2) :
 		IDrawTask{ task, pass1, pass2 },				_vbCount{ uint(task.vertexBuffers.size()) },
-		pipeline{ cb.AcquireTemporary( task.pipeline )},
+		pipelineId{ task.pipeline },					pipeline{ cb.AcquireTemporary( task.pipeline )},
+		fallbackPipeline{ task.fallbackPipeline ? cb.AcquireTemporary( task.fallbackPipeline ) : null },
 		pushConstants{ task.pushConstants },			vertexInput{ task.vertexInput },
 		colorBuffers{ task.colorBuffers },				dynamicStates{ task.dynamicStates },
-		topology{ task.topology },						primitiveRestart{ task.primitiveRestart }
+		topology{ task.topology },						primitiveRestart{ task.primitiveRestart },
+		warmUp{ task.warmUp }
 	{
 		CopyScissors( cb, task.scissors, OUT _scissors );
 		CopyDescriptorSets( &rp, cb, task.resources, OUT _resources );
@@ -689,11 +865,14 @@ namespace FG
 		{
 			auto&	src = task.regions[i];
 
-			dst[i].dataPtr		= cb.GetAllocator().Alloc( ArraySizeOf(src.data), AlignOf<uint8_t> );
-			dst[i].dataSize		= VkDeviceSize(ArraySizeOf(src.data));
+			dst[i].dataPtr		= cb.GetAllocator().Alloc( src.Size(), AlignOf<uint8_t> );
+			dst[i].dataSize		= VkDeviceSize(src.Size());
 			dst[i].bufferOffset	= VkDeviceSize(src.offset);
 
-			std::memcpy( dst[i].dataPtr, src.data.data(), size_t(dst[i].dataSize) );
+			if ( src.writer )
+				src.writer( dst[i].dataPtr, 0_b, src.Size() );
+			else
+				std::memcpy( dst[i].dataPtr, src.data.data(), size_t(dst[i].dataSize) );
 		}
 
 		_regions = ArrayView{ dst, cnt };
@@ -30,9 +30,22 @@ namespace FG
 		return static_cast<ResType const*>(res)->CommitBarrier( barrierMngr, debugger );
 	}
 
-	inline VTaskProcessor::Statistic_t&  VTaskProcessor::Stat () const
+	VTaskProcessor::Statistic_t&  VTaskProcessor::Stat () const
 	{
-		return _fgThread.EditStatistic().renderer;
+		return _stat;
+	}
+
+	ND_ inline ImageDataRange::RegionU  ToImageRegion (const VkOffset3D &offset, const VkExtent3D &extent)
+	{
+		const uint3	begin { uint(offset.x), uint(offset.y), uint(offset.z) };
+		return ImageDataRange::RegionU{ begin, begin + uint3{ extent.width, extent.height, extent.depth }};
+	}
+
+	ND_ inline ImageDataRange::RegionU  ToImageRegion (const VkOffset3D &offset0, const VkOffset3D &offset1)
+	{
+		const int3	a { offset0.x, offset0.y, offset0.z };
+		const int3	b { offset1.x, offset1.y, offset1.z };
+		return ImageDataRange::RegionU{ uint3(Min( a, b )), uint3(Max( a, b )) };
 	}
 
 	inline uint64_t  CalcPrimitiveCount (uint vertCount, EPrimitive topology, uint patchSize)
@@ -57,6 +70,74 @@ namespace FG
 		END_ENUM_CHECKS();
 		return 0;
 	}
+	
+	inline void  ValidateUniformBuffer (const VDevice &dev, const PipelineResources::Buffer &buf, const VLocalBuffer &buffer, VkDeviceSize offset, VkDeviceSize size)
+	{
+		ASSERT( (size >= buf.staticSize) and (buf.arrayStride == 0 or (size - buf.staticSize) % buf.arrayStride == 0) );
+		ASSERT( offset < buffer.Size() );
+		ASSERT( offset + size <= buffer.Size() );
+
+		auto&	limits	= dev.GetDeviceLimits();
+		Unused( limits, buf, buffer, offset, size );
+
+		if ( (buf.state & EResourceState::_StateMask) == EResourceState::UniformRead )
+		{
+			ASSERT( size == buf.staticSize );
+			ASSERT( (offset % limits.minUniformBufferOffsetAlignment) == 0 );
+			ASSERT( size <= limits.maxUniformBufferRange );
+		}else{
+			ASSERT( (offset % limits.minStorageBufferOffsetAlignment) == 0 );
+			ASSERT( size <= limits.maxStorageBufferRange );
+		}
+	}
+	
+/*
+=================================================
+	ExtractDescriptorSets
+----
+	copy descriptor set handles in binding order, copy dynamic offsets sorted by binding index
+	and pass resources to barrier visitor.
+	'resourceSet' is not modified, so it is safe to call it many times for the same task.
+=================================================
+*/
+	template <typename BarrierVisitor>
+	static void  ExtractDescriptorSets (const VPipelineLayout &layout, const VPipelineResourceSet &resourceSet, BarrierVisitor &barrierVisitor,
+										OUT VkDescriptorSets_t &descriptorSets, OUT VDynamicOffsets_t &dynamicOffsets)
+	{
+		StaticArray< Pair<uint, uint>, FG_MaxDescriptorSets >	new_offsets = {};
+		const uint												first_ds	= layout.GetFirstDescriptorSet();
+
+		descriptorSets.resize( resourceSet.resources.size() );
+
+		for (size_t i = 0; i < resourceSet.resources.size(); ++i)
+		{
+			const auto &				res		 = resourceSet.resources[i];
+			uint						binding	 = 0;
+			RawDescriptorSetLayoutID	ds_layout;
+
+			if ( not layout.GetDescriptorSetLayout( res.descSetId, OUT ds_layout, OUT binding ))
+				continue;
+
+			res.pplnRes->ForEachUniform( barrierVisitor );
+
+			ASSERT( ds_layout == res.pplnRes->GetLayoutID() );
+			ASSERT( binding >= first_ds );
+			binding -= first_ds;
+
+			descriptorSets[binding] = res.pplnRes->Handle();
+			new_offsets[binding]    = { res.offsetIndex, res.offsetCount };
+		}
+
+		// sort dynamic offsets by binding index
+		dynamicOffsets.clear();
+		for (auto& item : new_offsets)
+		{
+			for (uint i = item.first; i < item.second; ++i)
+			{
+				dynamicOffsets.push_back( resourceSet.dynamicOffsets[i] );
+			}
+		}
+	}
 //-----------------------------------------------------------------------------
 
 
@@ -92,31 +173,16 @@ namespace FG
 	//
 	class VTaskProcessor::DrawTaskBarriers final
 	{
-	// types
-	private:
-		using FragmentOutput	= GraphicsPipelineDesc::FragmentOutput;
-		using FragOutputs_t		= StaticArray< FragmentOutput, FG_MaxColorBuffers >;
-
-
 	// variables
 	private:
-		VTaskProcessor &			_tp;
-		VLogicalRenderPass const&	_logicalRP;
-
-		FragOutputs_t				_fragOutput;
-		uint						_maxFragCount;
-
-		bool						_earlyFragmentTests		: 1;
-		bool						_lateFragmentTests		: 1;
-		bool						_depthWrite				: 1;
-		bool						_stencilWrite			: 1;
-		bool						_rasterizerDiscard		: 1;
-		bool						_compatibleFragOutput	: 1;
+		VCommandBuffer &			_fgThread;
+		VLogicalRenderPass &		_logicalRP;
+		ArrayView<uint>				_dynamicOffsets;
 
 
 	// methods
 	public:
-		DrawTaskBarriers (VTaskProcessor &tp, const VLogicalRenderPass &);
+		DrawTaskBarriers (VCommandBuffer &fgThread, VLogicalRenderPass &logicalRP) : _fgThread{fgThread}, _logicalRP{logicalRP} {}
 
 		void  Visit (const VFgDrawTask<FG::DrawVertices> &task);
 		void  Visit (const VFgDrawTask<FG::DrawIndexed> &task);
@@ -128,21 +194,21 @@ namespace FG
 		void  Visit (const VFgDrawTask<FG::DrawIndexedIndirectCount> &task);
 		void  Visit (const VFgDrawTask<FG::DrawMeshesIndirectCount> &task);
 		void  Visit (const VFgDrawTask<FG::CustomDraw> &task);
+		
+		// ResourceGraph //
+		void  operator () (const UniformID &, const PipelineResources::Buffer &buf);
+		void  operator () (const UniformID &, const PipelineResources::TexelBuffer &texbuf);
+		void  operator () (const UniformID &, const PipelineResources::Image &img);
+		void  operator () (const UniformID &, const PipelineResources::Texture &tex);
+		void  operator () (const UniformID &, const PipelineResources::Sampler &) {}
+		void  operator () (const UniformID &, const PipelineResources::RayTracingScene &);
 
+	private:
 		template <typename PipelineType>
 		void  _MergePipeline (const _fg_hidden_::DynamicStates &, const PipelineType *);
 		
 		template <typename DrawTask>
 		void  _ExtractDescriptorSets (RawPipelineLayoutID layoutId, const DrawTask &task);
-
-		ND_ bool						IsEarlyFragmentTests ()			const	{ return _earlyFragmentTests; }
-		ND_ bool						IsLateFragmentTests ()			const	{ return _lateFragmentTests; }
-		ND_ bool						IsFragmentOutputCompatible ()	const	{ return _compatibleFragOutput; }
-		ND_ bool						HasDepthWriteAccess ()			const	{ return _depthWrite; }
-		ND_ bool						HasStencilWriteAccess ()		const	{ return _stencilWrite; }
-		ND_ bool						IsRasterizerDiscard ()			const	{ return _rasterizerDiscard; }
-
-		ND_ ArrayView<FragmentOutput>	GetFragOutputs ()				const	{ return ArrayView<FragmentOutput>{ _fragOutput.data(), _maxFragCount }; }
 	};
 
 
@@ -157,11 +223,12 @@ namespace FG
 		VTaskProcessor &					_tp;
 		VFgTask<SubmitRenderPass> const*	_currTask;
 		VkCommandBuffer						_cmdBuffer;
+		const bool							_resolvePipelinesOnly;	// create pipelines before parallel recording, commands are not recorded
 
 
 	// methods
 	public:
-		DrawTaskCommands (VTaskProcessor &tp, VFgTask<SubmitRenderPass> const* task, VkCommandBuffer cmd);
+		DrawTaskCommands (VTaskProcessor &tp, VFgTask<SubmitRenderPass> const* task, VkCommandBuffer cmd, bool resolvePipelinesOnly = false);
 
 		void  Visit (const VFgDrawTask<FG::DrawVertices> &task);
 		void  Visit (const VFgDrawTask<FG::DrawIndexed> &task);
@@ -176,6 +243,9 @@ namespace FG
 
 	private:
 		void  _BindVertexBuffers (ArrayView<VLocalBuffer const*> vertexBuffers, ArrayView<VkDeviceSize> vertexOffsets) const;
+		
+		template <typename DrawTask>
+		ND_ bool  _BindPipeline (const DrawTask &task, OUT VPipelineLayout const* &layout) const;
 
 		template <typename DrawTask>
 		void  _BindPipelineResources (const VPipelineLayout &layout, const DrawTask &task) const;
@@ -292,25 +362,7 @@ namespace FG
 			const VkDeviceSize	offset	= VkDeviceSize(elem.offset) + (buf.dynamicOffsetIndex < _dynamicOffsets.size() ? _dynamicOffsets[buf.dynamicOffsetIndex] : 0);		
 			const VkDeviceSize	size	= VkDeviceSize(elem.size == ~0_b ? (buffer->Size() - offset) : elem.size);
 
-			// validation
-			{
-				ASSERT( (size >= buf.staticSize) and (buf.arrayStride == 0 or (size - buf.staticSize) % buf.arrayStride == 0) );
-				ASSERT( offset < buffer->Size() );
-				ASSERT( offset + size <= buffer->Size() );
-
-				auto&	limits	= _tp._fgThread.GetDevice().GetDeviceLimits();
-				Unused( limits );
-
-				if ( (buf.state & EResourceState::_StateMask) == EResourceState::UniformRead )
-				{
-					ASSERT( size == buf.staticSize );
-					ASSERT( (offset % limits.minUniformBufferOffsetAlignment) == 0 );
-					ASSERT( size <= limits.maxUniformBufferRange );
-				}else{
-					ASSERT( (offset % limits.minStorageBufferOffsetAlignment) == 0 );
-					ASSERT( size <= limits.maxStorageBufferRange );
-				}
-			}
+			ValidateUniformBuffer( _tp._fgThread.GetDevice(), buf, *buffer, offset, size );
 
 			_tp._AddBuffer( buffer, buf.state, offset, size );
 		}
@@ -405,33 +457,100 @@ namespace FG
 
 /*
 =================================================
-	constructor
+	operator (Buffer)
+=================================================
+*/
+	void  VTaskProcessor::DrawTaskBarriers::operator () (const UniformID &, const PipelineResources::Buffer &buf)
+	{
+		for (uint i = 0; i < buf.elementCount; ++i)
+		{
+			auto&				elem	= buf.elements[i];
+			VLocalBuffer const*	buffer	= _fgThread.ToLocal( elem.bufferId );
+			if ( not buffer )
+				continue;
+
+			const VkDeviceSize	offset	= VkDeviceSize(elem.offset) + (buf.dynamicOffsetIndex < _dynamicOffsets.size() ? _dynamicOffsets[buf.dynamicOffsetIndex] : 0);		
+			const VkDeviceSize	size	= VkDeviceSize(elem.size == ~0_b ? (buffer->Size() - offset) : elem.size);
+			
+			ValidateUniformBuffer( _fgThread.GetDevice(), buf, *buffer, offset, size );
+
+			_logicalRP._AddDrawBuffer( buffer, buf.state, offset, size );
+		}
+	}
+
+/*
+=================================================
+	operator (TexelBuffer)
 =================================================
 */
-	VTaskProcessor::DrawTaskBarriers::DrawTaskBarriers (VTaskProcessor &tp, const VLogicalRenderPass &logicalRP) :
-		_tp{ tp },						_logicalRP{ logicalRP },
-		_maxFragCount{ 0 },
-		_earlyFragmentTests{false},		_lateFragmentTests{false},
-		_depthWrite{ _logicalRP.GetDepthState().write },
-		_stencilWrite{ false },
-		_rasterizerDiscard{ _logicalRP.GetRasterizationState().rasterizerDiscard },
-		_compatibleFragOutput{true}
+	void  VTaskProcessor::DrawTaskBarriers::operator () (const UniformID &, const PipelineResources::TexelBuffer &texbuf)
+	{
+		for (uint i = 0; i < texbuf.elementCount; ++i)
+		{
+			auto&				elem	= texbuf.elements[i];
+			VLocalBuffer const*	buffer	= _fgThread.ToLocal( elem.bufferId );
+			if ( not buffer )
+				continue;
+			
+			const VkDeviceSize	offset	= VkDeviceSize(elem.desc.offset);		
+			const VkDeviceSize	size	= VkDeviceSize(elem.desc.size == ~0_b ? (buffer->Size() - offset) : elem.desc.size);
+
+			_logicalRP._AddDrawBuffer( buffer, texbuf.state, offset, size );
+		}
+	}
+
+/*
+=================================================
+	operator (Image / Texture)
+=================================================
+*/
+	void  VTaskProcessor::DrawTaskBarriers::operator () (const UniformID &, const PipelineResources::Image &img)
+	{
+		for (uint i = 0; i < img.elementCount; ++i)
+		{
+			auto&				elem	= img.elements[i];
+			VLocalImage const*  image	= _fgThread.ToLocal( elem.imageId );
+
+			if ( image )
+				_logicalRP._AddDrawImage( image, img.state, EResourceState_ToImageLayout( img.state, image->AspectMask() ), elem.desc );
+		}
+	}
+	
+	void  VTaskProcessor::DrawTaskBarriers::operator () (const UniformID &, const PipelineResources::Texture &tex)
 	{
-		// invalidate fragment output
-		for (auto& frag : _fragOutput)
+		for (uint i = 0; i < tex.elementCount; ++i)
 		{
-			frag.index	= UMax;
-			frag.type	= EFragOutput::Unknown;
+			auto&				elem	= tex.elements[i];
+			VLocalImage const*  image	= _fgThread.ToLocal( elem.imageId );
+
+			if ( image )
+				_logicalRP._AddDrawImage( image, tex.state, EResourceState_ToImageLayout( tex.state, image->AspectMask() ), elem.desc );
 		}
+	}
 
-		auto&	stencil_st = _logicalRP.GetStencilState();
-		_stencilWrite |= not stencil_st.enabled ? 0 :
-						 (stencil_st.front.failOp		!= EStencilOp::Keep) |
-						 (stencil_st.front.depthFailOp	!= EStencilOp::Keep) |
-						 (stencil_st.front.passOp		!= EStencilOp::Keep) |
-						 (stencil_st.back.failOp		!= EStencilOp::Keep) |
-						 (stencil_st.back.depthFailOp	!= EStencilOp::Keep) |
-						 (stencil_st.back.passOp		!= EStencilOp::Keep);
+/*
+=================================================
+	operator (RayTracingScene)
+----
+	geometry instances will be added when render pass begins,
+	because scene may be rebuilded before
+=================================================
+*/
+	void  VTaskProcessor::DrawTaskBarriers::operator () (const UniformID &, const PipelineResources::RayTracingScene &rts)
+	{
+	#ifdef VK_NV_ray_tracing
+		for (uint i = 0; i < rts.elementCount; ++i)
+		{
+			VLocalRTScene const*  scene = _fgThread.ToLocal( rts.elements[i].sceneId );
+			if ( not scene )
+				return;
+
+			_logicalRP._AddDrawRTScene( scene );
+		}
+	#else
+		Unused( rts );
+		ASSERT( !"ray tracing is not supported" );
+	#endif
 	}
 
 /*
@@ -455,7 +574,7 @@ namespace FG
 				VkDeviceSize	offset	= vb_offset + stride * cmd.firstVertex;
 				VkDeviceSize	size	= stride * cmd.vertexCount;
 
-				_tp._AddBuffer( task.GetVertexBuffers()[i], EResourceState::VertexBuffer, offset, size );
+				_logicalRP._AddDrawBuffer( task.GetVertexBuffers()[i], EResourceState::VertexBuffer, offset, size );
 			}
 		}
 		
@@ -475,7 +594,7 @@ namespace FG
 		// add vertex buffers
 		for (size_t i = 0; i < task.GetVertexBuffers().size(); ++i)
 		{
-			_tp._AddBuffer( task.GetVertexBuffers()[i], EResourceState::VertexBuffer, task.GetVBOffsets()[i], VK_WHOLE_SIZE );
+			_logicalRP._AddDrawBuffer( task.GetVertexBuffers()[i], EResourceState::VertexBuffer, task.GetVBOffsets()[i], VK_WHOLE_SIZE );
 		}
 
 		// add index buffer
@@ -485,7 +604,7 @@ namespace FG
 			const VkDeviceSize	offset		= VkDeviceSize(task.indexBufferOffset);
 			const VkDeviceSize	size		= index_size * cmd.indexCount;
 
-			_tp._AddBuffer( task.indexBuffer, EResourceState::IndexBuffer, offset, size );
+			_logicalRP._AddDrawBuffer( task.indexBuffer, EResourceState::IndexBuffer, offset, size );
 		}
 		
 		_MergePipeline( task.dynamicStates, task.pipeline );
@@ -504,13 +623,13 @@ namespace FG
 		// add vertex buffers
 		for (size_t i = 0; i < task.GetVertexBuffers().size(); ++i)
 		{
-			_tp._AddBuffer( task.GetVertexBuffers()[i], EResourceState::VertexBuffer, task.GetVBOffsets()[i], VK_WHOLE_SIZE );
+			_logicalRP._AddDrawBuffer( task.GetVertexBuffers()[i], EResourceState::VertexBuffer, task.GetVBOffsets()[i], VK_WHOLE_SIZE );
 		}
 		
 		// add indirect buffer
 		for (auto& cmd : task.commands)
 		{
-			_tp._AddBuffer( task.indirectBuffer, EResourceState::IndirectBuffer, VkDeviceSize(cmd.indirectBufferOffset), VkDeviceSize(cmd.stride) * cmd.drawCount );
+			_logicalRP._AddDrawBuffer( task.indirectBuffer, EResourceState::IndirectBuffer, VkDeviceSize(cmd.indirectBufferOffset), VkDeviceSize(cmd.stride) * cmd.drawCount );
 		}
 
 		_MergePipeline( task.dynamicStates, task.pipeline );
@@ -529,16 +648,16 @@ namespace FG
 		// add vertex buffers
 		for (size_t i = 0; i < task.GetVertexBuffers().size(); ++i)
 		{
-			_tp._AddBuffer( task.GetVertexBuffers()[i], EResourceState::VertexBuffer, task.GetVBOffsets()[i], VK_WHOLE_SIZE );
+			_logicalRP._AddDrawBuffer( task.GetVertexBuffers()[i], EResourceState::VertexBuffer, task.GetVBOffsets()[i], VK_WHOLE_SIZE );
 		}
 		
 		// add index buffer
-		_tp._AddBuffer( task.indexBuffer, EResourceState::IndexBuffer, VkDeviceSize(task.indexBufferOffset), VK_WHOLE_SIZE );
+		_logicalRP._AddDrawBuffer( task.indexBuffer, EResourceState::IndexBuffer, VkDeviceSize(task.indexBufferOffset), VK_WHOLE_SIZE );
 
 		// add indirect buffer
 		for (auto& cmd : task.commands)
 		{
-			_tp._AddBuffer( task.indirectBuffer, EResourceState::IndirectBuffer, VkDeviceSize(cmd.indirectBufferOffset), VkDeviceSize(cmd.stride) * cmd.drawCount );
+			_logicalRP._AddDrawBuffer( task.indirectBuffer, EResourceState::IndirectBuffer, VkDeviceSize(cmd.indirectBufferOffset), VkDeviceSize(cmd.stride) * cmd.drawCount );
 		}
 		
 		_MergePipeline( task.dynamicStates, task.pipeline );
@@ -557,14 +676,14 @@ namespace FG
 		// add vertex buffers
 		for (size_t i = 0; i < task.GetVertexBuffers().size(); ++i)
 		{
-			_tp._AddBuffer( task.GetVertexBuffers()[i], EResourceState::VertexBuffer, task.GetVBOffsets()[i], VK_WHOLE_SIZE );
+			_logicalRP._AddDrawBuffer( task.GetVertexBuffers()[i], EResourceState::VertexBuffer, task.GetVBOffsets()[i], VK_WHOLE_SIZE );
 		}
 		
 		// add indirect buffer
 		for (auto& cmd : task.commands)
 		{
-			_tp._AddBuffer( task.indirectBuffer, EResourceState::IndirectBuffer, VkDeviceSize(cmd.indirectBufferOffset), VkDeviceSize(cmd.indirectBufferStride) * cmd.maxDrawCount );
-			_tp._AddBuffer( task.countBuffer,    EResourceState::IndirectBuffer, VkDeviceSize(cmd.countBufferOffset),    sizeof(uint) );
+			_logicalRP._AddDrawBuffer( task.indirectBuffer, EResourceState::IndirectBuffer, VkDeviceSize(cmd.indirectBufferOffset), VkDeviceSize(cmd.indirectBufferStride) * cmd.maxDrawCount );
+			_logicalRP._AddDrawBuffer( task.countBuffer,    EResourceState::IndirectBuffer, VkDeviceSize(cmd.countBufferOffset),    sizeof(uint) );
 		}
 
 		_MergePipeline( task.dynamicStates, task.pipeline );
@@ -583,17 +702,17 @@ namespace FG
 		// add vertex buffers
 		for (size_t i = 0; i < task.GetVertexBuffers().size(); ++i)
 		{
-			_tp._AddBuffer( task.GetVertexBuffers()[i], EResourceState::VertexBuffer, task.GetVBOffsets()[i], VK_WHOLE_SIZE );
+			_logicalRP._AddDrawBuffer( task.GetVertexBuffers()[i], EResourceState::VertexBuffer, task.GetVBOffsets()[i], VK_WHOLE_SIZE );
 		}
 		
 		// add index buffer
-		_tp._AddBuffer( task.indexBuffer, EResourceState::IndexBuffer, VkDeviceSize(task.indexBufferOffset), VK_WHOLE_SIZE );
+		_logicalRP._AddDrawBuffer( task.indexBuffer, EResourceState::IndexBuffer, VkDeviceSize(task.indexBufferOffset), VK_WHOLE_SIZE );
 
 		// add indirect buffer
 		for (auto& cmd : task.commands)
 		{
-			_tp._AddBuffer( task.indirectBuffer, EResourceState::IndirectBuffer, VkDeviceSize(cmd.indirectBufferOffset), VkDeviceSize(cmd.indirectBufferStride) * cmd.maxDrawCount );
-			_tp._AddBuffer( task.countBuffer,    EResourceState::IndirectBuffer, VkDeviceSize(cmd.countBufferOffset),    sizeof(uint) );
+			_logicalRP._AddDrawBuffer( task.indirectBuffer, EResourceState::IndirectBuffer, VkDeviceSize(cmd.indirectBufferOffset), VkDeviceSize(cmd.indirectBufferStride) * cmd.maxDrawCount );
+			_logicalRP._AddDrawBuffer( task.countBuffer,    EResourceState::IndirectBuffer, VkDeviceSize(cmd.countBufferOffset),    sizeof(uint) );
 		}
 		
 		_MergePipeline( task.dynamicStates, task.pipeline );
@@ -630,7 +749,7 @@ namespace FG
 		// add indirect buffer
 		for (auto& cmd : task.commands)
 		{
-			_tp._AddBuffer( task.indirectBuffer, EResourceState::IndirectBuffer, VkDeviceSize(cmd.indirectBufferOffset), VkDeviceSize(cmd.stride) * cmd.drawCount );
+			_logicalRP._AddDrawBuffer( task.indirectBuffer, EResourceState::IndirectBuffer, VkDeviceSize(cmd.indirectBufferOffset), VkDeviceSize(cmd.stride) * cmd.drawCount );
 		}
 
 		_MergePipeline( task.dynamicStates, task.pipeline );
@@ -653,8 +772,8 @@ namespace FG
 		// add indirect buffer
 		for (auto& cmd : task.commands)
 		{
-			_tp._AddBuffer( task.indirectBuffer, EResourceState::IndirectBuffer, VkDeviceSize(cmd.indirectBufferOffset), VkDeviceSize(cmd.indirectBufferStride) * cmd.maxDrawCount );
-			_tp._AddBuffer( task.countBuffer,    EResourceState::IndirectBuffer, VkDeviceSize(cmd.countBufferOffset),    sizeof(uint) );
+			_logicalRP._AddDrawBuffer( task.indirectBuffer, EResourceState::IndirectBuffer, VkDeviceSize(cmd.indirectBufferOffset), VkDeviceSize(cmd.indirectBufferStride) * cmd.maxDrawCount );
+			_logicalRP._AddDrawBuffer( task.countBuffer,    EResourceState::IndirectBuffer, VkDeviceSize(cmd.countBufferOffset),    sizeof(uint) );
 		}
 
 		_MergePipeline( task.dynamicStates, task.pipeline );
@@ -670,17 +789,17 @@ namespace FG
 */
 	inline void  VTaskProcessor::DrawTaskBarriers::Visit (const VFgDrawTask<FG::CustomDraw> &task)
 	{
-		EResourceState	stages = _tp._fgThread.GetDevice().GetGraphicsShaderStages();
+		EResourceState	stages = _fgThread.GetDevice().GetGraphicsShaderStages();
 
 		for (auto& item : task.GetImages())
 		{
 			ImageViewDesc	desc{ item.first->Description() };
-			_tp._AddImage( item.first, (item.second | stages), EResourceState_ToImageLayout( item.second, item.first->AspectMask() ), desc );
+			_logicalRP._AddDrawImage( item.first, (item.second | stages), EResourceState_ToImageLayout( item.second, item.first->AspectMask() ), desc );
 		}
 
 		for (auto& item : task.GetBuffers())
 		{
-			_tp._AddBuffer( item.first, item.second, 0, VK_WHOLE_SIZE );
+			_logicalRP._AddDrawBuffer( item.first, item.second, 0, VK_WHOLE_SIZE );
 		}
 	}
 
@@ -692,7 +811,11 @@ namespace FG
 	template <typename DrawTask>
 	inline void  VTaskProcessor::DrawTaskBarriers::_ExtractDescriptorSets (RawPipelineLayoutID layoutId, const DrawTask &task)
 	{
-		_tp._ExtractDescriptorSets( *_tp._GetResource( layoutId ), task.GetResources(), OUT task.descriptorSets );
+		VPipelineLayout const*	layout = _fgThread.AcquireTemporary( layoutId );
+		CHECK_ERRV( layout );
+
+		_dynamicOffsets = task.GetResources().dynamicOffsets;
+		ExtractDescriptorSets( *layout, task.GetResources(), *this, OUT task.descriptorSets, OUT task.dynamicOffsets );
 	}
 
 /*
@@ -706,19 +829,21 @@ namespace FG
 		STATIC_ASSERT(	(IsSameTypes<PipelineType, VGraphicsPipeline>) or
 						(IsSameTypes<PipelineType, VMeshPipeline>) );
 
+		auto&	states = _logicalRP._EditDrawStates();
+
 		if ( pipeline->IsEarlyFragmentTests() )
-			_earlyFragmentTests = true;
+			states.earlyFragmentTests = true;
 		else
-			_lateFragmentTests = true;
+			states.lateFragmentTests = true;
 
-		_depthWrite |= (ds.hasDepthWrite & ds.depthWrite);
+		states.depthWrite |= (ds.hasDepthWrite & ds.depthWrite);
 
-		_stencilWrite |= not (ds.hasStencilTest | _logicalRP.GetStencilState().enabled) ? false :
-						 bool(ds.hasStencilFailOp      & (ds.stencilFailOp      != EStencilOp::Keep)) |
-						 bool(ds.hasStencilDepthFailOp & (ds.stencilDepthFailOp != EStencilOp::Keep)) |
-						 bool(ds.hasStencilPassOp      & (ds.stencilPassOp      != EStencilOp::Keep));
+		states.stencilWrite |= not (ds.hasStencilTest | _logicalRP.GetStencilState().enabled) ? false :
+							   bool(ds.hasStencilFailOp      & (ds.stencilFailOp      != EStencilOp::Keep)) |
+							   bool(ds.hasStencilDepthFailOp & (ds.stencilDepthFailOp != EStencilOp::Keep)) |
+							   bool(ds.hasStencilPassOp      & (ds.stencilPassOp      != EStencilOp::Keep));
 
-		_rasterizerDiscard &= not _logicalRP.GetRasterizationState().rasterizerDiscard;
+		states.rasterizerDiscard &= not _logicalRP.GetRasterizationState().rasterizerDiscard;
 	}
 //-----------------------------------------------------------------------------
 
@@ -729,11 +854,32 @@ namespace FG
 	constructor
 =================================================
 */
-	VTaskProcessor::DrawTaskCommands::DrawTaskCommands (VTaskProcessor &tp, VFgTask<SubmitRenderPass> const* task, VkCommandBuffer cmd) :
-		_tp{ tp },	_currTask{ task },	_cmdBuffer{ cmd }
+	VTaskProcessor::DrawTaskCommands::DrawTaskCommands (VTaskProcessor &tp, VFgTask<SubmitRenderPass> const* task, VkCommandBuffer cmd, bool resolvePipelinesOnly) :
+		_tp{ tp },	_currTask{ task },	_cmdBuffer{ cmd },	_resolvePipelinesOnly{ resolvePipelinesOnly }
 	{
 	}
 
+/*
+=================================================
+	_BindPipeline
+----
+	returns 'false' if draw commands must not be recorded
+=================================================
+*/
+	template <typename DrawTask>
+	bool  VTaskProcessor::DrawTaskCommands::_BindPipeline (const DrawTask &task, OUT VPipelineLayout const* &layout) const
+	{
+		auto&	logical_rp = *_currTask->GetLogicalPass();
+
+		if ( _resolvePipelinesOnly )
+		{
+			CHECK( _tp._GetPipeline( logical_rp, task, OUT task.pipelineInstance, OUT task.pipelineLayout ));
+			return false;
+		}
+
+		return _tp._BindPipeline( logical_rp, task, OUT layout );
+	}
+
 /*
 =================================================
 	_BindVertexBuffers
@@ -771,8 +917,14 @@ namespace FG
 										  layout.GetFirstDescriptorSet(),
 										  uint(task.descriptorSets.size()),
 										  task.descriptorSets.data(),
-										  uint(task.GetResources().dynamicOffsets.size()),
-										  task.GetResources().dynamicOffsets.data() );
+										  uint(task.dynamicOffsets.size()),
+										  task.dynamicOffsets.data() );
+			_tp.Stat().descriptorBinds ++;
+		}
+
+		if ( VkDescriptorSet bindless = layout.GetBindlessSet() )
+		{
+			_tp.vkCmdBindDescriptorSets( _cmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, layout.Handle(), layout.GetBindlessSetIndex(), 1, &bindless, 0, null );
 			_tp.Stat().descriptorBinds ++;
 		}
 		
@@ -799,7 +951,8 @@ namespace FG
 		VPipelineLayout const*	layout	= null;
 		auto&					stat	= _tp.Stat();
 
-		CHECK_ERRV( _tp._BindPipeline( *_currTask->GetLogicalPass(), task, OUT layout ));
+		if ( not _BindPipeline( task, OUT layout ))
+			return;
 
 		_BindPipelineResources( *layout, task );
 		_tp._PushConstants( *layout, task.pushConstants );
@@ -829,7 +982,8 @@ namespace FG
 		VPipelineLayout const*	layout	= null;
 		auto&					stat	= _tp.Stat();
 
-		CHECK_ERRV( _tp._BindPipeline( *_currTask->GetLogicalPass(), task, OUT layout ));
+		if ( not _BindPipeline( task, OUT layout ))
+			return;
 
 		_BindPipelineResources( *layout, task );
 		_tp._PushConstants( *layout, task.pushConstants );
@@ -860,7 +1014,8 @@ namespace FG
 		VPipelineLayout const*	layout	= null;
 		auto&					stat	= _tp.Stat();
 
-		CHECK_ERRV( _tp._BindPipeline( *_currTask->GetLogicalPass(), task, OUT layout ));
+		if ( not _BindPipeline( task, OUT layout ))
+			return;
 
 		_BindPipelineResources( *layout, task );
 		_tp._PushConstants( *layout, task.pushConstants );
@@ -895,7 +1050,8 @@ namespace FG
 		VPipelineLayout const*	layout	= null;
 		auto&					stat	= _tp.Stat();
 
-		CHECK_ERRV( _tp._BindPipeline( *_currTask->GetLogicalPass(), task, OUT layout ));
+		if ( not _BindPipeline( task, OUT layout ))
+			return;
 
 		_BindPipelineResources( *layout, task );
 		_tp._PushConstants( *layout, task.pushConstants );
@@ -933,7 +1089,8 @@ namespace FG
 			VPipelineLayout const*	layout	= null;
 			auto&					stat	= _tp.Stat();
 
-			CHECK_ERRV( _tp._BindPipeline( *_currTask->GetLogicalPass(), task, OUT layout ));
+			if ( not _BindPipeline( task, OUT layout ))
+				return;
 
 			_BindPipelineResources( *layout, task );
 			_tp._PushConstants( *layout, task.pushConstants );
@@ -972,7 +1129,8 @@ namespace FG
 			VPipelineLayout const*	layout	= null;
 			auto&					stat	= _tp.Stat();
 
-			CHECK_ERRV( _tp._BindPipeline( *_currTask->GetLogicalPass(), task, OUT layout ));
+			if ( not _BindPipeline( task, OUT layout ))
+				return;
 
 			_BindPipelineResources( *layout, task );
 			_tp._PushConstants( *layout, task.pushConstants );
@@ -1013,7 +1171,8 @@ namespace FG
 			VPipelineLayout const*	layout	= null;
 			auto&					stat	= _tp.Stat();
 
-			CHECK_ERRV( _tp._BindPipeline( *_currTask->GetLogicalPass(), task, OUT layout ));
+			if ( not _BindPipeline( task, OUT layout ))
+				return;
 
 			_BindPipelineResources( *layout, task );
 			_tp._PushConstants( *layout, task.pushConstants );
@@ -1051,7 +1210,8 @@ namespace FG
 			VPipelineLayout const*	layout	= null;
 			auto&					stat	= _tp.Stat();
 
-			CHECK_ERRV( _tp._BindPipeline( *_currTask->GetLogicalPass(), task, OUT layout ));
+			if ( not _BindPipeline( task, OUT layout ))
+				return;
 
 			_BindPipelineResources( *layout, task );
 			_tp._PushConstants( *layout, task.pushConstants );
@@ -1092,7 +1252,8 @@ namespace FG
 			VPipelineLayout const*	layout	= null;
 			auto&					stat	= _tp.Stat();
 
-			CHECK_ERRV( _tp._BindPipeline( *_currTask->GetLogicalPass(), task, OUT layout ));
+			if ( not _BindPipeline( task, OUT layout ))
+				return;
 
 			_BindPipelineResources( *layout, task );
 			_tp._PushConstants( *layout, task.pushConstants );
@@ -1260,6 +1421,16 @@ namespace FG
 			else
 				result = false;
 		}
+		
+		// bind global descriptor heap
+		if ( result and _pplnLayout and (mask & (GRAPHICS_BIT | MESH_BIT)) )
+		{
+			if ( VkDescriptorSet bindless = _pplnLayout->GetBindlessSet() )
+			{
+				_tp.vkCmdBindDescriptorSets( _tp._cmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, _pplnLayout->Handle(), _pplnLayout->GetBindlessSetIndex(), 1, &bindless, 0, null );
+				_tp.Stat().descriptorBinds ++;
+			}
+		}
 
 		return result;
 	}
@@ -1777,9 +1948,13 @@ namespace FG
 	VTaskProcessor::VTaskProcessor (VCommandBuffer &fgThread, VkCommandBuffer cmd) :
 		_fgThread{ fgThread },
 		_cmdBuffer{ cmd },
+		_stat{ fgThread.EditStatistic().renderer },
 		_enableDebugUtils{ _fgThread.GetDevice().GetFeatures().debugUtils },
 		_isDefaultScissor{ false },	
 		_perPassStatesUpdated{ false },
+		_isSecondary{ false },
+		_splitBarriers{ fgThread.IsSplitBarriersEnabled() },
+		_renderPassActive{ false },
 		_dispatchBase{ _fgThread.GetDevice().GetFeatures().dispatchBase },
 		_drawIndirectCount{ _fgThread.GetDevice().GetFeatures().drawIndirectCount },
 		_meshShaderNV{ _fgThread.GetDevice().GetFeatures().meshShaderNV },
@@ -1797,6 +1972,39 @@ namespace FG
 		_CmdPushDebugGroup( "CommandBuffer: "s << (fgThread.GetName().size() ? fgThread.GetName() : ToString<16>( size_t(_cmdBuffer) )), RGBA8u{255} );
 	}
 	
+/*
+=================================================
+	constructor
+----
+	used to record draw tasks into secondary command buffer on worker thread,
+	so VCommandBuffer methods must not be used here.
+=================================================
+*/
+	VTaskProcessor::VTaskProcessor (const VTaskProcessor &parent, VkCommandBuffer secondaryCmd, Statistic_t &stat) :
+		_fgThread{ parent._fgThread },
+		_cmdBuffer{ secondaryCmd },
+		_stat{ stat },
+		_enableDebugUtils{ false },
+		_isDefaultScissor{ false },
+		_perPassStatesUpdated{ false },
+		_isSecondary{ true },
+		_splitBarriers{ false },
+		_renderPassActive{ true },
+		_dispatchBase{ parent._dispatchBase },
+		_drawIndirectCount{ parent._drawIndirectCount },
+		_meshShaderNV{ parent._meshShaderNV },
+		_rayTracingNV{ parent._rayTracingNV },
+		_maxDrawIndirectCount{ parent._maxDrawIndirectCount },
+		#ifdef VK_NV_mesh_shader
+		_maxMeshTaskCount{ parent._maxMeshTaskCount },
+		#endif
+		_pendingResourceBarriers{ parent._pendingResourceBarriers.get_allocator() }
+	{
+		ASSERT( _cmdBuffer );
+
+		VulkanDeviceFn_Init( parent );
+	}
+
 /*
 =================================================
 	destructor
@@ -1807,6 +2015,20 @@ namespace FG
 		_CmdPopDebugGroup();
 	}
 	
+/*
+=================================================
+	MergeDrawTask
+----
+	called when draw task is added to the render pass,
+	accumulates resource states and updates descriptor sets
+=================================================
+*/
+	void  VTaskProcessor::MergeDrawTask (VCommandBuffer &fgThread, VLogicalRenderPass &logicalRP, IDrawTask &task)
+	{
+		DrawTaskBarriers	visitor{ fgThread, logicalRP };
+		task.Process1( &visitor );
+	}
+
 /*
 =================================================
 	Visit*_DrawVertices
@@ -2068,19 +2290,17 @@ namespace FG
 	_AddRenderTargetBarriers
 =================================================
 */
-	void  VTaskProcessor::_AddRenderTargetBarriers (const VLogicalRenderPass &logicalRP, const DrawTaskBarriers &info)
+	void  VTaskProcessor::_AddRenderTargetBarriers (const VLogicalRenderPass &logicalRP, const VLogicalRenderPass::DrawStates &states)
 	{
-		CHECK( info.IsFragmentOutputCompatible() );
-
 		if ( logicalRP.GetDepthStencilTarget().IsDefined() )
 		{
 			auto &			rt		= logicalRP.GetDepthStencilTarget();
 			const bool		clear	= (rt.loadOp == VK_ATTACHMENT_LOAD_OP_CLEAR);
 			EResourceState	state	= rt.state;
 
-			state |= (info.IsEarlyFragmentTests() ? EResourceState::EarlyFragmentTests : Default);
-			state |= (info.IsLateFragmentTests()  ? EResourceState::LateFragmentTests : Default);
-			state &= ~((info.HasDepthWriteAccess() | clear) ? EResourceState::Unknown : EResourceState::_Write);
+			state |= (states.earlyFragmentTests ? EResourceState::EarlyFragmentTests : Default);
+			state |= (states.lateFragmentTests  ? EResourceState::LateFragmentTests : Default);
+			state &= ~((states.depthWrite | clear) ? EResourceState::Unknown : EResourceState::_Write);
 			
 			VkImageLayout&	layout	= rt._layout;
 			layout = EResourceState_ToImageLayout( state, rt.imagePtr->AspectMask() );
@@ -2088,7 +2308,7 @@ namespace FG
 			_AddImage( rt.imagePtr, state, layout, rt.desc );
 		}
 
-		if ( info.IsRasterizerDiscard() )
+		if ( states.rasterizerDiscard )
 			return;
 
 		for (auto& rt : logicalRP.GetColorTargets())
@@ -2101,6 +2321,45 @@ namespace FG
 		}
 	}
 	
+/*
+=================================================
+	_AddDrawTaskBarriers
+----
+	resource states was merged when draw tasks were added to the render pass
+=================================================
+*/
+	void  VTaskProcessor::_AddDrawTaskBarriers (const VLogicalRenderPass &logicalRP)
+	{
+		for (auto& [key, range] : logicalRP.GetDrawBuffers())
+		{
+			_AddBuffer( key.first, key.second, range.first, range.second - range.first );
+		}
+
+		for (auto& img : logicalRP.GetDrawImages())
+		{
+			_AddImage( img.image, img.state, img.layout, img.desc );
+		}
+
+	#ifdef VK_NV_ray_tracing
+		for (auto* scene : logicalRP.GetDrawRTScenes())
+		{
+			_AddRTScene( scene, EResourceState::RayTracingShaderRead );
+
+			auto&	data = scene->ToGlobal()->CurrentData();
+			SHAREDLOCK( data.guard );
+			ASSERT( data.geometryInstances.size() );
+
+			for (auto& inst : data.geometryInstances)
+			{
+				if ( auto* geom = _ToLocal( inst.geometry.Get() ))
+				{
+					_AddRTGeometry( geom, EResourceState::RayTracingShaderRead );
+				}
+			}
+		}
+	#endif
+	}
+
 /*
 =================================================
 	_SetShadingRateImage
@@ -2205,7 +2464,7 @@ namespace FG
 	_BeginRenderPass
 =================================================
 */
-	void  VTaskProcessor::_BeginRenderPass (const VFgTask<SubmitRenderPass> &task)
+	void  VTaskProcessor::_BeginRenderPass (const VFgTask<SubmitRenderPass> &task, VkSubpassContents contents)
 	{
 		ASSERT( not task.IsSubpass() );
 
@@ -2218,15 +2477,19 @@ namespace FG
 
 		
 		// add barriers
-		DrawTaskBarriers	barrier_visitor{ *this, *logical_passes.front() };
-		EResourceState		stages = _fgThread.GetDevice().GetGraphicsShaderStages();
+		VLogicalRenderPass::DrawStates	draw_states	= logical_passes.front()->GetDrawStates();
+		EResourceState					stages		= _fgThread.GetDevice().GetGraphicsShaderStages();
 
 		for (auto& pass : logical_passes)
 		{
-			for (auto& draw : pass->GetDrawTasks())
-			{
-				draw->Process1( &barrier_visitor );
-			}
+			_AddDrawTaskBarriers( *pass );
+
+			auto&	states = pass->GetDrawStates();
+			draw_states.earlyFragmentTests	|= states.earlyFragmentTests;
+			draw_states.lateFragmentTests	|= states.lateFragmentTests;
+			draw_states.depthWrite			|= states.depthWrite;
+			draw_states.stencilWrite		|= states.stencilWrite;
+			draw_states.rasterizerDiscard	&= states.rasterizerDiscard;
 
 			for (auto& item : pass->GetMutableImages())
 			{
@@ -2243,7 +2506,7 @@ namespace FG
 		VkImageView  sri_view = VK_NULL_HANDLE;
 		_SetShadingRateImage( *task.GetLogicalPass(), OUT sri_view );
 
-		_AddRenderTargetBarriers( *task.GetLogicalPass(), barrier_visitor );
+		_AddRenderTargetBarriers( *task.GetLogicalPass(), draw_states );
 		_CommitBarriers();
 
 
@@ -2267,7 +2530,8 @@ namespace FG
 		pass_info.pClearValues				= task.GetLogicalPass()->GetClearValues().data();
 		pass_info.framebuffer				= framebuffer->Handle();
 		
-		vkCmdBeginRenderPass( _cmdBuffer, &pass_info, VK_SUBPASS_CONTENTS_INLINE );
+		vkCmdBeginRenderPass( _cmdBuffer, &pass_info, contents );
+		_renderPassActive = true;
 
 		_BindShadingRateImage( sri_view );
 	}
@@ -2277,13 +2541,13 @@ namespace FG
 	_BeginSubpass
 =================================================
 */
-	void  VTaskProcessor::_BeginSubpass (const VFgTask<SubmitRenderPass> &task)
+	void  VTaskProcessor::_BeginSubpass (const VFgTask<SubmitRenderPass> &task, VkSubpassContents contents)
 	{
 		ASSERT( task.IsSubpass() );
 
 		// TODO: barriers for attachments
 
-		vkCmdNextSubpass( _cmdBuffer, VK_SUBPASS_CONTENTS_INLINE );
+		vkCmdNextSubpass( _cmdBuffer, contents );
 		/*
 		// TODO
 		vkCmdClearAttachments( _cmdBuffer,
@@ -2307,79 +2571,167 @@ namespace FG
 		_isDefaultScissor		= false;
 		_perPassStatesUpdated	= false;
 
+		const uint				secondary_count	= _CalcSecondaryCmdBufferCount( *task.GetLogicalPass() );
+		const VkSubpassContents	contents		= secondary_count ? VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS : VK_SUBPASS_CONTENTS_INLINE;
+
 		if ( not task.IsSubpass() )
 		{
 			_CmdPushDebugGroup( task.Name(), task.DebugColor() );
-			_BeginRenderPass( task );
+			_BeginRenderPass( task, contents );
 		}
 		else
 		{
 			_CmdPopDebugGroup();
 			_CmdPushDebugGroup( task.Name(), task.DebugColor() );
-			_BeginSubpass( task );
+			_BeginSubpass( task, contents );
 		}
 
 
 		// draw
-		DrawTaskCommands	command_builder{ *this, &task, _cmdBuffer };
-		
-		for (auto& draw : task.GetLogicalPass()->GetDrawTasks())
+		if ( secondary_count )
+		{
+			_ExecuteSecondaryCmdBuffers( task, secondary_count );
+		}
+		else
 		{
-			draw->Process2( &command_builder );
+			DrawTaskCommands	command_builder{ *this, &task, _cmdBuffer };
+		
+			for (auto& draw : task.GetLogicalPass()->GetDrawTasks())
+			{
+				draw->Process2( &command_builder );
+			}
 		}
 
 		// end render pass
 		if ( task.IsLastPass() )
 		{
 			vkCmdEndRenderPass( _cmdBuffer );
+			_renderPassActive = false;
 			_CmdPopDebugGroup();
 		}
 	}
 	
 /*
 =================================================
-	_ExtractDescriptorSets
+	_CalcSecondaryCmdBufferCount
+----
+	returns 0 if draw tasks must be recorded into primary command buffer
 =================================================
 */
-	void  VTaskProcessor::_ExtractDescriptorSets (const VPipelineLayout &layout, const VPipelineResourceSet &resourceSet,
-												  OUT VkDescriptorSets_t &descriptorSets)
+	uint  VTaskProcessor::_CalcSecondaryCmdBufferCount (const VLogicalRenderPass &logicalRP)
 	{
-		const FixedArray< uint, FG_MaxBufferDynamicOffsets >	old_offsets = resourceSet.dynamicOffsets;
-		StaticArray< Pair<uint, uint>, FG_MaxDescriptorSets >	new_offsets = {};
-		const uint												first_ds	= layout.GetFirstDescriptorSet();
+		auto	draw_tasks = logicalRP.GetDrawTasks();
 
-		descriptorSets.resize( resourceSet.resources.size() );
+		if ( not logicalRP.UseSecondaryCmdbuf() or draw_tasks.empty() )
+			return 0;
 
-		for (size_t i = 0; i < resourceSet.resources.size(); ++i)
+		// custom draw and shader debugger use VCommandBuffer that is not thread safe,
+		// shading rate image must be bound inside the secondary command buffer, this is not implemented yet
+		if ( logicalRP.HasCustomDraw() or logicalRP.HasShadingRateImage() )
+			return 0;
+
+		if ( draw_tasks.size() < FG_MinDrawTasksPerThread * 2 )
+			return 0;
+
+		for (auto& draw : draw_tasks)
 		{
-			const auto &				res		 = resourceSet.resources[i];
-			uint						binding	 = 0;
-			RawDescriptorSetLayoutID	ds_layout;
+			if ( draw->debugModeIndex != Default )
+				return 0;
+		}
 
-			if ( not layout.GetDescriptorSetLayout( res.descSetId, OUT ds_layout, OUT binding ))
-				continue;
+		const uint	count = Min( uint(draw_tasks.size()) / FG_MinDrawTasksPerThread,
+								 _fgThread.GetInstance().GetWorkerThreads().ThreadCount() + 1,
+								 FG_MaxRecordingThreads );
 
-			PipelineResourceBarriers	visitor{ *this, resourceSet.dynamicOffsets };
-			res.pplnRes->ForEachUniform( visitor );
+		// there is no benefit from single secondary command buffer
+		return count > 1 ? count : 0;
+	}
+	
+/*
+=================================================
+	_ExecuteSecondaryCmdBuffers
+=================================================
+*/
+	void  VTaskProcessor::_ExecuteSecondaryCmdBuffers (const VFgTask<SubmitRenderPass> &task, const uint cmdBufferCount)
+	{
+		using CmdBuffers_t	= FixedArray< VkCommandBuffer, FG_MaxRecordingThreads >;
+		using Statistics_t	= StaticArray< IFrameGraph::Statistics, FG_MaxRecordingThreads >;
 
-			ASSERT( ds_layout == res.pplnRes->GetLayoutID() );
-			ASSERT( binding >= first_ds );
-			binding -= first_ds;
+		auto const&		logical_rp	= *task.GetLogicalPass();
+		auto			draw_tasks	= logical_rp.GetDrawTasks();
+		CmdBuffers_t	cmd_buffers;
+		Statistics_t	statistics;
 
-			descriptorSets[binding] = res.pplnRes->Handle();
-			new_offsets[binding]    = { res.offsetIndex, res.offsetCount };
+		// pipeline cache and resource manager are not thread safe, so create all pipelines before recording
+		{
+			DrawTaskCommands	pipeline_resolver{ *this, &task, VK_NULL_HANDLE, true };
+
+			for (auto& draw : draw_tasks)
+			{
+				draw->Process2( &pipeline_resolver );
+			}
 		}
 
-		// sort dynamic offsets by binding index
-		uint	dst = 0;
-		for (auto& item : new_offsets)
+		for (uint i = 0; i < cmdBufferCount; ++i)
 		{
-			for (uint i = item.first; i < item.second; ++i, ++dst)
+			VkCommandBuffer	cmd = _fgThread.AllocSecondaryCommandBuffer( i );
+			CHECK_ERRV( cmd );
+			cmd_buffers.push_back( cmd );
+		}
+
+		VFramebuffer const*	framebuffer = _GetResource( logical_rp.GetFramebufferID() );
+		VRenderPass const*	render_pass = _GetResource( logical_rp.GetRenderPassID() );
+
+		VkCommandBufferInheritanceInfo	inheritance = {};
+		inheritance.sType		= VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+		inheritance.renderPass	= render_pass->Handle();
+		inheritance.subpass		= logical_rp.GetSubpassIndex();
+		inheritance.framebuffer	= framebuffer->Handle();
+
+		// record draw tasks on worker threads, current thread records one of the chunks too
+		_fgThread.GetInstance().GetWorkerThreads().ParallelFor( cmdBufferCount, [&] (uint index)
 			{
-				resourceSet.dynamicOffsets[dst] = old_offsets[i];
-			}
+				const size_t	first	= draw_tasks.size() * index / cmdBufferCount;
+				const size_t	last	= draw_tasks.size() * (index + 1) / cmdBufferCount;
+				VkCommandBuffer	cmd		= cmd_buffers[index];
+
+				VkCommandBufferBeginInfo	begin_info = {};
+				begin_info.sType			= VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+				begin_info.flags			= VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT | VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
+				begin_info.pInheritanceInfo	= &inheritance;
+
+				VK_CALL( vkBeginCommandBuffer( cmd, &begin_info ));
+				{
+					VTaskProcessor		processor		{ *this, cmd, statistics[index].renderer };
+					DrawTaskCommands	command_builder	{ processor, &task, cmd };
+
+					for (size_t i = first; i < last; ++i)
+					{
+						draw_tasks[i]->Process2( &command_builder );
+					}
+				}
+				VK_CALL( vkEndCommandBuffer( cmd ));
+			});
+
+		vkCmdExecuteCommands( _cmdBuffer, uint(cmd_buffers.size()), cmd_buffers.data() );
+
+		for (auto& stat : statistics) {
+			_fgThread.EditStatistic().Merge( stat );
 		}
 	}
+
+/*
+=================================================
+	_ExtractDescriptorSets
+=================================================
+*/
+	void  VTaskProcessor::_ExtractDescriptorSets (const VPipelineLayout &layout, const VPipelineResourceSet &resourceSet,
+												  OUT VkDescriptorSets_t &descriptorSets, OUT VDynamicOffsets_t &dynamicOffsets)
+	{
+		PipelineResourceBarriers	visitor{ *this, resourceSet.dynamicOffsets };
+
+		ExtractDescriptorSets( layout, resourceSet, visitor, OUT descriptorSets, OUT dynamicOffsets );
+	}
 	
 /*
 =================================================
@@ -2391,18 +2743,36 @@ namespace FG
 	{
 		// update descriptor sets and add pipeline barriers
 		VkDescriptorSets_t	descriptor_sets;
-		_ExtractDescriptorSets( layout, resourceSet, OUT descriptor_sets );
+		VDynamicOffsets_t	dynamic_offsets;
+		_ExtractDescriptorSets( layout, resourceSet, OUT descriptor_sets, OUT dynamic_offsets );
 
-		if ( descriptor_sets.size() )
+		_BindDescriptorSets( layout, descriptor_sets, dynamic_offsets, bindPoint, debugModeIndex );
+	}
+	
+/*
+=================================================
+	_BindDescriptorSets
+=================================================
+*/
+	void  VTaskProcessor::_BindDescriptorSets (const VPipelineLayout &layout, ArrayView<VkDescriptorSet> descriptorSets, ArrayView<uint> dynamicOffsets,
+											   VkPipelineBindPoint bindPoint, ShaderDbgIndex debugModeIndex)
+	{
+		if ( descriptorSets.size() )
 		{
 			vkCmdBindDescriptorSets( _cmdBuffer,
 									  bindPoint,
 									  layout.Handle(),
 									  layout.GetFirstDescriptorSet(),
-									  uint(descriptor_sets.size()),
-									  descriptor_sets.data(),
-									  uint(resourceSet.dynamicOffsets.size()),
-									  resourceSet.dynamicOffsets.data() );
+									  uint(descriptorSets.size()),
+									  descriptorSets.data(),
+									  uint(dynamicOffsets.size()),
+									  dynamicOffsets.data() );
+			Stat().descriptorBinds ++;
+		}
+
+		if ( VkDescriptorSet bindless = layout.GetBindlessSet() )
+		{
+			vkCmdBindDescriptorSets( _cmdBuffer, bindPoint, layout.Handle(), layout.GetBindlessSetIndex(), 1, &bindless, 0, null );
 			Stat().descriptorBinds ++;
 		}
 
@@ -2539,10 +2909,11 @@ namespace FG
 
 /*
 =================================================
-	_BindPipeline
+	_GetPipeline
 =================================================
 */
-	inline bool  VTaskProcessor::_BindPipeline (const VLogicalRenderPass &logicalRP, const VBaseDrawVerticesTask &task, VPipelineLayout const* &pplnLayout)
+	inline bool  VTaskProcessor::_GetPipeline (const VLogicalRenderPass &logicalRP, const VBaseDrawVerticesTask &task,
+											   OUT VkPipeline &pipelineId, OUT VPipelineLayout const* &pplnLayout)
 	{
 		RenderState				render_state;
 		EPipelineDynamicState	dynamic_states = EPipelineDynamicState::Viewport | EPipelineDynamicState::Scissor;
@@ -2561,27 +2932,72 @@ namespace FG
 									INOUT render_state.rasterization, INOUT dynamic_states, task.dynamicStates );
 		SetupExtensions( logicalRP, INOUT dynamic_states );
 
-		VkPipeline	ppln_id;
-		CHECK_ERR( _fgThread.GetPipelineCache().CreatePipelineInstance(
-										_fgThread,
-										logicalRP,
-										*task.pipeline,
-										task.vertexInput,
-										render_state,
-										dynamic_states,
-										task.debugModeIndex,
-										OUT ppln_id, OUT pplnLayout ));
-		
-		_BindPipeline2( logicalRP, ppln_id );
+		VAsyncPipelineCompiler*	compiler = _fgThread.GetInstance().GetPipelineCompiler();
+
+		if ( not compiler or task.debugModeIndex != Default )
+		{
+			CHECK_ERR( _fgThread.GetPipelineCache().CreatePipelineInstance(
+											_fgThread,
+											logicalRP,
+											*task.pipeline,
+											task.vertexInput,
+											render_state,
+											dynamic_states,
+											task.debugModeIndex,
+											OUT pipelineId, OUT pplnLayout ));
+		}
+		else
+		{
+			bool	is_failed = false;
+
+			CHECK_ERR( _fgThread.GetPipelineCache().CreatePipelineInstanceAsync(
+											_fgThread,
+											*compiler,
+											logicalRP,
+											task.pipelineId,
+											*task.pipeline,
+											task.vertexInput,
+											render_state,
+											dynamic_states,
+											OUT pipelineId, OUT pplnLayout, OUT is_failed ));
+
+			// pipeline is not compiled yet or compilation failed, draw task is skipped or fallback pipeline is used
+			if ( pipelineId == VK_NULL_HANDLE and not task.warmUp )
+			{
+				if ( not is_failed )
+					_fgThread.EditStatistic().resources.pipelineHitchesAvoided++;
+
+				// fallback pipeline must have the same layout because descriptor sets are created for main pipeline
+				if ( task.fallbackPipeline and task.fallbackPipeline->GetLayoutID() == task.pipeline->GetLayoutID() )
+				{
+					CHECK_ERR( _fgThread.GetPipelineCache().CreatePipelineInstance(
+													_fgThread,
+													logicalRP,
+													*task.fallbackPipeline,
+													task.vertexInput,
+													render_state,
+													dynamic_states,
+													Default,
+													OUT pipelineId, OUT pplnLayout ));
+				}
+				ASSERT( not task.fallbackPipeline or pipelineId != VK_NULL_HANDLE );
+			}
+		}
+
+		// draw commands are not recorded for warm-up task
+		if ( task.warmUp )
+			pipelineId = VK_NULL_HANDLE;
+
 		return true;
 	}
 	
 /*
 =================================================
-	_BindPipeline
+	_GetPipeline
 =================================================
 */
-	inline bool  VTaskProcessor::_BindPipeline (const VLogicalRenderPass &logicalRP, const VBaseDrawMeshes &task, VPipelineLayout const* &pplnLayout)
+	inline bool  VTaskProcessor::_GetPipeline (const VLogicalRenderPass &logicalRP, const VBaseDrawMeshes &task,
+											   OUT VkPipeline &pipelineId, OUT VPipelineLayout const* &pplnLayout)
 	{
 	#ifdef VK_NV_mesh_shader
 		RenderState				render_state;
@@ -2598,7 +3014,6 @@ namespace FG
 									INOUT render_state.rasterization, INOUT dynamic_states, task.dynamicStates );
 		SetupExtensions( logicalRP, INOUT dynamic_states );
 
-		VkPipeline	ppln_id;
 		CHECK_ERR( _fgThread.GetPipelineCache().CreatePipelineInstance(
 										_fgThread,
 										logicalRP,
@@ -2606,12 +3021,10 @@ namespace FG
 										render_state,
 										dynamic_states,
 										task.debugModeIndex,
-										OUT ppln_id, OUT pplnLayout ));
-		
-		_BindPipeline2( logicalRP, ppln_id );
+										OUT pipelineId, OUT pplnLayout ));
 		return true;
 	#else
-		Unused( logicalRP, task, pplnLayout );
+		Unused( logicalRP, task, pipelineId, pplnLayout );
 		return false;
 	#endif
 	}
@@ -2619,26 +3032,62 @@ namespace FG
 /*
 =================================================
 	_BindPipeline
+----
+	pipeline may be already created if draw task is recorded into secondary command buffer,
+	returns 'false' if pipeline is not compiled yet or task is used for warm-up.
 =================================================
 */
-	inline bool  VTaskProcessor::_BindPipeline (const VComputePipeline* pipeline, const Optional<uint3> &localSize,
-											    ShaderDbgIndex debugModeIndex, VkPipelineCreateFlags flags, OUT VPipelineLayout const* &pplnLayout)
+	template <typename DrawTask>
+	inline bool  VTaskProcessor::_BindPipeline (const VLogicalRenderPass &logicalRP, const DrawTask &task, OUT VPipelineLayout const* &pplnLayout)
+	{
+		VkPipeline	ppln_id = task.pipelineInstance;
+		pplnLayout = task.pipelineLayout;
+
+		if ( pplnLayout == null )
+		{
+			// pipeline cache can not be used on worker thread
+			CHECK_ERR( not _isSecondary );
+			CHECK_ERR( _GetPipeline( logicalRP, task, OUT ppln_id, OUT pplnLayout ));
+		}
+
+		// pipeline is compiled asynchronously or task is used for warm-up
+		if ( ppln_id == VK_NULL_HANDLE )
+			return false;
+
+		_BindPipeline2( logicalRP, ppln_id );
+		return true;
+	}
+
+/*
+=================================================
+	_BindPipeline
+=================================================
+*/
+	inline bool  VTaskProcessor::_GetPipeline (const VComputePipeline* pipeline, const Optional<uint3> &localSize, ShaderDbgIndex debugModeIndex,
+											   VkPipelineCreateFlags flags, OUT VkPipeline &pipelineId, OUT VPipelineLayout const* &pplnLayout)
 	{
-		VkPipeline	ppln_id;
 		CHECK_ERR( _fgThread.GetPipelineCache().CreatePipelineInstance(
 										_fgThread,
 										*pipeline, localSize,
 										flags,
 										debugModeIndex,
-										OUT ppln_id, OUT pplnLayout ));
-		
-		if ( _computePipeline.pipeline != ppln_id )
+										OUT pipelineId, OUT pplnLayout ));
+		return true;
+	}
+	
+/*
+=================================================
+	_BindComputePipeline
+=================================================
+*/
+	inline void  VTaskProcessor::_BindComputePipeline (VkPipeline pipelineId)
+	{
+		if ( _computePipeline.pipeline != pipelineId )
 		{
-			_computePipeline.pipeline = ppln_id;
-			vkCmdBindPipeline( _cmdBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, ppln_id );
+			_computePipeline.pipeline = pipelineId;
+			vkCmdBindPipeline( _cmdBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipelineId );
 			Stat().computePipelineBindings ++;
 		}
-		return true;
 	}
 
 /*
@@ -2650,14 +3099,21 @@ namespace FG
 	{
 		_CmdDebugMarker( task.Name() );
 
-		VPipelineLayout const*	layout = null;
+		VPipelineLayout const*	layout		= null;
+		VkPipeline				ppln_id		= VK_NULL_HANDLE;
+		VkDescriptorSets_t		descriptor_sets;
+		VDynamicOffsets_t		dynamic_offsets;
 
-		CHECK_ERRV( _BindPipeline( task.pipeline, task.localGroupSize, task.debugModeIndex, VK_PIPELINE_CREATE_DISPATCH_BASE, OUT layout ));
+		CHECK_ERRV( _GetPipeline( task.pipeline, task.localGroupSize, task.debugModeIndex, VK_PIPELINE_CREATE_DISPATCH_BASE, OUT ppln_id, OUT layout ));
 
-		_BindPipelineResources( *layout, task.GetResources(), VK_PIPELINE_BIND_POINT_COMPUTE, task.debugModeIndex );
-		_PushConstants( *layout, task.pushConstants );
+		_ExtractDescriptorSets( *layout, task.GetResources(), OUT descriptor_sets, OUT dynamic_offsets );
 
-		_CommitBarriers();
+		if ( not _CommitBarriers() )
+			return;
+		
+		_BindComputePipeline( ppln_id );
+		_BindDescriptorSets( *layout, descriptor_sets, dynamic_offsets, VK_PIPELINE_BIND_POINT_COMPUTE, task.debugModeIndex );
+		_PushConstants( *layout, task.pushConstants );
 
 		for (auto& cmd : task.commands)
 		{
@@ -2689,19 +3145,27 @@ namespace FG
 	{
 		_CmdDebugMarker( task.Name() );
 		
-		VPipelineLayout const*	layout = null;
+		VPipelineLayout const*	layout		= null;
+		VkPipeline				ppln_id		= VK_NULL_HANDLE;
+		VkDescriptorSets_t		descriptor_sets;
+		VDynamicOffsets_t		dynamic_offsets;
 
-		CHECK_ERRV( _BindPipeline( task.pipeline, task.localGroupSize, task.debugModeIndex, 0, OUT layout ));
+		CHECK_ERRV( _GetPipeline( task.pipeline, task.localGroupSize, task.debugModeIndex, 0, OUT ppln_id, OUT layout ));
 
-		_BindPipelineResources( *layout, task.GetResources(), VK_PIPELINE_BIND_POINT_COMPUTE, task.debugModeIndex );
-		_PushConstants( *layout, task.pushConstants );
+		_ExtractDescriptorSets( *layout, task.GetResources(), OUT descriptor_sets, OUT dynamic_offsets );
 		
 		for (auto& cmd : task.commands)
 		{
 			_AddBuffer( task.indirectBuffer, EResourceState::IndirectBuffer, VkDeviceSize(cmd.indirectBufferOffset),
 						sizeof(DispatchComputeIndirect::DispatchIndirectCommand) );
 		}
-		_CommitBarriers();
+
+		if ( not _CommitBarriers() )
+			return;
+		
+		_BindComputePipeline( ppln_id );
+		_BindDescriptorSets( *layout, descriptor_sets, dynamic_offsets, VK_PIPELINE_BIND_POINT_COMPUTE, task.debugModeIndex );
+		_PushConstants( *layout, task.pushConstants );
 		
 		for (auto& cmd : task.commands)
 		{
@@ -2745,7 +3209,8 @@ namespace FG
 			_AddBuffer( dst_buffer, EResourceState::TransferDst, dst.dstOffset, dst.size );
 		}
 		
-		_CommitBarriers();
+		if ( not _CommitBarriers() )
+			return;
 		
 		vkCmdCopyBuffer( _cmdBuffer,
 						  src_buffer->Handle(),
@@ -2796,11 +3261,12 @@ namespace FG
 			//ASSERT(All( src.srcOffset + src.size <= Max(1u, src_image.Dimension().xyz() >> src.srcSubresource.mipLevel.Get()) ));
 			//ASSERT(All( src.dstOffset + src.size <= Max(1u, dst_image.Dimension().xyz() >> src.dstSubresource.mipLevel.Get()) ));
 
-			_AddImage( src_image, EResourceState::TransferSrc, task.srcLayout, dst.srcSubresource );
-			_AddImage( dst_image, EResourceState::TransferDst, task.dstLayout, dst.dstSubresource );
+			_AddImage( src_image, EResourceState::TransferSrc, task.srcLayout, dst.srcSubresource, ToImageRegion( dst.srcOffset, dst.extent ));
+			_AddImage( dst_image, EResourceState::TransferDst, task.dstLayout, dst.dstSubresource, ToImageRegion( dst.dstOffset, dst.extent ));
 		}
 		
-		_CommitBarriers();
+		if ( not _CommitBarriers() )
+			return;
 		
 		vkCmdCopyImage( _cmdBuffer,
 						 src_image->Handle(),
@@ -2845,10 +3311,11 @@ namespace FG
 			dst.imageExtent						= VkExtent3D{ img_size.x, img_size.y, img_size.z };
 
 			_AddBuffer( src_buffer, EResourceState::TransferSrc, dst, dst_image );
-			_AddImage(  dst_image,  EResourceState::TransferDst, task.dstLayout, dst.imageSubresource );
+			_AddImage(  dst_image,  EResourceState::TransferDst, task.dstLayout, dst.imageSubresource, ToImageRegion( dst.imageOffset, dst.imageExtent ));
 		}
 		
-		_CommitBarriers();
+		if ( not _CommitBarriers() )
+			return;
 		
 		vkCmdCopyBufferToImage( _cmdBuffer,
 								 src_buffer->Handle(),
@@ -2890,11 +3357,12 @@ namespace FG
 			dst.imageOffset						= VkOffset3D{ src.imageOffset.x, src.imageOffset.y, src.imageOffset.z };
 			dst.imageExtent						= VkExtent3D{ image_size.x, image_size.y, image_size.z };
 
-			_AddImage(  src_image,  EResourceState::TransferSrc, task.srcLayout, dst.imageSubresource );
+			_AddImage(  src_image,  EResourceState::TransferSrc, task.srcLayout, dst.imageSubresource, ToImageRegion( dst.imageOffset, dst.imageExtent ));
 			_AddBuffer( dst_buffer, EResourceState::TransferDst, dst, src_image );
 		}
 		
-		_CommitBarriers();
+		if ( not _CommitBarriers() )
+			return;
 		
 		vkCmdCopyImageToBuffer( _cmdBuffer,
 								 src_image->Handle(),
@@ -2938,11 +3406,12 @@ namespace FG
 			dst.dstOffsets[0]					= VkOffset3D{ src.dstOffset0.x, src.dstOffset0.y, src.dstOffset0.z };
 			dst.dstOffsets[1]					= VkOffset3D{ src.dstOffset1.x, src.dstOffset1.y, src.dstOffset1.z };
 
-			_AddImage( src_image, EResourceState::TransferSrc, task.srcLayout, dst.srcSubresource );
-			_AddImage( dst_image, EResourceState::TransferDst, task.dstLayout, dst.dstSubresource );
+			_AddImage( src_image, EResourceState::TransferSrc, task.srcLayout, dst.srcSubresource, ToImageRegion( dst.srcOffsets[0], dst.srcOffsets[1] ));
+			_AddImage( dst_image, EResourceState::TransferDst, task.dstLayout, dst.dstSubresource, ToImageRegion( dst.dstOffsets[0], dst.dstOffsets[1] ));
 		}
 		
-		_CommitBarriers();
+		if ( not _CommitBarriers() )
+			return;
 		
 		vkCmdBlitImage( _cmdBuffer,
 						src_image->Handle(),
@@ -2989,11 +3458,12 @@ namespace FG
 			
 			dst.extent							= VkExtent3D{ image_size.x, image_size.y, image_size.z };
 
-			_AddImage( src_image, EResourceState::TransferSrc, task.srcLayout, dst.srcSubresource );
-			_AddImage( dst_image, EResourceState::TransferDst, task.dstLayout, dst.dstSubresource );
+			_AddImage( src_image, EResourceState::TransferSrc, task.srcLayout, dst.srcSubresource, ToImageRegion( dst.srcOffset, dst.extent ));
+			_AddImage( dst_image, EResourceState::TransferDst, task.dstLayout, dst.dstSubresource, ToImageRegion( dst.dstOffset, dst.extent ));
 		}
 		
-		_CommitBarriers();
+		if ( not _CommitBarriers() )
+			return;
 		
 		vkCmdResolveImage(	_cmdBuffer,
 							src_image->Handle(),
@@ -3065,6 +3535,7 @@ namespace FG
 							 vk_image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region, VK_FILTER_LINEAR );
 			
 			Stat().transferOps ++;
+			Stat().pipelineBarriers += 2;
 
 			// read after write
 			barrier.oldLayout			= VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
@@ -3091,7 +3562,8 @@ namespace FG
 
 		_AddBuffer( dst_buffer, EResourceState::TransferDst, task.dstOffset, task.size );
 		
-		_CommitBarriers();
+		if ( not _CommitBarriers() )
+			return;
 		
 		vkCmdFillBuffer( _cmdBuffer,
 						  dst_buffer->Handle(),
@@ -3128,7 +3600,8 @@ namespace FG
 			_AddImage( dst_image, EResourceState::TransferDst, task.dstLayout, dst );
 		}
 		
-		_CommitBarriers();
+		if ( not _CommitBarriers() )
+			return;
 		
 		vkCmdClearColorImage( _cmdBuffer,
 							   dst_image->Handle(),
@@ -3166,7 +3639,8 @@ namespace FG
 			_AddImage( dst_image, EResourceState::TransferDst, task.dstLayout, dst );
 		}
 		
-		_CommitBarriers();
+		if ( not _CommitBarriers() )
+			return;
 		
 		vkCmdClearDepthStencilImage( _cmdBuffer,
 									  dst_image->Handle(),
@@ -3192,7 +3666,8 @@ namespace FG
 		for (auto& reg : task.Regions()) {
 			_AddBuffer( dst_buffer, EResourceState::TransferDst, reg.bufferOffset, reg.dataSize );
 		}	
-		_CommitBarriers();
+		if ( not _CommitBarriers() )
+			return;
 		
 		for (auto& reg : task.Regions()) {
 			vkCmdUpdateBuffer( _cmdBuffer, dst_buffer->Handle(), reg.bufferOffset, reg.dataSize, reg.dataPtr );
@@ -3501,6 +3976,27 @@ namespace FG
 
 		task.callback( ctx );
 	}
+	
+/*
+=================================================
+	Visit (AliasingFence)
+----
+	memory of released transient resource will be reused by the next resource,
+	so all previous commands must be complete before any subsequent command
+=================================================
+*/
+	void  VTaskProcessor::Visit (const VFgTask<AliasingFence> &task)
+	{
+		_CmdDebugMarker( task.Name() );
+
+		VkMemoryBarrier	barrier = {};
+		barrier.sType			= VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+		barrier.srcAccessMask	= VK_ACCESS_MEMORY_WRITE_BIT;
+		barrier.dstAccessMask	= VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT;
+
+		_fgThread.GetBarrierManager().AddMemoryBarrier( VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, barrier );
+		_CommitBarriers();
+	}
 
 /*
 =================================================
@@ -3512,6 +4008,15 @@ namespace FG
 		ASSERT( img );
 		ASSERT( not state.range.IsEmpty() );
 
+		if ( _batchPass == EBatchPass::Collect )
+			return _AddBatchAccess( img, state.state, state.layout );
+
+		if ( _batchPass == EBatchPass::Commands )
+			return;
+
+		_taskStages		|= EResourceState_ToPipelineStages( state.state );
+		_taskHasWrites	|= EResourceState_IsWritable( state.state );
+
 		_pendingResourceBarriers.insert({ img, &CommitResourceBarrier<VLocalImage> });
 
 		img->AddPendingState( state );
@@ -3555,6 +4060,23 @@ namespace FG
 						});
 	}
 	
+/*
+=================================================
+	_AddImage
+=================================================
+*/
+	inline void  VTaskProcessor::_AddImage (const VLocalImage *img, EResourceState state, VkImageLayout layout, const VkImageSubresourceLayers &subres,
+											const ImageRange::RegionU &region)
+	{
+		_AddImageState( img,
+						ImageState{
+							state, layout,
+							ImageRange{ ImageLayer(subres.baseArrayLayer), subres.layerCount, MipmapLevel(subres.mipLevel), 1, region },
+							VkImageAspectFlagBits(subres.aspectMask),
+							_currTask
+						});
+	}
+	
 /*
 =================================================
 	_AddImage
@@ -3579,6 +4101,16 @@ namespace FG
 	inline void  VTaskProcessor::_AddBufferState (const VLocalBuffer *buf, const BufferState &state)
 	{
 		ASSERT( buf );
+
+		if ( _batchPass == EBatchPass::Collect )
+			return _AddBatchAccess( buf, state.state );
+
+		if ( _batchPass == EBatchPass::Commands )
+			return;
+
+		_taskStages		|= EResourceState_ToPipelineStages( state.state );
+		_taskHasWrites	|= EResourceState_IsWritable( state.state );
+
 		_pendingResourceBarriers.insert({ buf, &CommitResourceBarrier<VLocalBuffer> });
 
 		buf->AddPendingState( state );
@@ -3650,6 +4182,13 @@ namespace FG
 	void  VTaskProcessor::_AddRTGeometry (const VLocalRTGeometry *geom, EResourceState state)
 	{
 		ASSERT( geom );
+
+		if ( _batchPass == EBatchPass::Collect )
+			return _AddBatchAccess( geom, state );
+
+		if ( _batchPass == EBatchPass::Commands )
+			return;
+
 		_pendingResourceBarriers.insert({ geom, &CommitResourceBarrier<VLocalRTGeometry> });
 
 		geom->AddPendingState(RTGeometryState{ state, _currTask });
@@ -3668,6 +4207,13 @@ namespace FG
 	void  VTaskProcessor::_AddRTScene (const VLocalRTScene *scene, EResourceState state)
 	{
 		ASSERT( scene );
+
+		if ( _batchPass == EBatchPass::Collect )
+			return _AddBatchAccess( scene, state );
+
+		if ( _batchPass == EBatchPass::Commands )
+			return;
+
 		_pendingResourceBarriers.insert({ scene, &CommitResourceBarrier<VLocalRTScene> });
 
 		scene->AddPendingState(RTSceneState{ state, _currTask });
@@ -3682,8 +4228,18 @@ namespace FG
 	_CommitBarriers
 =================================================
 */
-	inline void  VTaskProcessor::_CommitBarriers ()
+	inline bool  VTaskProcessor::_CommitBarriers ()
 	{
+		BEGIN_ENUM_CHECKS();
+		switch ( _batchPass )
+		{
+			case EBatchPass::None :		break;
+			case EBatchPass::Collect :
+			case EBatchPass::Barriers :	return false;	// skip commands
+			case EBatchPass::Commands :	return true;	// barriers are already committed
+		}
+		END_ENUM_CHECKS();
+
 		auto&	barrier_mngr = _fgThread.GetBarrierManager();
 
 		for (auto& res : _pendingResourceBarriers)
@@ -3732,12 +4288,72 @@ namespace FG
 			barrier.dstAccessMask	= barrier.srcAccessMask;
 
 			barrier_mngr.AddMemoryBarrier( VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, barrier );
-			barrier_mngr.Commit( _fgThread.GetDevice(), _cmdBuffer );
+			Stat().pipelineBarriers += uint(barrier_mngr.Commit( _fgThread.GetDevice(), _cmdBuffer ));
 		}
 		else
 	#endif	// FG_DEBUG
 
-		barrier_mngr.Commit( _fgThread.GetDevice(), _cmdBuffer );
+		Stat().pipelineBarriers += uint(barrier_mngr.Commit( _fgThread.GetDevice(), _cmdBuffer ));
+		return true;
+	}
+	
+/*
+=================================================
+	_SetSplitEvent
+----
+	called after all commands of the task (or batch of tasks) were recorded,
+	consumers that will be recorded much later wait for this event instead of pipeline barrier
+=================================================
+*/
+	void  VTaskProcessor::_SetSplitEvent ()
+	{
+		const VkPipelineStageFlags	stages		= _taskStages;
+		const bool					has_writes	= _taskHasWrites;
+
+		_taskStages		= 0;
+		_taskHasWrites	= false;
+
+		// events can not be set inside render pass
+		if ( not (_splitBarriers and has_writes and stages) or _renderPassActive )
+			return;
+
+		VkEvent		ev = _fgThread.GetBatch().AcquireEvent();
+		CHECK_ERRV( ev );
+
+		vkCmdSetEvent( _cmdBuffer, ev, stages );
+		_fgThread.GetBarrierManager().SetEvent( _currTask->ExecutionOrder(), ev, stages );
+	}
+	
+/*
+=================================================
+	_AddBatchAccess
+=================================================
+*/
+	inline void  VTaskProcessor::_AddBatchAccess (void const* resource, EResourceState state, VkImageLayout layout)
+	{
+		_taskAccesses.push_back({ resource, state, layout });
+	}
+	
+/*
+=================================================
+	_IsCompatible
+----
+	only read accesses with the same state can be merged,
+	otherwise execution order will be changed
+=================================================
+*/
+	bool  VTaskProcessor::_IsCompatible (ArrayView<BatchAccess> accesses, const BatchAccess &access)
+	{
+		for (auto& other : accesses)
+		{
+			if ( other.resource != access.resource )
+				continue;
+
+			if ( EResourceState_IsWritable( other.state ) or EResourceState_IsWritable( access.state ) or
+				 other.state != access.state or other.layout != access.layout )
+				return false;
+		}
+		return true;
 	}
 	
 /*
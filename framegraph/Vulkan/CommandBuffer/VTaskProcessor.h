@@ -7,6 +7,7 @@
 #include "VLocalImage.h"
 #include "VLocalRTGeometry.h"
 #include "VLocalRTScene.h"
+#include "VLogicalRenderPass.h"
 #include "VBarrierManager.h"
 
 namespace FG
@@ -54,16 +55,37 @@ namespace FG
 			VkPipeline		pipeline	= VK_NULL_HANDLE;
 		};
 
+		// see 'CommandBufferDesc::reorderTasks'
+		enum class EBatchPass : uint8_t
+		{
+			None,			// add resource states, commit barriers and record commands
+			Collect,		// only collect resource accesses to check compatibility with the current batch
+			Barriers,		// add resource states, barriers will be committed for all tasks in the batch
+			Commands,		// only record commands, barriers are already committed
+		};
+
+		struct BatchAccess
+		{
+			void const*		resource	= null;
+			EResourceState	state		= Default;
+			VkImageLayout	layout		= VK_IMAGE_LAYOUT_UNDEFINED;
+		};
+		using BatchAccesses_t			= Array< BatchAccess >;
+
 
 	// variables
 	private:
 		VCommandBuffer &			_fgThread;
 		const VkCommandBuffer		_cmdBuffer;
+		Statistic_t &				_stat;
 		
 		VTask						_currTask;
 		bool						_enableDebugUtils		: 1;
 		bool						_isDefaultScissor		: 1;
 		bool						_perPassStatesUpdated	: 1;
+		const bool					_isSecondary			: 1;	// secondary command buffer recorded on worker thread, '_fgThread' must not be used
+		const bool					_splitBarriers			: 1;
+		bool						_renderPassActive		: 1;
 		const bool					_dispatchBase			: 1;
 		const bool					_drawIndirectCount		: 1;
 		const bool					_meshShaderNV			: 1;
@@ -86,6 +108,18 @@ namespace FG
 
 		VkImageView					_shadingRateImage	= VK_NULL_HANDLE;
 
+		// task batch
+		EBatchPass					_batchPass			= EBatchPass::None;
+		uint						_batchSize			= 0;
+		bool						_batchClosed		= false;
+		BatchAccesses_t				_batchAccesses;		// accesses of the tasks in the current batch
+		BatchAccesses_t				_rejectedAccesses;	// accesses of the rejected tasks, conflicting tasks must keep their order
+		BatchAccesses_t				_taskAccesses;
+
+		// split barriers
+		VkPipelineStageFlags		_taskStages			= 0;		// stages of all resource states in the current task
+		bool						_taskHasWrites		= false;
+
 
 	// methods
 	public:
@@ -112,6 +146,7 @@ namespace FG
 		void  Visit (const VFgTask<BuildRayTracingScene> &);
 		void  Visit (const VFgTask<TraceRays> &);
 		void  Visit (const VFgTask<CustomTask> &);
+		void  Visit (const VFgTask<AliasingFence> &);
 
 		static void  Visit1_DrawVertices (void *, void *);
 		static void  Visit2_DrawVertices (void *, void *);
@@ -134,10 +169,17 @@ namespace FG
 		static void  Visit1_CustomDraw (void *, void *);
 		static void  Visit2_CustomDraw (void *, void *);
 
+		static void  MergeDrawTask (VCommandBuffer &fgThread, VLogicalRenderPass &logicalRP, IDrawTask &task);
+
 		void  Run (VTask);
 
+		ND_ bool  TryAddToBatch (VTask);
+		void  RunBatch (ArrayView<VTask>);
+
 
 	private:
+		VTaskProcessor (const VTaskProcessor &parent, VkCommandBuffer secondaryCmd, Statistic_t &stat);
+
 		void  _CmdDebugMarker (StringView text) const;
 		void  _CmdPushDebugGroup (StringView text, RGBA8u color) const;
 		void  _CmdPopDebugGroup () const;
@@ -145,21 +187,33 @@ namespace FG
 		template <typename ID>	ND_ auto const*  _ToLocal (ID id) const;
 		template <typename ID>	ND_ auto const*  _GetResource (ID id) const;
 		
-		void  _CommitBarriers ();
+		bool  _CommitBarriers ();
+		void  _SetSplitEvent ();
+		void  _AddBatchAccess (void const* resource, EResourceState state, VkImageLayout layout = VK_IMAGE_LAYOUT_UNDEFINED);
+		ND_ static bool  _IsCompatible (ArrayView<BatchAccess> accesses, const BatchAccess &access);
 		
-		void  _AddRenderTargetBarriers (const VLogicalRenderPass &logicalRP, const DrawTaskBarriers &info);
+		void  _AddRenderTargetBarriers (const VLogicalRenderPass &logicalRP, const VLogicalRenderPass::DrawStates &states);
+		void  _AddDrawTaskBarriers (const VLogicalRenderPass &logicalRP);
 		void  _SetShadingRateImage (const VLogicalRenderPass &logicalRP, OUT VkImageView &view);
-		void  _BeginRenderPass (const VFgTask<SubmitRenderPass> &task);
-		void  _BeginSubpass (const VFgTask<SubmitRenderPass> &task);
+		void  _BeginRenderPass (const VFgTask<SubmitRenderPass> &task, VkSubpassContents contents);
+		void  _BeginSubpass (const VFgTask<SubmitRenderPass> &task, VkSubpassContents contents);
 		bool  _CreateRenderPass (ArrayView<VLogicalRenderPass*> logicalPasses);
+		
+		ND_ uint  _CalcSecondaryCmdBufferCount (const VLogicalRenderPass &logicalRP);
+		void  _ExecuteSecondaryCmdBuffers (const VFgTask<SubmitRenderPass> &task, uint cmdBufferCount);
 
-		void  _ExtractDescriptorSets (const VPipelineLayout &, const VPipelineResourceSet &, OUT VkDescriptorSets_t &);
+		void  _ExtractDescriptorSets (const VPipelineLayout &, const VPipelineResourceSet &, OUT VkDescriptorSets_t &, OUT VDynamicOffsets_t &);
 		void  _BindPipelineResources (const VPipelineLayout &layout, const VPipelineResourceSet &resourceSet, VkPipelineBindPoint bindPoint, ShaderDbgIndex debugModeIndex);
-		bool  _BindPipeline (const VLogicalRenderPass &logicalRP, const VBaseDrawVerticesTask &task, OUT VPipelineLayout const* &pplnLayout);
-		bool  _BindPipeline (const VLogicalRenderPass &logicalRP, const VBaseDrawMeshes &task, OUT VPipelineLayout const* &pplnLayout);
+		void  _BindDescriptorSets (const VPipelineLayout &layout, ArrayView<VkDescriptorSet> descriptorSets, ArrayView<uint> dynamicOffsets,
+								   VkPipelineBindPoint bindPoint, ShaderDbgIndex debugModeIndex);
+		bool  _GetPipeline (const VLogicalRenderPass &logicalRP, const VBaseDrawVerticesTask &task, OUT VkPipeline &pipelineId, OUT VPipelineLayout const* &pplnLayout);
+		bool  _GetPipeline (const VLogicalRenderPass &logicalRP, const VBaseDrawMeshes &task, OUT VkPipeline &pipelineId, OUT VPipelineLayout const* &pplnLayout);
+		template <typename DrawTask>
+		bool  _BindPipeline (const VLogicalRenderPass &logicalRP, const DrawTask &task, OUT VPipelineLayout const* &pplnLayout);
 		void  _BindPipeline2 (const VLogicalRenderPass &logicalRP, VkPipeline pipelineId);
-		bool  _BindPipeline (const VComputePipeline* pipeline, const Optional<uint3> &localSize, ShaderDbgIndex debugModeIndex,
-							 VkPipelineCreateFlags flags, OUT VPipelineLayout const* &pplnLayout);
+		bool  _GetPipeline (const VComputePipeline* pipeline, const Optional<uint3> &localSize, ShaderDbgIndex debugModeIndex,
+							VkPipelineCreateFlags flags, OUT VkPipeline &pipelineId, OUT VPipelineLayout const* &pplnLayout);
+		void  _BindComputePipeline (VkPipeline pipelineId);
 		void  _PushConstants (const VPipelineLayout &layout, const _fg_hidden_::PushConstants_t &pc) const;
 		void  _SetScissor (const VLogicalRenderPass &, ArrayView<RectI>);
 		void  _SetDynamicStates (const _fg_hidden_::DynamicStates &) const;
@@ -168,6 +222,7 @@ namespace FG
 
 		void  _AddImage (const VLocalImage *img, EResourceState state, VkImageLayout layout, const ImageViewDesc &desc);
 		void  _AddImage (const VLocalImage *img, EResourceState state, VkImageLayout layout, const VkImageSubresourceLayers &subresLayers);
+		void  _AddImage (const VLocalImage *img, EResourceState state, VkImageLayout layout, const VkImageSubresourceLayers &subresLayers, const ImageRange::RegionU &region);
 		void  _AddImage (const VLocalImage *img, EResourceState state, VkImageLayout layout, const VkImageSubresourceRange &subres);
 		void  _AddImageState (const VLocalImage *img, const ImageState &state);
 
@@ -0,0 +1,51 @@
+// Copyright (c) 2018-2020,  Zhirnov Andrey. For more information see 'LICENSE'
+
+#include "VTaskSchedule.h"
+
+namespace FG
+{
+
+/*
+=================================================
+	Find
+=================================================
+*/
+	VTaskSchedulePtr  VTaskScheduleCache::Find (HashVal key) const
+	{
+		EXLOCK( _guard );
+
+		auto	iter = _map.find( size_t(key) );
+		return iter != _map.end() ? iter->second : null;
+	}
+
+/*
+=================================================
+	Add
+----
+	when cache is full all schedules are removed,
+	task graphs that are used every frame will be added again in the next frame
+=================================================
+*/
+	void  VTaskScheduleCache::Add (HashVal key, VTaskSchedulePtr schedule)
+	{
+		EXLOCK( _guard );
+
+		if ( _map.size() >= FG_MaxTaskSchedules )
+			_map.clear();
+
+		_map.insert_or_assign( size_t(key), std::move(schedule) );
+	}
+
+/*
+=================================================
+	Clear
+=================================================
+*/
+	void  VTaskScheduleCache::Clear ()
+	{
+		EXLOCK( _guard );
+		_map.clear();
+	}
+
+
+}	// FG
@@ -0,0 +1,68 @@
+// Copyright (c) 2018-2020,  Zhirnov Andrey. For more information see 'LICENSE'
+/*
+	Task schedule is an execution order of the task graph.
+	Structurally identical task graphs have the same hash and the same schedule,
+	so schedule that was built in previous frame is reused and task ordering is skipped.
+	Barriers are not cached because resource states at the start of the command buffer
+	depend on previous command buffers.
+*/
+
+#pragma once
+
+#include "VCommon.h"
+
+namespace FG
+{
+
+	//
+	// Task Schedule
+	//
+
+	struct VTaskSchedule
+	{
+	// variables
+		Array<uint>		order;		// task indices in order of 'VTaskGraph::Add' calls
+		Array<uint>		batches;	// number of tasks in each batch, sum is equal to 'order.size()'
+
+	// methods
+		VTaskSchedule () {}
+
+		void Clear ()
+		{
+			order.clear();
+			batches.clear();
+		}
+	};
+
+	using VTaskSchedulePtr	= SharedPtr< const VTaskSchedule >;
+
+
+
+	//
+	// Task Schedule Cache
+	//
+
+	class VTaskScheduleCache final
+	{
+	// types
+	private:
+		using ScheduleMap_t	= HashMap< size_t, VTaskSchedulePtr >;
+
+
+	// variables
+	private:
+		mutable Mutex		_guard;
+		ScheduleMap_t		_map;
+
+
+	// methods
+	public:
+		VTaskScheduleCache () {}
+
+		ND_ VTaskSchedulePtr  Find (HashVal key) const;
+			void  Add (HashVal key, VTaskSchedulePtr schedule);
+			void  Clear ();
+	};
+
+
+}	// FG
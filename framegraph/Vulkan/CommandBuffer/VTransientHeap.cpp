@@ -0,0 +1,207 @@
+// Copyright (c) 2018-2020,  Zhirnov Andrey. For more information see 'LICENSE'
+
+#include "VTransientHeap.h"
+#include "VResourceManager.h"
+#include "VDevice.h"
+
+namespace FG
+{
+
+/*
+=================================================
+	destructor
+=================================================
+*/
+	VTransientHeap::~VTransientHeap ()
+	{
+		ASSERT( _blocks.empty() );
+	}
+
+/*
+=================================================
+	Alloc
+----
+	first-fit allocation, new block is allocated only if there is no free space in existing blocks
+=================================================
+*/
+	bool  VTransientHeap::Alloc (VResourceManager &resMngr, const VkMemoryRequirements &memReq, OUT Allocation &result, OUT bool &aliased)
+	{
+		VDevice const&		dev		= resMngr.GetDevice();
+
+		// linear and optimal resources are placed in the same block, so use the largest alignment
+		const VkDeviceSize	align	= Max( memReq.alignment, dev.GetDeviceLimits().bufferImageGranularity );
+		const VkDeviceSize	size	= AlignToLarger( memReq.size, align );
+
+		aliased = false;
+
+		uint			block_idx	= UMax;
+		VkDeviceSize	offset		= 0;
+
+		for (size_t i = 0; i < _blocks.size(); ++i)
+		{
+			auto&	block = _blocks[i];
+
+			if ( AllBits( memReq.memoryTypeBits, 1u << block.memTypeIndex ) and _FindRange( block, size, align, OUT offset ))
+			{
+				block_idx = uint(i);
+				break;
+			}
+		}
+
+		if ( block_idx == UMax )
+		{
+			Block	block;
+			block.memTypeIndex	= _ChooseMemoryType( dev, memReq.memoryTypeBits );
+			block.size			= Max( size, VkDeviceSize(FG_TransientMemoryBlockSize) );
+			CHECK_ERR( block.memTypeIndex != UMax );
+
+			CHECK_ERR( resMngr.GetMemoryManager().AllocateBlock( block.memTypeIndex, block.size, OUT block.memory ));
+
+			block_idx	= uint(_blocks.size());
+			offset		= 0;
+			_blocks.push_back( std::move(block) );
+		}
+
+		auto&		block	= _blocks[ block_idx ];
+		const Range	range	{ offset, offset + size };
+
+		block.lastUsage = resMngr.GetSubmitIndex();
+
+		for (auto& rel : block.released)
+		{
+			if ( rel.begin < range.end and rel.end > range.begin )
+			{
+				aliased = true;
+				break;
+			}
+		}
+
+		auto	iter = std::find_if( block.used.begin(), block.used.end(), [&range] (auto& r) { return r.begin > range.begin; });
+		block.used.insert( iter, range );
+
+		result.block	= block_idx;
+		result.offset	= offset;
+		result.size		= size;
+		return true;
+	}
+
+/*
+=================================================
+	Release
+=================================================
+*/
+	void  VTransientHeap::Release (const Allocation &alloc)
+	{
+		CHECK_ERRV( alloc.block < _blocks.size() );
+
+		auto&	block	= _blocks[ alloc.block ];
+		auto	iter	= std::find_if( block.used.begin(), block.used.end(), [&alloc] (auto& r) { return r.begin == alloc.offset; });
+
+		CHECK_ERRV( iter != block.used.end() );
+		ASSERT( iter->end == alloc.offset + alloc.size );
+
+		block.released.push_back( *iter );
+		block.used.erase( iter );
+	}
+
+/*
+=================================================
+	OnAliasingBarrier
+=================================================
+*/
+	void  VTransientHeap::OnAliasingBarrier ()
+	{
+		for (auto& block : _blocks) {
+			block.released.clear();
+		}
+	}
+
+/*
+=================================================
+	Reset
+----
+	command batch is complete, so memory can be reused without barriers,
+	blocks that were not used during 'FG_FreeMemoryBlockLifetime' submissions are released.
+=================================================
+*/
+	void  VTransientHeap::Reset (VResourceManager &resMngr)
+	{
+		const uint	submit_index = resMngr.GetSubmitIndex();
+
+		for (size_t i = 0; i < _blocks.size();)
+		{
+			auto&	block = _blocks[i];
+
+			block.used.clear();
+			block.released.clear();
+
+			if ( submit_index - block.lastUsage > FG_FreeMemoryBlockLifetime )
+			{
+				resMngr.GetMemoryManager().DeallocateBlock( block.memory, block.memTypeIndex, block.size );
+				_blocks.erase( _blocks.begin() + i );
+			}
+			else
+				++i;
+		}
+	}
+
+/*
+=================================================
+	Destroy
+=================================================
+*/
+	void  VTransientHeap::Destroy (VResourceManager &resMngr)
+	{
+		for (auto& block : _blocks) {
+			resMngr.GetMemoryManager().DeallocateBlock( block.memory, block.memTypeIndex, block.size );
+		}
+		_blocks.clear();
+	}
+
+/*
+=================================================
+	_FindRange
+=================================================
+*/
+	bool  VTransientHeap::_FindRange (const Block &block, VkDeviceSize size, VkDeviceSize align, OUT VkDeviceSize &offset)
+	{
+		VkDeviceSize	begin = 0;
+
+		for (auto& range : block.used)
+		{
+			if ( begin + size <= range.begin )
+			{
+				offset = begin;
+				return true;
+			}
+			begin = AlignToLarger( range.end, align );
+		}
+
+		if ( begin + size <= block.size )
+		{
+			offset = begin;
+			return true;
+		}
+		return false;
+	}
+
+/*
+=================================================
+	_ChooseMemoryType
+=================================================
+*/
+	uint  VTransientHeap::_ChooseMemoryType (const VDevice &dev, uint memoryTypeBits)
+	{
+		const auto&		mem_props = dev.GetProperties().memoryProperties;
+
+		for (uint i = 0; i < mem_props.memoryTypeCount; ++i)
+		{
+			if ( AllBits( memoryTypeBits, 1u << i ) and
+				 AllBits( mem_props.memoryTypes[i].propertyFlags, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT ))
+				return i;
+		}
+		return UMax;
+	}
+
+
+}	// FG
@@ -0,0 +1,80 @@
+// Copyright (c) 2018-2020,  Zhirnov Andrey. For more information see 'LICENSE'
+/*
+	Device local memory for transient resources of a single command batch.
+	Memory of released resource can be reused by the next resource,
+	in this case allocation is marked as 'aliased' and command buffer must add aliasing barrier.
+	Memory blocks are kept when batch is complete and reused by the next command buffer,
+	blocks that are unused during 'FG_FreeMemoryBlockLifetime' submissions are returned to the memory manager.
+*/
+
+#pragma once
+
+#include "VCommon.h"
+
+namespace FG
+{
+
+	//
+	// Vulkan Transient Memory Heap
+	//
+
+	class VTransientHeap final
+	{
+	// types
+	public:
+		struct Allocation
+		{
+			uint			block	= UMax;
+			VkDeviceSize	offset	= 0;
+			VkDeviceSize	size	= 0;
+		};
+
+	private:
+		struct Range
+		{
+			VkDeviceSize	begin;
+			VkDeviceSize	end;
+		};
+		using Ranges_t	= Array< Range >;
+
+		struct Block
+		{
+			VkDeviceMemory	memory			= VK_NULL_HANDLE;
+			uint			memTypeIndex	= UMax;
+			VkDeviceSize	size			= 0;
+			uint			lastUsage		= 0;	// submission index
+			Ranges_t		used;			// sorted by offset
+			Ranges_t		released;		// memory of released resources, access to this memory requires barrier
+		};
+		using Blocks_t	= Array< Block >;
+
+
+	// variables
+	private:
+		Blocks_t		_blocks;
+
+
+	// methods
+	public:
+		VTransientHeap () {}
+		~VTransientHeap ();
+
+		bool  Alloc (VResourceManager &resMngr, const VkMemoryRequirements &memReq, OUT Allocation &result, OUT bool &aliased);
+		void  Release (const Allocation &alloc);
+
+		// all released memory will be available without aliasing barrier
+		void  OnAliasingBarrier ();
+
+		// all resources are released
+		void  Reset (VResourceManager &resMngr);
+		void  Destroy (VResourceManager &resMngr);
+
+		ND_ VkDeviceMemory  GetMemory (const Allocation &alloc) const	{ return _blocks[ alloc.block ].memory; }
+
+	private:
+		ND_ static bool  _FindRange (const Block &block, VkDeviceSize size, VkDeviceSize align, OUT VkDeviceSize &offset);
+		ND_ static uint  _ChooseMemoryType (const VDevice &dev, uint memoryTypeBits);
+	};
+
+
+}	// FG
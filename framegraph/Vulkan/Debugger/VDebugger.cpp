@@ -14,7 +14,7 @@ namespace FG
 */
 	VDebugger::VDebugger ()
 	{
-		EXLOCK( _drCheck );
+		EXLOCK( _guard );
 
 		_fullDump.reserve( 8 );
 		_graphs.reserve( 8 );
@@ -27,7 +27,7 @@ namespace FG
 */
 	void VDebugger::AddBatchDump (StringView name, String &&value)
 	{
-		EXLOCK( _drCheck );
+		EXLOCK( _guard );
 
 		if ( value.size() )
 			_fullDump.emplace_back( name, std::move(value) );
@@ -40,7 +40,7 @@ namespace FG
 */
 	void VDebugger::GetFrameDump (OUT String &str) const
 	{
-		EXLOCK( _drCheck );
+		EXLOCK( _guard );
 
 		std::sort( _fullDump.begin(), _fullDump.end(), [](auto& lhs, auto& rhs) { return lhs.first < rhs.first; });
 
@@ -57,7 +57,7 @@ namespace FG
 */
 	void VDebugger::AddBatchGraph (BatchGraph &&value)
 	{
-		EXLOCK( _drCheck );
+		EXLOCK( _guard );
 
 		if ( value.body.size() )
 			_graphs.push_back( std::move(value) );
@@ -70,7 +70,7 @@ namespace FG
 */
 	void VDebugger::GetGraphDump (OUT String &str) const
 	{
-		EXLOCK( _drCheck );
+		EXLOCK( _guard );
 
 		str.clear();
 		str	<< "digraph FrameGraph {\n"
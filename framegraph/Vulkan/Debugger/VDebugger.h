@@ -23,7 +23,7 @@ namespace FG
 		mutable Array<Pair< String, String >>	_fullDump;
 		mutable Array<BatchGraph>				_graphs;
 		
-		DataRaceCheck							_drCheck;
+		mutable Mutex							_guard;		// batches may be released on the completion thread
 
 
 	// methods
@@ -0,0 +1,401 @@
+// Copyright (c) 2018-2020,  Zhirnov Andrey. For more information see 'LICENSE'
+
+#include "VBindlessHeap.h"
+#include "VImage.h"
+#include "VBuffer.h"
+#include "VSampler.h"
+#include "VDevice.h"
+#include "framegraph/Shared/EnumUtils.h"
+
+namespace FG
+{
+
+/*
+=================================================
+	SlotAllocator::Alloc
+=================================================
+*/
+	uint  VBindlessHeap::SlotAllocator::Alloc (Index_t index)
+	{
+		if ( index >= slots.size() )
+			slots.resize( index+1, UMax );
+
+		if ( slots[index] != UMax )
+			return UMax;	// already added
+
+		uint	slot = UMax;
+
+		if ( freeSlots.size() )
+		{
+			slot = freeSlots.back();
+			freeSlots.pop_back();
+		}
+		else
+		if ( count < capacity )
+			slot = count++;
+		else
+			RETURN_ERR( "bindless heap overflow", UMax );
+
+		slots[index] = slot;
+		return slot;
+	}
+
+/*
+=================================================
+	SlotAllocator::Release
+=================================================
+*/
+	uint  VBindlessHeap::SlotAllocator::Release (Index_t index)
+	{
+		if ( index >= slots.size() or slots[index] == UMax )
+			return UMax;
+
+		const uint	slot = slots[index];
+		slots[index] = UMax;
+
+		freeSlots.push_back( slot );
+		return slot;
+	}
+
+/*
+=================================================
+	SlotAllocator::Get
+=================================================
+*/
+	uint  VBindlessHeap::SlotAllocator::Get (Index_t index) const
+	{
+		return index < slots.size() ? slots[index] : UMax;
+	}
+
+/*
+=================================================
+	SlotAllocator::Clear
+=================================================
+*/
+	void  VBindlessHeap::SlotAllocator::Clear ()
+	{
+		slots.clear();
+		freeSlots.clear();
+		count		= 0;
+		capacity	= 0;
+	}
+//-----------------------------------------------------------------------------
+
+
+
+/*
+=================================================
+	constructor
+=================================================
+*/
+	VBindlessHeap::VBindlessHeap (const VDevice &dev) :
+		_device{ dev }
+	{}
+
+/*
+=================================================
+	destructor
+=================================================
+*/
+	VBindlessHeap::~VBindlessHeap ()
+	{
+		CHECK( not _descPool );
+	}
+
+/*
+=================================================
+	IsSupported
+=================================================
+*/
+	bool  VBindlessHeap::IsSupported (const VDevice &dev)
+	{
+	#ifdef VK_EXT_descriptor_indexing
+		if ( not dev.GetFeatures().descriptorIndexing )
+			return false;
+
+		auto&	feats = dev.GetProperties().descriptorIndexingFeatures;
+
+		return	feats.runtimeDescriptorArray							and
+				feats.descriptorBindingPartiallyBound					and
+				feats.descriptorBindingUpdateUnusedWhilePending			and
+				feats.descriptorBindingSampledImageUpdateAfterBind		and
+				feats.descriptorBindingStorageBufferUpdateAfterBind;
+	#else
+		Unused( dev );
+		return false;
+	#endif
+	}
+
+/*
+=================================================
+	GetDescriptorBinding
+----
+	array sizes are clamped to the device limits
+=================================================
+*/
+	void  VBindlessHeap::GetDescriptorBinding (const VDevice &dev, OUT DescriptorBinding_t &binding)
+	{
+		binding.clear();
+
+	#ifdef VK_EXT_descriptor_indexing
+		auto&	props		= dev.GetProperties().descriptorIndexingProperties;
+		uint	per_stage	= props.maxPerStageUpdateAfterBindResources;
+
+		const auto	AddBinding = [&binding, &per_stage] (uint index, VkDescriptorType type, uint count)
+		{
+			count		 = Min( count, per_stage );
+			per_stage	-= count;
+
+			VkDescriptorSetLayoutBinding	bind = {};
+			bind.binding			= index;
+			bind.descriptorType		= type;
+			bind.descriptorCount	= count;
+			bind.stageFlags			= VK_SHADER_STAGE_ALL;
+
+			binding.push_back( bind );
+		};
+
+		AddBinding( SamplerBinding, VK_DESCRIPTOR_TYPE_SAMPLER,
+				    Min( FG_MaxBindlessSamplers, props.maxDescriptorSetUpdateAfterBindSamplers, props.maxPerStageDescriptorUpdateAfterBindSamplers ));
+
+		AddBinding( BufferBinding, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+				    Min( FG_MaxBindlessBuffers, props.maxDescriptorSetUpdateAfterBindStorageBuffers, props.maxPerStageDescriptorUpdateAfterBindStorageBuffers ));
+
+		AddBinding( ImageBinding, VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE,
+				    Min( FG_MaxBindlessImages, props.maxDescriptorSetUpdateAfterBindSampledImages, props.maxPerStageDescriptorUpdateAfterBindSampledImages ));
+	#else
+		Unused( dev );
+	#endif
+	}
+
+/*
+=================================================
+	Create
+=================================================
+*/
+	bool  VBindlessHeap::Create (RawDescriptorSetLayoutID layoutId, VkDescriptorSetLayout layout, const DescriptorBinding_t &binding)
+	{
+		EXLOCK( _guard );
+		CHECK_ERR( not _descPool );
+		CHECK_ERR( layout and binding.size() );
+
+		FixedArray< VkDescriptorPoolSize, 4 >	pool_sizes;
+
+		for (auto& bind : binding)
+		{
+			pool_sizes.push_back({ bind.descriptorType, bind.descriptorCount });
+
+			switch ( bind.binding )
+			{
+				case ImageBinding :		_images.capacity	= bind.descriptorCount;	break;
+				case SamplerBinding :	_samplers.capacity	= bind.descriptorCount;	break;
+				case BufferBinding :	_buffers.capacity	= bind.descriptorCount;	break;
+				default :				ASSERT( !"unknown binding" );			break;
+			}
+		}
+
+		VkDescriptorPoolCreateInfo	pool_info = {};
+		pool_info.sType			= VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+		pool_info.flags			= VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT_EXT;
+		pool_info.maxSets		= 1;
+		pool_info.poolSizeCount	= uint(pool_sizes.size());
+		pool_info.pPoolSizes	= pool_sizes.data();
+
+		VK_CHECK( _device.vkCreateDescriptorPool( _device.GetVkDevice(), &pool_info, null, OUT &_descPool ));
+
+		VkDescriptorSetAllocateInfo	alloc_info = {};
+		alloc_info.sType				= VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+		alloc_info.descriptorPool		= _descPool;
+		alloc_info.descriptorSetCount	= 1;
+		alloc_info.pSetLayouts			= &layout;
+
+		VK_CHECK( _device.vkAllocateDescriptorSets( _device.GetVkDevice(), &alloc_info, OUT &_descSet ));
+
+		_device.SetObjectName( BitCast<uint64_t>(_descSet), "BindlessHeap", VK_OBJECT_TYPE_DESCRIPTOR_SET );
+
+		_layoutId = layoutId;
+		return true;
+	}
+
+/*
+=================================================
+	Destroy
+=================================================
+*/
+	void  VBindlessHeap::Destroy ()
+	{
+		EXLOCK( _guard );
+
+		if ( _descPool ) {
+			_device.vkDestroyDescriptorPool( _device.GetVkDevice(), _descPool, null );
+		}
+
+		_images.Clear();
+		_samplers.Clear();
+		_buffers.Clear();
+
+		_descPool	= VK_NULL_HANDLE;
+		_descSet	= VK_NULL_HANDLE;
+		_layoutId	= Default;
+	}
+
+/*
+=================================================
+	AddImage
+----
+	only color and depth images with 'Sampled' usage are added,
+	image must be in the default layout when it is accessed in shader.
+=================================================
+*/
+	void  VBindlessHeap::AddImage (Index_t index, const VImage &image)
+	{
+		if ( not IsCreated() )
+			return;
+
+		auto&	desc = image.Description();
+
+		if ( not AllBits( desc.usage, EImageUsage::Sampled ) or EPixelFormat_IsDepthStencil( desc.format ))
+			return;
+
+		ImageViewDesc			view_desc;
+		VkDescriptorImageInfo	info = {};
+		info.imageView		= image.GetView( _device, true, INOUT view_desc );
+		info.imageLayout	= image.DefaultLayout();
+		CHECK_ERRV( info.imageView );
+
+		EXLOCK( _guard );
+
+		const uint	slot = _images.Alloc( index );
+		if ( slot != UMax )
+			_Write( ImageBinding, slot, VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, &info, null );
+	}
+
+/*
+=================================================
+	AddSampler
+----
+	sampler may be added many times because samplers are cached
+=================================================
+*/
+	void  VBindlessHeap::AddSampler (Index_t index, const VSampler &sampler)
+	{
+		if ( not IsCreated() )
+			return;
+
+		VkDescriptorImageInfo	info = {};
+		info.sampler = sampler.Handle();
+
+		EXLOCK( _guard );
+
+		const uint	slot = _samplers.Alloc( index );
+		if ( slot != UMax )
+			_Write( SamplerBinding, slot, VK_DESCRIPTOR_TYPE_SAMPLER, &info, null );
+	}
+
+/*
+=================================================
+	AddBuffer
+----
+	only buffers with 'Storage' usage are added,
+	descriptor covers the whole buffer.
+=================================================
+*/
+	void  VBindlessHeap::AddBuffer (Index_t index, const VBuffer &buffer)
+	{
+		if ( not IsCreated() or not AllBits( buffer.Description().usage, EBufferUsage::Storage ))
+			return;
+
+		VkDescriptorBufferInfo	info = {};
+		info.buffer	= buffer.Handle();
+		info.offset	= 0;
+		info.range	= VK_WHOLE_SIZE;
+
+		EXLOCK( _guard );
+
+		const uint	slot = _buffers.Alloc( index );
+		if ( slot != UMax )
+			_Write( BufferBinding, slot, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, null, &info );
+	}
+
+/*
+=================================================
+	Remove***
+----
+	descriptor is not cleared, it is partially bound
+	and will be overwritten when slot is reused.
+=================================================
+*/
+	void  VBindlessHeap::RemoveImage (Index_t index)
+	{
+		if ( not IsCreated() )
+			return;
+
+		EXLOCK( _guard );
+		Unused( _images.Release( index ));
+	}
+
+	void  VBindlessHeap::RemoveSampler (Index_t index)
+	{
+		if ( not IsCreated() )
+			return;
+
+		EXLOCK( _guard );
+		Unused( _samplers.Release( index ));
+	}
+
+	void  VBindlessHeap::RemoveBuffer (Index_t index)
+	{
+		if ( not IsCreated() )
+			return;
+
+		EXLOCK( _guard );
+		Unused( _buffers.Release( index ));
+	}
+
+/*
+=================================================
+	Get***Index
+=================================================
+*/
+	uint  VBindlessHeap::GetImageIndex (Index_t index) const
+	{
+		EXLOCK( _guard );
+		return _images.Get( index );
+	}
+
+	uint  VBindlessHeap::GetSamplerIndex (Index_t index) const
+	{
+		EXLOCK( _guard );
+		return _samplers.Get( index );
+	}
+
+	uint  VBindlessHeap::GetBufferIndex (Index_t index) const
+	{
+		EXLOCK( _guard );
+		return _buffers.Get( index );
+	}
+
+/*
+=================================================
+	_Write
+----
+	'_guard' must be locked
+=================================================
+*/
+	void  VBindlessHeap::_Write (uint binding, uint slot, VkDescriptorType type, const VkDescriptorImageInfo *image, const VkDescriptorBufferInfo *buffer) const
+	{
+		VkWriteDescriptorSet	write = {};
+		write.sType				= VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+		write.dstSet			= _descSet;
+		write.dstBinding		= binding;
+		write.dstArrayElement	= slot;
+		write.descriptorCount	= 1;
+		write.descriptorType	= type;
+		write.pImageInfo		= image;
+		write.pBufferInfo		= buffer;
+
+		_device.vkUpdateDescriptorSets( _device.GetVkDevice(), 1, &write, 0, null );
+	}
+
+
+}	// FG
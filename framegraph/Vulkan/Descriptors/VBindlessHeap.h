@@ -0,0 +1,95 @@
+// Copyright (c) 2018-2020,  Zhirnov Andrey. For more information see 'LICENSE'
+/*
+	Global descriptor heap for bindless mode.
+
+	Contains single update-after-bind descriptor set with arrays of all sampled images,
+	samplers and storage buffers, slot is allocated when resource is created and recycled when it is destroyed.
+	Resources in the heap are not tracked by frame graph, so pipeline barriers are not added for them.
+	Resource manager destroys released resource (and recycles its slot) only when all command buffers
+	that were submitted before the release have completed.
+*/
+
+#pragma once
+
+#include "VDescriptorSetLayout.h"
+
+namespace FG
+{
+
+	//
+	// Vulkan Bindless Descriptor Heap
+	//
+
+	class VBindlessHeap final
+	{
+	// types
+	public:
+		using Index_t				= RawImageID::Index_t;
+		using DescriptorBinding_t	= VDescriptorSetLayout::DescriptorBinding_t;
+
+		static constexpr uint	ImageBinding	= 0;
+		static constexpr uint	SamplerBinding	= 1;
+		static constexpr uint	BufferBinding	= 2;
+
+	private:
+		struct SlotAllocator
+		{
+			Array<uint>		slots;				// resource index to slot index
+			Array<uint>		freeSlots;
+			uint			count		= 0;	// number of allocated slots, including released slots
+			uint			capacity	= 0;
+
+			ND_ uint  Alloc (Index_t index);
+			ND_ uint  Release (Index_t index);
+			ND_ uint  Get (Index_t index) const;
+				void  Clear ();
+		};
+
+
+	// variables
+	private:
+		VDevice const&				_device;
+
+		mutable Mutex				_guard;
+		VkDescriptorPool			_descPool		= VK_NULL_HANDLE;
+		VkDescriptorSet				_descSet		= VK_NULL_HANDLE;	// immutable after 'Create()'
+		RawDescriptorSetLayoutID	_layoutId;
+
+		SlotAllocator				_images;
+		SlotAllocator				_samplers;
+		SlotAllocator				_buffers;
+
+
+	// methods
+	public:
+		explicit VBindlessHeap (const VDevice &dev);
+		~VBindlessHeap ();
+
+		ND_ static bool  IsSupported (const VDevice &dev);
+			static void  GetDescriptorBinding (const VDevice &dev, OUT DescriptorBinding_t &binding);
+
+		bool  Create (RawDescriptorSetLayoutID layoutId, VkDescriptorSetLayout layout, const DescriptorBinding_t &binding);
+		void  Destroy ();
+
+		void  AddImage (Index_t index, const VImage &image);
+		void  AddSampler (Index_t index, const VSampler &sampler);
+		void  AddBuffer (Index_t index, const VBuffer &buffer);
+
+		void  RemoveImage (Index_t index);
+		void  RemoveSampler (Index_t index);
+		void  RemoveBuffer (Index_t index);
+
+		ND_ uint  GetImageIndex (Index_t index) const;
+		ND_ uint  GetSamplerIndex (Index_t index) const;
+		ND_ uint  GetBufferIndex (Index_t index) const;
+
+		ND_ bool						IsCreated ()	const	{ return _descSet != VK_NULL_HANDLE; }
+		ND_ VkDescriptorSet				Handle ()		const	{ return _descSet; }
+		ND_ RawDescriptorSetLayoutID	GetLayoutID ()	const	{ return _layoutId; }
+
+	private:
+		void  _Write (uint binding, uint slot, VkDescriptorType type, const VkDescriptorImageInfo *image, const VkDescriptorBufferInfo *buffer) const;
+	};
+
+
+}	// FG
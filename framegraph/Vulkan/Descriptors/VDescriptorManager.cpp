@@ -14,6 +14,9 @@ namespace FG
 	VDescriptorManager::VDescriptorManager (const VDevice &dev) :
 		_device{ dev }
 	{
+		for (auto& slot : _threadSlots) {
+			slot.store( UMax, memory_order_relaxed );
+		}
 	}
 	
 /*
@@ -23,7 +26,7 @@ namespace FG
 */
 	VDescriptorManager::~VDescriptorManager ()
 	{
-		CHECK( _descriptorPools.empty() );
+		CHECK( _poolCount.load( memory_order_relaxed ) == 0 );
 	}
 	
 /*
@@ -33,9 +36,13 @@ namespace FG
 */
 	bool VDescriptorManager::Initialize ()
 	{
-		EXLOCK( _guard );
+		EXLOCK( _createGuard );
+
+		// pools are created on demand for each thread slot
+		uint	index;
+		CHECK_ERR( _CreateDescriptorPool( 0, OUT index ));
 
-		CHECK_ERR( _CreateDescriptorPool() );
+		_threadSlots[0].store( index, memory_order_relaxed );
 		return true;
 	}
 	
@@ -46,53 +53,94 @@ namespace FG
 */
 	void VDescriptorManager::Deinitialize ()
 	{
-		EXLOCK( _guard );
+		EXLOCK( _createGuard );
+
+		const uint	count = _poolCount.exchange( 0, memory_order_relaxed );
 
-		for (auto& item : _descriptorPools)
+		for (uint i = 0; i < count; ++i)
 		{
-			//EXLOCK( item.guard );
+			auto&	item = _descriptorPools[i];
+			EXLOCK( item.guard );
 
 			if ( item.pool )
 			{
 				_device.vkDestroyDescriptorPool( _device.GetVkDevice(), item.pool, null );
 				item.pool = VK_NULL_HANDLE;
 			}
+			item.allocated.store( 0, memory_order_relaxed );
+		}
+
+		for (auto& slot : _threadSlots) {
+			slot.store( UMax, memory_order_relaxed );
 		}
-		_descriptorPools.clear();
 	}
 	
 /*
 =================================================
 	AllocDescriptorSet
+----
+	each thread allocates from the pool of its own slot,
+	so pool lock is contended only by deallocations.
+	When the pool is exhausted then pool of the same slot
+	that has enough free sets is reused or new pool is created.
 =================================================
 */
 	bool  VDescriptorManager::AllocDescriptorSet (VkDescriptorSetLayout layout, OUT DescriptorSet &ds)
 	{
-		EXLOCK( _guard );
+		const uint	slot_idx	= uint(size_t(HashOf( std::this_thread::get_id() )) % MaxThreadSlots);
+		auto&		slot		= _threadSlots[slot_idx];
+		uint		pool_idx	= slot.load( memory_order_acquire );
 
-		VkDescriptorSetAllocateInfo		info = {};
-		info.sType				= VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-		info.descriptorSetCount	= 1;
-		info.pSetLayouts		= &layout;
+		if ( pool_idx < _poolCount.load( memory_order_acquire ) and _AllocInPool( pool_idx, layout, OUT ds ))
+			return true;
+
+		EXLOCK( _createGuard );
+
+		const uint	count = _poolCount.load( memory_order_relaxed );
 
-		for (auto& item : _descriptorPools)
+		for (uint i = 0; i < count; ++i)
 		{
-			//EXLOCK( item.guard );
-			info.descriptorPool = item.pool;
-			
-			if ( _device.vkAllocateDescriptorSets( _device.GetVkDevice(), &info, OUT &ds.first ) == VK_SUCCESS )
+			auto&	item = _descriptorPools[i];
+
+			// skip pools of other threads and pools that are almost full
+			if ( i == pool_idx or item.slot != slot_idx or item.allocated.load( memory_order_relaxed ) >= MaxDescriptorSets / 2 )
+				continue;
+
+			if ( _AllocInPool( i, layout, OUT ds ))
 			{
-				ds.second = uint8_t(Distance( _descriptorPools.data(), &item ));
+				slot.store( i, memory_order_release );
 				return true;
 			}
 		}
 
-		CHECK_ERR( _CreateDescriptorPool() );
-		
-		info.descriptorPool = _descriptorPools.back().pool;
-		VK_CHECK( _device.vkAllocateDescriptorSets( _device.GetVkDevice(), &info, OUT &ds.first ));
-		ds.second = uint8_t(_descriptorPools.size() - 1);
+		CHECK_ERR( _CreateDescriptorPool( slot_idx, OUT pool_idx ));
+		slot.store( pool_idx, memory_order_release );
 
+		CHECK_ERR( _AllocInPool( pool_idx, layout, OUT ds ));
+		return true;
+	}
+	
+/*
+=================================================
+	_AllocInPool
+=================================================
+*/
+	bool  VDescriptorManager::_AllocInPool (uint index, VkDescriptorSetLayout layout, OUT DescriptorSet &ds)
+	{
+		auto&	item = _descriptorPools[index];
+		EXLOCK( item.guard );
+
+		VkDescriptorSetAllocateInfo		info = {};
+		info.sType				= VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+		info.descriptorPool		= item.pool;
+		info.descriptorSetCount	= 1;
+		info.pSetLayouts		= &layout;
+			
+		if ( _device.vkAllocateDescriptorSets( _device.GetVkDevice(), &info, OUT &ds.first ) != VK_SUCCESS )
+			return false;
+
+		ds.second = CheckCast<uint16_t>( index );
+		item.allocated.fetch_add( 1, memory_order_relaxed );
 		return true;
 	}
 	
@@ -103,10 +151,13 @@ namespace FG
 */
 	bool  VDescriptorManager::DeallocDescriptorSet (const DescriptorSet &ds)
 	{
-		EXLOCK( _guard );
-		CHECK_ERR( ds.second < _descriptorPools.size() );
+		CHECK_ERR( ds.second < _poolCount.load( memory_order_acquire ));
+
+		auto&	item = _descriptorPools[ds.second];
+		EXLOCK( item.guard );
 
-		VK_CALL( _device.vkFreeDescriptorSets( _device.GetVkDevice(), _descriptorPools[ds.second].pool, 1, &ds.first ));
+		VK_CALL( _device.vkFreeDescriptorSets( _device.GetVkDevice(), item.pool, 1, &ds.first ));
+		item.allocated.fetch_sub( 1, memory_order_relaxed );
 		return true;
 	}
 	
@@ -117,27 +168,35 @@ namespace FG
 */
 	bool  VDescriptorManager::DeallocDescriptorSets (ArrayView<DescriptorSet> descSets)
 	{
-		EXLOCK( _guard );
-
 		FixedArray< VkDescriptorSet, 32 >	temp;
-		uint8_t								last_idx = UMax;
+		uint16_t							last_idx = UMax;
+
+		const auto	FreeSets = [this, &temp] (uint16_t index)
+		{
+			auto&	item = _descriptorPools[index];
+			EXLOCK( item.guard );
+
+			VK_CALL( _device.vkFreeDescriptorSets( _device.GetVkDevice(), item.pool, uint(temp.size()), temp.data() ));
+			item.allocated.fetch_sub( uint(temp.size()), memory_order_relaxed );
+			temp.clear();
+		};
+
+		const uint	count = _poolCount.load( memory_order_acquire );
 
 		for (auto& ds : descSets)
 		{
-			if ( last_idx != ds.second and temp.size() )
-			{
-				VK_CALL( _device.vkFreeDescriptorSets( _device.GetVkDevice(), _descriptorPools[last_idx].pool, uint(temp.size()), temp.data() ));
-				temp.clear();
-			}
+			CHECK_ERR( ds.second < count );
+
+			if ( (last_idx != ds.second and temp.size()) or temp.size() == temp.capacity() )
+				FreeSets( last_idx );
 
 			last_idx = ds.second;
 			temp.push_back( ds.first );
 		}
 
 		if ( temp.size() )
-		{
-			VK_CALL( _device.vkFreeDescriptorSets( _device.GetVkDevice(), _descriptorPools[last_idx].pool, uint(temp.size()), temp.data() ));
-		}
+			FreeSets( last_idx );
+
 		return true;
 	}
 
@@ -146,9 +205,10 @@ namespace FG
 	_CreateDescriptorPool
 =================================================
 */
-	bool  VDescriptorManager::_CreateDescriptorPool ()
+	bool  VDescriptorManager::_CreateDescriptorPool (uint slot, OUT uint &index)
 	{
-		CHECK_ERR( _descriptorPools.size() < _descriptorPools.capacity() );
+		const uint	count = _poolCount.load( memory_order_relaxed );
+		CHECK_ERR( count < _descriptorPools.size() );
 
 		FixedArray< VkDescriptorPoolSize, 32 >	pool_sizes;
 
@@ -176,10 +236,15 @@ namespace FG
 		info.maxSets		= MaxDescriptorSets;
 		info.flags			= VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT;
 
-		VkDescriptorPool	ds_pool;
-		VK_CHECK( _device.vkCreateDescriptorPool( _device.GetVkDevice(), &info, null, OUT &ds_pool ));
+		auto&	item = _descriptorPools[count];
+		VK_CHECK( _device.vkCreateDescriptorPool( _device.GetVkDevice(), &info, null, OUT &item.pool ));
+
+		item.slot = slot;
+		item.allocated.store( 0, memory_order_relaxed );
 
-		_descriptorPools.push_back({ ds_pool });
+		// pool is visible for other threads after this
+		index = count;
+		_poolCount.store( count + 1, memory_order_release );
 		return true;
 	}
 
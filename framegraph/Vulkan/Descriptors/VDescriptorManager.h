@@ -14,16 +14,23 @@ namespace FG
 	class VDescriptorManager final
 	{
 	// types
-	private:
+	public:
 		static constexpr uint	MaxDescriptorPoolSize	= 1u << 11;
 		static constexpr uint	MaxDescriptorSets		= 1u << 10;
+		static constexpr uint	MaxDescriptorPools		= 1u << 10;
+		static constexpr uint	MaxThreadSlots			= 16;
 
+	private:
 		struct DSPool
 		{
-			VkDescriptorPool	pool	= VK_NULL_HANDLE;
+			Mutex				guard;			// vulkan pool must be externally synchronized
+			VkDescriptorPool	pool		= VK_NULL_HANDLE;
+			Atomic<uint>		allocated	{0};
+			uint				slot		= 0;	// thread slot that allocates from this pool
 		};
 
-		using DescriptorPoolArray_t		= FixedArray< DSPool, 8 >;
+		using DescriptorPoolArray_t		= StaticArray< DSPool, MaxDescriptorPools >;
+		using ThreadSlots_t				= StaticArray< Atomic<uint>, MaxThreadSlots >;
 		using DescriptorSet				= VDescriptorSetLayout::DescriptorSet;
 
 
@@ -31,8 +38,10 @@ namespace FG
 	private:
 		VDevice const&				_device;
 
-		Mutex						_guard;
+		Mutex						_createGuard;		// used only when pool of the thread slot is exhausted
+		Atomic<uint>				_poolCount		{0};
 		DescriptorPoolArray_t		_descriptorPools;
+		ThreadSlots_t				_threadSlots;		// index of the current pool for each thread slot
 
 
 	// methods
@@ -47,8 +56,11 @@ namespace FG
 		bool DeallocDescriptorSet (const DescriptorSet &ds);
 		bool DeallocDescriptorSets (ArrayView<DescriptorSet> ds);
 
+		ND_ uint  GetPoolCount ()	const	{ return _poolCount.load( memory_order_acquire ); }
+
 	private:
-		bool _CreateDescriptorPool ();
+		bool _AllocInPool (uint index, VkDescriptorSetLayout layout, OUT DescriptorSet &ds);
+		bool _CreateDescriptorPool (uint slot, OUT uint &index);
 	};
 
 
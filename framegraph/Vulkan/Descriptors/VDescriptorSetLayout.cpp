@@ -49,6 +49,27 @@ namespace FG
 		}
 	}
 	
+/*
+=================================================
+	constructor
+----
+	layout for the global descriptor heap (see 'VBindlessHeap'),
+	it has no uniforms and never added to the layout cache.
+=================================================
+*/
+	VDescriptorSetLayout::VDescriptorSetLayout (const DescriptorBinding_t &bindlessBinding) :
+		_uniforms{ MakeShared<PipelineDescription::UniformMap_t>() },
+		_updateAfterBind{ true }
+	{
+		EXLOCK( _drCheck );
+
+		for (auto& bind : bindlessBinding)
+		{
+			_hash << HashOf( bind.binding ) << HashOf( bind.descriptorType ) << HashOf( bind.descriptorCount );
+			_maxIndex = Max( _maxIndex, bind.binding );
+		}
+	}
+	
 /*
 =================================================
 	Create
@@ -64,8 +85,30 @@ namespace FG
 		descriptor_info.pBindings		= binding.data();
 		descriptor_info.bindingCount	= uint(binding.size());
 
+		VkDescriptorSetLayoutBindingFlagsCreateInfoEXT	flags_info = {};
+		Array< VkDescriptorBindingFlagsEXT >			binding_flags;
+
+		if ( _updateAfterBind )
+		{
+			CHECK_ERR( dev.GetFeatures().descriptorIndexing );
+
+			binding_flags.resize( binding.size(), VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT_EXT | VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT_EXT |
+												  VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT_EXT );
+
+			flags_info.sType			= VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO_EXT;
+			flags_info.bindingCount		= uint(binding_flags.size());
+			flags_info.pBindingFlags	= binding_flags.data();
+
+			descriptor_info.pNext		= &flags_info;
+			descriptor_info.flags		= VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT_EXT;
+		}
+
 		VK_CHECK( dev.vkCreateDescriptorSetLayout( dev.GetVkDevice(), &descriptor_info, null, OUT &_layout ));
 
+		// global descriptor heap is updated per descriptor, template is not needed
+		if ( not _updateAfterBind )
+			CHECK_ERR( _CreateUpdateTemplate( dev, binding ));
+
 		_resourcesTemplate = PipelineResourcesHelper::CreateDynamicData( _uniforms, _maxIndex+1, _elementCount, _dynamicOffsetCount );
 		return true;
 	}
@@ -83,23 +126,121 @@ namespace FG
 			resMngr.GetDescriptorManager().DeallocDescriptorSets( _descSetCache );
 		}
 
+		auto&	dev = resMngr.GetDevice();
+
+		if ( _updateTemplate ) {
+			dev.vkDestroyDescriptorUpdateTemplateKHR( dev.GetVkDevice(), _updateTemplate, null );
+		}
+
 		if ( _layout ) {
-			auto&	dev = resMngr.GetDevice();
 			dev.vkDestroyDescriptorSetLayout( dev.GetVkDevice(), _layout, null );
 		}
 
 		_descSetCache.clear();
+		_templateBindings.clear();
 		_resourcesTemplate.reset();
 		_poolSize.clear();
 
 		_uniforms			= null;
 		_layout				= VK_NULL_HANDLE;
+		_updateTemplate		= VK_NULL_HANDLE;
+		_templateDataSize	= 0;
 		_hash				= Default;
 		_maxIndex			= 0;
 		_elementCount		= 0;
 		_dynamicOffsetCount	= 0;
+		_updateAfterBind	= false;
 	}
 	
+/*
+=================================================
+	_CreateUpdateTemplate
+----
+	descriptors are packed into the single data blob
+	in the template order, so all descriptors of the set
+	are updated by single call without 'VkWriteDescriptorSet' setup.
+=================================================
+*/
+	bool VDescriptorSetLayout::_CreateUpdateTemplate (const VDevice &dev, const DescriptorBinding_t &binding)
+	{
+		if ( not dev.GetFeatures().descriptorUpdateTemplate or binding.empty() )
+			return true;
+
+		// unsized arrays may have different number of elements
+		for (auto& un : *_uniforms)
+		{
+			if ( un.second.arraySize == 0 )
+				return true;
+		}
+
+		Array< VkDescriptorUpdateTemplateEntry >	entries;
+		TemplateBindings_t							bindings;
+		uint										offset	= 0;
+		
+		entries.reserve( binding.size() );
+		bindings.resize( _maxIndex+1 );
+
+		for (auto& bind : binding)
+		{
+			size_t	stride = 0;
+
+			switch ( bind.descriptorType )
+			{
+				case VK_DESCRIPTOR_TYPE_SAMPLER :
+				case VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER :
+				case VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE :
+				case VK_DESCRIPTOR_TYPE_STORAGE_IMAGE :
+				case VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT :			stride = sizeof(VkDescriptorImageInfo);		break;
+
+				case VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER :
+				case VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER :		stride = sizeof(VkBufferView);				break;
+
+				case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER :
+				case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER :
+				case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC :
+				case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC :	stride = sizeof(VkDescriptorBufferInfo);	break;
+
+				// acceleration structures are written by 'vkUpdateDescriptorSets'
+				default :											return true;
+			}
+
+			auto&	entry = entries.emplace_back();
+			entry.dstBinding		= bind.binding;
+			entry.dstArrayElement	= 0;
+			entry.descriptorCount	= bind.descriptorCount;
+			entry.descriptorType	= bind.descriptorType;
+			entry.offset			= offset;
+			entry.stride			= stride;
+
+			bindings[ bind.binding ] = TemplateBinding{ offset, bind.descriptorCount };
+			offset += CheckCast<uint>( stride * bind.descriptorCount );
+		}
+
+		VkDescriptorUpdateTemplateCreateInfo	info = {};
+		info.sType						= VK_STRUCTURE_TYPE_DESCRIPTOR_UPDATE_TEMPLATE_CREATE_INFO;
+		info.descriptorUpdateEntryCount	= uint(entries.size());
+		info.pDescriptorUpdateEntries	= entries.data();
+		info.templateType				= VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_DESCRIPTOR_SET;
+		info.descriptorSetLayout		= _layout;
+
+		VK_CHECK( dev.vkCreateDescriptorUpdateTemplateKHR( dev.GetVkDevice(), &info, null, OUT &_updateTemplate ));
+
+		_templateBindings	= std::move(bindings);
+		_templateDataSize	= offset;
+		return true;
+	}
+	
+/*
+=================================================
+	GetTemplateBinding
+=================================================
+*/
+	VDescriptorSetLayout::TemplateBinding  VDescriptorSetLayout::GetTemplateBinding (uint binding) const
+	{
+		SHAREDLOCK( _drCheck );
+		return binding < _templateBindings.size() ? _templateBindings[binding] : TemplateBinding{};
+	}
+
 /*
 =================================================
 	AllocDescriptorSet
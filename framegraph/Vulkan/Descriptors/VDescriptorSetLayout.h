@@ -18,13 +18,20 @@ namespace FG
 	// types
 	public:
 		using DescriptorBinding_t	= Array< VkDescriptorSetLayoutBinding >;
-		using DescriptorSet			= Pair< VkDescriptorSet, /*pool index*/uint8_t >;
+		using DescriptorSet			= Pair< VkDescriptorSet, /*pool index*/uint16_t >;
+
+		struct TemplateBinding
+		{
+			uint	offset	= UMax;		// offset in the update template data
+			uint	count	= 0;
+		};
 
 	private:
 		using UniformMapPtr			= PipelineDescription::UniformMapPtr;
 		using PoolSizeArray_t		= FixedArray< VkDescriptorPoolSize, 10 >;
 		using DynamicDataPtr		= PipelineResources::DynamicDataPtr;
 		using DescSetCache_t		= FixedArray< DescriptorSet, 32 >;
+		using TemplateBindings_t	= Array< TemplateBinding >;
 
 
 	// variables
@@ -41,8 +48,13 @@ namespace FG
 		mutable Mutex			_descSetCacheGuard;
 		mutable DescSetCache_t	_descSetCache;
 
+		VkDescriptorUpdateTemplate	_updateTemplate		= VK_NULL_HANDLE;
+		TemplateBindings_t		_templateBindings;		// indexed by binding
+		uint					_templateDataSize	= 0;
+
+		bool					_updateAfterBind	= false;	// layout of the global descriptor heap
+
 		DebugName_t				_debugName;
-		// TODO: desc set update template
 
 		RWDataRaceCheck			_drCheck;
 
@@ -53,6 +65,7 @@ namespace FG
 		VDescriptorSetLayout (VDescriptorSetLayout &&) = delete;
 		VDescriptorSetLayout (const VDescriptorSetLayout &) = delete;
 		VDescriptorSetLayout (const VDevice &dev, const UniformMapPtr &uniforms, OUT DescriptorBinding_t &binding);
+		explicit VDescriptorSetLayout (const DescriptorBinding_t &bindlessBinding);
 		~VDescriptorSetLayout ();
 
 		bool Create (const VDevice &dev, const DescriptorBinding_t &binding);
@@ -70,8 +83,13 @@ namespace FG
 		ND_ uint					GetMaxIndex ()		const	{ SHAREDLOCK( _drCheck );  return _maxIndex; }
 		ND_ StringView				GetDebugName ()		const	{ SHAREDLOCK( _drCheck );  return _debugName; }
 
+		ND_ VkDescriptorUpdateTemplate	GetUpdateTemplate ()	const	{ SHAREDLOCK( _drCheck );  return _updateTemplate; }
+		ND_ uint						GetTemplateDataSize ()	const	{ SHAREDLOCK( _drCheck );  return _templateDataSize; }
+		ND_ TemplateBinding				GetTemplateBinding (uint binding) const;
+
 
 	private:
+		bool _CreateUpdateTemplate (const VDevice &dev, const DescriptorBinding_t &binding);
 		void _AddUniform (const PipelineDescription::Uniform &un, INOUT DescriptorBinding_t &binding);
 		void _AddImage (const PipelineDescription::Image &img, uint bindingIndex, uint arraySize, EShaderStages stageFlags, INOUT DescriptorBinding_t &binding);
 		void _AddTexture (const PipelineDescription::Texture &tex, uint bindingIndex, uint arraySize, EShaderStages stageFlags, INOUT DescriptorBinding_t &binding);
@@ -84,6 +84,25 @@ namespace FG
 		CHECK_ERR( ds_layout->AllocDescriptorSet( resMngr, OUT _descriptorSet ));
 		
 		UpdateDescriptors	update;
+		update.layout = ds_layout;
+
+		if ( VkDescriptorUpdateTemplate templ = ds_layout->GetUpdateTemplate() )
+		{
+			bool	is_valid = true;
+			update.templateData = Cast<uint8_t>( update.allocator.Alloc( BytesU{ds_layout->GetTemplateDataSize()}, AlignOf<VkDescriptorBufferInfo> ));
+
+			_dataPtr->ForEachUniform( [&](auto& un, auto& data) { is_valid &= _AddResource( resMngr, un, data, INOUT update ); });
+
+			if ( is_valid )
+			{
+				dev.vkUpdateDescriptorSetWithTemplateKHR( dev.GetVkDevice(), _descriptorSet.first, templ, update.templateData );
+				return true;
+			}
+
+			// some resources are invalid, write only valid descriptors
+			update.templateData = null;
+		}
+
 		update.descriptors		= update.allocator.Alloc< VkWriteDescriptorSet >( ds_layout->GetMaxIndex() + 1 );
 		update.descriptorIndex	= 0;
 
@@ -93,6 +112,23 @@ namespace FG
 		return true;
 	}
 
+/*
+=================================================
+	UpdateDescriptors::AllocInfo
+=================================================
+*/
+	template <typename T>
+	inline T*  VPipelineResources::UpdateDescriptors::AllocInfo (uint binding, uint count)
+	{
+		if ( not templateData )
+			return allocator.Alloc<T>( count );
+
+		// number of elements must match the template
+		const auto	bind = layout->GetTemplateBinding( binding );
+
+		return bind.count == count ? BitCast<T *>( templateData + bind.offset ) : null;
+	}
+
 /*
 =================================================
 	Destroy
@@ -241,7 +277,10 @@ namespace FG
 */
 	bool  VPipelineResources::_AddResource (VResourceManager &resMngr, const UniformID &un, INOUT PipelineResources::Buffer &buf, INOUT UpdateDescriptors &list)
 	{
-		auto*	info = list.allocator.Alloc< VkDescriptorBufferInfo >( buf.elementCount );
+		auto*	info = list.AllocInfo< VkDescriptorBufferInfo >( buf.index.VKBinding(), buf.elementCount );
+
+		if_unlikely( not info )
+			return false;
 
 		for (uint i = 0; i < buf.elementCount; ++i)
 		{
@@ -264,6 +303,9 @@ namespace FG
 		const bool	is_uniform	= ((buf.state & EResourceState::_StateMask) == EResourceState::UniformRead);
 		const bool	is_dynamic	= AllBits( buf.state, EResourceState::_BufferDynamicOffset );
 
+		if ( list.templateData )
+			return true;
+
 		VkWriteDescriptorSet&	wds = list.descriptors[list.descriptorIndex++];
 		wds = {};
 		wds.sType			= VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
@@ -285,7 +327,10 @@ namespace FG
 */
 	bool  VPipelineResources::_AddResource (VResourceManager &resMngr, const UniformID &un, INOUT PipelineResources::TexelBuffer &texbuf, INOUT UpdateDescriptors &list)
 	{
-		auto*	info = list.allocator.Alloc< VkBufferView >( texbuf.elementCount );
+		auto*	info = list.AllocInfo< VkBufferView >( texbuf.index.VKBinding(), texbuf.elementCount );
+
+		if_unlikely( not info )
+			return false;
 
 		for (uint i = 0; i < texbuf.elementCount; ++i)
 		{
@@ -311,6 +356,9 @@ namespace FG
 		
 		const bool	is_uniform	= ((texbuf.state & EResourceState::_StateMask) == EResourceState::UniformRead);
 
+		if ( list.templateData )
+			return true;
+
 		VkWriteDescriptorSet&	wds = list.descriptors[list.descriptorIndex++];
 		wds = {};
 		wds.sType				= VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
@@ -330,7 +378,10 @@ namespace FG
 */
 	bool  VPipelineResources::_AddResource (VResourceManager &resMngr, const UniformID &un, INOUT PipelineResources::Image &img, INOUT UpdateDescriptors &list)
 	{
-		auto*	info = list.allocator.Alloc< VkDescriptorImageInfo >( img.elementCount );
+		auto*	info = list.AllocInfo< VkDescriptorImageInfo >( img.index.VKBinding(), img.elementCount );
+
+		if_unlikely( not info )
+			return false;
 
 		for (uint i = 0; i < img.elementCount; ++i)
 		{
@@ -357,6 +408,9 @@ namespace FG
 			_CheckImageUsage( *img_res, img.state );
 		}		
 		
+		if ( list.templateData )
+			return true;
+
 		VkWriteDescriptorSet&	wds = list.descriptors[list.descriptorIndex++];
 		wds = {};
 		wds.sType			= VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
@@ -377,7 +431,10 @@ namespace FG
 */
 	bool  VPipelineResources::_AddResource (VResourceManager &resMngr, const UniformID &un, INOUT PipelineResources::Texture &tex, INOUT UpdateDescriptors &list)
 	{
-		auto*	info = list.allocator.Alloc< VkDescriptorImageInfo >( tex.elementCount );
+		auto*	info = list.AllocInfo< VkDescriptorImageInfo >( tex.index.VKBinding(), tex.elementCount );
+
+		if_unlikely( not info )
+			return false;
 
 		for (uint i = 0; i < tex.elementCount; ++i)
 		{
@@ -405,6 +462,9 @@ namespace FG
 			_CheckImageUsage( *img_res, tex.state );
 		}
 		
+		if ( list.templateData )
+			return true;
+
 		VkWriteDescriptorSet&	wds = list.descriptors[list.descriptorIndex++];
 		wds = {};
 		wds.sType			= VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
@@ -424,7 +484,10 @@ namespace FG
 */
 	bool  VPipelineResources::_AddResource (VResourceManager &resMngr, const UniformID &un, const PipelineResources::Sampler &samp, INOUT UpdateDescriptors &list)
 	{
-		auto*	info = list.allocator.Alloc< VkDescriptorImageInfo >( samp.elementCount );
+		auto*	info = list.AllocInfo< VkDescriptorImageInfo >( samp.index.VKBinding(), samp.elementCount );
+
+		if_unlikely( not info )
+			return false;
 
 		for (uint i = 0; i < samp.elementCount; ++i)
 		{
@@ -442,6 +505,9 @@ namespace FG
 			info[i].sampler		= sampler->Handle();
 		}
 		
+		if ( list.templateData )
+			return true;
+
 		VkWriteDescriptorSet&	wds = list.descriptors[list.descriptorIndex++];
 		wds = {};
 		wds.sType			= VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
@@ -462,6 +528,8 @@ namespace FG
 	bool  VPipelineResources::_AddResource (VResourceManager &resMngr, const UniformID &un, const PipelineResources::RayTracingScene &rtScene, INOUT UpdateDescriptors &list)
 	{
 	#ifdef VK_NV_ray_tracing
+		ASSERT( not list.templateData );
+
 		auto*	tlas = list.allocator.Alloc<VkAccelerationStructureNV>( rtScene.elementCount );
 
 		for (uint i = 0; i < rtScene.elementCount; ++i)
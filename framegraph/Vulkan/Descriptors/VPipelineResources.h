@@ -20,8 +20,13 @@ namespace FG
 		struct UpdateDescriptors
 		{
 			LinearAllocator<>			allocator;
-			VkWriteDescriptorSet *		descriptors;
-			uint						descriptorIndex;
+			VkWriteDescriptorSet *		descriptors		= null;
+			uint						descriptorIndex	= 0;
+			uint8_t *					templateData	= null;		// if not null then descriptors are packed for the update template
+			VDescriptorSetLayout const*	layout			= null;
+
+			template <typename T>
+			ND_ T*  AllocInfo (uint binding, uint count);
 		};
 
 		//using Element_t			= Union< VkDescriptorBufferInfo, VkDescriptorImageInfo, VkAccelerationStructureNV >;
@@ -6,6 +6,7 @@
 #include "framegraph/Shared/ImageViewDesc.h"
 #include "framegraph/Public/FrameGraph.h"
 #include "VCommon.h"
+#include <condition_variable>
 
 namespace FG
 {
@@ -23,6 +24,15 @@ namespace FG
 		using ImageViewMap_t	= HashMap< HashedImageViewDesc, VkImageView, HashOfImageViewDesc >;
 		using OnRelease_t		= IFrameGraph::OnExternalImageReleased_t;
 
+		// last known state of the whole image, see 'CommandBufferDesc::persistentState'
+		struct LastState
+		{
+			VDeviceQueueInfoPtr		queue;				// null if image is in default layout
+			VkImageLayout			layout		= Zero;
+			VkPipelineStageFlagBits	stages		= Zero;
+			VkAccessFlagBits		access		= Zero;
+		};
+
 
 	// variables
 	private:
@@ -41,6 +51,14 @@ namespace FG
 		DebugName_t					_debugName;
 		OnRelease_t					_onRelease;
 
+		mutable Mutex				_lastStateGuard;
+		mutable std::condition_variable	_lastStateCV;	// notified when '_lastStateOwner' is reset
+		mutable LastState			_lastState;
+		mutable void const*			_lastStateOwner		= null;		// local image that loaded state and has not stored it yet
+		mutable Atomic<VCmdBatch *>	_lastStateBatch		{null};	// batch that stored state, reset when batch is complete
+		mutable Atomic<bool>		_hasLastState		{false};
+		bool						_canKeepState		= false;	// false for external and host visible images
+
 		RWDataRaceCheck				_drCheck;
 
 
@@ -65,6 +83,13 @@ namespace FG
 		
 		ND_ bool				IsReadOnly ()			const;
 
+		ND_ LastState			GetLastState ()			const;
+		ND_ bool				AcquireLastState (void const* owner, Ptr<VCmdBatch> batch, OUT LastState &) const;
+			void				ReleaseLastState (void const* owner) const;
+			void				ReleaseLastState (void const* owner, Ptr<VCmdBatch> batch, const LastState &) const;
+			void				ResetLastStateBatch (const VCmdBatch *batch) const;
+		ND_ bool				HasLastState ()			const	{ return _hasLastState.load( memory_order_relaxed ); }
+
 		ND_ VkImage				Handle ()				const	{ SHAREDLOCK( _drCheck );  return _image; }
 		ND_ RawMemoryID			GetMemoryID ()			const	{ SHAREDLOCK( _drCheck );  return _memoryId.Get(); }
 
@@ -86,6 +111,7 @@ namespace FG
 		ND_ bool				IsExclusiveSharing ()	const	{ SHAREDLOCK( _drCheck );  return _queueFamilyMask == Default; }
 		ND_ EQueueFamilyMask	GetQueueFamilyMask ()	const	{ SHAREDLOCK( _drCheck );  return _queueFamilyMask; }
 		ND_ StringView			GetDebugName ()			const	{ SHAREDLOCK( _drCheck );  return _debugName; }
+		ND_ bool				CanKeepState ()			const	{ SHAREDLOCK( _drCheck );  return _canKeepState; }
 		
 		ND_ static bool	IsSupported (const VDevice &dev, const ImageDesc &desc, EMemoryType memType);
 		ND_ bool		IsSupported (const VDevice &dev, const ImageViewDesc &desc) const;
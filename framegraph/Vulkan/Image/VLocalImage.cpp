@@ -24,11 +24,14 @@ namespace FG
 	Create
 =================================================
 */
-	bool VLocalImage::Create (const VImage *imageData)
+	bool VLocalImage::Create (const VImage *imageData, LinearAllocator<> &allocator)
 	{
 		CHECK_ERR( _imageData == null );
 		CHECK_ERR( imageData );
 
+		_pendingAccesses.SetAllocator( allocator );
+		_accessForReadWrite.SetAllocator( allocator );
+
 		_imageData		= imageData;
 		_finalLayout	= _imageData->DefaultLayout();
 		_isImmutable	= false; //_imageData->IsReadOnly();
@@ -57,14 +60,17 @@ namespace FG
 */
 	void VLocalImage::Destroy ()
 	{
+		ASSERT( not _ownsLastState );
+
 		_imageData	= null;
 		
 		// check for uncommited barriers
 		ASSERT( _pendingAccesses.empty() );
 		ASSERT( _accessForReadWrite.empty() );
 
-		_pendingAccesses.clear();
-		_accessForReadWrite.clear();
+		// memory will be discarded by command buffer allocator
+		_pendingAccesses.Release();
+		_accessForReadWrite.Release();
 	}
 
 /*
@@ -226,39 +232,11 @@ namespace FG
 		pending.access			= EResourceState_ToAccess( is.state );
 		pending.layout			= is.layout;
 		pending.index			= is.task->ExecutionOrder();
+		pending.region			= is.range.Region();
 		
 
-		// extract sub ranges
-		const uint		arr_layers	= ArrayLayers();
-		const uint		mip_levels	= MipmapLevels();
-		Array<SubRange>	sub_ranges;
-		SubRange		layer_range	 { is.range.Layers().begin,  Min( is.range.Layers().end,  arr_layers )};
-		SubRange		mipmap_range { is.range.Mipmaps().begin, Min( is.range.Mipmaps().end, mip_levels )};
-
-		if ( is.range.IsWholeLayers() and is.range.IsWholeMipmaps() )
-		{
-			sub_ranges.push_back(SubRange{ 0, arr_layers * mip_levels });
-		}
-		else
-		if ( is.range.IsWholeLayers() )
-		{
-			uint	begin = mipmap_range.begin   * arr_layers + layer_range.begin;
-			uint	end   = (mipmap_range.end-1) * arr_layers + layer_range.end;
-				
-			sub_ranges.push_back(SubRange{ begin, end });
-		}
-		else
-		for (uint mip = mipmap_range.begin; mip < mipmap_range.end; ++mip)
-		{
-			uint	begin = mip * arr_layers + layer_range.begin;
-			uint	end   = mip * arr_layers + layer_range.end;
-
-			sub_ranges.push_back(SubRange{ begin, end });
-		}
-
-
 		// merge with pending
-		for (auto& range : sub_ranges)
+		const auto	MergeWithPending = [this, &pending] (SubRange range)
 		{
 			auto	iter = _FindFirstAccess( _pendingAccesses, range );
 
@@ -285,6 +263,7 @@ namespace FG
 				iter->isWritable		|= pending.isWritable;
 				iter->invalidateBefore	&= pending.invalidateBefore;
 				iter->invalidateAfter	&= pending.invalidateAfter;
+				iter->region.Merge( pending.region );
 			}
 
 			if ( not range.IsEmpty() )
@@ -292,6 +271,34 @@ namespace FG
 				pending.range = range;
 				_pendingAccesses.insert( iter, pending );
 			}
+		};
+
+
+		// extract sub ranges
+		const uint		arr_layers	= ArrayLayers();
+		const uint		mip_levels	= MipmapLevels();
+		SubRange		layer_range	 { is.range.Layers().begin,  Min( is.range.Layers().end,  arr_layers )};
+		SubRange		mipmap_range { is.range.Mipmaps().begin, Min( is.range.Mipmaps().end, mip_levels )};
+
+		if ( is.range.IsWholeLayers() and is.range.IsWholeMipmaps() )
+		{
+			MergeWithPending( SubRange{ 0, arr_layers * mip_levels });
+		}
+		else
+		if ( is.range.IsWholeLayers() )
+		{
+			uint	begin = mipmap_range.begin   * arr_layers + layer_range.begin;
+			uint	end   = (mipmap_range.end-1) * arr_layers + layer_range.end;
+				
+			MergeWithPending( SubRange{ begin, end });
+		}
+		else
+		for (uint mip = mipmap_range.begin; mip < mipmap_range.end; ++mip)
+		{
+			uint	begin = mip * arr_layers + layer_range.begin;
+			uint	end   = mip * arr_layers + layer_range.end;
+
+			MergeWithPending( SubRange{ begin, end });
 		}
 	}
 	
@@ -324,11 +331,154 @@ namespace FG
 
 		// flush
 		_accessForReadWrite.clear();
+
+		if ( _ownsLastState )
+			_imageData->ReleaseLastState( this, null, {} );
+
+		_ownsLastState = false;
+	}
+
+/*
+=================================================
+	LoadLastState
+----
+	continue from the state that was stored by previous command buffer,
+	pipeline barrier can wait for previous commands only on the same queue,
+	on other queue batch dependency (semaphore) is used.
+	Called when command buffer is executed, state is owned by this image
+	until 'StoreLastState()' or 'ResetState()' is called.
+	Returns 'false' if state is not acquired.
+=================================================
+*/
+	bool VLocalImage::LoadLastState (VDeviceQueueInfoPtr queue, Ptr<VCmdBatch> batch) const
+	{
+		ASSERT( _accessForReadWrite.size() == 1 );
+		ASSERT( not _ownsLastState );
+
+		if ( not _imageData->CanKeepState() )
+			return true;
+
+		VImage::LastState	last;
+		CHECK_ERR( _imageData->AcquireLastState( this, batch, OUT last ));
+		
+		_ownsLastState = true;
+
+		if ( last.queue == null )
+			return true;
+
+		auto&	initial = _accessForReadWrite.front();
+
+		// image that was kept in last state may require layout transition
+		_isImmutable = false;
+
+		// keep undefined layout if image is invalidated, see 'SetInitialState()'
+		if ( initial.layout == _imageData->DefaultLayout() )
+			initial.layout = last.layout;
+
+		if ( last.queue == queue )
+		{
+			initial.stages		= last.stages;
+			initial.access		= last.access;
+			initial.isReadable	= true;
+			initial.isWritable	= (last.access != 0);
+		}
+
+		return true;
+	}
+
+/*
+=================================================
+	DiscardLastState
+----
+	release state without changes, used when command buffer failed to load states
+=================================================
+*/
+	void VLocalImage::DiscardLastState () const
+	{
+		if ( not _ownsLastState )
+			return;
+
+		_imageData->ReleaseLastState( this );
+		_ownsLastState = false;
+	}
+
+/*
+=================================================
+	StoreLastState
+----
+	keep image layout and access state for the next command buffer instead of transition to default layout.
+	If subresources are in different layouts, then image is transited to default layout.
+	Returns 'false' if state is reset and full barrier is required.
+=================================================
+*/
+	bool VLocalImage::StoreLastState (VDeviceQueueInfoPtr queue, Ptr<VCmdBatch> batch, VBarrierManager &barrierMngr, Ptr<VLocalDebugger> debugger) const
+	{
+		ASSERT( _pendingAccesses.empty() and "you must commit all pending states before reseting" );
+		ASSERT( queue );
+
+		if ( not _ownsLastState )
+		{
+			ResetState( ExeOrderIndex::Final, barrierMngr, debugger );
+			return false;
+		}
+
+		if ( _isImmutable )
+		{
+			_imageData->ReleaseLastState( this );
+			_ownsLastState = false;
+			_accessForReadWrite.clear();
+			return true;
+		}
+
+		VImage::LastState	last;
+		last.queue = queue;
+
+		if ( _accessForReadWrite.size() == 1 and _accessForReadWrite.front().range == SubRange{ 0, ArrayLayers() * MipmapLevels() })
+		{
+			auto&	rec = _accessForReadWrite.front();
+
+			last.layout	= rec.layout;
+			last.stages	= rec.stages;
+
+			// only write access must be made visible
+			if ( rec.isWritable )
+				last.access = rec.access;
+		}
+		else
+		{
+			// wait for all commands because the next command buffer can not wait for specific stages of layout transition
+			ImageAccess		pending;
+			pending.isReadable		= true;
+			pending.isWritable		= false;
+			pending.invalidateBefore= false;
+			pending.invalidateAfter	= false;
+			pending.stages			= VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+			pending.access			= _imageData->GetAllReadAccessMask();
+			pending.layout			= _finalLayout;
+			pending.index			= ExeOrderIndex::Final;
+			pending.range			= SubRange{ 0, ArrayLayers() * MipmapLevels() };
+
+			_pendingAccesses.push_back( pending );
+			CommitBarrier( barrierMngr, debugger );
+
+			last.layout	= _finalLayout;
+			last.stages	= VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+			last.access	= Zero;
+		}
+
+		_imageData->ReleaseLastState( this, batch, last );
+		_ownsLastState = false;
+		_accessForReadWrite.clear();
+		return true;
 	}
 
 /*
 =================================================
 	CommitBarrier
+----
+	accesses to non-intersecting regions of the same subresource with the same layout
+	don't require barrier, in this case access records are merged,
+	so the next access to any of these regions will wait for all of them.
 =================================================
 */
 	void VLocalImage::CommitBarrier (VBarrierManager &barrierMngr, Ptr<VLocalDebugger> debugger) const
@@ -337,7 +487,8 @@ namespace FG
 
 		for (const auto& pending : _pendingAccesses)
 		{
-			const auto	first = _FindFirstAccess( _accessForReadWrite, pending.range );
+			const auto	first	= _FindFirstAccess( _accessForReadWrite, pending.range );
+			ImageAccess	merged	= pending;
 
 			for (auto iter = first; iter != _accessForReadWrite.end() and iter->range.begin < pending.range.end; ++iter)
 			{
@@ -348,7 +499,25 @@ namespace FG
 											  (iter->isReadable and pending.isWritable)	or		// read -> write
 											  iter->isWritable;									// write -> read/write
 
-				if ( not range.IsEmpty() and is_modified )
+				const bool		is_disjoint	= (iter->layout == pending.layout) and not iter->region.IsIntersects( pending.region );
+
+				if ( range.IsEmpty() )
+					continue;
+
+				// without barrier the next access must wait for previous access too
+				if ( not is_modified or is_disjoint )
+				{
+					merged.region.Merge( iter->region );
+
+					if ( is_modified )
+					{
+						merged.stages		|= iter->stages;
+						merged.access		|= iter->access;
+						merged.isReadable	|= iter->isReadable;
+						merged.isWritable	|= iter->isWritable;
+					}
+				}
+				else
 				{
 					VkImageMemoryBarrier	barrier = {};
 					barrier.sType				= VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
@@ -371,7 +540,7 @@ namespace FG
 					ASSERT( barrier.subresourceRange.layerCount > 0 );
 
 					dst_stages |= pending.stages;
-					barrierMngr.AddImageBarrier( iter->stages, pending.stages, 0, barrier );
+					barrierMngr.AddImageBarrier( iter->index, pending.index, iter->stages, pending.stages, 0, barrier );
 
 					if ( debugger ) {
 						debugger->AddImageBarrier( _imageData.get(), iter->index, pending.index, iter->stages, pending.stages, 0, barrier );
@@ -379,7 +548,7 @@ namespace FG
 				}
 			}
 
-			_ReplaceAccessRecords( _accessForReadWrite, first, pending );
+			_ReplaceAccessRecords( _accessForReadWrite, first, merged );
 		}
 
 		_pendingAccesses.clear();
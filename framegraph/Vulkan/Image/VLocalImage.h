@@ -5,6 +5,7 @@
 #include "VImage.h"
 #include "framegraph/Public/EResourceState.h"
 #include "framegraph/Shared/ImageDataRange.h"
+#include "stl/Containers/LinearArray.h"
 
 namespace FG
 {
@@ -39,11 +40,13 @@ namespace FG
 
 	private:
 		using SubRange	= ImageRange::SubRange_t;
+		using Region	= ImageRange::RegionU;
 
 		struct ImageAccess
 		{
 		// variables
 			SubRange				range;
+			Region					region;			// bounding box of all accesses since last barrier
 			VkImageLayout			layout			= Zero;
 			VkPipelineStageFlagBits	stages			= Zero;
 			VkAccessFlagBits		access			= Zero;
@@ -58,7 +61,7 @@ namespace FG
 		};
 
 		using ImageViewMap_t	= VImage::ImageViewMap_t;
-		using AccessRecords_t	= Array< ImageAccess >;		// TODO: fixed size array or custom allocator
+		using AccessRecords_t	= LinearArray< ImageAccess >;	// memory is allocated from command buffer allocator
 		using AccessIter_t		= AccessRecords_t::iterator;
 
 		
@@ -70,6 +73,7 @@ namespace FG
 		mutable AccessRecords_t		_pendingAccesses;
 		mutable AccessRecords_t		_accessForReadWrite;
 		mutable bool				_isImmutable	= false;
+		mutable bool				_ownsLastState	= false;	// state is acquired from global image and must be released
 
 
 	// methods
@@ -79,12 +83,15 @@ namespace FG
 		VLocalImage (const VLocalImage &) = delete;
 		~VLocalImage ();
 
-		bool Create (const VImage *);
+		bool Create (const VImage *, LinearAllocator<> &);
 		void Destroy ();
 
 		void SetInitialState (bool immutable, bool invalidate) const;
 		void AddPendingState (const ImageState &) const;
 		void ResetState (ExeOrderIndex index, VBarrierManager &barrierMngr, Ptr<VLocalDebugger> debugger) const;
+		bool LoadLastState (VDeviceQueueInfoPtr queue, Ptr<VCmdBatch> batch) const;
+		void DiscardLastState () const;
+		bool StoreLastState (VDeviceQueueInfoPtr queue, Ptr<VCmdBatch> batch, VBarrierManager &barrierMngr, Ptr<VLocalDebugger> debugger) const;
 		void CommitBarrier (VBarrierManager &barrierMngr, Ptr<VLocalDebugger> debugger) const;
 		
 		ND_ VkImageView			GetView (const VDevice &dev, bool isDefault, INOUT ImageViewDesc &desc) const	{ return _imageData->GetView( dev, isDefault, INOUT desc ); }
@@ -19,6 +19,7 @@ namespace FG
 		VulkanDeviceFn_Init( &_deviceFnTable );
 
 		std::memset( &_properties, 0, sizeof(_properties) );
+		std::memset( &_features, 0, sizeof(_features) );
 
 		FixedArray<VkQueueFamilyProperties, 16>	queue_properties;
 		uint									count = uint(queue_properties.size());
@@ -157,6 +158,9 @@ namespace FG
 		_features.commandPoolTrim			= has_maintenance1;
 		_features.array2DCompatible			= has_maintenance1;
 		#endif
+		#ifdef VK_KHR_descriptor_update_template
+		_features.descriptorUpdateTemplate	= _vkVersion >= EShaderLangFormat::Vulkan_110 or HasDeviceExtension( VK_KHR_DESCRIPTOR_UPDATE_TEMPLATE_EXTENSION_NAME );
+		#endif
 		#ifdef VK_KHR_device_group
 		_features.dispatchBase				= _vkVersion >= EShaderLangFormat::Vulkan_110 or HasDeviceExtension( VK_KHR_DEVICE_GROUP_EXTENSION_NAME );
 		#endif
@@ -187,6 +191,9 @@ namespace FG
 		#ifdef VK_EXT_robustness2
 		_features.robustness2				= HasDeviceExtension( VK_EXT_ROBUSTNESS_2_EXTENSION_NAME );
 		#endif
+		#ifdef VK_KHR_timeline_semaphore
+		_features.timelineSemaphore			= HasDeviceExtension( VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME );
+		#endif
 
 		// load extensions
 		if ( _vkVersion >= EShaderLangFormat::Vulkan_110 or HasInstanceExtension( VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME ))
@@ -227,6 +234,14 @@ namespace FG
 				_properties.robustness2Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_ROBUSTNESS_2_FEATURES_EXT;
 			}
 			#endif
+			#ifdef VK_KHR_timeline_semaphore
+			if ( _features.timelineSemaphore )
+			{
+				*next_feat	= &_properties.timelineSemaphoreFeatures;
+				next_feat	= &_properties.timelineSemaphoreFeatures.pNext;
+				_properties.timelineSemaphoreFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES_KHR;
+			}
+			#endif
 			Unused( next_feat );
 
 			vkGetPhysicalDeviceFeatures2KHR( GetVkPhysicalDevice(), OUT &feat2 );
@@ -240,6 +255,9 @@ namespace FG
 			#ifdef VK_EXT_robustness2
 			_features.robustness2			&= !!(_properties.robustness2Features.robustBufferAccess2 | _properties.robustness2Features.robustImageAccess2 | _properties.robustness2Features.nullDescriptor);
 			#endif
+			#ifdef VK_KHR_timeline_semaphore
+			_features.timelineSemaphore		&= (_properties.timelineSemaphoreFeatures.timelineSemaphore == VK_TRUE);
+			#endif
 
 			VkPhysicalDeviceProperties2	props2		= {};
 			void **						next_props	= &props2.pNext;
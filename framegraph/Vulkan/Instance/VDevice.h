@@ -53,6 +53,7 @@ namespace FG
 			bool	dispatchBase			: 1;
 			bool	array2DCompatible		: 1;
 			bool	blockTexelView			: 1;
+			bool	descriptorUpdateTemplate	: 1;
 			// vulkan 1.2 core
 			bool	samplerMirrorClamp		: 1;
 			bool	descriptorIndexing		: 1;
@@ -69,6 +70,7 @@ namespace FG
 			bool	rayTracingNV			: 1;
 			bool	shadingRateImageNV		: 1;
 			bool	robustness2				: 1;
+			bool	timelineSemaphore		: 1;
 			//bool	rayTracing				: 1;
 		};
 
@@ -103,6 +105,9 @@ namespace FG
 			VkPhysicalDeviceRobustness2FeaturesEXT				robustness2Features;
 			VkPhysicalDeviceRobustness2PropertiesEXT			robustness2Properties;
 			#endif
+			#ifdef VK_KHR_timeline_semaphore
+			VkPhysicalDeviceTimelineSemaphoreFeaturesKHR		timelineSemaphoreFeatures;
+			#endif
 			#ifdef VK_KHR_ray_tracing
 			//VkPhysicalDeviceRayTracingFeaturesKHR				rayTracingFeatures;
 			//VkPhysicalDeviceRayTracingPropertiesKHR			rayTracingProperties;
@@ -23,8 +23,11 @@ namespace FG
 */
 	VFrameGraph::VFrameGraph (const VulkanDeviceInfo &vdi) :
 		_state{ EState::Initial },	_device{ vdi },
-		_queueUsage{ Default },		_resourceMngr{ _device, vdi.maxStagingBufferMemory, vdi.stagingBufferSize },
-		_queryPool{ VK_NULL_HANDLE }
+		_queueUsage{ Default },		_resourceMngr{ _device, vdi.maxStagingBufferMemory, vdi.stagingBufferSize, vdi.enableBindless },
+		_queryPool{ VK_NULL_HANDLE },
+		_pipelineCacheFile{ vdi.pipelineCacheFile },
+		_pipelineCompiler{ _device },
+		_asyncPipelineCompilation{ vdi.asyncPipelineCompilation }
 	{
 	}
 	
@@ -81,11 +84,41 @@ namespace FG
 		}
 
 		CHECK_ERR( _resourceMngr.Initialize() );
+
+		// create pipeline cache
+		if ( _pipelineCacheFile.empty() ) {
+			CHECK_ERR( _pipelineCache.Initialize( _device ));
+		}else{
+			bool	loaded = false;
+			CHECK_ERR( _pipelineCache.Load( _device, _pipelineCacheFile, OUT loaded ));
+		}
+
+		if ( _asyncPipelineCompilation )
+			CHECK_ERR( _pipelineCompiler.Start( FG_PipelineCompilerThreads, _pipelineCache ));
 		
 		CHECK_ERR( _SetState( EState::Initialization, EState::Idle ));
 		return true;
 	}
 	
+/*
+=================================================
+	GetWorkerThreads
+----
+	threads are started when render pass is recorded into secondary command buffers for the first time,
+	current thread is used too.
+=================================================
+*/
+	ThreadPool&  VFrameGraph::GetWorkerThreads ()
+	{
+		std::call_once( _workerThreadsStarted, [this] ()
+		{
+			const uint	thread_count = Min( Max( 1u, std::thread::hardware_concurrency() ), FG_MaxRecordingThreads );
+
+			CHECK( _workerThreads.Start( thread_count - 1, "FG_Worker" ));
+		});
+		return _workerThreads;
+	}
+
 /*
 =================================================
 	Deinitialize
@@ -96,23 +129,41 @@ namespace FG
 		CHECK_ERRV( _SetState( EState::Idle, EState::Destroyed ));
 		CHECK_ERRV( WaitIdle( MaxTimeout ));
 
+		_workerThreads.Stop();
+		_completionThread.Stop();
+		_taskSchedules.Clear();
+
+		// complete pending pipelines while resources are alive, caches are merged into '_pipelineCache'
+		_pipelineCompiler.Stop();
+
 		// delete command buffers
 		{
 			FG_LOGD( "Max command buffers "s << ToString(_cmdBufferPool.CreatedObjectsCount()) );
 			FG_LOGD( "Max command batches "s << ToString(_cmdBatchPool.CreatedObjectsCount()) );
 			FG_LOGD( "Max submitted batches "s << ToString(_submittedPool.CreatedObjectsCount()) );
 
+			// per-thread pipeline caches are merged into '_pipelineCache' here
 			_cmdBufferPool.Release();
 			_cmdBatchPool.Release();
 			_submittedPool.Release([this] (auto& s) { s.Destroy( GetDevice() ); });
 		}
 
+		// save pipeline cache
+		{
+			if ( _pipelineCacheFile.size() )
+				CHECK( _pipelineCache.Save( _device, _pipelineCacheFile ));
+
+			_pipelineCache.Deinitialize( _device );
+		}
+
 		// delete per queue data
 		{
 			EXLOCK( _queueGuard );
 
 			for (auto& q : _queueMap)
 			{
+				_MoveExecutedBatches( q );
+
 				CHECK( q.pending.empty() );
 				CHECK( q.submitted.empty() );
 
@@ -122,6 +173,10 @@ namespace FG
 					_device.vkDestroySemaphore( _device.GetVkDevice(), sem, null );
 					sem = VK_NULL_HANDLE;
 				}
+
+				_device.vkDestroySemaphore( _device.GetVkDevice(), q.timeline, null );
+				q.timeline		= VK_NULL_HANDLE;
+				q.timelineValue	= 0;
 			}
 		}
 		
@@ -160,6 +215,44 @@ namespace FG
 		return true;
 	}
 	
+/*
+=================================================
+	SetCompletionThreadEnabled
+----
+	all submitted batches must be released before
+	switching mode, otherwise they may be released twice
+=================================================
+*/
+	bool  VFrameGraph::SetCompletionThreadEnabled (bool enabled)
+	{
+		CHECK_ERR( _IsInitialized() );
+		CHECK_ERR( WaitIdle( MaxTimeout ));
+
+		{
+			EXLOCK( _queueGuard );
+			if ( _useCompletionThread == enabled )
+				return true;
+		}
+
+		if ( enabled )
+		{
+			CHECK_ERR( _completionThread.Start( 1, "FG_Completion" ));
+
+			EXLOCK( _queueGuard );
+			_useCompletionThread = true;
+		}
+		else
+		{
+			{
+				EXLOCK( _queueGuard );
+				_useCompletionThread = false;
+			}
+			// finish all jobs
+			_completionThread.Stop();
+		}
+		return true;
+	}
+	
 /*
 =================================================
 	GetDeviceInfo
@@ -229,6 +322,7 @@ namespace FG
 		result.minUniformBufferOffsetAlignment	= BytesU{props.properties.limits.minUniformBufferOffsetAlignment};
 		result.maxDrawIndirectCount				= props.properties.limits.maxDrawIndirectCount;
 		result.maxDrawIndexedIndexValue			= props.properties.limits.maxDrawIndexedIndexValue;
+		result.maxUploadSize					= Min( _resourceMngr.GetHostWriteBufferSize() * VCmdBatch::MaxStagingBuffers, _resourceMngr.GetMaxStagingBufferMemory() );
 		return result;
 	}
 
@@ -629,6 +723,29 @@ namespace FG
 		return _resourceMngr.GetDescription( id );
 	}
 	
+/*
+=================================================
+	GetBindlessIndex
+=================================================
+*/
+	uint  VFrameGraph::GetBindlessIndex (RawImageID id) const
+	{
+		ASSERT( _IsInitialized() );
+		return _resourceMngr.GetBindlessIndex( id );
+	}
+
+	uint  VFrameGraph::GetBindlessIndex (RawBufferID id) const
+	{
+		ASSERT( _IsInitialized() );
+		return _resourceMngr.GetBindlessIndex( id );
+	}
+
+	uint  VFrameGraph::GetBindlessIndex (RawSamplerID id) const
+	{
+		ASSERT( _IsInitialized() );
+		return _resourceMngr.GetBindlessIndex( id );
+	}
+	
 /*
 =================================================
 	GetApiSpecificDescription
@@ -774,13 +891,20 @@ namespace FG
 
 		cmdBufPtr = CommandBuffer{ (ICommandBuffer*)(null), cmdBufPtr.GetBatch() };
 
-		// add batch to the submission queue
+		// add batch to the submission queue,
+		// lock is not needed, batch will be moved to the pending list by the thread that flushes queue
 		{
 			uint	q_idx = uint(batch->GetQueueType());
 			CHECK_ERR( q_idx < _queueMap.size() );
 
-			EXLOCK( _queueGuard );
-			_queueMap[q_idx].pending.push_back( batch );
+			auto&	q = _queueMap[q_idx];
+
+			for (; not q.executed.Push( std::move(batch) );)
+			{
+				// queue overflow, become owner and release space
+				EXLOCK( _queueGuard );
+				_MoveExecutedBatches( q );
+			}
 		}
 
 		//_FlushQueue( batch->GetQueueUsage(), 3u );
@@ -805,6 +929,34 @@ namespace FG
 
 		return result;
 	}
+	
+/*
+=================================================
+	_CreateTimelineSemaphore
+=================================================
+*/
+	VkSemaphore  VFrameGraph::_CreateTimelineSemaphore ()
+	{
+		VkSemaphore		result	= VK_NULL_HANDLE;
+
+	#ifdef VK_KHR_timeline_semaphore
+		VkSemaphoreTypeCreateInfoKHR	type_info	= {};
+		VkSemaphoreCreateInfo			info		= {};
+
+		type_info.sType			= VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO_KHR;
+		type_info.semaphoreType	= VK_SEMAPHORE_TYPE_TIMELINE_KHR;
+		type_info.initialValue	= 0;
+
+		info.sType	= VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+		info.pNext	= &type_info;
+		info.flags	= 0;
+
+		VK_CHECK( _device.vkCreateSemaphore( _device.GetVkDevice(), &info, null, OUT &result ));
+		_device.SetObjectName( uint64_t(result), "QueueTimeline", VK_OBJECT_TYPE_SEMAPHORE );
+	#endif
+
+		return result;
+	}
 
 /*
 =================================================
@@ -832,13 +984,28 @@ namespace FG
 */
 	bool  VFrameGraph::_FlushAll (EQueueUsage queues, uint maxIter)
 	{
+		for (auto& q : _queueMap) {
+			_MoveExecutedBatches( q );
+		}
+
 		for (size_t a = 0, a_max = Min( maxIter, _queueMap.size()), changed = 1;
 			 changed and (a < a_max);
 			 ++a)
 		{
 			changed = 0;
 
-			// for each queue type
+			// submit queues that don't wait for other queues first,
+			// then all batches of the dependent queue will be submitted by a single 'vkQueueSubmit' call
+			for (size_t qi = 0; qi < _queueMap.size(); ++qi)
+			{
+				if ( _queueMap[qi].ptr and AllBits( queues, 1u<<qi ) and not _IsWaitingForQueues( EQueueType(qi), queues ))
+					changed |= size_t(_FlushQueue( EQueueType(qi), 10u ));
+			}
+
+			if ( changed )
+				continue;
+
+			// circular dependency between queues
 			for (size_t qi = 0; qi < _queueMap.size(); ++qi)
 			{
 				if ( _queueMap[qi].ptr and AllBits( queues, 1u<<qi ))
@@ -848,6 +1015,33 @@ namespace FG
 		return true;
 	}
 	
+/*
+=================================================
+	_IsWaitingForQueues
+----
+	returns 'true' if some pending batches depend on batches
+	that will be submitted to the other queue in the current flush
+=================================================
+*/
+	bool  VFrameGraph::_IsWaitingForQueues (EQueueType queueIndex, EQueueUsage queues) const
+	{
+		for (auto& batch : _queueMap[uint(queueIndex)].pending)
+		{
+			for (auto& dep : batch->GetDependencies())
+			{
+				const EQueueType	dep_queue	= dep->GetQueueType();
+				const EBatchState	dep_state	= dep->GetState();
+
+				if ( dep_queue != queueIndex					and
+					 AllBits( queues, 1u << uint(dep_queue) )	and
+					 dep_state >= EBatchState::Backed			and
+					 dep_state <  EBatchState::Submitted )
+					return true;
+			}
+		}
+		return false;
+	}
+	
 /*
 =================================================
 	_FlushQueue
@@ -867,6 +1061,8 @@ namespace FG
 		TempSemaphores_t	release_semaphores;
 		PendingSwapchains_t	swapchains;
 
+		_MoveExecutedBatches( q );
+
 		// find batches that can be submitted
 		for (size_t b = 0, b_max = Min( maxIter, q.pending.size()), changed = 1;
 			 changed and (b < b_max);
@@ -914,31 +1110,49 @@ namespace FG
 			return false;
 		}
 
-		// add semaphores
-		for (size_t qj = 0; qj < _queueMap.size(); ++qj)
+		// add timeline semaphores
+		if ( q.timeline )
 		{
-			auto&	q2 = _queueMap[qj];
-
-			if ( not q2.ptr or qi == qj )
-				continue;
-			
-			// input
-			if ( AllBits( q_mask, 1u<<qj ) and q2.semaphores[qi] )
+			for (size_t qj = 0; qj < _queueMap.size(); ++qj)
 			{
-				pending.front()->WaitSemaphore( q2.semaphores[qi], VK_PIPELINE_STAGE_ALL_COMMANDS_BIT );
-				release_semaphores.push_back( q2.semaphores[qi] );
-				q2.semaphores[qi] = VK_NULL_HANDLE;
+				auto&	q2 = _queueMap[qj];
+
+				// input
+				if ( q2.ptr and qi != qj and AllBits( q_mask, 1u<<qj ))
+					pending.front()->WaitSemaphore( q2.timeline, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, q2.timelineValue );
 			}
-						
+
 			// output
+			pending.back()->SignalSemaphore( q.timeline, ++q.timelineValue );
+		}
+		else
+		{
+			// add binary semaphores
+			for (size_t qj = 0; qj < _queueMap.size(); ++qj)
 			{
-				if ( q.semaphores[qj] )
-					release_semaphores.push_back( q.semaphores[qj] );
+				auto&	q2 = _queueMap[qj];
+
+				if ( not q2.ptr or qi == qj )
+					continue;
+			
+				// input
+				if ( AllBits( q_mask, 1u<<qj ) and q2.semaphores[qi] )
+				{
+					pending.front()->WaitSemaphore( q2.semaphores[qi], VK_PIPELINE_STAGE_ALL_COMMANDS_BIT );
+					release_semaphores.push_back( q2.semaphores[qi] );
+					q2.semaphores[qi] = VK_NULL_HANDLE;
+				}
+						
+				// output
+				{
+					if ( q.semaphores[qj] )
+						release_semaphores.push_back( q.semaphores[qj] );
 
-				VkSemaphore	sem = _CreateSemaphore();
+					VkSemaphore	sem = _CreateSemaphore();
 
-				pending.back()->SignalSemaphore( sem );
-				q.semaphores[qj] = sem;
+					pending.back()->SignalSemaphore( sem );
+					q.semaphores[qj] = sem;
+				}
 			}
 		}
 
@@ -950,7 +1164,7 @@ namespace FG
 			if ( _submittedPool.Assign( OUT index, [](VSubmitted* ptr, uint idx) { PlacementNew<VSubmitted>( ptr, idx ); }) )
 			{
 				submit = &_submittedPool[index];
-				submit->Initialize( GetDevice(), EQueueType(qi), pending, release_semaphores );
+				submit->Initialize( GetDevice(), EQueueType(qi), pending, release_semaphores, q.timeline, q.timelineValue );
 				break;
 			}
 			
@@ -987,8 +1201,13 @@ namespace FG
 		{
 			// some logical queues may have access to the same physical queue
 			EXLOCK( q.ptr->guard );
+			
+			// must be registered before the batches can complete
+			submit->SetSubmitIndex( _resourceMngr, _resourceMngr.OnSubmit() );
 
+			// all ready batches are submitted at once, 'VSubmitted' tracks them with a single fence
 			VK_CALL( _device.vkQueueSubmit( q.ptr->handle, uint(pending.size()), submit_infos.data(), OUT submit->GetFence() ));
+			_queueSubmits.fetch_add( 1, memory_order_relaxed );
 			
 			for (uint i = 0; i < pending.size(); ++i)
 			{
@@ -1016,38 +1235,110 @@ namespace FG
 			}
 		}
 
-		// remove completed batches
-		for (auto iter = q.submitted.begin(); iter != q.submitted.end();)
+		// batches will be released by the completion thread
+		if ( _useCompletionThread )
 		{
-			VSubmitted*	submitted	= *iter;
-			VkFence		fence		= submitted->GetFence();
-			bool		is_complete	= not fence;
-
-			if ( fence and _device.vkGetFenceStatus( _device.GetVkDevice(), fence ) == VK_SUCCESS )
-				is_complete = true;
-
-			if ( is_complete )
+			q.submitted.push_back( submit );
 			{
+				EXLOCK( _completionGuard );
+				++_completionPending;
+			}
+			_completionThread.Enqueue( [this, submit] () { _CompleteSubmitted( submit ); });
+		}
+		else
+		{
+			// remove completed batches
+			for (auto iter = q.submitted.begin(); iter != q.submitted.end();)
+			{
+				VSubmitted*	submitted = *iter;
+
+				if ( submitted->IsComplete( _device ))
 				{
-					EXLOCK( _statisticGuard );
-					submitted->Release( GetDevice(), _debugger, _shaderDebugCallback, INOUT _lastStatistic );
-				}
+					{
+						EXLOCK( _statisticGuard );
+						submitted->Release( GetDevice(), _debugger, _shaderDebugCallback, INOUT _lastStatistic );
+					}
 
-				iter = q.submitted.erase( iter );
-				_submittedPool.Unassign( submitted->GetIndexInPool() );
+					iter = q.submitted.erase( iter );
+					_submittedPool.Unassign( submitted->GetIndexInPool() );
+				}
+				else
+					break;
 			}
-			else
-				break;
-		}
 
-		q.submitted.push_back( submit );
-		
-		_resourceMngr.OnSubmit();
+			q.submitted.push_back( submit );
+		}
 		
 		_submitingTime.fetch_add( (TimePoint_t::clock::now() - start_time).count(), memory_order_relaxed );
 		return true;
 	}
 
+/*
+=================================================
+	_MoveExecutedBatches
+----
+	must be called by the queue owner (under '_queueGuard'),
+	batches are moved in execution order
+=================================================
+*/
+	void  VFrameGraph::_MoveExecutedBatches (QueueData &q)
+	{
+		VCmdBatchPtr	batch;
+
+		for (; q.executed.Pop( OUT batch );)
+		{
+			q.pending.push_back( std::move(batch) );
+		}
+	}
+
+/*
+=================================================
+	_CompleteSubmitted
+----
+	runs on the completion thread,
+	'submitted' is not reused until it is unassigned here,
+	so it can be waited without lock
+=================================================
+*/
+	void  VFrameGraph::_CompleteSubmitted (VSubmitted *submitted)
+	{
+		VSubmitted*	tmp[] = { submitted };
+		VkResult	res;
+
+		for (;;)
+		{
+			res = _WaitSubmitted( tmp, MaxTimeout );
+			if ( res != VK_TIMEOUT )
+				break;
+		}
+		CHECK( res == VK_SUCCESS );
+
+		{
+			EXLOCK( _queueGuard );
+
+			auto&	q		= _queueMap[ uint(submitted->GetQueueType()) ];
+			auto	iter	= std::find( q.submitted.begin(), q.submitted.end(), submitted );
+
+			if ( iter != q.submitted.end() )
+				q.submitted.erase( iter );
+		}
+
+		// callbacks are called without lock
+		Statistics	stat;
+		submitted->Release( GetDevice(), _debugger, _shaderDebugCallback, INOUT stat );
+		_submittedPool.Unassign( submitted->GetIndexInPool() );
+
+		{
+			EXLOCK( _statisticGuard );
+			_lastStatistic.Merge( stat );
+		}
+		{
+			EXLOCK( _completionGuard );
+			--_completionPending;
+		}
+		_completionCV.notify_all();
+	}
+
 /*
 =================================================
 	Wait
@@ -1058,16 +1349,42 @@ namespace FG
 		ASSERT( _IsInitialized() );
 
 		const auto	start_time = TimePoint_t::clock::now();
+		bool		use_thread;
+		{
+			EXLOCK( _queueGuard );
+			use_thread = _useCompletionThread;
+		}
+
+		// batches are released by the completion thread
+		if ( use_thread )
+		{
+			const auto	IsComplete = [commands] ()
+			{
+				for (auto& cmd : commands)
+				{
+					auto*	batch = Cast<VCmdBatch>(cmd.GetBatch());
+					if ( batch and batch->GetState() == EBatchState::Submitted )
+						return false;
+				}
+				return true;
+			};
+
+			std::unique_lock	lock{ _completionGuard };
+			const bool			result = _completionCV.wait_for( lock, timeout, IsComplete );
+			std::atomic_thread_fence( memory_order_acquire );
+			
+			_waitingTime.fetch_add( (TimePoint_t::clock::now() - start_time).count(), memory_order_relaxed );
+			return result;
+		}
 
 		EXLOCK( _queueGuard );
 
-		TempFences_t		tmp_fences;
 		TempSubmitted_t		tmp_submitted;
 		bool				result = true;
 
-		const auto	WaitAndRelease = [this, &tmp_fences, &tmp_submitted, &result, timeout] ()
+		const auto	WaitAndRelease = [this, &tmp_submitted, &result, timeout] ()
 		{
-			auto  res = _device.vkWaitForFences( _device.GetVkDevice(), uint(tmp_fences.size()), tmp_fences.data(), VK_TRUE, uint64_t(timeout.count()) );
+			auto  res = _WaitSubmitted( tmp_submitted, timeout );
 
 			if ( res == VK_SUCCESS )
 			{
@@ -1084,7 +1401,6 @@ namespace FG
 				CHECK( res == VK_TIMEOUT );
 			}
 
-			tmp_fences.clear();
 			tmp_submitted.clear();
 		};
 
@@ -1102,27 +1418,23 @@ namespace FG
 			else
 			if ( state == EBatchState::Submitted )
 			{
-				auto	fence = submitted->GetFence();
 				bool	found = false;
 
-				ASSERT( fence );
+				ASSERT( submitted );
 
-				for (auto& f : tmp_fences) {
-					found |= (f == fence);
+				for (auto* s : tmp_submitted) {
+					found |= (s == submitted);
 				}
 
 				if ( not found )
-				{
-					tmp_fences.push_back( fence );
 					tmp_submitted.push_back( submitted );
-				}
 			}
 
-			if ( tmp_fences.size() == tmp_fences.capacity() )
+			if ( tmp_submitted.size() == tmp_submitted.capacity() )
 				WaitAndRelease();
 		}
 
-		if ( tmp_fences.size() )
+		if ( tmp_submitted.size() )
 			WaitAndRelease();
 		
 		_waitingTime.fetch_add( (TimePoint_t::clock::now() - start_time).count(), memory_order_relaxed );
@@ -1138,11 +1450,11 @@ namespace FG
 	{
 		const auto		start_time	= TimePoint_t::clock::now();
 		bool			result		= true;
-		TempFences_t	tmp_fences;
+		TempSubmitted_t	tmp_submitted;
 		
-		const auto	WaitAndRelease = [this, &tmp_fences, &result, timeout] ()
+		const auto	WaitAndRelease = [this, &tmp_submitted, &result, timeout] ()
 		{
-			auto  res = _device.vkWaitForFences( _device.GetVkDevice(), uint(tmp_fences.size()), tmp_fences.data(), VK_TRUE, uint64_t(timeout.count()) );
+			auto  res = _WaitSubmitted( tmp_submitted, timeout );
 
 			if ( res != VK_SUCCESS )
 			{
@@ -1150,38 +1462,39 @@ namespace FG
 				CHECK( res == VK_TIMEOUT );
 			}
 
-			tmp_fences.clear();
+			tmp_submitted.clear();
 		};
 
+		bool			use_thread;
+
 		// access to queues must be protected
 		{
 			EXLOCK( _queueGuard );
 
 			CHECK_ERR( _FlushAll( EQueueUsage::All, 10u ));
+
+			use_thread = _useCompletionThread;
 		
-			for (size_t i = 0; i < _queueMap.size(); ++i)
+			for (size_t i = 0; i < _queueMap.size() and not use_thread; ++i)
 			{
 				auto&	q = _queueMap[i];
 
 				CHECK( q.pending.empty() );	// circular dependency
 
-				for (auto& s : q.submitted)
+				for (auto* s : q.submitted)
 				{
-					if ( auto fence = s->GetFence() )
-					{
-						tmp_fences.push_back( fence );
+					tmp_submitted.push_back( s );
 						
-						if ( tmp_fences.size() == tmp_fences.capacity() )
-							WaitAndRelease();
-					}
+					if ( tmp_submitted.size() == tmp_submitted.capacity() )
+						WaitAndRelease();
 				}
 			}
 		
-			if ( tmp_fences.size() )
+			if ( tmp_submitted.size() )
 				WaitAndRelease();
 		
 			// clear queues
-			if ( result )
+			if ( result and not use_thread )
 			{
 				EXLOCK( _statisticGuard );
 
@@ -1197,6 +1510,13 @@ namespace FG
 			}
 		}
 
+		// wait until all batches are released by the completion thread
+		if ( use_thread )
+		{
+			std::unique_lock	lock{ _completionGuard };
+			result = _completionCV.wait_for( lock, timeout, [this] () { return _completionPending == 0; });
+		}
+
 		_resourceMngr.RunValidation( 100 );
 
 		_waitingTime.fetch_add( (TimePoint_t::clock::now() - start_time).count(), memory_order_relaxed );
@@ -1234,6 +1554,69 @@ namespace FG
 		return true;
 	}
 
+/*
+=================================================
+	_WaitSubmitted
+----
+	with timeline semaphores only the last batch in each queue is waited
+=================================================
+*/
+	VkResult  VFrameGraph::_WaitSubmitted (ArrayView<VSubmitted *> submitted, Nanoseconds timeout) const
+	{
+	#ifdef VK_KHR_timeline_semaphore
+		if ( _device.GetFeatures().timelineSemaphore )
+		{
+			StaticArray< VkSemaphore, uint(EQueueType::_Count) >	per_queue_sem	= {};
+			StaticArray< uint64_t, uint(EQueueType::_Count) >		per_queue_val	= {};
+			FixedArray< VkSemaphore, uint(EQueueType::_Count) >		semaphores;
+			FixedArray< uint64_t, uint(EQueueType::_Count) >		values;
+
+			for (auto* s : submitted)
+			{
+				const uint	qi = uint(s->GetQueueType());
+				ASSERT( s->GetTimeline() );
+
+				per_queue_sem[qi] = s->GetTimeline();
+				per_queue_val[qi] = Max( per_queue_val[qi], s->GetTimelineValue() );
+			}
+
+			for (uint qi = 0; qi < per_queue_sem.size(); ++qi)
+			{
+				if ( per_queue_sem[qi] )
+				{
+					semaphores.push_back( per_queue_sem[qi] );
+					values.push_back( per_queue_val[qi] );
+				}
+			}
+
+			if ( semaphores.empty() )
+				return VK_SUCCESS;
+
+			VkSemaphoreWaitInfoKHR	info = {};
+			info.sType			= VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO_KHR;
+			info.flags			= 0;
+			info.semaphoreCount	= uint(semaphores.size());
+			info.pSemaphores	= semaphores.data();
+			info.pValues		= values.data();
+
+			return _device.vkWaitSemaphoresKHR( _device.GetVkDevice(), &info, uint64_t(timeout.count()) );
+		}
+	#endif
+
+		TempFences_t	fences;
+
+		for (auto* s : submitted)
+		{
+			if ( auto fence = s->GetFence() )
+				fences.push_back( fence );
+		}
+
+		if ( fences.empty() )
+			return VK_SUCCESS;
+
+		return _device.vkWaitForFences( _device.GetVkDevice(), uint(fences.size()), fences.data(), VK_TRUE, uint64_t(timeout.count()) );
+	}
+
 /*
 =================================================
 	GetStatistics
@@ -1247,6 +1630,10 @@ namespace FG
 		result = _lastStatistic;
 		result.renderer.submitingTime   = Nanoseconds{_submitingTime.exchange( 0, memory_order_relaxed )};
 		result.renderer.waitingTime	 = Nanoseconds{_waitingTime.exchange( 0, memory_order_relaxed )};
+		result.renderer.queueSubmits = _queueSubmits.exchange( 0, memory_order_relaxed );
+
+		_resourceMngr.GetMemoryManager().GetStatistics( INOUT result.resources );
+		_pipelineCompiler.GetStatistics( INOUT result.resources );
 		
 		_lastStatistic = Default;
 		return true;
@@ -1306,6 +1693,13 @@ namespace FG
 
 		CHECK_ERR( q.cmdPool.Create( _device, q.ptr ));
 
+		// single timeline semaphore is used for synchronization with other queues and with host
+		if ( _device.GetFeatures().timelineSemaphore )
+		{
+			q.timeline = _CreateTimelineSemaphore();
+			CHECK_ERR( q.timeline );
+		}
+
 		return true;
 	}
 
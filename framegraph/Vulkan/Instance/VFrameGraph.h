@@ -7,7 +7,12 @@
 #include "VDevice.h"
 #include "VCmdBatch.h"
 #include "VDebugger.h"
+#include "VTaskSchedule.h"
+#include "VPipelineCache.h"
+#include "VAsyncPipelineCompiler.h"
 #include "stl/ThreadSafe/LfIndexedPool.h"
+#include "stl/ThreadSafe/LfCircularQueue.h"
+#include "stl/ThreadSafe/ThreadPool.h"
 
 namespace FG
 {
@@ -30,6 +35,7 @@ namespace FG
 		
 		using EBatchState		= VCmdBatch::EState;
 		using PerQueueSem_t		= StaticArray< VkSemaphore, uint(EQueueType::_Count) >;
+		using ExecutedQueue_t	= LfCircularQueue< VCmdBatchPtr, FG_MaxPendingBatches >;
 
 		struct QueueData
 		{
@@ -37,10 +43,15 @@ namespace FG
 			VDeviceQueueInfoPtr			ptr;			// pointer to the physical queue
 			EQueueType					type			= Default;
 
-		// mutable data
-			Array<VCmdBatchPtr>			pending;		// TODO: circular queue
+		// lock-free data
+			ExecutedQueue_t				executed;		// batches that are added by 'Execute()', moved to 'pending' by queue owner
+
+		// mutable data, protected by '_queueGuard'
+			Array<VCmdBatchPtr>			pending;
 			Array<VSubmitted *>			submitted;
-			PerQueueSem_t				semaphores		{};
+			PerQueueSem_t				semaphores		{};		// binary semaphores, used if timeline semaphores are not supported
+			VkSemaphore					timeline		= VK_NULL_HANDLE;
+			uint64_t					timelineValue	= 0;	// value that will be signaled by the last submitted batch
 
 			VCommandPool				cmdPool;
 			Array<VkImageMemoryBarrier>	imageBarriers;
@@ -60,7 +71,7 @@ namespace FG
 
 		VDevice					_device;
 
-		Mutex					_queueGuard;		// TODO: remove global lock
+		Mutex					_queueGuard;		// thread that locks it becomes owner of all queues
 		QueueMap_t				_queueMap;
 		EQueueUsage				_queueUsage;
 
@@ -74,11 +85,29 @@ namespace FG
 
 		ShaderDebugCallback_t	_shaderDebugCallback;
 
+		ThreadPool				_workerThreads;		// used to record secondary command buffers, started on first use, see 'GetWorkerThreads()'
+		std::once_flag			_workerThreadsStarted;
+
+		ThreadPool				_completionThread;	// waits for submitted batches and releases them, see 'SetCompletionThreadEnabled()'
+		bool					_useCompletionThread	= false;	// protected by '_queueGuard'
+		Mutex					_completionGuard;
+		std::condition_variable	_completionCV;		// notified when batches are released by the completion thread
+		uint					_completionPending		= 0;		// protected by '_completionGuard'
+
+		VTaskScheduleCache		_taskSchedules;		// task order that is reused by command buffers with the same task graph
+
+		VPipelineCache			_pipelineCache;		// device-wide cache, initial data for per-thread caches, immutable until 'Deinitialize()'
+		const String			_pipelineCacheFile;
+
+		VAsyncPipelineCompiler	_pipelineCompiler;	// compiles graphics pipelines in background, see 'VulkanDeviceInfo::asyncPipelineCompilation'
+		const bool				_asyncPipelineCompilation;
+
 		mutable Mutex			_statisticGuard;
 		mutable Statistics		_lastStatistic;
 
 		mutable Atomic<uint64_t>   _submitingTime {0};
 		mutable Atomic<uint64_t>   _waitingTime   {0};
+		mutable Atomic<uint>       _queueSubmits  {0};
 
 
 	// methods
@@ -91,6 +120,7 @@ namespace FG
 		void			Deinitialize () override;
 		bool			AddPipelineCompiler (const PipelineCompiler &comp) override;
 		bool			SetShaderDebugCallback (ShaderDebugCallback_t &&) override;
+		bool			SetCompletionThreadEnabled (bool enabled) override;
 		DeviceInfo_t	GetDeviceInfo () const override;
 		EQueueUsage		GetAvilableQueues () const override;
 		DeviceProperties GetDeviceProperties () const override;
@@ -186,6 +216,10 @@ namespace FG
 		ImageDesc const&	GetDescription (RawImageID id) const override;
 		ExternalBufferDesc_t GetApiSpecificDescription (RawBufferID id) const override;
 		ExternalImageDesc_t  GetApiSpecificDescription (RawImageID id) const override;
+
+		uint			GetBindlessIndex (RawImageID id) const override;
+		uint			GetBindlessIndex (RawBufferID id) const override;
+		uint			GetBindlessIndex (RawSamplerID id) const override;
 		
 		bool			UpdateHostBuffer (RawBufferID id, BytesU offset, BytesU size, const void *data) override;
 		bool			MapBufferRange (RawBufferID id, BytesU offset, INOUT BytesU &size, OUT void* &data) override;
@@ -212,7 +246,11 @@ namespace FG
 		ND_ VDeviceQueueInfoPtr	FindQueue (EQueueType type) const;
 		ND_ VDevice const&		GetDevice ()				const	{ return _device; }
 		ND_ VResourceManager &	GetResourceManager ()				{ return _resourceMngr; }
+		ND_ VPipelineCache &	GetPipelineCache ()					{ return _pipelineCache; }
+		ND_ VAsyncPipelineCompiler*	GetPipelineCompiler ()			{ return _pipelineCompiler.IsStarted() ? &_pipelineCompiler : null; }
 		ND_ VkQueryPool			GetQueryPool ()				const	{ return _queryPool; }
+		ND_ ThreadPool &		GetWorkerThreads ();
+		ND_ VTaskScheduleCache&	GetTaskSchedules ()					{ return _taskSchedules; }
 
 
 	private:
@@ -226,6 +264,7 @@ namespace FG
 		void  _TransitImageLayoutToDefault (RawImageID imageId, VkImageLayout initialLayout, uint queueFamily);
 
 		ND_ VkSemaphore	 _CreateSemaphore ();
+		ND_ VkSemaphore	 _CreateTimelineSemaphore ();
 
 
 		// queues //
@@ -241,7 +280,11 @@ namespace FG
 			bool  _TryFlush (const VCmdBatchPtr &batch);
 			bool  _FlushAll (EQueueUsage queues, uint maxIter);
 			bool  _FlushQueue (EQueueType queue, uint maxIter);
+			void  _MoveExecutedBatches (QueueData &q);
+		ND_ bool  _IsWaitingForQueues (EQueueType queue, EQueueUsage queues) const;
 			bool  _WaitQueue (EQueueType queue, Nanoseconds timeout);
+		ND_ VkResult  _WaitSubmitted (ArrayView<VSubmitted *> submitted, Nanoseconds timeout) const;
+			void  _CompleteSubmitted (VSubmitted *submitted);
 
 
 		// states //
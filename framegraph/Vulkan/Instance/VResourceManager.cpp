@@ -57,10 +57,12 @@ namespace FG
 	constructor
 =================================================
 */
-	VResourceManager::VResourceManager (const VDevice &dev, BytesU maxStagingBufferMemory, BytesU stagingBufferSize) :
+	VResourceManager::VResourceManager (const VDevice &dev, BytesU maxStagingBufferMemory, BytesU stagingBufferSize, bool enableBindless) :
 		_device{ dev },
 		_memoryMngr{ dev },
 		_descMngr{ dev },
+		_bindless{ dev },
+		_enableBindless{ enableBindless },
 		_submissionCounter{ 0 }
 	{
 		_staging.maxStagingBufferMemory = maxStagingBufferMemory < 1_Mb ? ~0_b : maxStagingBufferMemory;
@@ -90,6 +92,9 @@ namespace FG
 		_CreateEmptyDescriptorSetLayout();
 		_CheckHostVisibleMemory();
 
+		if ( _enableBindless )
+			_CreateBindlessHeap();
+
 		return true;
 	}
 	
@@ -102,6 +107,8 @@ namespace FG
 	{
 		_DestroyStagingBuffers();
 		_DestroyShaderDebuggerResources();
+		_DestroyBindlessReleased( UMax );
+		_bindless.Destroy();
 
 		_DestroyResourceCache( INOUT _samplerCache );
 		_DestroyResourceCache( INOUT _pplnLayoutCache );
@@ -149,9 +156,101 @@ namespace FG
 	OnSubmit
 =================================================
 */
-	void  VResourceManager::OnSubmit ()
+	uint  VResourceManager::OnSubmit ()
+	{
+		uint	index;
+		{
+			EXLOCK( _submitted.guard );
+			index = _submissionCounter.fetch_add( 1, memory_order_relaxed ) + 1;
+			_submitted.inFlight.push_back( index );
+		}
+
+		_memoryMngr.OnSubmit( index );
+		return index;
+	}
+	
+/*
+=================================================
+	OnSubmitComplete
+----
+	submissions may complete in any order,
+	so only resources released before the oldest incomplete submission are destroyed
+=================================================
+*/
+	void  VResourceManager::OnSubmitComplete (uint submitIndex)
+	{
+		uint	completed;
+		{
+			EXLOCK( _submitted.guard );
+
+			auto&	in_flight	= _submitted.inFlight;
+			auto	iter		= std::lower_bound( in_flight.begin(), in_flight.end(), submitIndex );
+			CHECK_ERRV( iter != in_flight.end() and *iter == submitIndex );
+
+			in_flight.erase( iter );
+
+			if ( _submitted.bindlessReleased.empty() )
+				return;
+
+			completed = in_flight.empty() ? UMax : in_flight.front() - 1;
+		}
+		_DestroyBindlessReleased( completed );
+	}
+	
+/*
+=================================================
+	_DeferBindlessRelease
+----
+	returns 'false' if resource can be destroyed immediately
+=================================================
+*/
+	bool  VResourceManager::_DeferBindlessRelease (const BindlessResID_t &id)
+	{
+		EXLOCK( _submitted.guard );
+
+		if ( _submitted.inFlight.empty() )
+			return false;
+
+		_submitted.bindlessReleased.emplace_back( id, _submissionCounter.load( memory_order_relaxed ));
+		return true;
+	}
+	
+/*
+=================================================
+	_DestroyBindlessReleased
+----
+	heap slot is recycled only after resource is destroyed,
+	so descriptor is not overwritten while it may be used by the GPU
+=================================================
+*/
+	void  VResourceManager::_DestroyBindlessReleased (uint completedIndex)
 	{
-		_submissionCounter.fetch_add( 1, memory_order_relaxed );
+		BindlessReleased_t	released;
+		{
+			EXLOCK( _submitted.guard );
+
+			auto&	pending = _submitted.bindlessReleased;
+
+			for (; pending.size() and pending.front().second <= completedIndex;)
+			{
+				released.push_back( std::move(pending.front()) );
+				pending.pop_front();
+			}
+		}
+
+		for (auto& item : released)
+		{
+			Visit( item.first, [this] (auto id)
+				{
+					auto&	pool = _GetResourcePool( id );
+					auto&	data = pool[ id.Index() ];
+					ASSERT( data.GetInstanceID() == id.InstanceID() );
+
+					_RemoveFromBindlessHeap( data, id.Index() );
+					data.Destroy( *this );
+					pool.Unassign( id.Index() );
+				});
+		}
 	}
 	
 /*
@@ -215,6 +314,63 @@ namespace FG
 		return true;
 	}
 	
+/*
+=================================================
+	_CreateBindlessHeap
+----
+	descriptor set layout of the heap is not added to the cache,
+	it is used instead of reflected layout for 'FG_BindlessDescriptorSet'.
+=================================================
+*/
+	bool  VResourceManager::_CreateBindlessHeap ()
+	{
+		if ( not VBindlessHeap::IsSupported( _device ))
+		{
+			FG_LOGI( "bindless mode is not supported by device" );
+			return false;
+		}
+
+		VDescriptorSetLayout::DescriptorBinding_t	binding;
+		VBindlessHeap::GetDescriptorBinding( _device, OUT binding );
+
+		RawDescriptorSetLayoutID	id;
+		CHECK_ERR( _Assign( OUT id ));
+
+		auto&	res = _GetResourcePool( id )[ id.Index() ];
+		Replace( res, binding );
+
+		if ( not res.Create( _device, binding ))
+		{
+			res.Destroy( *this );
+			_Unassign( id );
+			RETURN_ERR( "failed when creating bindless descriptor set layout" );
+		}
+		res.AddRef();
+
+		CHECK_ERR( _bindless.Create( id, res.Data().Handle(), binding ));
+		return true;
+	}
+	
+/*
+=================================================
+	GetBindlessIndex
+=================================================
+*/
+	uint  VResourceManager::GetBindlessIndex (RawImageID id) const
+	{
+		return _bindless.IsCreated() and GetResource( id, false, true ) ? _bindless.GetImageIndex( id.Index() ) : UMax;
+	}
+
+	uint  VResourceManager::GetBindlessIndex (RawBufferID id) const
+	{
+		return _bindless.IsCreated() and GetResource( id, false, true ) ? _bindless.GetBufferIndex( id.Index() ) : UMax;
+	}
+
+	uint  VResourceManager::GetBindlessIndex (RawSamplerID id) const
+	{
+		return _bindless.IsCreated() and GetResource( id, false, true ) ? _bindless.GetSamplerIndex( id.Index() ) : UMax;
+	}
+	
 /*
 =================================================
 	GetDebugShaderStorageSize
@@ -367,6 +523,26 @@ namespace FG
 		{
 			RawDescriptorSetLayoutID			ds_id;
 			ResourceBase<VDescriptorSetLayout>*	ds_layout = null;
+
+			// shader declares arrays of the global descriptor heap, reflected layout is replaced by heap layout
+			if ( ds.bindingIndex == FG_BindlessDescriptorSet and _bindless.IsCreated() )
+			{
+				if ( not _IsCompatibleWithBindlessHeap( ds.uniforms ))
+				{
+					for (auto& ds_prev : ds_layouts) {
+						ReleaseResource( ds_prev.first );
+					}
+					RETURN_ERR( "descriptor set "s << ToString( ds.bindingIndex ) << " is reserved for bindless descriptor heap, but reflected uniforms don't match heap layout" );
+				}
+
+				ds_id		= _bindless.GetLayoutID();
+				ds_layout	= &_GetResourcePool( ds_id )[ ds_id.Index() ];
+				ds_layout->AddRef();
+
+				ds_layouts.push_back({ ds_id, ds_layout });
+				continue;
+			}
+
 			CHECK_ERR( _CreateDescriptorSetLayout( OUT ds_id, OUT ds_layout, ds.uniforms ));
 
 			ds_layouts.push_back({ ds_id, ds_layout });
@@ -374,6 +550,37 @@ namespace FG
 		return _CreatePipelineLayout( OUT id, OUT layoutPtr, desc, ds_layouts );
 	}
 	
+/*
+=================================================
+	_IsCompatibleWithBindlessHeap
+----
+	each uniform must be declared as one of the heap arrays:
+	'texture*' at binding 0, 'sampler' at binding 1, 'buffer' at binding 2.
+=================================================
+*/
+	bool  VResourceManager::_IsCompatibleWithBindlessHeap (const PipelineDescription::UniformMapPtr &uniforms) const
+	{
+		if ( not uniforms )
+			return true;
+
+		for (auto& un : *uniforms)
+		{
+			const uint	binding = un.second.index.VKBinding();
+			bool		matched = false;
+
+			Visit( un.second.data,
+				[&] (const PipelineDescription::Texture &)			{ matched = (binding == VBindlessHeap::ImageBinding); },
+				[&] (const PipelineDescription::Sampler &)			{ matched = (binding == VBindlessHeap::SamplerBinding); },
+				[&] (const PipelineDescription::StorageBuffer &sb)	{ matched = (binding == VBindlessHeap::BufferBinding and sb.dynamicOffsetIndex == PipelineDescription::STATIC_OFFSET); },
+				[] (const auto &) {}
+			);
+
+			if ( not matched )
+				return false;
+		}
+		return true;
+	}
+
 	bool  VResourceManager::_CreatePipelineLayout (OUT RawPipelineLayoutID &id, OUT ResourceBase<VPipelineLayout> const* &layoutPtr,
 												   const PipelineDescription::PipelineLayout &desc, const DSLayouts_t &dsLayouts)
 	{
@@ -393,7 +600,7 @@ namespace FG
 		if ( temp_id == UMax )
 		{
 			// create new
-			if ( not layout.Create( _device, empty_layout->Handle() ))
+			if ( not layout.Create( _device, empty_layout->Handle(), _bindless ))
 			{
 				_Unassign( id );
 				RETURN_ERR( "failed when creating pipeline layout" );
@@ -919,6 +1126,8 @@ namespace FG
 		
 		mem_obj->AddRef();
 		data.AddRef();
+
+		_bindless.AddImage( id.Index(), data.Data() );
 		return id;
 	}
 	
@@ -948,6 +1157,8 @@ namespace FG
 		
 		mem_obj->AddRef();
 		data.AddRef();
+
+		_bindless.AddBuffer( id.Index(), data.Data() );
 		return id;
 	}
 	
@@ -971,6 +1182,8 @@ namespace FG
 		}
 		
 		data.AddRef();
+
+		_bindless.AddImage( id.Index(), data.Data() );
 		return id;
 	}
 	
@@ -994,6 +1207,8 @@ namespace FG
 		}
 		
 		data.AddRef();
+
+		_bindless.AddBuffer( id.Index(), data.Data() );
 		return id;
 	}
 
@@ -1054,9 +1269,15 @@ namespace FG
 */
 	RawSamplerID  VResourceManager::CreateSampler (const SamplerDesc &desc, StringView dbgName)
 	{
-		return _CreateCachedResource<RawSamplerID>( "failed when creating sampler",
+		RawSamplerID	id = _CreateCachedResource<RawSamplerID>( "failed when creating sampler",
 										[&] (auto& data) { Replace( data, _device, desc ); },
 										[&] (auto& data) { return data.Create( _device, dbgName ); });
+
+		// sampler may be taken from cache, it is added to the heap only once
+		if ( id and _bindless.IsCreated() )
+			_bindless.AddSampler( id.Index(), _samplerCache[ id.Index() ].Data() );
+
+		return id;
 	}
 	
 	RawRenderPassID  VResourceManager::CreateRenderPass (ArrayView<VLogicalRenderPass*> logicalPasses, StringView dbgName)
@@ -1609,6 +1830,57 @@ namespace FG
 		}
 	}
 	
+/*
+=================================================
+	GetStagingRing
+----
+	returns null if ring is disabled or can not be created,
+	in this case staging buffers are used
+=================================================
+*/
+	VStagingRing*  VResourceManager::GetStagingRing (EQueueType queue)
+	{
+		if ( FG_StagingRingSize == 0 or uint(queue) >= _staging.rings.size() )
+			return null;
+
+		EXLOCK( _staging.ringGuard );
+
+		auto&	ring = _staging.rings[ uint(queue) ];
+
+		if ( ring.GetBufferID() )
+			return &ring;
+
+		const BytesU	size = BytesU{FG_StagingRingSize};
+
+		BytesU	total_size = BytesU{ _staging.currStagingBufferMemory.fetch_add( uint64_t(size), memory_order_relaxed )} + size;
+
+		// ring doesn't fit into staging memory limit, staging buffers will be used instead
+		if ( total_size > _staging.maxStagingBufferMemory )
+		{
+			_staging.currStagingBufferMemory.fetch_sub( uint64_t(size), memory_order_relaxed );
+			return null;
+		}
+
+		RawBufferID		buf_id = CreateBuffer( BufferDesc{ size, EBufferUsage::TransferSrc }, MemoryDesc{ EMemoryType::HostWrite },
+											   EQueueFamilyMask::Unknown, "StagingRing" );
+		if ( not buf_id )
+		{
+			_staging.currStagingBufferMemory.fetch_sub( uint64_t(size), memory_order_relaxed );
+			RETURN_ERR( "failed to create staging ring" );
+		}
+
+		VMemoryObj::MemoryInfo	info;
+		VMemoryObj const*		mem = GetResource( GetResource( buf_id )->GetMemoryID() );
+
+		if ( not (mem and mem->GetInfo( _memoryMngr, OUT info ) and ring.Create( buf_id, info, size )) )
+		{
+			ReleaseResource( buf_id );
+			_staging.currStagingBufferMemory.fetch_sub( uint64_t(size), memory_order_relaxed );
+			RETURN_ERR( "failed to create staging ring" );
+		}
+		return &ring;
+	}
+
 /*
 =================================================
 	_DestroyStagingBuffers
@@ -1623,6 +1895,12 @@ namespace FG
 
 		_staging.write.Release( dtor );
 		_staging.read.Release( dtor );
+
+		for (auto& ring : _staging.rings)
+		{
+			if ( RawBufferID id = ring.Destroy() )
+				ReleaseResource( id );
+		}
 	}
 	
 /*
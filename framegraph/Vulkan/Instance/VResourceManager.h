@@ -23,6 +23,7 @@
 #include "VSwapchain.h"
 #include "VMemoryManager.h"
 #include "VDescriptorManager.h"
+#include "VBindlessHeap.h"
 #include "VCmdBatch.h"
 
 namespace FG
@@ -78,6 +79,10 @@ namespace FG
 		using DebugLayoutCache_t	= HashMap< uint, RawDescriptorSetLayoutID >;
 		
 		using StagingBufferfPool_t	= LfIndexedPool< BufferID, uint, 32, 2 >;
+		using StagingRings_t		= StaticArray< VStagingRing, uint(EQueueType::_Count) >;
+
+		using BindlessResID_t		= Union< RawImageID, RawBufferID, RawSamplerID >;
+		using BindlessReleased_t	= Deque<Pair< BindlessResID_t, uint >>;		// resource, last submission index before release
 
 
 	// variables
@@ -85,6 +90,8 @@ namespace FG
 		VDevice const&				_device;
 		VMemoryManager				_memoryMngr;
 		VDescriptorManager			_descMngr;
+		VBindlessHeap				_bindless;
+		const bool					_enableBindless;
 
 		BufferPool_t				_bufferPool;
 		ImagePool_t					_imagePool;
@@ -122,6 +129,13 @@ namespace FG
 
 		Atomic<uint>				_submissionCounter;
 
+		// resources from the bindless heap are destroyed when all previous submissions have completed
+		struct {
+			Mutex						guard;
+			Array<uint>					inFlight;			// submission indices in ascending order
+			BindlessReleased_t			bindlessReleased;	// sorted by submission index
+		}							_submitted;
+
 		struct {
 			DebugLayoutCache_t			dsLayoutsCache;
 			CPipelineID					pplnFindMaxValue1;
@@ -138,6 +152,8 @@ namespace FG
 			BytesU						uniformBufPageSize;
 			BytesU						maxStagingBufferMemory;
 			Atomic<uint64_t>			currStagingBufferMemory		{0};
+			StagingRings_t				rings;						// created on first use
+			Mutex						ringGuard;
 		}							_staging;
 
 		// cached resources validation
@@ -162,14 +178,15 @@ namespace FG
 
 	// methods
 	public:
-		VResourceManager (const VDevice &dev, BytesU maxStagingBufferMemory, BytesU stagingBufferSize);
+		VResourceManager (const VDevice &dev, BytesU maxStagingBufferMemory, BytesU stagingBufferSize, bool enableBindless);
 		~VResourceManager ();
 
 		bool  Initialize ();
 		void  Deinitialize ();
 		
 		void  AddCompiler (const PipelineCompiler &comp);
-		void  OnSubmit ();
+		ND_ uint  OnSubmit ();
+			void  OnSubmitComplete (uint submitIndex);
 
 		ND_ RawMPipelineID		CreatePipeline (INOUT MeshPipelineDesc &desc, StringView dbgName);
 		ND_ RawGPipelineID		CreatePipeline (INOUT GraphicsPipelineDesc &desc, StringView dbgName);
@@ -221,6 +238,7 @@ namespace FG
 		ND_ VDevice const&		GetDevice ()				const	{ return _device; }
 		ND_ VMemoryManager&		GetMemoryManager ()					{ return _memoryMngr; }
 		ND_ VDescriptorManager&	GetDescriptorManager ()				{ return _descMngr; }
+		ND_ VBindlessHeap const&	GetBindlessHeap ()			const	{ return _bindless; }
 		
 		ND_ uint				GetSubmitIndex ()			const	{ return _submissionCounter.load( memory_order_relaxed ); }
 		
@@ -229,8 +247,13 @@ namespace FG
 		ND_ BytesU				GetHostReadBufferSize ()	const	{ return _staging.readBufPageSize; }
 		ND_ BytesU				GetHostWriteBufferSize ()	const	{ return _staging.writeBufPageSize; }
 		ND_ BytesU				GetUniformBufferSize ()		const	{ return _staging.uniformBufPageSize; }
+		ND_ BytesU				GetMaxStagingBufferMemory ()const	{ return _staging.maxStagingBufferMemory; }
 		
 		ND_ Tuple<RawCPipelineID, RawCPipelineID, RawCPipelineID>	GetShaderTimemapPipelines ();
+		
+		ND_ uint				GetBindlessIndex (RawImageID id)	const;
+		ND_ uint				GetBindlessIndex (RawBufferID id)	const;
+		ND_ uint				GetBindlessIndex (RawSamplerID id)	const;
 
 		void  CheckTask (const BuildRayTracingScene &);
 
@@ -239,6 +262,8 @@ namespace FG
 		bool  CreateStagingBuffer (EBufferUsage usage, OUT RawBufferID &id, OUT StagingBufferIdx &index);
 		void  ReleaseStagingBuffer (StagingBufferIdx index);
 
+		ND_ VStagingRing*  GetStagingRing (EQueueType queue);
+
 
 	private:
 		bool  _CheckHostVisibleMemory ();
@@ -250,6 +275,7 @@ namespace FG
 
 		bool  _CreatePipelineLayout (OUT RawPipelineLayoutID &id, OUT ResourceBase<VPipelineLayout> const* &layoutPtr,
 									 const PipelineDescription::PipelineLayout &, const DSLayouts_t &);
+		ND_ bool  _IsCompatibleWithBindlessHeap (const PipelineDescription::UniformMapPtr &) const;
 
 		bool  _CreateDescriptorSetLayout (OUT RawDescriptorSetLayoutID &id, OUT ResourceBase<VDescriptorSetLayout>* &layoutPtr,
 										  const PipelineDescription::UniformMapPtr &uniforms);
@@ -311,6 +337,24 @@ namespace FG
 		ND_ auto  _GetEmptyDescriptorSetLayout ()		{ return _emptyDSLayout; }
 
 
+	// bindless descriptor heap
+		bool  _CreateBindlessHeap ();
+
+		template <typename DataT>
+		void  _RemoveFromBindlessHeap (const DataT &, Index_t)						{}
+		void  _RemoveFromBindlessHeap (const ResourceBase<VImage> &, Index_t index)	{ _bindless.RemoveImage( index ); }
+		void  _RemoveFromBindlessHeap (const ResourceBase<VBuffer> &, Index_t index)	{ _bindless.RemoveBuffer( index ); }
+		void  _RemoveFromBindlessHeap (const ResourceBase<VSampler> &, Index_t index)	{ _bindless.RemoveSampler( index ); }
+		
+		template <typename DataT>
+		ND_ bool  _DeferBindlessRelease (const DataT &, Index_t)							{ return false; }
+		ND_ bool  _DeferBindlessRelease (const ResourceBase<VImage> &data, Index_t index)	{ return _bindless.GetImageIndex( index ) != UMax and _DeferBindlessRelease( RawImageID{ index, data.GetInstanceID() }); }
+		ND_ bool  _DeferBindlessRelease (const ResourceBase<VBuffer> &data, Index_t index)	{ return _bindless.GetBufferIndex( index ) != UMax and _DeferBindlessRelease( RawBufferID{ index, data.GetInstanceID() }); }
+		ND_ bool  _DeferBindlessRelease (const ResourceBase<VSampler> &data, Index_t index){ return _bindless.GetSamplerIndex( index ) != UMax and _DeferBindlessRelease( RawSamplerID{ index, data.GetInstanceID() }); }
+		ND_ bool  _DeferBindlessRelease (const BindlessResID_t &id);
+			void  _DestroyBindlessReleased (uint completedIndex);
+
+
 	// shader debugger
 		bool  _CreateFindMaxValuePipeline1 ();
 		bool  _CreateFindMaxValuePipeline2 ();
@@ -439,6 +483,11 @@ namespace FG
 	{
 		if ( data.ReleaseRef( refCount ) and data.IsCreated() )
 		{
+			// descriptor in the bindless heap may be used by submitted commands
+			if ( _DeferBindlessRelease( data, index ))
+				return true;
+
+			_RemoveFromBindlessHeap( data, index );
 			data.Destroy( *this );
 			pool.Unassign( index );
 			return true;
@@ -452,6 +501,11 @@ namespace FG
 		if ( data.ReleaseRef( refCount ) and data.IsCreated() )
 		{
 			pool.RemoveFromCache( index );
+			
+			if ( _DeferBindlessRelease( data, index ))
+				return true;
+
+			_RemoveFromBindlessHeap( data, index );
 			data.Destroy( *this );
 			pool.Unassign( index );
 			return true;
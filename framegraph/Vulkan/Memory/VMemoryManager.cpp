@@ -162,6 +162,64 @@ namespace FG
 		CHECK_ERR( _allocators[alloc_id]->GetMemoryInfo( data, OUT info ));
 		return true;
 	}
+	
+/*
+=================================================
+	AllocateBlock
+----
+	block is allocated by the first allocator,
+	so released block may be reused for other resources.
+=================================================
+*/
+	bool VMemoryManager::AllocateBlock (uint memTypeIndex, VkDeviceSize size, OUT VkDeviceMemory &mem)
+	{
+		SHAREDLOCK( _drCheck );
+		CHECK_ERR( not _allocators.empty() );
+
+		CHECK_ERR( _allocators.front()->AllocBlock( memTypeIndex, size, OUT mem ));
+		return true;
+	}
+	
+/*
+=================================================
+	DeallocateBlock
+=================================================
+*/
+	void VMemoryManager::DeallocateBlock (VkDeviceMemory mem, uint memTypeIndex, VkDeviceSize size)
+	{
+		SHAREDLOCK( _drCheck );
+		CHECK_ERRV( not _allocators.empty() );
+
+		_allocators.front()->DeallocBlock( mem, memTypeIndex, size );
+	}
+
+/*
+=================================================
+	OnSubmit
+=================================================
+*/
+	void VMemoryManager::OnSubmit (uint submitIndex)
+	{
+		SHAREDLOCK( _drCheck );
+
+		for (auto& alloc : _allocators) {
+			alloc->OnSubmit( submitIndex );
+		}
+	}
+	
+/*
+=================================================
+	GetStatistics
+=================================================
+*/
+	void VMemoryManager::GetStatistics (INOUT Statistic_t &result)
+	{
+		SHAREDLOCK( _drCheck );
+
+		for (auto& alloc : _allocators) {
+			alloc->GetStatistics( INOUT result );
+		}
+	}
 
 
 }	// FG
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include "framegraph/Public/FrameGraph.h"
 #include "VMemoryObj.h"
 
 namespace FG
@@ -17,6 +18,7 @@ namespace FG
 	protected:
 		using Storage_t		= VMemoryObj::Storage_t;
 		using MemoryInfo_t	= VMemoryObj::MemoryInfo;
+		using Statistic_t	= IFrameGraph::ResourceStatistics;
 
 		class DedicatedMemAllocator;
 		class HostMemAllocator;
@@ -43,6 +45,12 @@ namespace FG
 			virtual bool Dealloc (INOUT Storage_t &data) = 0;
 			
 			virtual bool GetMemoryInfo (const Storage_t &data, OUT MemoryInfo_t &info) const = 0;
+
+			virtual bool AllocBlock (uint memTypeIndex, VkDeviceSize size, OUT VkDeviceMemory &mem) = 0;
+			virtual void DeallocBlock (VkDeviceMemory mem, uint memTypeIndex, VkDeviceSize size) = 0;
+
+			virtual void OnSubmit (uint submitIndex) = 0;
+			virtual void GetStatistics (INOUT Statistic_t &) = 0;
 		};
 
 		using AllocatorPtr	= UniquePtr< IMemoryAllocator >;
@@ -76,6 +84,13 @@ namespace FG
 
 		virtual bool GetMemoryInfo (const Storage_t &data, OUT MemoryInfo_t &info) const;
 
+		// device memory block without suballocation, used for transient resources
+		virtual bool AllocateBlock (uint memTypeIndex, VkDeviceSize size, OUT VkDeviceMemory &mem);
+		virtual void DeallocateBlock (VkDeviceMemory mem, uint memTypeIndex, VkDeviceSize size);
+
+		virtual void OnSubmit (uint submitIndex);
+		virtual void GetStatistics (INOUT Statistic_t &);
+
 
 	private:
 		ND_ AllocatorPtr  _CreateVMA ();
@@ -70,6 +70,25 @@ namespace FG
 			VmaAllocation	allocation;
 		};
 
+		// memory block that was released by VMA and may be reused
+		struct FreeBlock
+		{
+			VkDeviceMemory	memory		= VK_NULL_HANDLE;
+			VkDeviceSize	size		= 0;
+			uint			memType		= UMax;
+			uint			lastUsage	= 0;	// submission index
+		};
+
+		using FreeBlocks_t		= Array< FreeBlock >;
+		using MappedBlocks_t	= HashSet< VkDeviceMemory >;
+
+		// VMA calls vulkan functions synchronously, so allocator is passed to the memory hooks by thread local variable
+		struct AllocatorScope
+		{
+			explicit AllocatorScope (VulkanMemoryAllocator *alloc)	{ ASSERT( _currentAllocator == null );  _currentAllocator = alloc; }
+			~AllocatorScope ()										{ _currentAllocator = null; }
+		};
+
 
 	// variables
 	private:
@@ -77,6 +96,15 @@ namespace FG
 		VDevice const&			_device;
 		VmaAllocator			_allocator;
 
+		FreeBlocks_t			_freeBlocks;		// in release order
+		VkDeviceSize			_freeBlocksSize		= 0;
+		FreeBlock				_releasedBlock;		// block that will be released by the next 'vkFreeMemory' call
+		MappedBlocks_t			_mappedBlocks;		// VMA may free dedicated memory without unmapping
+		uint					_submitIndex		= 0;
+		Statistic_t				_statistic;
+
+		static thread_local VulkanMemoryAllocator*	_currentAllocator;
+
 
 	// methods
 	public:
@@ -96,9 +124,25 @@ namespace FG
 		
 		bool GetMemoryInfo (const Storage_t &data, OUT MemoryInfo_t &info) const override;
 
+		bool AllocBlock (uint memTypeIndex, VkDeviceSize size, OUT VkDeviceMemory &mem) override;
+		void DeallocBlock (VkDeviceMemory mem, uint memTypeIndex, VkDeviceSize size) override;
+
+		void OnSubmit (uint submitIndex) override;
+		void GetStatistics (INOUT Statistic_t &) override;
+
 	private:
 		bool _CreateAllocator (OUT VmaAllocator &alloc) const;
 
+		ND_ VkResult  _AllocateMemory (const VkMemoryAllocateInfo &info, OUT VkDeviceMemory &mem);
+			void	  _FreeMemory (VkDeviceMemory mem);
+			void	  _ReleaseFreeBlocks (size_t count);
+
+		static VKAPI_ATTR VkResult VKAPI_CALL  _AllocateMemoryHook (VkDevice, const VkMemoryAllocateInfo*, const VkAllocationCallbacks*, VkDeviceMemory*);
+		static VKAPI_ATTR void VKAPI_CALL      _FreeMemoryHook (VkDevice, VkDeviceMemory, const VkAllocationCallbacks*);
+		static VKAPI_ATTR VkResult VKAPI_CALL  _MapMemoryHook (VkDevice, VkDeviceMemory, VkDeviceSize, VkDeviceSize, VkMemoryMapFlags, void**);
+		static VKAPI_ATTR void VKAPI_CALL      _UnmapMemoryHook (VkDevice, VkDeviceMemory);
+		static void VKAPI_PTR                  _OnFreeMemory (VmaAllocator, uint memType, VkDeviceMemory mem, VkDeviceSize size);
+
 		ND_ static Data *					_CastStorage (Storage_t &data);
 		ND_ static Data const*				_CastStorage (const Storage_t &data);
 		
@@ -108,6 +152,8 @@ namespace FG
 	};
 	
 	
+	thread_local VMemoryManager::VulkanMemoryAllocator*  VMemoryManager::VulkanMemoryAllocator::_currentAllocator = null;
+
 /*
 =================================================
 	_CreateVMA
@@ -127,6 +173,8 @@ namespace FG
 		_device{ dev },		_allocator{ null }
 	{
 		EXLOCK( _guard );
+		AllocatorScope	scope{ this };
+
 		CHECK( _CreateAllocator( OUT _allocator ));
 	}
 	
@@ -139,9 +187,14 @@ namespace FG
 	{
 		EXLOCK( _guard );
 
-		if ( _allocator ) {
+		if ( _allocator )
+		{
+			AllocatorScope	scope{ this };
 			vmaDestroyAllocator( _allocator );
 		}
+
+		_ReleaseFreeBlocks( _freeBlocks.size() );
+		ASSERT( _mappedBlocks.empty() );
 	}
 	
 /*
@@ -179,6 +232,7 @@ namespace FG
 	bool VMemoryManager::VulkanMemoryAllocator::AllocForImage (VkImage image, const MemoryDesc &desc, OUT Storage_t &data)
 	{
 		EXLOCK( _guard );
+		AllocatorScope	scope{ this };
 
 		VmaAllocationCreateInfo		info = {};
 		info.flags			= _ConvertToMemoryFlags( desc.type );
@@ -228,6 +282,7 @@ namespace FG
 	bool VMemoryManager::VulkanMemoryAllocator::AllocForBuffer (VkBuffer buffer, const MemoryDesc &desc, OUT Storage_t &data)
 	{
 		EXLOCK( _guard );
+		AllocatorScope	scope{ this };
 
 		VmaAllocationCreateInfo		info = {};
 		info.flags			= _ConvertToMemoryFlags( desc.type );
@@ -278,6 +333,7 @@ namespace FG
 	bool VMemoryManager::VulkanMemoryAllocator::AllocForAccelStruct (VkAccelerationStructureNV accelStruct, const MemoryDesc &desc, OUT Storage_t &data)
 	{
 		EXLOCK( _guard );
+		AllocatorScope	scope{ this };
 
 		VkAccelerationStructureMemoryRequirementsInfoNV	mem_info = {};
 		mem_info.sType					= VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_MEMORY_REQUIREMENTS_INFO_NV;
@@ -325,6 +381,7 @@ namespace FG
 	bool VMemoryManager::VulkanMemoryAllocator::Dealloc (INOUT Storage_t &data)
 	{
 		EXLOCK( _guard );
+		AllocatorScope	scope{ this };
 
 		VmaAllocation&	mem = _CastStorage( data )->allocation;
 
@@ -358,6 +415,239 @@ namespace FG
 		return true;
 	}
 	
+/*
+=================================================
+	AllocBlock
+----
+	block is allocated from the same pool that is used by VMA
+=================================================
+*/
+	bool VMemoryManager::VulkanMemoryAllocator::AllocBlock (uint memTypeIndex, VkDeviceSize size, OUT VkDeviceMemory &mem)
+	{
+		EXLOCK( _guard );
+
+		VkMemoryAllocateInfo	info = {};
+		info.sType				= VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+		info.allocationSize		= size;
+		info.memoryTypeIndex	= memTypeIndex;
+
+		VK_CHECK( _AllocateMemory( info, OUT mem ));
+		return true;
+	}
+	
+/*
+=================================================
+	DeallocBlock
+----
+	block is kept in the pool of free blocks, see '_FreeMemory()'
+=================================================
+*/
+	void VMemoryManager::VulkanMemoryAllocator::DeallocBlock (VkDeviceMemory mem, uint memTypeIndex, VkDeviceSize size)
+	{
+		EXLOCK( _guard );
+
+		_releasedBlock.memory	= mem;
+		_releasedBlock.size		= size;
+		_releasedBlock.memType	= memTypeIndex;
+
+		_FreeMemory( mem );
+	}
+
+/*
+=================================================
+	OnSubmit
+----
+	releases memory blocks that were not reused
+	during 'FG_FreeMemoryBlockLifetime' submissions
+=================================================
+*/
+	void VMemoryManager::VulkanMemoryAllocator::OnSubmit (uint submitIndex)
+	{
+		EXLOCK( _guard );
+
+		_submitIndex = submitIndex;
+
+		size_t	count = 0;
+		for (; count < _freeBlocks.size(); ++count)
+		{
+			if ( submitIndex - _freeBlocks[count].lastUsage <= FG_FreeMemoryBlockLifetime )
+				break;
+		}
+		_ReleaseFreeBlocks( count );
+	}
+	
+/*
+=================================================
+	GetStatistics
+=================================================
+*/
+	void VMemoryManager::VulkanMemoryAllocator::GetStatistics (INOUT Statistic_t &result)
+	{
+		EXLOCK( _guard );
+
+		result.memoryBlockReuses		+= _statistic.memoryBlockReuses;
+		result.memoryBlockAllocations	+= _statistic.memoryBlockAllocations;
+		result.memoryBlockReleases		+= _statistic.memoryBlockReleases;
+
+		_statistic = Default;
+	}
+
+/*
+=================================================
+	_AllocateMemory
+----
+	called by VMA instead of 'vkAllocateMemory'
+=================================================
+*/
+	VkResult  VMemoryManager::VulkanMemoryAllocator::_AllocateMemory (const VkMemoryAllocateInfo &info, OUT VkDeviceMemory &mem)
+	{
+		// search for block with the same size and memory type, recently released blocks are preferred
+		if ( info.pNext == null )
+		{
+			for (size_t i = _freeBlocks.size(); i-- > 0;)
+			{
+				auto&	block = _freeBlocks[i];
+
+				if ( block.memType == info.memoryTypeIndex and block.size == info.allocationSize )
+				{
+					mem				 = block.memory;
+					_freeBlocksSize -= block.size;
+					_freeBlocks.erase( _freeBlocks.begin() + i );
+
+					++_statistic.memoryBlockReuses;
+					return VK_SUCCESS;
+				}
+			}
+		}
+
+		VkResult	res = _device.vkAllocateMemory( _device.GetVkDevice(), &info, null, OUT &mem );
+
+		// out of memory budget, release unused blocks and try again
+		if ( (res == VK_ERROR_OUT_OF_DEVICE_MEMORY or res == VK_ERROR_OUT_OF_HOST_MEMORY) and _freeBlocks.size() )
+		{
+			_ReleaseFreeBlocks( _freeBlocks.size() );
+			res = _device.vkAllocateMemory( _device.GetVkDevice(), &info, null, OUT &mem );
+		}
+
+		if ( res == VK_SUCCESS )
+			++_statistic.memoryBlockAllocations;
+
+		return res;
+	}
+	
+/*
+=================================================
+	_FreeMemory
+----
+	called by VMA instead of 'vkFreeMemory'
+=================================================
+*/
+	void  VMemoryManager::VulkanMemoryAllocator::_FreeMemory (VkDeviceMemory mem)
+	{
+		const VkDeviceSize	max_size = VkDeviceSize(FG_MaxFreeMemoryBlocksMb) << 20;
+
+		// block info is unknown or block is too big to be cached
+		if ( _releasedBlock.memory != mem or _releasedBlock.size > max_size )
+		{
+			_mappedBlocks.erase( mem );
+			_device.vkFreeMemory( _device.GetVkDevice(), mem, null );
+			++_statistic.memoryBlockReleases;
+			return;
+		}
+
+		if ( _mappedBlocks.erase( mem ))
+			_device.vkUnmapMemory( _device.GetVkDevice(), mem );
+
+		_releasedBlock.lastUsage = _submitIndex;
+		_freeBlocksSize			+= _releasedBlock.size;
+		_freeBlocks.push_back( _releasedBlock );
+		_releasedBlock			 = Default;
+
+		// release the oldest blocks
+		size_t	count = 0;
+		for (VkDeviceSize size = _freeBlocksSize; size > max_size; ++count) {
+			size -= _freeBlocks[count].size;
+		}
+		_ReleaseFreeBlocks( count );
+	}
+	
+/*
+=================================================
+	_ReleaseFreeBlocks
+----
+	releases the first 'count' blocks
+=================================================
+*/
+	void  VMemoryManager::VulkanMemoryAllocator::_ReleaseFreeBlocks (size_t count)
+	{
+		ASSERT( count <= _freeBlocks.size() );
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			auto&	block = _freeBlocks[i];
+
+			_device.vkFreeMemory( _device.GetVkDevice(), block.memory, null );
+			_freeBlocksSize -= block.size;
+			++_statistic.memoryBlockReleases;
+		}
+		_freeBlocks.erase( _freeBlocks.begin(), _freeBlocks.begin() + count );
+	}
+	
+/*
+=================================================
+	_*Hook
+=================================================
+*/
+	VKAPI_ATTR VkResult VKAPI_CALL  VMemoryManager::VulkanMemoryAllocator::_AllocateMemoryHook (VkDevice, const VkMemoryAllocateInfo* pAllocateInfo,
+																								 const VkAllocationCallbacks* pAllocator, VkDeviceMemory* pMemory)
+	{
+		auto*	self = _currentAllocator;
+		CHECK_ERR( self and pAllocator == null, VK_ERROR_INITIALIZATION_FAILED );
+
+		return self->_AllocateMemory( *pAllocateInfo, OUT *pMemory );
+	}
+	
+	VKAPI_ATTR void VKAPI_CALL  VMemoryManager::VulkanMemoryAllocator::_FreeMemoryHook (VkDevice, VkDeviceMemory memory, const VkAllocationCallbacks* pAllocator)
+	{
+		auto*	self = _currentAllocator;
+		CHECK_ERRV( self and pAllocator == null );
+
+		self->_FreeMemory( memory );
+	}
+	
+	VKAPI_ATTR VkResult VKAPI_CALL  VMemoryManager::VulkanMemoryAllocator::_MapMemoryHook (VkDevice, VkDeviceMemory memory, VkDeviceSize offset, VkDeviceSize size,
+																							VkMemoryMapFlags flags, void** ppData)
+	{
+		auto*	self = _currentAllocator;
+		CHECK_ERR( self, VK_ERROR_INITIALIZATION_FAILED );
+
+		VkResult	res = self->_device.vkMapMemory( self->_device.GetVkDevice(), memory, offset, size, flags, OUT ppData );
+
+		if ( res == VK_SUCCESS )
+			self->_mappedBlocks.insert( memory );
+
+		return res;
+	}
+	
+	VKAPI_ATTR void VKAPI_CALL  VMemoryManager::VulkanMemoryAllocator::_UnmapMemoryHook (VkDevice, VkDeviceMemory memory)
+	{
+		auto*	self = _currentAllocator;
+		CHECK_ERRV( self );
+
+		self->_mappedBlocks.erase( memory );
+		self->_device.vkUnmapMemory( self->_device.GetVkDevice(), memory );
+	}
+
+	void VKAPI_PTR  VMemoryManager::VulkanMemoryAllocator::_OnFreeMemory (VmaAllocator, uint memType, VkDeviceMemory memory, VkDeviceSize size)
+	{
+		auto*	self = _currentAllocator;
+		CHECK_ERRV( self );
+
+		self->_releasedBlock.memory		= memory;
+		self->_releasedBlock.size		= size;
+		self->_releasedBlock.memType	= memType;
+	}
+
 /*
 =================================================
 	_ConvertToMemoryFlags
@@ -445,10 +735,10 @@ namespace FG
 
 		funcs.vkGetPhysicalDeviceProperties			= _var_vkGetPhysicalDeviceProperties;
 		funcs.vkGetPhysicalDeviceMemoryProperties	= _var_vkGetPhysicalDeviceMemoryProperties;
-		funcs.vkAllocateMemory						= BitCast<PFN_vkAllocateMemory>(vkGetDeviceProcAddr( dev, "vkAllocateMemory" ));
-		funcs.vkFreeMemory							= BitCast<PFN_vkFreeMemory>(vkGetDeviceProcAddr( dev, "vkFreeMemory" ));
-		funcs.vkMapMemory							= BitCast<PFN_vkMapMemory>(vkGetDeviceProcAddr( dev, "vkMapMemory" ));
-		funcs.vkUnmapMemory							= BitCast<PFN_vkUnmapMemory>(vkGetDeviceProcAddr( dev, "vkUnmapMemory" ));
+		funcs.vkAllocateMemory						= &_AllocateMemoryHook;		// memory blocks are cached to avoid frequent reallocations
+		funcs.vkFreeMemory							= &_FreeMemoryHook;
+		funcs.vkMapMemory							= &_MapMemoryHook;
+		funcs.vkUnmapMemory							= &_UnmapMemoryHook;
 		funcs.vkBindBufferMemory					= BitCast<PFN_vkBindBufferMemory>(vkGetDeviceProcAddr( dev, "vkBindBufferMemory" ));
 		funcs.vkBindImageMemory						= BitCast<PFN_vkBindImageMemory>(vkGetDeviceProcAddr( dev, "vkBindImageMemory" ));
 		funcs.vkGetBufferMemoryRequirements			= BitCast<PFN_vkGetBufferMemoryRequirements>(vkGetDeviceProcAddr( dev, "vkGetBufferMemoryRequirements" ));
@@ -473,6 +763,10 @@ namespace FG
 		}
 	#endif
 
+		VmaDeviceMemoryCallbacks	mem_callbacks = {};
+		mem_callbacks.pfnAllocate	= null;
+		mem_callbacks.pfnFree		= &_OnFreeMemory;
+
 		VmaAllocatorCreateInfo	info = {};
 		info.flags			= VMA_ALLOCATOR_CREATE_EXTERNALLY_SYNCHRONIZED_BIT;
 		info.physicalDevice	= _device.GetVkPhysicalDevice();
@@ -480,7 +774,7 @@ namespace FG
 
 		info.preferredLargeHeapBlockSize	= VkDeviceSize(FG_VkDevicePageSizeMb) << 20;
 		info.pAllocationCallbacks			= null;
-		info.pDeviceMemoryCallbacks			= null;
+		info.pDeviceMemoryCallbacks			= &mem_callbacks;
 		//info.frameInUseCount	// ignore
 		info.pHeapSizeLimit					= null;		// TODO
 		info.pVulkanFunctions				= &funcs;
@@ -0,0 +1,138 @@
+// Copyright (c) 2018-2020,  Zhirnov Andrey. For more information see 'LICENSE'
+
+#include "VStagingRing.h"
+
+namespace FG
+{
+
+/*
+=================================================
+	destructor
+=================================================
+*/
+	VStagingRing::~VStagingRing ()
+	{
+		ASSERT( not _bufferId );
+	}
+
+/*
+=================================================
+	Create
+=================================================
+*/
+	bool  VStagingRing::Create (RawBufferID bufferId, const VMemoryObj::MemoryInfo &info, BytesU capacity)
+	{
+		EXLOCK( _guard );
+		CHECK_ERR( not _bufferId );
+		CHECK_ERR( bufferId and info.mappedPtr );
+		CHECK_ERR( capacity >= ChunkAlign and capacity % ChunkAlign == 0 );
+
+		_bufferId	= bufferId;
+		_memory		= info.mem;
+		_memOffset	= info.offset;
+		_mappedPtr	= info.mappedPtr;
+		_capacity	= capacity;
+		_isCoherent	= AllBits( info.flags, VK_MEMORY_PROPERTY_HOST_COHERENT_BIT );
+		_head		= 0;
+		_tail		= 0;
+		return true;
+	}
+
+/*
+=================================================
+	Destroy
+----
+	returns buffer that must be released by resource manager
+=================================================
+*/
+	RawBufferID  VStagingRing::Destroy ()
+	{
+		EXLOCK( _guard );
+		ASSERT( _allocations.empty() );
+
+		RawBufferID	result = _bufferId;
+
+		_bufferId	= Default;
+		_memory		= VK_NULL_HANDLE;
+		_mappedPtr	= null;
+		_allocations.clear();
+
+		return result;
+	}
+
+/*
+=================================================
+	Alloc
+----
+	chunk must be contiguous, so if free space at the end
+	of buffer is too small then it is skipped and will be
+	released together with the chunk
+=================================================
+*/
+	bool  VStagingRing::Alloc (BytesU size, BytesU minSize, OUT Chunk &result)
+	{
+		EXLOCK( _guard );
+		ASSERT( minSize <= size );
+
+		const VkDeviceSize	capacity	= VkDeviceSize(_capacity);
+		const VkDeviceSize	min_size	= VkDeviceSize(AlignToLarger( Max( minSize, 1_b ), ChunkAlign ));
+		VkDeviceSize		offset		= _head % capacity;
+		VkDeviceSize		available	= capacity - (_head - _tail);
+		VkDeviceSize		padding		= 0;
+
+		if ( capacity - offset < min_size )
+		{
+			padding		 = Min( available, capacity - offset );
+			available	-= padding;
+			offset		 = 0;
+		}
+
+		available = Min( available, capacity - offset );
+
+		if ( available < min_size )
+			return false;
+
+		const VkDeviceSize	alloc_size = Min( VkDeviceSize(AlignToLarger( size, ChunkAlign )), available );
+
+		result.begin	= _head;
+		result.end		= _head + padding + alloc_size;
+		result.offset	= BytesU(offset);
+		result.size		= BytesU(alloc_size);
+
+		_allocations.push_back({ result.begin, result.end, false });
+		_head = result.end;
+		return true;
+	}
+
+/*
+=================================================
+	Release
+=================================================
+*/
+	void  VStagingRing::Release (const Chunk &chunk)
+	{
+		EXLOCK( _guard );
+
+		auto	iter = std::lower_bound( _allocations.begin(), _allocations.end(), chunk.begin,
+										 [] (auto& lhs, VkDeviceSize rhs) { return lhs.begin < rhs; });
+
+		CHECK_ERRV( iter != _allocations.end() and iter->begin == chunk.begin and not iter->released );
+		iter->released = true;
+
+		// free space only after all previous chunks are released
+		for (; _allocations.size() and _allocations.front().released;)
+		{
+			_tail = _allocations.front().end;
+			_allocations.pop_front();
+		}
+
+		// ring is empty, start from the beginning to get the largest contiguous space
+		if ( _allocations.empty() )
+		{
+			_head = 0;
+			_tail = 0;
+		}
+	}
+
+
+}	// FG
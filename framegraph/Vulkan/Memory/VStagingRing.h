@@ -0,0 +1,81 @@
+// Copyright (c) 2018-2020,  Zhirnov Andrey. For more information see 'LICENSE'
+/*
+	Persistently mapped host visible buffer that is used as ring buffer for uploads, one per queue.
+	Command batch acquires chunk of the ring and sub-allocates data inside the chunk by pointer bump.
+	Chunk is released when batch is complete, but memory becomes available only when
+	all previously acquired chunks are released too, because batches may complete in any order.
+*/
+
+#pragma once
+
+#include "VMemoryObj.h"
+
+namespace FG
+{
+
+	//
+	// Vulkan Staging Ring Buffer
+	//
+
+	class VStagingRing final
+	{
+	// types
+	public:
+		struct Chunk
+		{
+			VkDeviceSize	begin	= 0;	// position in the ring, includes padding at the end of buffer
+			VkDeviceSize	end		= 0;
+			BytesU			offset;			// offset in the buffer
+			BytesU			size;
+		};
+
+	private:
+		struct Allocation
+		{
+			VkDeviceSize	begin;
+			VkDeviceSize	end;
+			bool			released;
+		};
+		using Allocations_t	= Deque< Allocation >;
+
+		static constexpr BytesU		ChunkAlign	= 256_b;
+
+
+	// variables
+	private:
+		Mutex				_guard;
+		VkDeviceSize		_head		= 0;		// protected by '_guard'
+		VkDeviceSize		_tail		= 0;		// protected by '_guard'
+		Allocations_t		_allocations;			// sorted by position, protected by '_guard'
+
+		// immutable after creation
+		RawBufferID			_bufferId;
+		VkDeviceMemory		_memory		= VK_NULL_HANDLE;
+		BytesU				_memOffset;
+		void *				_mappedPtr	= null;
+		BytesU				_capacity;
+		bool				_isCoherent	= false;
+
+
+	// methods
+	public:
+		VStagingRing () {}
+		~VStagingRing ();
+
+		bool  Create (RawBufferID bufferId, const VMemoryObj::MemoryInfo &info, BytesU capacity);
+		ND_ RawBufferID  Destroy ();
+
+		// returns contiguous chunk of at least 'minSize' bytes, 'false' if ring is full
+		ND_ bool  Alloc (BytesU size, BytesU minSize, OUT Chunk &result);
+			void  Release (const Chunk &chunk);
+
+		ND_ RawBufferID		GetBufferID ()		const	{ return _bufferId; }
+		ND_ VkDeviceMemory	GetMemory ()		const	{ return _memory; }
+		ND_ BytesU			GetMemOffset ()		const	{ return _memOffset; }
+		ND_ void *			GetMappedPtr ()		const	{ return _mappedPtr; }
+		ND_ BytesU			Capacity ()			const	{ return _capacity; }
+		ND_ bool			IsCoherent ()		const	{ return _isCoherent; }
+	};
+
+
+}	// FG
@@ -0,0 +1,145 @@
+// Copyright (c) 2018-2020,  Zhirnov Andrey. For more information see 'LICENSE'
+
+#include "VAsyncPipelineCompiler.h"
+#include "VPipelineCache.h"
+#include "VDevice.h"
+
+namespace FG
+{
+
+/*
+=================================================
+	constructor
+=================================================
+*/
+	VAsyncPipelineCompiler::VAsyncPipelineCompiler (const VDevice &dev) :
+		_device{ dev }
+	{}
+
+/*
+=================================================
+	destructor
+=================================================
+*/
+	VAsyncPipelineCompiler::~VAsyncPipelineCompiler ()
+	{
+		CHECK( not IsStarted() );
+	}
+
+/*
+=================================================
+	Start
+=================================================
+*/
+	bool  VAsyncPipelineCompiler::Start (uint threadCount, VPipelineCache &deviceCache)
+	{
+		CHECK_ERR( not IsStarted() );
+		CHECK_ERR( threadCount > 0 );
+
+		_deviceCache = &deviceCache;
+
+		CHECK_ERR( _threads.Start( threadCount, "FG_PplnCompiler" ));
+		return true;
+	}
+
+/*
+=================================================
+	Stop
+----
+	remaining jobs are executed on the current thread,
+	then per-job caches are merged into the device cache.
+=================================================
+*/
+	void  VAsyncPipelineCompiler::Stop ()
+	{
+		if ( not IsStarted() )
+			return;
+
+		_threads.Stop();
+
+		EXLOCK( _guard );
+
+		for (auto& cache : _freeCaches)
+		{
+			if ( cache->IsCreated() )
+			{
+				CHECK( _deviceCache->MergeCache( _device, *cache ));
+				cache->Deinitialize( _device );
+			}
+		}
+
+		_freeCaches.clear();
+		_deviceCache = null;
+	}
+
+/*
+=================================================
+	Enqueue
+----
+	job must be completed even if compilation failed, because it owns pending pipeline instance
+=================================================
+*/
+	void  VAsyncPipelineCompiler::Enqueue (Job_t &&job)
+	{
+		ASSERT( IsStarted() );
+
+		_threads.Enqueue( [this, job = std::move(job)] ()
+		{
+			auto	cache = _AcquireCache();
+
+			if ( job( *cache ))
+				_compiledCount.fetch_add( 1, memory_order_relaxed );
+
+			_ReleaseCache( std::move(cache) );
+		});
+	}
+
+/*
+=================================================
+	GetStatistics
+=================================================
+*/
+	void  VAsyncPipelineCompiler::GetStatistics (INOUT Statistic_t &result)
+	{
+		result.asyncGraphicsPipelineCount += _compiledCount.exchange( 0, memory_order_relaxed );
+	}
+
+/*
+=================================================
+	_AcquireCache
+----
+	uninitialized cache is valid too,
+	pipelines are created without cache in this case.
+=================================================
+*/
+	UniquePtr<VPipelineCache>  VAsyncPipelineCompiler::_AcquireCache ()
+	{
+		{
+			EXLOCK( _guard );
+
+			if ( _freeCaches.size() )
+			{
+				auto	cache = std::move( _freeCaches.back() );
+				_freeCaches.pop_back();
+				return cache;
+			}
+		}
+
+		auto	cache = std::make_unique<VPipelineCache>();
+		CHECK( cache->Initialize( _device, *_deviceCache ));
+		return cache;
+	}
+
+/*
+=================================================
+	_ReleaseCache
+=================================================
+*/
+	void  VAsyncPipelineCompiler::_ReleaseCache (UniquePtr<VPipelineCache> &&cache)
+	{
+		EXLOCK( _guard );
+		_freeCaches.push_back( std::move(cache) );
+	}
+
+
+}	// FG
@@ -0,0 +1,68 @@
+// Copyright (c) 2018-2020,  Zhirnov Andrey. For more information see 'LICENSE'
+/*
+	Compiles graphics pipeline instances on background threads.
+
+	Each job gets its own pipeline cache, caches are created from the device-wide cache
+	and merged back into it in 'Stop()', so compiled pipelines are saved with the device cache.
+	Pipeline instance is inserted as pending when job is enqueued, draw tasks that use
+	pending instance are skipped or drawn with fallback pipeline, see 'VulkanDeviceInfo::asyncPipelineCompilation'.
+*/
+
+#pragma once
+
+#include "framegraph/Public/FrameGraph.h"
+#include "VCommon.h"
+#include "stl/ThreadSafe/ThreadPool.h"
+
+namespace FG
+{
+
+	//
+	// Async Pipeline Compiler
+	//
+
+	class VAsyncPipelineCompiler final
+	{
+	// types
+	public:
+		using Job_t			= Function< bool (VPipelineCache &) >;
+		using Statistic_t	= IFrameGraph::ResourceStatistics;
+
+	private:
+		using Caches_t		= Array< UniquePtr< VPipelineCache >>;
+
+
+	// variables
+	private:
+		VDevice const&			_device;
+		VPipelineCache *		_deviceCache	= null;
+
+		ThreadPool				_threads;
+
+		Mutex					_guard;
+		Caches_t				_freeCaches;		// caches that are not used by jobs, protected by '_guard'
+
+		Atomic<uint>			_compiledCount	{0};
+
+
+	// methods
+	public:
+		explicit VAsyncPipelineCompiler (const VDevice &dev);
+		~VAsyncPipelineCompiler ();
+
+		bool  Start (uint threadCount, VPipelineCache &deviceCache);
+		void  Stop ();
+
+		void  Enqueue (Job_t &&job);
+
+		void  GetStatistics (INOUT Statistic_t &result);
+
+		ND_ bool  IsStarted ()	const	{ return _deviceCache != null; }
+
+	private:
+		ND_ UniquePtr<VPipelineCache>  _AcquireCache ();
+			void  _ReleaseCache (UniquePtr<VPipelineCache> &&cache);
+	};
+
+
+}	// FG
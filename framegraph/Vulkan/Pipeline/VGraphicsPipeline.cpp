@@ -123,6 +123,7 @@ namespace FG
 
 		_shaders.clear();
 		_instances.clear();
+		_failedInstances.clear();
 		_vertexAttribs.clear();
 		_debugName.clear();
 
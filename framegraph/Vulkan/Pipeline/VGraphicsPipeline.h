@@ -53,6 +53,7 @@ namespace FG
 		};
 
 		using Instances_t			= HashMap< PipelineInstance, VkPipeline, PipelineInstanceHash >;
+		using FailedInstances_t		= HashSet< PipelineInstance, PipelineInstanceHash >;
 		using ShaderModules_t		= FixedArray< ShaderModule, 8 >;
 		using TopologyBits_t		= GraphicsPipelineDesc::TopologyBits_t;
 		using VertexAttrib			= VertexInputState::VertexAttrib;
@@ -63,6 +64,7 @@ namespace FG
 	private:
 		mutable SharedMutex			_instanceGuard;
 		mutable Instances_t			_instances;
+		mutable FailedInstances_t	_failedInstances;	// instances that failed to compile on background thread, protected by '_instanceGuard'
 
 		PipelineLayoutID			_baseLayoutId;
 		ShaderModules_t				_shaders;
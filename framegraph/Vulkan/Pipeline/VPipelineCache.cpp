@@ -6,6 +6,9 @@
 #include "VEnumCast.h"
 #include "VRenderPass.h"
 #include "VCommandBuffer.h"
+#include "VAsyncPipelineCompiler.h"
+#include "stl/Stream/FileStream.h"
+#include "stl/Algorithms/StringUtils.h"
 
 namespace FG
 {
@@ -52,6 +55,24 @@ namespace FG
 		return true;
 	}
 	
+/*
+=================================================
+	Initialize
+----
+	creates cache that contains all pipelines from 'initial' cache,
+	'initial' must not be modified at the same time.
+=================================================
+*/
+	bool VPipelineCache::Initialize (const VDevice &dev, const VPipelineCache &initial)
+	{
+		CHECK_ERR( _CreatePipelineCache( dev ));
+
+		if ( initial.IsCreated() )
+			CHECK_ERR( MergeCache( dev, initial ));
+
+		return true;
+	}
+	
 /*
 =================================================
 	Deinitialize
@@ -66,15 +87,121 @@ namespace FG
 		}
 	}
 
+/*
+=================================================
+	Load
+----
+	creates cache with data from file,
+	if file doesn't exist, is damaged or was created on another device or driver then cache will be empty
+	and 'isLoaded' is 'false'.
+=================================================
+*/
+	bool VPipelineCache::Load (const VDevice &dev, NtStringView filename, OUT bool &isLoaded)
+	{
+		STATIC_ASSERT( sizeof(FileHeader) == 56 );
+		STATIC_ASSERT( offsetof(FileHeader, dataSize) == offsetof(FileHeader, padding) + sizeof(uint) );
+
+		isLoaded = false;
+
+		FileRStream		file{ filename };
+		FileHeader		header;
+		Array<uint8_t>	data;
+
+		const auto	IsValid = [&] ()
+		{
+			auto&	props = dev.GetProperties().properties;
+
+			if ( not file.IsOpen() or not file.Read( OUT header ))
+				return false;
+
+			if ( header.magic			!= FileHeader::Magic	or
+				 header.version			!= FileHeader::Version	or
+				 header.padding			!= 0					or
+				 header.vendorID		!= props.vendorID		or
+				 header.deviceID		!= props.deviceID		or
+				 header.driverVersion	!= props.driverVersion	or
+				 std::memcmp( header.pipelineCacheUUID, props.pipelineCacheUUID, sizeof(header.pipelineCacheUUID) ) != 0 )
+				return false;
+
+			if ( header.dataSize == 0												or
+				 BytesU{header.dataSize} != file.RemainingSize()					or
+				 not file.Read( size_t(header.dataSize), OUT data )					or
+				 size_t(HashOf( data.data(), data.size() )) != header.dataHash )
+				return false;
+
+			return true;
+		};
+
+		if ( not IsValid() )
+		{
+			if ( file.IsOpen() )
+				FG_LOGI( "pipeline cache '"s << filename.c_str() << "' is not compatible with current device and will be replaced" );
+			
+			data.clear();
+		}
+
+		CHECK_ERR( _CreatePipelineCache( dev, data ));
+
+		isLoaded = not data.empty();
+		return true;
+	}
+	
+/*
+=================================================
+	Save
+----
+	file is rewritten, header contains device and driver info
+	that is checked in 'Load()'.
+=================================================
+*/
+	bool VPipelineCache::Save (const VDevice &dev, NtStringView filename) const
+	{
+		CHECK_ERR( _pipelinesCache );
+
+		size_t	size = 0;
+		VK_CHECK( dev.vkGetPipelineCacheData( dev.GetVkDevice(), _pipelinesCache, OUT &size, null ));
+
+		if ( size == 0 )
+			return true;
+
+		Array<uint8_t>	data;
+		data.resize( size );
+		VK_CHECK( dev.vkGetPipelineCacheData( dev.GetVkDevice(), _pipelinesCache, INOUT &size, OUT data.data() ));
+		data.resize( size );
+
+		auto&		props	= dev.GetProperties().properties;
+		FileHeader	header	= {};
+		header.magic			= FileHeader::Magic;
+		header.version			= FileHeader::Version;
+		header.vendorID			= props.vendorID;
+		header.deviceID			= props.deviceID;
+		header.driverVersion	= props.driverVersion;
+		header.dataSize			= uint64_t(size);
+		header.dataHash			= uint64_t(size_t(HashOf( data.data(), data.size() )));
+		std::memcpy( OUT header.pipelineCacheUUID, props.pipelineCacheUUID, sizeof(header.pipelineCacheUUID) );
+
+		FileWStream		file{ filename };
+		CHECK_ERR( file.IsOpen() );
+		CHECK_ERR( file.Write( header ));
+		CHECK_ERR( file.Write( ArrayView<uint8_t>{ data }));
+		return true;
+	}
+
 /*
 =================================================
 	MergeCache
+----
+	adds pipelines from 'src' cache,
+	this cache must be externally synchronized.
 =================================================
 */
-	bool VPipelineCache::MergeCache (VPipelineCache &)
+	bool VPipelineCache::MergeCache (const VDevice &dev, const VPipelineCache &src)
 	{
-		// TODO
-		return false;
+		CHECK_ERR( _pipelinesCache and src._pipelinesCache );
+		CHECK_ERR( _pipelinesCache != src._pipelinesCache );
+
+		VK_CHECK( dev.vkMergePipelineCaches( dev.GetVkDevice(), _pipelinesCache, 1, &src._pipelinesCache ));
+		return true;
 	}
 	
 /*
@@ -82,7 +209,7 @@ namespace FG
 	_CreatePipelineCache
 =================================================
 */
-	bool  VPipelineCache::_CreatePipelineCache (const VDevice &dev)
+	bool  VPipelineCache::_CreatePipelineCache (const VDevice &dev, ArrayView<uint8_t> initialData)
 	{
 		CHECK_ERR( not _pipelinesCache );
 
@@ -90,8 +217,8 @@ namespace FG
 		info.sType				= VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
 		info.pNext				= null;
 		info.flags				= 0;
-		info.initialDataSize	= 0;
-		info.pInitialData		= null;
+		info.initialDataSize	= initialData.size();
+		info.pInitialData		= initialData.data();
 
 		VK_CHECK( dev.vkCreatePipelineCache( dev.GetVkDevice(), &info, null, OUT &_pipelinesCache ));
 		return true;
@@ -195,15 +322,211 @@ namespace FG
 			CHECK( _SetupShaderDebugging( fgThread, gppln, debugModeIndex, OUT dbg_mode, OUT dbg_stages, OUT layout_id ));
 		}
 
-		VGraphicsPipeline::PipelineInstance		inst;
-		inst.layoutId		= layout_id;
+		GraphicsInstance_t	inst;
+		CHECK_ERR( _InitGraphicsInstance( dev, logicalRP, gppln, vertexInput, renderState, dynamicStates,
+										  layout_id, GetDebugModeHash( dbg_mode, dbg_stages ), OUT inst ));
+		
+		outLayout = fgThread.AcquireTemporary( layout_id );
+
+		// find existing instance, pending instance is not used
+		{
+			SHAREDLOCK( gppln._instanceGuard );
+
+			auto iter = gppln._instances.find( inst );
+			if ( iter != gppln._instances.end() and iter->second != VK_NULL_HANDLE ) {
+				outPipeline = iter->second;
+				return true;
+			}
+		}
+
+		// create new instance
+		outPipeline = {};
+		CHECK_ERR( _CreateGraphicsPipeline( dev, gppln, inst, *render_pass, *outLayout, dbg_mode, dbg_stages, OUT outPipeline ));
+
+		fgThread.EditStatistic().resources.newGraphicsPipelineCount++;
+		
+		// try to insert new instance
+		{
+			EXLOCK( gppln._instanceGuard );
+
+			auto[iter, inserted] = gppln._instances.insert({ std::move(inst), outPipeline });
+		
+			if ( not inserted )
+			{
+				// replace pending instance, layout is already referenced by it
+				if ( iter->second == VK_NULL_HANDLE ) {
+					iter->second = outPipeline;
+					return true;
+				}
+
+				dev.vkDestroyPipeline( dev.GetVkDevice(), outPipeline, null );
+
+				outPipeline = iter->second;
+				return true;
+			}
+		}
+		
+		CHECK( fgThread.GetResourceManager().AcquireResource( layout_id ));
+		return true;
+	}
+	
+/*
+=================================================
+	CreatePipelineInstanceAsync
+----
+	returns null pipeline if instance is not compiled yet,
+	new instance is added as pending and compiled by 'compiler', pending instance holds reference to the layout.
+	'outFailed' is 'true' if compilation of this instance has failed, error is reported only once by compiler.
+	shader debugging is not supported here.
+=================================================
+*/
+	bool  VPipelineCache::CreatePipelineInstanceAsync (VCommandBuffer				&fgThread,
+													   VAsyncPipelineCompiler		&compiler,
+													   const VLogicalRenderPass		&logicalRP,
+													   const RawGPipelineID			 pipelineId,
+													   const VGraphicsPipeline		&gppln,
+													   const VertexInputState		&vertexInput,
+													   const RenderState			&renderState,
+													   const EPipelineDynamicState	 dynamicStates,
+													   OUT VkPipeline				&outPipeline,
+													   OUT VPipelineLayout const*	&outLayout,
+													   OUT bool						&outFailed)
+	{
+		CHECK_ERR( logicalRP.GetRenderPassID() );
+
+		const RawPipelineLayoutID	layout_id = gppln.GetLayoutID();
+		GraphicsInstance_t			inst;
+
+		CHECK_ERR( _InitGraphicsInstance( fgThread.GetDevice(), logicalRP, gppln, vertexInput, renderState, dynamicStates,
+										  layout_id, GetDebugModeHash( Default, Default ), OUT inst ));
+
+		outLayout	= fgThread.AcquireTemporary( layout_id );
+		outPipeline	= VK_NULL_HANDLE;
+		outFailed	= false;
+
+		// find existing, pending or failed instance
+		{
+			SHAREDLOCK( gppln._instanceGuard );
+
+			auto iter = gppln._instances.find( inst );
+			if ( iter != gppln._instances.end() ) {
+				outPipeline = iter->second;
+				return true;
+			}
+
+			if ( gppln._failedInstances.count( inst )) {
+				outFailed = true;
+				return true;
+			}
+		}
+
+		// try to insert pending instance
+		{
+			EXLOCK( gppln._instanceGuard );
+
+			if ( gppln._failedInstances.count( inst )) {
+				outFailed = true;
+				return true;
+			}
+
+			auto[iter, inserted] = gppln._instances.insert({ inst, VK_NULL_HANDLE });
+
+			if ( not inserted ) {
+				outPipeline = iter->second;
+				return true;
+			}
+		}
+
+		VResourceManager&	res_mngr	= fgThread.GetResourceManager();
+		VRenderPass const*	render_pass	= fgThread.AcquireTemporary( inst.renderPassId );
+		
+		// pipeline and render pass must be alive until compilation is complete
+		CHECK( res_mngr.AcquireResource( layout_id ));
+		CHECK( res_mngr.AcquireResource( pipelineId ));
+		CHECK( res_mngr.AcquireResource( inst.renderPassId ));
+
+		compiler.Enqueue( [&res_mngr, &gppln, pipelineId, inst = std::move(inst), render_pass, layout = outLayout] (VPipelineCache &cache)
+		{
+			const bool	result = cache._CompileGraphicsInstance( res_mngr, gppln, inst, *render_pass, *layout );
+
+			res_mngr.ReleaseResource( inst.renderPassId );
+			res_mngr.ReleaseResource( pipelineId );
+			return result;
+		});
+		return true;
+	}
+	
+/*
+=================================================
+	_CompileGraphicsInstance
+----
+	called by async compiler,
+	returns 'true' if compiled pipeline was added to the pending instance.
+	if compilation failed then pending instance is replaced by failed marker,
+	so compilation is not restarted on each draw call.
+=================================================
+*/
+	bool  VPipelineCache::_CompileGraphicsInstance (VResourceManager &resMngr, const VGraphicsPipeline &gppln, const GraphicsInstance_t &inst,
+													const VRenderPass &renderPass, const VPipelineLayout &layout)
+	{
+		VDevice const&	dev		= resMngr.GetDevice();
+		VkPipeline		ppln	= VK_NULL_HANDLE;
+		const bool		created	= _CreateGraphicsPipeline( dev, gppln, inst, renderPass, layout, Default, Default, OUT ppln );
+		{
+			EXLOCK( gppln._instanceGuard );
+
+			auto	iter = gppln._instances.find( inst );
+			ASSERT( iter != gppln._instances.end() );	// pending instance is removed only here
+
+			if ( iter != gppln._instances.end() )
+			{
+				// instance was created synchronously, see 'CreatePipelineInstance()'
+				if ( iter->second != VK_NULL_HANDLE )
+				{
+					if ( created )
+						dev.vkDestroyPipeline( dev.GetVkDevice(), ppln, null );
+					return false;
+				}
+
+				if ( created )
+				{
+					iter->second = ppln;
+					return true;
+				}
+
+				gppln._instances.erase( iter );
+				gppln._failedInstances.insert( inst );
+			}
+		}
+
+		if ( created )
+			dev.vkDestroyPipeline( dev.GetVkDevice(), ppln, null );
+		else
+			FG_LOGE( "failed to compile graphics pipeline instance, draw tasks that use it will be skipped or drawn with fallback pipeline" );
+
+		// failed marker doesn't hold reference to the layout
+		resMngr.ReleaseResource( inst.layoutId );
+		return false;
+	}
+
+/*
+=================================================
+	_InitGraphicsInstance
+=================================================
+*/
+	bool  VPipelineCache::_InitGraphicsInstance (const VDevice &dev, const VLogicalRenderPass &logicalRP, const VGraphicsPipeline &gppln,
+												 const VertexInputState &vertexInput, const RenderState &renderState,
+												 const EPipelineDynamicState dynamicStates, RawPipelineLayoutID layoutId, uint debugMode,
+												 OUT GraphicsInstance_t &inst) const
+	{
+		inst.layoutId		= layoutId;
 		inst.dynamicState	= dynamicStates;
 		inst.renderPassId	= logicalRP.GetRenderPassID();
 		inst.subpassIndex	= uint8_t(logicalRP.GetSubpassIndex());
 		inst.vertexInput	= vertexInput;
 		//inst.flags		= 0;	//pipelineFlags;	// TODO
 		inst.viewportCount	= uint8_t(logicalRP.GetViewports().size());
-		inst.debugMode		= GetDebugModeHash( dbg_mode, dbg_stages );
+		inst.debugMode		= debugMode;
 		inst.renderState	= renderState;
 
 		if ( gppln._patchControlPoints )
@@ -217,22 +540,18 @@ namespace FG
 					gppln._supportedTopology[uint(inst.renderState.inputAssembly.topology)] );
 
 		inst.UpdateHash();
-		
-		outLayout = fgThread.AcquireTemporary( layout_id );
-
-		// find existing instance
-		{
-			SHAREDLOCK( gppln._instanceGuard );
-
-			auto iter = gppln._instances.find( inst );
-			if ( iter != gppln._instances.end() ) {
-				outPipeline = iter->second;
-				return true;
-			}
-		}
-
+		return true;
+	}
 
-		// create new instance
+/*
+=================================================
+	_CreateGraphicsPipeline
+=================================================
+*/
+	bool  VPipelineCache::_CreateGraphicsPipeline (const VDevice &dev, const VGraphicsPipeline &gppln, const GraphicsInstance_t &inst,
+												   const VRenderPass &renderPass, const VPipelineLayout &layout,
+												   EShaderDebugMode dbgMode, EShaderStages dbgStages, OUT VkPipeline &outPipeline)
+	{
 		_ClearTemp();
 
 		VkGraphicsPipelineCreateInfo			pipeline_info		= {};
@@ -246,9 +565,9 @@ namespace FG
 		VkPipelineVertexInputStateCreateInfo	vertex_input_info	= {};
 		VkPipelineViewportStateCreateInfo		viewport_info		= {};
 
-		CHECK_ERR( _SetShaderStages( OUT _tempStages, INOUT _tempSpecialization, INOUT _tempSpecEntries, gppln._shaders, dbg_mode, dbg_stages ));
+		CHECK_ERR( _SetShaderStages( OUT _tempStages, INOUT _tempSpecialization, INOUT _tempSpecEntries, gppln._shaders, dbgMode, dbgStages ));
 		_SetDynamicState( OUT dynamic_state_info, OUT _tempDynamicStates, inst.dynamicState );
-		_SetColorBlendState( OUT blend_info, OUT _tempAttachments, inst.renderState.color, *render_pass, inst.subpassIndex );
+		_SetColorBlendState( OUT blend_info, OUT _tempAttachments, inst.renderState.color, renderPass, inst.subpassIndex );
 		_SetMultisampleState( OUT multisample_info, inst.renderState.multisample );
 		_SetTessellationState( OUT tessellation_info, gppln._patchControlPoints );
 		_SetDepthStencilState( OUT depth_stencil_info, inst.renderState.depth, inst.renderState.stencil );
@@ -271,10 +590,10 @@ namespace FG
 		pipeline_info.pDynamicState			= (_tempDynamicStates.empty() ? null : &dynamic_state_info);
 		pipeline_info.basePipelineIndex		= -1;
 		pipeline_info.basePipelineHandle	= VK_NULL_HANDLE;
-		pipeline_info.layout				= outLayout->Handle();
+		pipeline_info.layout				= layout.Handle();
 		pipeline_info.stageCount			= uint(_tempStages.size());
 		pipeline_info.pStages				= _tempStages.data();
-		pipeline_info.renderPass			= render_pass->Handle();
+		pipeline_info.renderPass			= renderPass.Handle();
 		pipeline_info.subpass				= inst.subpassIndex;
 		
 		if ( not rasterization_info.rasterizerDiscardEnable )
@@ -287,29 +606,10 @@ namespace FG
 			pipeline_info.pColorBlendState		= null;
 		}
 
-		outPipeline = {};
 		VK_CHECK( dev.vkCreateGraphicsPipelines( dev.GetVkDevice(), _pipelinesCache, 1, &pipeline_info, null, OUT &outPipeline ));
-
-		fgThread.EditStatistic().resources.newGraphicsPipelineCount++;
-		
-		// try to insert new instance
-		{
-			EXLOCK( gppln._instanceGuard );
-
-			auto[iter, inserted] = gppln._instances.insert({ std::move(inst), outPipeline });
-		
-			if ( not inserted )
-			{
-				dev.vkDestroyPipeline( dev.GetVkDevice(), outPipeline, null );
-
-				outPipeline = iter->second;
-				return true;
-			}
-		}
-		
-		CHECK( fgThread.GetResourceManager().AcquireResource( layout_id ));
 		return true;
 	}
+
 /*
 =================================================
 	CreatePipelineInstance
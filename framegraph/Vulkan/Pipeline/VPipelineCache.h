@@ -61,6 +61,24 @@ namespace FG
 		using RTShaderSpecializations_t	= FixedArray< RTShaderSpec, 32 >;
 		
 		using ShaderModule_t			= VGraphicsPipeline::ShaderModule;
+		using GraphicsInstance_t		= VGraphicsPipeline::PipelineInstance;
+
+		// header of the pipeline cache file, written as raw bytes
+		struct FileHeader
+		{
+			static constexpr uint	Magic	= 0x46474350;	// 'FGCP'
+			static constexpr uint	Version	= 1;
+
+			uint		magic;
+			uint		version;
+			uint		vendorID;
+			uint		deviceID;
+			uint		driverVersion;
+			uint8_t		pipelineCacheUUID [VK_UUID_SIZE];
+			uint		padding;			// must be zero, makes alignment of 'dataSize' explicit
+			uint64_t	dataSize;
+			uint64_t	dataHash;
+		};
 
 	public:
 		struct BufferCopyRegion
@@ -100,9 +118,15 @@ namespace FG
 		~VPipelineCache ();
 		
 		bool Initialize (const VDevice &dev);
+		bool Initialize (const VDevice &dev, const VPipelineCache &initial);
 		void Deinitialize (const VDevice &dev);
 
-		bool MergeCache (VPipelineCache &);
+		bool Load (const VDevice &dev, NtStringView filename, OUT bool &isLoaded);
+		bool Save (const VDevice &dev, NtStringView filename) const;
+
+		bool MergeCache (const VDevice &dev, const VPipelineCache &);
+
+		ND_ bool  IsCreated () const	{ return _pipelinesCache != VK_NULL_HANDLE; }
 
 		bool CreatePipelineInstance (VCommandBuffer					&fgThread,
 									 const VLogicalRenderPass		&logicalRP,
@@ -114,6 +138,18 @@ namespace FG
 									 OUT VkPipeline					&outPipeline,
 									 OUT VPipelineLayout const*		&outLayout);
 		
+		bool CreatePipelineInstanceAsync (VCommandBuffer				&fgThread,
+										  VAsyncPipelineCompiler		&compiler,
+										  const VLogicalRenderPass		&logicalRP,
+										  const RawGPipelineID			 pipelineId,
+										  const VGraphicsPipeline		&gpipeline,
+										  const VertexInputState		&vertexInput,
+										  const RenderState				&renderState,
+										  const EPipelineDynamicState	 dynamicStates,
+										  OUT VkPipeline				&outPipeline,
+										  OUT VPipelineLayout const*	&outLayout,
+										  OUT bool						&outFailed);
+		
 		bool CreatePipelineInstance (VCommandBuffer					&fgThread,
 									 const VLogicalRenderPass		&logicalRP,
 									 const VMeshPipeline			&mpipeline,
@@ -142,7 +178,7 @@ namespace FG
 
 
 	private:
-		bool _CreatePipelineCache (const VDevice &dev);
+		bool _CreatePipelineCache (const VDevice &dev, ArrayView<uint8_t> initialData = {});
 
 		template <typename Pipeline>
 		bool _SetupShaderDebugging (VCommandBuffer &fgThread, const Pipeline &ppln, ShaderDbgIndex debugModeIndex,
@@ -150,6 +186,18 @@ namespace FG
 
 		void _ClearTemp ();
 
+		bool _InitGraphicsInstance (const VDevice &dev, const VLogicalRenderPass &logicalRP, const VGraphicsPipeline &gppln,
+									const VertexInputState &vertexInput, const RenderState &renderState,
+									EPipelineDynamicState dynamicStates, RawPipelineLayoutID layoutId, uint debugMode,
+									OUT GraphicsInstance_t &inst) const;
+
+		bool _CreateGraphicsPipeline (const VDevice &dev, const VGraphicsPipeline &gppln, const GraphicsInstance_t &inst,
+									  const VRenderPass &renderPass, const VPipelineLayout &layout,
+									  EShaderDebugMode dbgMode, EShaderStages dbgStages, OUT VkPipeline &outPipeline);
+
+		bool _CompileGraphicsInstance (VResourceManager &resMngr, const VGraphicsPipeline &gppln, const GraphicsInstance_t &inst,
+									   const VRenderPass &renderPass, const VPipelineLayout &layout);
+
 		void _SetColorBlendState (OUT VkPipelineColorBlendStateCreateInfo &outState,
 								  OUT ColorAttachments_t &attachments,
 								  const RenderState::ColorBuffersState &inState,
@@ -2,6 +2,7 @@
 
 #include "VPipelineLayout.h"
 #include "VResourceManager.h"
+#include "VBindlessHeap.h"
 #include "VDevice.h"
 #include "VEnumCast.h"
 
@@ -118,7 +119,7 @@ namespace FG
 	Create
 =================================================
 */
-	bool VPipelineLayout::Create (const VDevice &dev, VkDescriptorSetLayout emptyLayout)
+	bool VPipelineLayout::Create (const VDevice &dev, VkDescriptorSetLayout emptyLayout, const VBindlessHeap &bindless)
 	{
 		EXLOCK( _drCheck );
 		CHECK_ERR( _layout == VK_NULL_HANDLE );
@@ -141,8 +142,16 @@ namespace FG
 			ASSERT( ds.layout );
 
 			vk_layouts[ ds.index ] = ds.layout;
-			min_set = Min( min_set, ds.index );
 			max_set = Max( max_set, ds.index );
+
+			// bindless set is bound separately
+			if ( bindless.IsCreated() and ds.layoutId == bindless.GetLayoutID() )
+			{
+				_bindlessIndex	= ds.index;
+				_bindlessSet	= bindless.Handle();
+				continue;
+			}
+			min_set = Min( min_set, ds.index );
 		}
 
 		for (auto& pc : _pushConstants)
@@ -190,8 +199,10 @@ namespace FG
 		_pushConstants.clear();
 
 		_layout			= VK_NULL_HANDLE;
+		_bindlessSet	= VK_NULL_HANDLE;
 		_hash			= Default;
 		_firstDescSet	= UMax;
+		_bindlessIndex	= UMax;
 	}
 	
 /*
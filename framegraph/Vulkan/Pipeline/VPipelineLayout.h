@@ -26,7 +26,7 @@ namespace FG
 			DescSetLayout (RawDescriptorSetLayoutID id, VkDescriptorSetLayout layout, uint index) : layoutId{id}, layout{layout}, index{index} {}
 		};
 
-		// the last index will be used for shader debugger
+		// the last index will be used for shader debugger, the previous index may be used for bindless descriptor heap
 		static constexpr uint	MaxDescSets	= FG_MaxDescriptorSets;
 
 		using DescriptorSets_t			= FixedMap< DescriptorSetID, DescSetLayout, MaxDescSets >;
@@ -42,7 +42,9 @@ namespace FG
 		VkPipelineLayout		_layout			= VK_NULL_HANDLE;
 		DescriptorSets_t		_descriptorSets;
 		PushConstants_t			_pushConstants;
-		uint					_firstDescSet	= UMax;
+		uint					_firstDescSet	= UMax;		// first set that is bound from resources, bindless set is excluded
+		uint					_bindlessIndex	= UMax;
+		VkDescriptorSet			_bindlessSet	= VK_NULL_HANDLE;
 
 		DebugName_t				_debugName;
 		
@@ -57,7 +59,7 @@ namespace FG
 		VPipelineLayout (const PipelineDescription::PipelineLayout &ppln, DSLayoutArray_t sets);
 		~VPipelineLayout ();
 
-		bool Create (const VDevice &dev, VkDescriptorSetLayout emptyLayout);
+		bool Create (const VDevice &dev, VkDescriptorSetLayout emptyLayout, const VBindlessHeap &bindless);
 		void Destroy (VResourceManager &);
 		
 		bool  GetDescriptorSetLayout (const DescriptorSetID &id, OUT RawDescriptorSetLayoutID &layout, OUT uint &binding) const;
@@ -72,6 +74,8 @@ namespace FG
 		ND_ StringView				GetDebugName ()				const	{ SHAREDLOCK( _drCheck );  return _debugName; }
 		
 		ND_ uint					GetFirstDescriptorSet ()	const	{ SHAREDLOCK( _drCheck );  return _firstDescSet; }
+		ND_ uint					GetBindlessSetIndex ()		const	{ SHAREDLOCK( _drCheck );  return _bindlessIndex; }
+		ND_ VkDescriptorSet			GetBindlessSet ()			const	{ SHAREDLOCK( _drCheck );  return _bindlessSet; }
 		ND_ DescriptorSets_t const&	GetDescriptorSets ()		const	{ SHAREDLOCK( _drCheck );  return _descriptorSets; }
 		ND_ PushConstants_t const&	GetPushConstants ()			const	{ SHAREDLOCK( _drCheck );  return _pushConstants; }
 
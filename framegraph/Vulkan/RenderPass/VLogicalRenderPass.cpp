@@ -2,6 +2,7 @@
 
 #include "VLogicalRenderPass.h"
 #include "VCommandBuffer.h"
+#include "VTaskProcessor.h"
 #include "VEnumCast.h"
 
 namespace FG
@@ -53,8 +54,19 @@ namespace {
 		_area				= desc.area;
 		//_parallelExecution= desc.parallelExecution;
 		//_canBeMerged		= desc.canBeMerged;
-		//_useSecondaryCmdbuf	= desc.useSecondaryCmdbuf;
+		_useSecondaryCmdbuf	= desc.useSecondaryCmdbuf;
 		
+		// initial states, will be updated by draw tasks
+		_drawStates.depthWrite			= _depthState.write;
+		_drawStates.rasterizerDiscard	= _rasterizationState.rasterizerDiscard;
+		_drawStates.stencilWrite		= not _stencilState.enabled ? false :
+										  (_stencilState.front.failOp		!= EStencilOp::Keep) |
+										  (_stencilState.front.depthFailOp	!= EStencilOp::Keep) |
+										  (_stencilState.front.passOp		!= EStencilOp::Keep) |
+										  (_stencilState.back.failOp		!= EStencilOp::Keep) |
+										  (_stencilState.back.depthFailOp	!= EStencilOp::Keep) |
+										  (_stencilState.back.passOp		!= EStencilOp::Keep);
+
 		Optional<MultiSamples>	samples;
 
 
@@ -268,6 +280,9 @@ namespace {
 		ASSERT( _isSubmited and "render pass was not submitted" );
 
 		_drawTasks.clear();
+		_drawBuffers.clear();
+		_drawImages.clear();
+		_drawRTScenes.clear();
 
 		_allocator.Destroy();
 		
@@ -353,4 +368,62 @@ namespace {
 		}
 	}
 
+/*
+=================================================
+	_MergeDrawTask
+=================================================
+*/
+	void VLogicalRenderPass::_MergeDrawTask (VCommandBuffer &fgThread, IDrawTask &task)
+	{
+		VTaskProcessor::MergeDrawTask( fgThread, *this, task );
+	}
+
+/*
+=================================================
+	_AddDrawBuffer
+----
+	ranges of the same buffer and state are merged into one range,
+	this may produce unnecessary barrier, but significantly reduces barrier count for thousands of draw tasks
+=================================================
+*/
+	void VLogicalRenderPass::_AddDrawBuffer (const VLocalBuffer *buffer, EResourceState state, VkDeviceSize offset, VkDeviceSize size)
+	{
+		ASSERT( buffer );
+		ASSERT( size > 0 );
+
+		const VkDeviceSize	buf_size	= VkDeviceSize(buffer->Size());
+		const VkDeviceSize	end			= (size == VK_WHOLE_SIZE ? buf_size : Min( buf_size, offset + size ));
+
+		auto	result = _drawBuffers.insert({ {buffer, state}, {offset, end} });
+
+		if ( not result.second )
+		{
+			auto&	range = result.first->second;
+			range.first		= Min( range.first, offset );
+			range.second	= Max( range.second, end );
+		}
+	}
+	
+/*
+=================================================
+	_AddDrawImage
+=================================================
+*/
+	void VLogicalRenderPass::_AddDrawImage (const VLocalImage *image, EResourceState state, VkImageLayout layout, const ImageViewDesc &desc)
+	{
+		ASSERT( image );
+		_drawImages.insert( DrawImage{ image, state, layout, desc });
+	}
+	
+/*
+=================================================
+	_AddDrawRTScene
+=================================================
+*/
+	void VLogicalRenderPass::_AddDrawRTScene (const VLocalRTScene *scene)
+	{
+		ASSERT( scene );
+		_drawRTScenes.insert( scene );
+	}
+
 }	// FG
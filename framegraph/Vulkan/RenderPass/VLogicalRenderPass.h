@@ -54,6 +54,39 @@ namespace FG
 		using Allocator_t				= LinearAllocator< UntypedLinearAllocator<> >;
 		using MutableImages_t			= ArrayView< Pair< VLocalImage const*, EResourceState >>;
 		using MutableBuffers_t			= ArrayView< Pair< VLocalBuffer const*, EResourceState >>;
+
+		// states that are accumulated from all draw tasks and used for render target barriers
+		struct DrawStates
+		{
+			bool	earlyFragmentTests	= false;
+			bool	lateFragmentTests	= false;
+			bool	depthWrite			= false;
+			bool	stencilWrite		= false;
+			bool	rasterizerDiscard	= false;
+		};
+
+		struct DrawImage
+		{
+			VLocalImage const*	image	= null;
+			EResourceState		state	= Default;
+			VkImageLayout		layout	= VK_IMAGE_LAYOUT_UNDEFINED;
+			ImageViewDesc		desc;
+
+			ND_ bool  operator == (const DrawImage &rhs) const {
+				return image == rhs.image and state == rhs.state and layout == rhs.layout and desc == rhs.desc;
+			}
+		};
+
+		struct DrawImageHash {
+			ND_ size_t  operator () (const DrawImage &x) const {
+				return size_t(HashOf( x.image ) + HashOf( x.state ) + HashOf( x.layout ) + HashOf( x.desc ));
+			}
+		};
+
+		using DrawBufferRange_t			= Pair< VkDeviceSize, VkDeviceSize >;	// begin, end
+		using DrawBuffers_t				= HashMap< Pair< VLocalBuffer const*, EResourceState >, DrawBufferRange_t >;
+		using DrawImages_t				= HashSet< DrawImage, DrawImageHash >;
+		using DrawRTScenes_t			= HashSet< VLocalRTScene const* >;
 		
 
 	// variables
@@ -84,7 +117,8 @@ namespace FG
 		RectI						_area;
 		//bool						_parallelExecution		= true;
 		//bool						_canBeMerged			= true;
-		//bool						_useSecondaryCmdbuf		= false;
+		bool						_useSecondaryCmdbuf		= false;
+		bool						_hasCustomDraw			= false;	// custom draw can not be recorded into secondary command buffer
 		bool						_isSubmited				= false;
 		
 		VPipelineResourceSet		_perPassResources;
@@ -99,6 +133,13 @@ namespace FG
 		MutableImages_t				_mutableImages;
 		MutableBuffers_t			_mutableBuffers;
 
+		// resources and states of all draw tasks, they are merged when draw task is added,
+		// so barriers can be placed without additional pass through the draw tasks
+		DrawStates					_drawStates;
+		DrawBuffers_t				_drawBuffers;
+		DrawImages_t				_drawImages;
+		DrawRTScenes_t				_drawRTScenes;
+
 
 	// methods
 	public:
@@ -112,10 +153,12 @@ namespace FG
 
 
 		template <typename DrawTaskType, typename ...Args>
-		bool AddTask (Args&& ...args)
+		bool AddTask (VCommandBuffer &fgThread, Args&& ...args)
 		{
 			auto*	ptr = _allocator->Alloc<DrawTaskType>();
-			_drawTasks.push_back( PlacementNew<DrawTaskType>( ptr, *this, std::forward<Args&&>(args)... ));
+			_hasCustomDraw |= IsSameTypes< DrawTaskType, VFgDrawTask<CustomDraw> >;
+			_drawTasks.push_back( PlacementNew<DrawTaskType>( ptr, *this, fgThread, std::forward<Args&&>(args)... ));
+			_MergeDrawTask( fgThread, *_drawTasks.back() );
 			return true;
 		}
 
@@ -125,6 +168,11 @@ namespace FG
 		void _SetRenderPass (RawRenderPassID rp, uint subpass, RawFramebufferID fb, uint depthIndex);
 		void _SetShaderDebugIndex (ShaderDbgIndex id);
 		
+		void _AddDrawBuffer (const VLocalBuffer *buffer, EResourceState state, VkDeviceSize offset, VkDeviceSize size);
+		void _AddDrawImage (const VLocalImage *image, EResourceState state, VkImageLayout layout, const ImageViewDesc &desc);
+		void _AddDrawRTScene (const VLocalRTScene *scene);
+		ND_ DrawStates&	_EditDrawStates ()	{ return _drawStates; }
+		
 		bool GetShadingRateImage (OUT VLocalImage const* &, OUT ImageViewDesc &) const;
 
 		ND_ ArrayView< IDrawTask *>				GetDrawTasks ()				const	{ return _drawTasks; }
@@ -136,6 +184,8 @@ namespace FG
 		ND_ RectI const&						GetArea ()					const	{ return _area; }
 
 		ND_ bool								IsSubmited ()				const	{ return _isSubmited; }
+		ND_ bool								UseSecondaryCmdbuf ()		const	{ return _useSecondaryCmdbuf; }
+		ND_ bool								HasCustomDraw ()			const	{ return _hasCustomDraw; }
 		
 		ND_ RawFramebufferID					GetFramebufferID ()			const	{ return _framebufferId; }
 		ND_ RawRenderPassID						GetRenderPassID ()			const	{ return _renderPassId; }
@@ -161,6 +211,14 @@ namespace FG
 
 		ND_ MutableImages_t						GetMutableImages ()			const	{ return _mutableImages; }
 		ND_ MutableBuffers_t					GetMutableBuffers ()		const	{ return _mutableBuffers; }
+		
+		ND_ DrawStates const&					GetDrawStates ()			const	{ return _drawStates; }
+		ND_ DrawBuffers_t const&				GetDrawBuffers ()			const	{ return _drawBuffers; }
+		ND_ DrawImages_t const&					GetDrawImages ()			const	{ return _drawImages; }
+		ND_ DrawRTScenes_t const&				GetDrawRTScenes ()			const	{ return _drawRTScenes; }
+
+	private:
+		void _MergeDrawTask (VCommandBuffer &, IDrawTask &);
 	};
 
 
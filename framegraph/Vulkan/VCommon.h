@@ -40,6 +40,7 @@ namespace FG
 	using DebugName_t				= StaticString<64>;
 	
 	using VkDescriptorSets_t		= FixedArray< VkDescriptorSet, FG_MaxDescriptorSets >;
+	using VDynamicOffsets_t			= FixedArray< uint, FG_MaxBufferDynamicOffsets >;
 	
 	using VDeviceQueueInfoPtr		= Ptr< const struct VDeviceQueueInfo >;
 
@@ -71,9 +72,12 @@ namespace FG
 	class VRenderPass;
 	class VLogicalRenderPass;
 	class VPipelineCache;
+	class VAsyncPipelineCompiler;
 	class VDescriptorManager;
 	class VBuffer;
 	class VImage;
+	class VSampler;
+	class VBindlessHeap;
 	class VLocalBuffer;
 	class VLocalImage;
 	class VLocalRTGeometry;
@@ -99,6 +103,7 @@ namespace FG
 	class VMemoryManager;
 	class VFrameGraph;
 	class VDebugger;
+	class VCmdBatch;
 	struct VCmdBatchPtr;
 
 
@@ -112,7 +117,7 @@ namespace FG
 		};
 
 		FixedArray< Item, FG_MaxDescriptorSets >					resources;
-		mutable FixedArray< uint, FG_MaxBufferDynamicOffsets >		dynamicOffsets;
+		VDynamicOffsets_t											dynamicOffsets;		// in order of 'resources'
 	};
 
 }	// FG
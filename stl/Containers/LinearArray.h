@@ -0,0 +1,163 @@
+// Copyright (c) 2018-2020,  Zhirnov Andrey. For more information see 'LICENSE'
+/*
+	Array with inline storage for the first 'InlineSize' elements,
+	when array grows memory is allocated from linear allocator and never deallocated,
+	so array must be reset by 'Release()' before linear allocator discards its memory.
+	Only for trivially copyable types.
+*/
+
+#pragma once
+
+#include "stl/Containers/ArrayView.h"
+#include "stl/Memory/LinearAllocator.h"
+
+namespace FGC
+{
+
+	//
+	// Linear Array
+	//
+
+	template <typename T,
+			  size_t InlineSize = 1,
+			  typename AllocatorType = UntypedAlignedAllocator>
+	struct LinearArray final
+	{
+		STATIC_ASSERT( std::is_trivially_copyable_v<T> );
+		STATIC_ASSERT( std::is_trivially_destructible_v<T> );
+		STATIC_ASSERT( InlineSize > 0 );
+
+	// types
+	public:
+		using iterator			= T *;
+		using const_iterator	= const T *;
+		using Self				= LinearArray< T, InlineSize, AllocatorType >;
+		using LinearAllocator_t	= LinearAllocator< AllocatorType >;
+
+
+	// variables
+	private:
+		T *						_ptr		= _inline;
+		size_t					_count		= 0;
+		size_t					_capacity	= InlineSize;
+		LinearAllocator_t *		_alloc		= null;
+		T						_inline [InlineSize];
+
+
+	// methods
+	public:
+		LinearArray () {}
+		explicit LinearArray (LinearAllocator_t &alloc) : _alloc{&alloc} {}
+
+		LinearArray (Self &&) = delete;
+		LinearArray (const Self &) = delete;
+
+		Self&  operator = (Self &&) = delete;
+		Self&  operator = (const Self &) = delete;
+
+		~LinearArray ()
+		{
+			ASSERT( _ptr == _inline );
+		}
+
+		ND_ operator ArrayView<T> ()					const	{ return ArrayView<T>{ _ptr, _count }; }
+
+		ND_ size_t			size ()						const	{ return _count; }
+		ND_ bool			empty ()					const	{ return _count == 0; }
+		ND_ size_t			capacity ()					const	{ return _capacity; }
+		ND_ T *				data ()								{ return _ptr; }
+		ND_ T const *		data ()						const	{ return _ptr; }
+
+		ND_ T &				operator [] (size_t i)				{ ASSERT( i < _count );  return _ptr[i]; }
+		ND_ T const &		operator [] (size_t i)		const	{ ASSERT( i < _count );  return _ptr[i]; }
+
+		ND_ iterator		begin ()							{ return _ptr; }
+		ND_ const_iterator	begin ()					const	{ return _ptr; }
+		ND_ iterator		end ()								{ return _ptr + _count; }
+		ND_ const_iterator	end ()						const	{ return _ptr + _count; }
+
+		ND_ T &				front ()							{ ASSERT( _count > 0 );  return _ptr[0]; }
+		ND_ T const&		front ()					const	{ ASSERT( _count > 0 );  return _ptr[0]; }
+		ND_ T &				back ()								{ ASSERT( _count > 0 );  return _ptr[_count-1]; }
+		ND_ T const&		back ()						const	{ ASSERT( _count > 0 );  return _ptr[_count-1]; }
+
+
+		void  SetAllocator (LinearAllocator_t &alloc)
+		{
+			ASSERT( _ptr == _inline );
+			_alloc = &alloc;
+		}
+
+
+		void  push_back (const T &value)
+		{
+			insert( end(), value );
+		}
+
+
+		iterator  insert (const_iterator pos, const T &value)
+		{
+			ASSERT( pos >= begin() and pos <= end() );
+
+			const size_t	idx = size_t(pos - _ptr);
+
+			if_unlikely( _count == _capacity )
+				_Grow( _capacity * 2 );
+
+			if ( idx < _count )
+				memmove( _ptr + idx + 1, _ptr + idx, sizeof(T) * (_count - idx) );
+
+			_ptr[idx] = value;
+			++_count;
+			return _ptr + idx;
+		}
+
+
+		iterator  erase (const_iterator pos)
+		{
+			ASSERT( pos >= begin() and pos < end() );
+
+			const size_t	idx = size_t(pos - _ptr);
+
+			if ( idx + 1 < _count )
+				memmove( _ptr + idx, _ptr + idx + 1, sizeof(T) * (_count - idx - 1) );
+
+			--_count;
+			return _ptr + idx;
+		}
+
+
+		// memory is kept to avoid allocations
+		void  clear ()
+		{
+			_count = 0;
+		}
+
+
+		// switch to inline storage, must be called before linear allocator discards memory
+		void  Release ()
+		{
+			_ptr		= _inline;
+			_count		= 0;
+			_capacity	= InlineSize;
+		}
+
+
+	private:
+		void  _Grow (size_t newCapacity)
+		{
+			CHECK_FATAL( _alloc != null );
+
+			T*	new_ptr = _alloc->template Alloc<T>( newCapacity );
+			CHECK_FATAL( new_ptr != null );
+
+			memcpy( new_ptr, _ptr, sizeof(T) * _count );
+
+			// previous memory is not deallocated, linear allocator will release it
+			_ptr		= new_ptr;
+			_capacity	= newCapacity;
+		}
+	};
+
+
+}	// FGC
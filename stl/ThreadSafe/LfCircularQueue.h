@@ -0,0 +1,142 @@
+// Copyright (c) 2018-2020,  Zhirnov Andrey. For more information see 'LICENSE'
+/*
+	Bounded lock-free queue, based on Dmitry Vyukov's MPMC queue.
+	Each cell has sequence number that shows which operation (push or pop) expects this cell,
+	so producers and consumers only compete for queue position.
+*/
+
+#pragma once
+
+#include "stl/CompileTime/TypeTraits.h"
+#include "stl/Math/BitMath.h"
+#include <atomic>
+
+namespace FGC
+{
+
+	//
+	// Lock-free Circular Queue
+	//
+
+	template <typename T, size_t Capacity>
+	struct LfCircularQueue final
+	{
+		STATIC_ASSERT( IsPowerOfTwo( Capacity ));
+
+	// types
+	public:
+		using Self		= LfCircularQueue< T, Capacity >;
+		using Value_t	= T;
+
+	private:
+		struct Cell
+		{
+			Atomic<size_t>	sequence;
+			T				value;
+		};
+		using Cells_t	= StaticArray< Cell, Capacity >;
+
+		static constexpr size_t	Mask = Capacity - 1;
+
+
+	// variables
+	private:
+		Cells_t								_cells;
+		alignas(FG_CACHE_LINE) Atomic<size_t>	_pushPos;
+		alignas(FG_CACHE_LINE) Atomic<size_t>	_popPos;
+
+
+	// methods
+	public:
+		LfCircularQueue ()
+		{
+			for (size_t i = 0; i < Capacity; ++i) {
+				_cells[i].sequence.store( i, memory_order_relaxed );
+			}
+			_pushPos.store( 0, memory_order_relaxed );
+			_popPos.store( 0, memory_order_relaxed );
+
+			std::atomic_thread_fence( memory_order_release );
+		}
+
+		LfCircularQueue (const Self &) = delete;
+		LfCircularQueue (Self &&) = delete;
+
+		Self& operator = (const Self &) = delete;
+		Self& operator = (Self &&) = delete;
+
+
+		// returns 'false' if queue is full
+		ND_ bool  Push (T &&value)
+		{
+			Cell*	cell;
+			size_t	pos = _pushPos.load( memory_order_relaxed );
+
+			for (;;)
+			{
+				cell = &_cells[ pos & Mask ];
+
+				const size_t	seq		= cell->sequence.load( memory_order_acquire );
+				const ssize_t	diff	= ssize_t(seq) - ssize_t(pos);
+
+				if ( diff == 0 )
+				{
+					if ( _pushPos.compare_exchange_weak( INOUT pos, pos + 1, memory_order_relaxed ))
+						break;
+				}
+				else
+				if ( diff < 0 )
+					return false;
+				else
+					pos = _pushPos.load( memory_order_relaxed );
+			}
+
+			cell->value = std::move(value);
+			cell->sequence.store( pos + 1, memory_order_release );
+			return true;
+		}
+
+
+		// returns 'false' if queue is empty
+		ND_ bool  Pop (OUT T &value)
+		{
+			Cell*	cell;
+			size_t	pos = _popPos.load( memory_order_relaxed );
+
+			for (;;)
+			{
+				cell = &_cells[ pos & Mask ];
+
+				const size_t	seq		= cell->sequence.load( memory_order_acquire );
+				const ssize_t	diff	= ssize_t(seq) - ssize_t(pos + 1);
+
+				if ( diff == 0 )
+				{
+					if ( _popPos.compare_exchange_weak( INOUT pos, pos + 1, memory_order_relaxed ))
+						break;
+				}
+				else
+				if ( diff < 0 )
+					return false;
+				else
+					pos = _popPos.load( memory_order_relaxed );
+			}
+
+			value = std::move(cell->value);
+			cell->value = T{};
+			cell->sequence.store( pos + Mask + 1, memory_order_release );
+			return true;
+		}
+
+
+		// not thread safe, use only for debugging
+		ND_ bool  IsEmpty () const
+		{
+			return _pushPos.load( memory_order_relaxed ) == _popPos.load( memory_order_relaxed );
+		}
+
+		ND_ static constexpr size_t  capacity ()	{ return Capacity; }
+	};
+
+
+}	// FGC
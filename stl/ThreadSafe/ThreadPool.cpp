@@ -0,0 +1,191 @@
+// Copyright (c) 2018-2020,  Zhirnov Andrey. For more information see 'LICENSE'
+
+#include "stl/ThreadSafe/ThreadPool.h"
+#include "stl/Platforms/ThreadName.h"
+#include "stl/Algorithms/StringUtils.h"
+
+namespace FGC
+{
+namespace
+{
+	//
+	// Parallel For State
+	//
+	struct ParallelForState
+	{
+	// variables
+		Atomic<uint>				next		{0};
+		Atomic<uint>				complete	{0};
+		const uint					count;
+		ThreadPool::IndexedJob_t	job;
+
+		Mutex						guard;
+		std::condition_variable		cv;
+
+	// methods
+		ParallelForState (uint count, const ThreadPool::IndexedJob_t &job) : count{count}, job{job} {}
+
+		void  Run ()
+		{
+			for (uint i = next.fetch_add( 1, memory_order_relaxed ); i < count; i = next.fetch_add( 1, memory_order_relaxed ))
+			{
+				job( i );
+
+				if ( complete.fetch_add( 1, memory_order_acq_rel ) + 1 == count )
+				{
+					EXLOCK( guard );
+					cv.notify_all();
+				}
+			}
+		}
+
+		void  Wait ()
+		{
+			std::unique_lock	lock{ guard };
+			cv.wait( lock, [this] () { return complete.load( memory_order_acquire ) == count; });
+		}
+	};
+
+}	// namespace
+//-----------------------------------------------------------------------------
+
+
+/*
+=================================================
+	destructor
+=================================================
+*/
+	ThreadPool::~ThreadPool ()
+	{
+		Stop();
+	}
+
+/*
+=================================================
+	Start
+=================================================
+*/
+	bool  ThreadPool::Start (uint threadCount, StringView name)
+	{
+		EXLOCK( _guard );
+		CHECK_ERR( _threads.empty() );
+
+		_looping = true;
+		_threads.reserve( threadCount );
+
+		for (uint i = 0; i < threadCount; ++i)
+		{
+			_threads.emplace_back( [this, thread_name = String(name) << '_' << ToString(i)] ()
+			{
+				SetCurrentThreadName( thread_name );
+				_Loop();
+			});
+		}
+		return true;
+	}
+
+/*
+=================================================
+	Stop
+=================================================
+*/
+	void  ThreadPool::Stop ()
+	{
+		{
+			EXLOCK( _guard );
+			_looping = false;
+		}
+		_cv.notify_all();
+
+		for (auto& t : _threads) {
+			t.join();
+		}
+		_threads.clear();
+
+		// run jobs that was added after the last thread exits
+		for (auto& job : _jobs) {
+			job();
+		}
+		_jobs.clear();
+	}
+
+/*
+=================================================
+	Enqueue
+=================================================
+*/
+	void  ThreadPool::Enqueue (Job_t &&job)
+	{
+		std::unique_lock	lock{ _guard };
+
+		if ( not _looping )
+		{
+			// thread pool is not started, run job immediately
+			lock.unlock();
+			job();
+			return;
+		}
+
+		_jobs.push_back( std::move(job) );
+		lock.unlock();
+
+		_cv.notify_one();
+	}
+
+/*
+=================================================
+	ParallelFor
+=================================================
+*/
+	void  ThreadPool::ParallelFor (uint count, const IndexedJob_t &job)
+	{
+		if ( count == 0 )
+			return;
+
+		if ( count == 1 or _threads.empty() )
+		{
+			for (uint i = 0; i < count; ++i) {
+				job( i );
+			}
+			return;
+		}
+
+		// state is shared with worker threads because some of them may start
+		// after all indices are processed and this function has returned
+		auto	state = std::make_shared<ParallelForState>( count, job );
+
+		for (uint i = 0, cnt = Min( count-1, ThreadCount() ); i < cnt; ++i)
+		{
+			Enqueue( [state] () { state->Run(); });
+		}
+
+		state->Run();
+		state->Wait();
+	}
+
+/*
+=================================================
+	_Loop
+=================================================
+*/
+	void  ThreadPool::_Loop ()
+	{
+		for (;;)
+		{
+			Job_t	job;
+			{
+				std::unique_lock	lock{ _guard };
+				_cv.wait( lock, [this] () { return not _looping or not _jobs.empty(); });
+
+				if ( _jobs.empty() )
+					return;	// stopped
+
+				job = std::move( _jobs.front() );
+				_jobs.pop_front();
+			}
+			job();
+		}
+	}
+
+
+}	// FGC
@@ -0,0 +1,69 @@
+// Copyright (c) 2018-2020,  Zhirnov Andrey. For more information see 'LICENSE'
+/*
+	Simple thread pool with a single job queue.
+	'ParallelFor' runs jobs on the worker threads and on the calling thread
+	and returns when all jobs are complete.
+*/
+
+#pragma once
+
+#include "stl/Common.h"
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+
+namespace FGC
+{
+
+	//
+	// Thread Pool
+	//
+
+	class ThreadPool final
+	{
+	// types
+	public:
+		using Job_t			= std::function< void () >;
+		using IndexedJob_t	= std::function< void (uint index) >;
+
+	private:
+		using Threads_t		= Array< std::thread >;
+		using JobQueue_t	= std::deque< Job_t >;
+
+
+	// variables
+	private:
+		Mutex					_guard;
+		std::condition_variable	_cv;
+		JobQueue_t				_jobs;
+		Threads_t				_threads;
+		bool					_looping	= false;
+
+
+	// methods
+	public:
+		ThreadPool () {}
+		~ThreadPool ();
+
+		ThreadPool (ThreadPool &&) = delete;
+		ThreadPool (const ThreadPool &) = delete;
+
+		ThreadPool& operator = (const ThreadPool &) = delete;
+		ThreadPool& operator = (ThreadPool &&) = delete;
+
+		bool  Start (uint threadCount, StringView name);
+		void  Stop ();
+
+		void  Enqueue (Job_t &&job);
+		void  ParallelFor (uint count, const IndexedJob_t &job);
+
+		ND_ uint  ThreadCount () const	{ return uint(_threads.size()); }
+
+	private:
+		void  _Loop ();
+	};
+
+
+}	// FGC
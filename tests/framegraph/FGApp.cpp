@@ -62,6 +62,19 @@ namespace {
 		_tests.push_back({ &FGApp::ImplTest_Multithreading2, 1 });
 		_tests.push_back({ &FGApp::ImplTest_Multithreading3, 1 });
 		_tests.push_back({ &FGApp::ImplTest_Multithreading4, 1 });
+		_tests.push_back({ &FGApp::ImplTest_TransientResources1, 1 });
+		_tests.push_back({ &FGApp::ImplTest_Submission1, 1 });
+		_tests.push_back({ &FGApp::ImplTest_CompletionThread1, 1 });
+		_tests.push_back({ &FGApp::ImplTest_MemoryReuse1, 1 });
+		_tests.push_back({ &FGApp::ImplTest_UploadWriter1, 1 });
+		_tests.push_back({ &FGApp::ImplTest_UploadScheduler1, 1 });
+		_tests.push_back({ &FGApp::ImplTest_ReadImageContiguous1, 1 });
+		_tests.push_back({ &FGApp::ImplTest_Bindless1, 1 });
+		_tests.push_back({ &FGApp::ImplTest_DynamicOffsetBatch1, 1 });
+		_tests.push_back({ &FGApp::ImplTest_AsyncPipeline1, 1 });
+		_tests.push_back({ &FGApp::ImplTest_PipelineCache1, 1 });
+		_tests.push_back({ &FGApp::ImplTest_DescriptorManager1, 1 });
+		_tests.push_back({ &FGApp::ImplTest_SplitBarriers1, 1 });
 		
 		// RTX only
 		_tests.push_back({ &FGApp::Test_DrawMeshes1,		1 });
@@ -187,6 +200,7 @@ namespace {
 
 		// initialize framegraph
 		{
+			_vulkanInfo = vulkan_info;
 			_frameGraph = IFrameGraph::CreateFrameGraph( vulkan_info );
 			CHECK_ERR( _frameGraph );
 
@@ -293,6 +307,53 @@ namespace {
 		}
 	}
 	
+/*
+=================================================
+	FrameGraphScope
+----
+	new instance uses the same device and pipeline compiler
+=================================================
+*/
+	FGApp::FrameGraphScope::FrameGraphScope (FGApp &app, const Function<void (VulkanDeviceInfo &)> &setup) :
+		_app{ app }
+	{
+	#ifdef FG_ENABLE_VULKAN
+		VulkanDeviceInfo	info = _app._vulkanInfo;
+		setup( INOUT info );
+
+		// on failure '_prev' stays empty, test must check the scope
+		const bool	idle = _app._frameGraph->WaitIdle();
+		CHECK( idle );
+		if ( not idle )
+			return;
+
+		FrameGraph	fg = IFrameGraph::CreateFrameGraph( info );
+		CHECK( fg );
+		if ( not fg )
+			return;
+
+		#ifdef FG_ENABLE_GLSLANG
+		if ( _app._pplnCompiler )
+			fg->AddPipelineCompiler( _app._pplnCompiler );
+		#endif
+
+		_prev = std::move( _app._frameGraph );
+		_app._frameGraph = std::move( fg );
+	#else
+		Unused( setup );
+	#endif
+	}
+	
+	FGApp::FrameGraphScope::~FrameGraphScope ()
+	{
+		if ( not _prev )
+			return;
+
+		CHECK( _app._frameGraph->WaitIdle() );
+		_app._frameGraph->Deinitialize();
+		_app._frameGraph = std::move( _prev );
+	}
+
 /*
 =================================================
 	SavePNG
@@ -22,12 +22,28 @@ namespace FG
 		using TestQueue_t			= Deque<Pair< TestFunc_t, uint >>;
 		using VPipelineCompilerPtr	= SharedPtr< class VPipelineCompiler >;
 		using DeviceProperties		= IFrameGraph::DeviceProperties;
+		
+		// replaces '_frameGraph' by instance with modified device settings until the end of scope,
+		// used by tests for features that change behaviour of all other tests
+		struct FrameGraphScope
+		{
+		private:
+			FGApp &		_app;
+			FrameGraph	_prev;
+
+		public:
+			FrameGraphScope (FGApp &app, const Function<void (VulkanDeviceInfo &)> &setup);
+			~FrameGraphScope ();
+
+			ND_ explicit operator bool () const	{ return _prev != null; }
+		};
 
 
 	// variables
 	private:
 		#ifdef FG_ENABLE_VULKAN
 		VulkanDeviceInitializer	_vulkan;
+		VulkanDeviceInfo		_vulkanInfo;
 		#endif
 
 		WindowPtr				_window;
@@ -89,6 +105,19 @@ namespace FG
 		bool ImplTest_Multithreading2 ();
 		bool ImplTest_Multithreading3 ();
 		bool ImplTest_Multithreading4 ();
+		bool ImplTest_TransientResources1 ();
+		bool ImplTest_Submission1 ();
+		bool ImplTest_CompletionThread1 ();
+		bool ImplTest_MemoryReuse1 ();
+		bool ImplTest_UploadWriter1 ();
+		bool ImplTest_UploadScheduler1 ();
+		bool ImplTest_ReadImageContiguous1 ();
+		bool ImplTest_Bindless1 ();
+		bool ImplTest_DynamicOffsetBatch1 ();
+		bool ImplTest_AsyncPipeline1 ();
+		bool ImplTest_PipelineCache1 ();
+		bool ImplTest_DescriptorManager1 ();
+		bool ImplTest_SplitBarriers1 ();
 
 
 	// drawing tests
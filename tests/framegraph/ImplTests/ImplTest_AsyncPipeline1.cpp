@@ -0,0 +1,170 @@
+// Copyright (c) 2018-2020,  Zhirnov Andrey. For more information see 'LICENSE'
+
+#include "../FGApp.h"
+#include <thread>
+
+namespace FG
+{
+
+	bool FGApp::ImplTest_AsyncPipeline1 ()
+	{
+		if ( not _pplnCompiler )
+		{
+			FG_LOGI( TEST_NAME << " - skipped" );
+			return true;
+		}
+
+		FrameGraphScope	scope{ *this, [] (VulkanDeviceInfo &info) { info.asyncPipelineCompilation = true; }};
+		CHECK_ERR( scope );
+
+		// all pipelines have the same (empty) layout, so any of them can be used as fallback
+		const auto	CreatePipeline = [this] (StringView color) -> GPipelineID
+		{
+			GraphicsPipelineDesc	ppln;
+
+			ppln.AddShader( EShader::Vertex, EShaderLangFormat::VKSL_100, "main", R"#(
+#pragma shader_stage(vertex)
+#extension GL_ARB_separate_shader_objects : enable
+#extension GL_ARB_shading_language_420pack : enable
+
+const vec2	g_Positions[3] = vec2[](
+	vec2(-1.0, -1.0),
+	vec2( 3.0, -1.0),
+	vec2(-1.0,  3.0)
+);
+
+void main() {
+	gl_Position	= vec4( g_Positions[gl_VertexIndex], 0.0, 1.0 );
+}
+)#" );
+
+			ppln.AddShader( EShader::Fragment, EShaderLangFormat::VKSL_100, "main", String{R"#(
+#pragma shader_stage(fragment)
+#extension GL_ARB_separate_shader_objects : enable
+#extension GL_ARB_shading_language_420pack : enable
+
+layout(location=0) out vec4  out_Color;
+
+void main() {
+	out_Color = vec4)#"} << color << ";\n}\n" );
+
+			return _frameGraph->CreatePipeline( ppln );
+		};
+
+		const uint2		view_size		= {64, 64};
+		ImageID			image			= _frameGraph->CreateImage( ImageDesc{}.SetDimension( view_size ).SetFormat( EPixelFormat::RGBA8_UNorm )
+																			.SetUsage( EImageUsage::ColorAttachment | EImageUsage::TransferSrc ),
+																	Default, "RenderTarget" );
+		GPipelineID		main_ppln		= CreatePipeline( "(0.0, 1.0, 0.0, 1.0)" );
+		GPipelineID		fallback_ppln	= CreatePipeline( "(1.0, 0.0, 0.0, 1.0)" );
+		GPipelineID		warmup_ppln		= CreatePipeline( "(0.0, 0.0, 1.0, 1.0)" );
+		GPipelineID		skipped_ppln	= CreatePipeline( "(1.0, 1.0, 1.0, 1.0)" );
+		CHECK_ERR( image and main_ppln and fallback_ppln and warmup_ppln and skipped_ppln );
+
+		// reset statistics
+		{
+			IFrameGraph::Statistics		stat;
+			CHECK_ERR( _frameGraph->WaitIdle() );
+			CHECK_ERR( _frameGraph->GetStatistics( OUT stat ));
+		}
+
+		// draws with 'pipeline' and returns color of the center pixel
+		const auto	Draw = [&] (RawGPipelineID pipeline, RawGPipelineID fallback, RawGPipelineID warmUp, OUT RGBA32f &color) -> bool
+		{
+			bool	cb_was_called = false;
+
+			const auto	OnLoaded = [&] (const ImageView &imageData)
+			{
+				cb_was_called = true;
+				imageData.Load( uint3{view_size.x / 2, view_size.y / 2, 0}, OUT color );
+			};
+
+			CommandBuffer	cmd = _frameGraph->Begin( CommandBufferDesc{} );
+			CHECK_ERR( cmd );
+
+			LogicalPassID	render_pass	= cmd->CreateRenderPass( RenderPassDesc( view_size )
+												.AddTarget( RenderTargetID::Color_0, image, RGBA32f(0.0f), EAttachmentStoreOp::Store )
+												.AddViewport( view_size ));
+
+			DrawVertices	draw;
+			draw.Draw( 3 ).SetPipeline( pipeline ).SetTopology( EPrimitive::TriangleList );
+
+			if ( fallback )
+				draw.SetFallbackPipeline( fallback );
+
+			cmd->AddTask( render_pass, draw );
+
+			if ( warmUp )
+				cmd->AddTask( render_pass, DrawVertices().Draw( 3 ).SetPipeline( warmUp ).SetTopology( EPrimitive::TriangleList ).SetWarmUp() );
+
+			Task	t_draw	= cmd->AddTask( SubmitRenderPass{ render_pass });
+			Task	t_read	= cmd->AddTask( ReadImage().SetImage( image, int2(), view_size ).SetCallback( OnLoaded ).DependsOn( t_draw ));
+			Unused( t_read );
+
+			CHECK_ERR( _frameGraph->Execute( cmd ));
+			CHECK_ERR( _frameGraph->WaitIdle() );
+			CHECK_ERR( cb_was_called );
+			return true;
+		};
+
+		const RGBA32f	black	{0.0f, 0.0f, 0.0f, 0.0f};
+		const RGBA32f	green	{0.0f, 1.0f, 0.0f, 1.0f};
+		const RGBA32f	red		{1.0f, 0.0f, 0.0f, 1.0f};
+		const RGBA32f	blue	{0.0f, 0.0f, 1.0f, 1.0f};
+		RGBA32f			color;
+		uint			async_count	= 0;
+
+		// pipeline is not compiled yet, draw task without fallback pipeline is skipped
+		{
+			CHECK_ERR( Draw( skipped_ppln, Default, Default, OUT color ));
+			CHECK_ERR( All(Equals( color, black, 0.1f )));
+
+			IFrameGraph::Statistics		stat;
+			CHECK_ERR( _frameGraph->GetStatistics( OUT stat ));
+			CHECK_ERR( stat.resources.pipelineHitchesAvoided == 1 );
+			async_count += stat.resources.asyncGraphicsPipelineCount;
+		}
+
+		// fallback pipeline is used, warm-up task doesn't record draw commands and is not counted as hitch
+		{
+			CHECK_ERR( Draw( main_ppln, fallback_ppln, warmup_ppln, OUT color ));
+			CHECK_ERR( All(Equals( color, red, 0.1f )));
+
+			IFrameGraph::Statistics		stat;
+			CHECK_ERR( _frameGraph->GetStatistics( OUT stat ));
+			CHECK_ERR( stat.resources.pipelineHitchesAvoided == 1 );
+			async_count += stat.resources.asyncGraphicsPipelineCount;
+		}
+
+		// wait for background compilation of 'skipped_ppln', 'main_ppln' and 'warmup_ppln' instances
+		for (uint i = 0; i < 1000 and async_count < 3; ++i)
+		{
+			std::this_thread::sleep_for( std::chrono::milliseconds{10} );
+
+			IFrameGraph::Statistics		stat;
+			CHECK_ERR( _frameGraph->GetStatistics( OUT stat ));
+			async_count += stat.resources.asyncGraphicsPipelineCount;
+		}
+		CHECK_ERR( async_count == 3 );
+
+		// compiled instances are used without fallback
+		{
+			CHECK_ERR( Draw( main_ppln, fallback_ppln, Default, OUT color ));
+			CHECK_ERR( All(Equals( color, green, 0.1f )));
+
+			CHECK_ERR( Draw( warmup_ppln, Default, Default, OUT color ));
+			CHECK_ERR( All(Equals( color, blue, 0.1f )));
+
+			IFrameGraph::Statistics		stat;
+			CHECK_ERR( _frameGraph->GetStatistics( OUT stat ));
+			CHECK_ERR( stat.resources.pipelineHitchesAvoided == 0 );
+			CHECK_ERR( stat.resources.asyncGraphicsPipelineCount == 0 );
+		}
+
+		DeleteResources( image, main_ppln, fallback_ppln, warmup_ppln, skipped_ppln );
+
+		FG_LOGI( TEST_NAME << " - passed" );
+		return true;
+	}
+
+}	// FG
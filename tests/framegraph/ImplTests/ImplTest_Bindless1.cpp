@@ -0,0 +1,154 @@
+// Copyright (c) 2018-2020,  Zhirnov Andrey. For more information see 'LICENSE'
+
+#include "../FGApp.h"
+
+namespace FG
+{
+
+	bool FGApp::ImplTest_Bindless1 ()
+	{
+		// heap writes descriptor for each created resource, so it is enabled only for this test
+		FrameGraphScope	scope{ *this, [] (VulkanDeviceInfo &info) { info.enableBindless = true; }};
+		CHECK_ERR( scope );
+
+		const uint		count		= 256;
+		const BytesU	buffer_size	= SizeOf<uint> * count;
+
+		BufferID	src_buffer	= _frameGraph->CreateBuffer( BufferDesc{ buffer_size, EBufferUsage::Storage | EBufferUsage::TransferDst }, Default, "SrcBuffer" );
+		BufferID	dst_buffer	= _frameGraph->CreateBuffer( BufferDesc{ buffer_size, EBufferUsage::Storage | EBufferUsage::TransferSrc }, Default, "DstBuffer" );
+		CHECK_ERR( src_buffer and dst_buffer );
+
+		const uint	src_index = _frameGraph->GetBindlessIndex( src_buffer );
+
+		if ( not _properties.descriptorIndexing or not _pplnCompiler or src_index == UMax )
+		{
+			DeleteResources( src_buffer, dst_buffer );
+			FG_LOGI( TEST_NAME << " - skipped" );
+			return true;
+		}
+
+		// slot of the destroyed resource must be reused
+		{
+			BufferID	temp		= _frameGraph->CreateBuffer( BufferDesc{ buffer_size, EBufferUsage::Storage }, Default, "Temp" );
+			const uint	temp_index	= _frameGraph->GetBindlessIndex( temp );
+			CHECK_ERR( temp_index != UMax and temp_index != src_index );
+
+			DeleteResources( temp );
+
+			temp = _frameGraph->CreateBuffer( BufferDesc{ buffer_size, EBufferUsage::Storage }, Default, "Temp" );
+			CHECK_ERR( _frameGraph->GetBindlessIndex( temp ) == temp_index );
+			DeleteResources( temp );
+		}
+
+		// only storage buffers are added to the heap
+		{
+			BufferID	temp = _frameGraph->CreateBuffer( BufferDesc{ buffer_size, EBufferUsage::Uniform }, Default, "Temp" );
+			CHECK_ERR( _frameGraph->GetBindlessIndex( temp ) == UMax );
+			DeleteResources( temp );
+		}
+
+		// cached sampler has single slot
+		{
+			SamplerID	samp1	= _frameGraph->CreateSampler( SamplerDesc{} );
+			SamplerID	samp2	= _frameGraph->CreateSampler( SamplerDesc{} );
+			CHECK_ERR( samp1 and samp2 );
+			CHECK_ERR( _frameGraph->GetBindlessIndex( samp1 ) != UMax );
+			CHECK_ERR( _frameGraph->GetBindlessIndex( samp1 ) == _frameGraph->GetBindlessIndex( samp2 ));
+			DeleteResources( samp1, samp2 );
+		}
+
+		ComputePipelineDesc	ppln;
+
+		ppln.AddShader( EShaderLangFormat::VKSL_100, "main", R"#(
+#version 460 core
+#extension GL_ARB_shading_language_420pack : enable
+#extension GL_EXT_nonuniform_qualifier : require
+
+layout (local_size_x = 64, local_size_y = 1, local_size_z = 1) in;
+
+layout (push_constant, std140) uniform PushConst {
+	uint	srcIndex;
+} pc;
+
+layout (set = )#" + ToString(FG_BindlessDescriptorSet) + R"#(, binding = 2, std430) readonly buffer BindlessBuffers {
+	uint	data[];
+} bindless_Buffers[];
+
+layout (set = 0, binding = 0, std430) writeonly buffer DstBuffer {
+	uint	data[];
+} un_DstBuffer;
+
+void main ()
+{
+	const uint	i = gl_GlobalInvocationID.x;
+	un_DstBuffer.data[i] = bindless_Buffers[ nonuniformEXT(pc.srcIndex) ].data[i] * 3;
+}
+)#" );
+
+		CPipelineID		pipeline = _frameGraph->CreatePipeline( ppln );
+		CHECK_ERR( pipeline );
+
+		PipelineResources	resources;
+		CHECK_ERR( _frameGraph->InitPipelineResources( pipeline, DescriptorSetID("0"), OUT resources ));
+
+		Array<uint>		src_data;	src_data.resize( count );
+		for (uint i = 0; i < count; ++i) {
+			src_data[i] = i * 7 + 1;
+		}
+
+		// resources in the heap are not tracked, so upload must be completed before use
+		{
+			CommandBuffer	cmd = _frameGraph->Begin( CommandBufferDesc{} );
+			CHECK_ERR( cmd );
+
+			Task	t_update = cmd->AddTask( UpdateBuffer{}.SetBuffer( src_buffer ).AddData( src_data ));
+			Unused( t_update );
+
+			CHECK_ERR( _frameGraph->Execute( cmd ));
+			CHECK_ERR( _frameGraph->WaitIdle() );
+		}
+
+		bool	cb_was_called	= false;
+		bool	data_is_correct	= false;
+
+		const auto	OnLoaded = [&] (BufferView data)
+		{
+			cb_was_called	= true;
+			data_is_correct	= (data.size() == size_t(buffer_size));
+
+			for (uint i = 0; data_is_correct and i < count; ++i)
+			{
+				uint	value;
+				std::memcpy( OUT &value, data.data() + i * sizeof(uint), sizeof(value) );
+
+				bool	is_equal = (value == src_data[i] * 3);
+				ASSERT( is_equal );
+
+				data_is_correct &= is_equal;
+			}
+		};
+
+		CommandBuffer	cmd = _frameGraph->Begin( CommandBufferDesc{} );
+		CHECK_ERR( cmd );
+
+		resources.BindBuffer( UniformID("un_DstBuffer"), dst_buffer );
+
+		Task	t_dispatch	= cmd->AddTask( DispatchCompute{}.Dispatch({ count / 64, 1 }).SetPipeline( pipeline )
+														.AddResources( DescriptorSetID("0"), resources )
+														.AddPushConstant( PushConstantID("PushConst"), src_index ));
+		Task	t_read		= cmd->AddTask( ReadBuffer{}.SetBuffer( dst_buffer, 0_b, buffer_size ).SetCallback( OnLoaded ).DependsOn( t_dispatch ));
+		Unused( t_read );
+
+		CHECK_ERR( _frameGraph->Execute( cmd ));
+		CHECK_ERR( _frameGraph->WaitIdle() );
+
+		CHECK_ERR( cb_was_called );
+		CHECK_ERR( data_is_correct );
+
+		DeleteResources( pipeline, src_buffer, dst_buffer );
+
+		FG_LOGI( TEST_NAME << " - passed" );
+		return true;
+	}
+
+}	// FG
@@ -0,0 +1,63 @@
+// Copyright (c) 2018-2020,  Zhirnov Andrey. For more information see 'LICENSE'
+
+#include "../FGApp.h"
+
+namespace FG
+{
+
+	bool FGApp::ImplTest_CompletionThread1 ()
+	{
+		const BytesU	buffer_size	= 1_Kb;
+		const uint		pattern		= 0x12345678;
+
+		BufferID	buffer	= _frameGraph->CreateBuffer( BufferDesc{ buffer_size, EBufferUsage::Transfer }, Default, "Buffer" );
+		CHECK_ERR( buffer );
+
+		const auto		main_thread		= std::this_thread::get_id();
+		Atomic<bool>	cb_was_called	{false};
+		bool			data_is_correct	= false;
+		bool			is_bg_thread	= false;
+
+		const auto	OnLoaded = [&] (BufferView data)
+		{
+			data_is_correct	= (data.size() == size_t(buffer_size));
+			is_bg_thread	= (std::this_thread::get_id() != main_thread);
+
+			for (size_t i = 0; i < data.size(); ++i)
+			{
+				bool	is_equal = (data[i] == uint8_t( pattern >> ((i % sizeof(pattern)) * 8) ));
+				ASSERT( is_equal );
+
+				data_is_correct &= is_equal;
+			}
+			cb_was_called.store( true, memory_order_release );
+		};
+
+		CHECK_ERR( _frameGraph->SetCompletionThreadEnabled( true ));
+
+		CommandBuffer	cmd = _frameGraph->Begin( CommandBufferDesc{} );
+		CHECK_ERR( cmd );
+
+		Task	t_fill	= cmd->AddTask( FillBuffer().SetBuffer( buffer ).SetPattern( pattern ));
+		Task	t_read	= cmd->AddTask( ReadBuffer().SetBuffer( buffer, 0_b, buffer_size ).SetCallback( OnLoaded ).DependsOn( t_fill ));
+		Unused( t_read );
+
+		CHECK_ERR( _frameGraph->Execute( cmd ));
+		CHECK_ERR( _frameGraph->Flush() );
+
+		// callback is called on the completion thread, 'Wait' only waits for it
+		CHECK_ERR( _frameGraph->Wait({ cmd }));
+
+		CHECK_ERR( cb_was_called.load( memory_order_acquire ));
+		CHECK_ERR( data_is_correct );
+		CHECK_ERR( is_bg_thread );
+
+		CHECK_ERR( _frameGraph->SetCompletionThreadEnabled( false ));
+
+		DeleteResources( buffer );
+
+		FG_LOGI( TEST_NAME << " - passed" );
+		return true;
+	}
+
+}	// FG
@@ -0,0 +1,134 @@
+// Copyright (c) 2018-2020,  Zhirnov Andrey. For more information see 'LICENSE'
+
+#include "../FGApp.h"
+#include "VDevice.h"
+#include "VDescriptorManager.h"
+#include "stl/ThreadSafe/Barrier.h"
+#include <thread>
+
+namespace FG
+{
+
+	bool FGApp::ImplTest_DescriptorManager1 ()
+	{
+		using DescriptorSet = VDescriptorSetLayout::DescriptorSet;
+
+		static constexpr uint	thread_count	= 4;
+		static constexpr uint	sets_per_thread	= VDescriptorManager::MaxDescriptorSets * 3;
+
+		VDevice					dev		{ _vulkanInfo };
+		VDescriptorManager		mngr	{ dev };
+		VkDescriptorSetLayout	layout	= VK_NULL_HANDLE;
+
+		CHECK_ERR( mngr.Initialize() );
+		{
+			VkDescriptorSetLayoutBinding	binding = {};
+			binding.binding			= 0;
+			binding.descriptorType	= VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+			binding.descriptorCount	= 1;
+			binding.stageFlags		= VK_SHADER_STAGE_COMPUTE_BIT;
+
+			VkDescriptorSetLayoutCreateInfo	info = {};
+			info.sType			= VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+			info.bindingCount	= 1;
+			info.pBindings		= &binding;
+
+			VK_CHECK( dev.vkCreateDescriptorSetLayout( dev.GetVkDevice(), &info, null, OUT &layout ));
+		}
+
+		// main thread takes part in synchronization to check pool count between phases
+		Barrier					sync		{ thread_count + 1 };
+		Array<DescriptorSet>	sets		[thread_count];
+		bool					results		[thread_count];
+		Array<std::thread>		threads;
+
+		// thread must not return before all barriers are passed, otherwise other threads will be blocked
+		const auto	AllocSets = [&] (uint index) -> bool
+		{
+			auto&	dst = sets[index];
+			dst.clear();
+			dst.reserve( sets_per_thread );
+
+			for (uint i = 0; i < sets_per_thread; ++i)
+			{
+				DescriptorSet	ds;
+				if ( not mngr.AllocDescriptorSet( layout, OUT ds ))
+					return false;
+
+				dst.push_back( ds );
+			}
+			return true;
+		};
+
+		for (uint t = 0; t < thread_count; ++t)
+		{
+			threads.emplace_back( [&, t] ()
+			{
+				// (1) allocate more sets than single pool can hold
+				bool	ok = AllocSets( t );
+				sync.wait();
+
+				// (2) release sets that were allocated by another thread,
+				//     half of them one by one and other half in batch
+				{
+					auto&			src		= sets[ (t + 1) % thread_count ];
+					const size_t	half	= src.size() / 2;
+
+					for (size_t i = 0; i < half; ++i) {
+						ok &= mngr.DeallocDescriptorSet( src[i] );
+					}
+					ok &= mngr.DeallocDescriptorSets( ArrayView<DescriptorSet>{ src }.section( half, UMax ));
+				}
+				sync.wait();
+
+				// (3) allocate again, released pools must be reused
+				ok &= AllocSets( t );
+
+				results[t] = ok;
+			});
+		}
+
+		sync.wait();
+		const uint	pool_count = mngr.GetPoolCount();
+		sync.wait();
+
+		for (auto& t : threads) {
+			t.join();
+		}
+
+		// pool count is not limited by old 8 pools
+		CHECK_ERR( pool_count >= thread_count * sets_per_thread / VDescriptorManager::MaxDescriptorSets );
+		CHECK_ERR( pool_count > 8 );
+		CHECK_ERR( mngr.GetPoolCount() == pool_count );
+
+		HashSet<VkDescriptorSet>	unique_sets;
+		uint16_t					max_index	= 0;
+
+		for (uint t = 0; t < thread_count; ++t)
+		{
+			CHECK_ERR( results[t] );
+			CHECK_ERR( sets[t].size() == sets_per_thread );
+
+			for (auto& ds : sets[t])
+			{
+				CHECK_ERR( ds.first != VK_NULL_HANDLE );
+				CHECK_ERR( ds.second < pool_count );
+
+				unique_sets.insert( ds.first );
+				max_index = Max( max_index, ds.second );
+			}
+			CHECK_ERR( mngr.DeallocDescriptorSets( sets[t] ));
+		}
+
+		// pool index must not be truncated
+		CHECK_ERR( max_index >= 8 );
+		CHECK_ERR( unique_sets.size() == thread_count * sets_per_thread );
+
+		dev.vkDestroyDescriptorSetLayout( dev.GetVkDevice(), layout, null );
+		mngr.Deinitialize();
+
+		FG_LOGI( TEST_NAME << " - passed" );
+		return true;
+	}
+
+}	// FG
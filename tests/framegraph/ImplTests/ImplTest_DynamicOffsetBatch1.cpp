@@ -0,0 +1,144 @@
+// Copyright (c) 2018-2020,  Zhirnov Andrey. For more information see 'LICENSE'
+
+#include "../FGApp.h"
+
+namespace FG
+{
+
+	bool FGApp::ImplTest_DynamicOffsetBatch1 ()
+	{
+		if ( not _pplnCompiler )
+		{
+			FG_LOGI( TEST_NAME << " - skipped" );
+			return true;
+		}
+
+		ComputePipelineDesc	ppln;
+
+		ppln.AddShader( EShaderLangFormat::VKSL_100, "main", R"#(
+#extension GL_ARB_shading_language_420pack : enable
+
+layout (local_size_x = 1, local_size_y = 1, local_size_z = 1) in;
+
+// @dynamic-offset
+layout (set=0, binding=0, std140) uniform UB_A {
+	vec4	data;
+} ub_a;
+
+// @dynamic-offset
+layout (set=0, binding=1, std140) uniform UB_B {
+	vec4	data;
+} ub_b;
+
+// @dynamic-offset
+layout (set=1, binding=0, std430) writeonly buffer SSB {
+	vec4	data;
+} ssb;
+
+void main ()
+{
+	ssb.data = ub_a.data * 10.0 + ub_b.data;
+}
+)#" );
+
+		constexpr uint	count		= 4;
+		const BytesU	align		= Max( _properties.minUniformBufferOffsetAlignment, _properties.minStorageBufferOffsetAlignment, 16_b );
+		const BytesU	elem_size	= SizeOf<float4>;
+
+		BufferID		src_buffer	= _frameGraph->CreateBuffer( BufferDesc{ align * (count + 1), EBufferUsage::Uniform | EBufferUsage::TransferDst }, Default, "SrcBuffer" );
+		BufferID		dst_buffer	= _frameGraph->CreateBuffer( BufferDesc{ align * count, EBufferUsage::Storage | EBufferUsage::TransferSrc }, Default, "DstBuffer" );
+		CPipelineID		pipeline	= _frameGraph->CreatePipeline( ppln );
+		CHECK_ERR( src_buffer and dst_buffer and pipeline );
+
+		PipelineResources	resources0;
+		PipelineResources	resources1;
+		CHECK_ERR( _frameGraph->InitPipelineResources( pipeline, DescriptorSetID("0"), OUT resources0 ));
+		CHECK_ERR( _frameGraph->InitPipelineResources( pipeline, DescriptorSetID("1"), OUT resources1 ));
+
+		// 'ub_a' at offset 0, 'ub_b' of dispatch 'i' at offset 'align * (i+1)'
+		Array<uint8_t>	src_data;	src_data.resize( size_t(align * (count + 1)) );
+		const auto		SetSrc		= [&] (uint index, const float4 &value) { std::memcpy( OUT src_data.data() + size_t(align * index), &value, sizeof(value) ); };
+
+		SetSrc( 0, float4{1.0f, 2.0f, 3.0f, 4.0f} );
+		for (uint i = 0; i < count; ++i) {
+			SetSrc( i+1, float4{float(i)} );
+		}
+
+		resources0.SetBufferBase( UniformID("UB_A"), 0_b );
+		resources0.SetBufferBase( UniformID("UB_B"), 0_b );
+		resources1.SetBufferBase( UniformID("SSB"),  0_b );
+
+		// reset statistics
+		{
+			IFrameGraph::Statistics		stat;
+			CHECK_ERR( _frameGraph->WaitIdle() );
+			CHECK_ERR( _frameGraph->GetStatistics( OUT stat ));
+		}
+
+		for (uint frame = 0; frame < 2; ++frame)
+		{
+			bool	cb_was_called	= false;
+			bool	data_is_correct	= false;
+
+			const auto	OnLoaded = [&] (BufferView data)
+			{
+				cb_was_called	= true;
+				data_is_correct	= (data.size() == size_t(align * count));
+
+				for (uint i = 0; data_is_correct and (i < count); ++i)
+				{
+					float4	value;
+					std::memcpy( OUT &value, data.data() + size_t(align * i), sizeof(value) );
+
+					bool	is_equal = All( value == float4{10.0f, 20.0f, 30.0f, 40.0f} + float(i) );
+					ASSERT( is_equal );
+
+					data_is_correct &= is_equal;
+				}
+			};
+
+			// second frame replays cached schedule
+			CommandBuffer	cmd = _frameGraph->Begin( CommandBufferDesc{}.SetReorderTasks().SetReuseSchedule() );
+			CHECK_ERR( cmd );
+
+			Task	t_update = cmd->AddTask( UpdateBuffer{}.SetBuffer( src_buffer ).AddData( src_data ));
+			Task	t_dispatch[count];
+
+			for (uint i = 0; i < count; ++i)
+			{
+				resources0.BindBuffer( UniformID("UB_A"), src_buffer, 0_b, elem_size );
+				resources0.BindBuffer( UniformID("UB_B"), src_buffer, align * (i+1), elem_size );
+				resources1.BindBuffer( UniformID("SSB"),  dst_buffer, align * i, elem_size );
+
+				// descriptor set 1 is added first, dynamic offsets must be sorted by binding index
+				t_dispatch[i] = cmd->AddTask( DispatchCompute{}.SetPipeline( pipeline ).Dispatch({ 1, 1 })
+													.AddResources( DescriptorSetID("1"), resources1 )
+													.AddResources( DescriptorSetID("0"), resources0 )
+													.DependsOn( t_update ));
+			}
+
+			Task	t_read = cmd->AddTask( ReadBuffer{}.SetBuffer( dst_buffer, 0_b, align * count ).SetCallback( OnLoaded )
+												.DependsOn( t_dispatch[0], t_dispatch[1], t_dispatch[2], t_dispatch[3] ));
+			Unused( t_read );
+
+			CHECK_ERR( _frameGraph->Execute( cmd ));
+			CHECK_ERR( _frameGraph->WaitIdle() );
+
+			IFrameGraph::Statistics		stat;
+			CHECK_ERR( _frameGraph->GetStatistics( OUT stat ));
+
+			// dispatches write to different ranges, so they must be batched
+			CHECK_ERR( stat.renderer.batchedTasks > 0 );
+			CHECK_ERR( frame == 0 or stat.renderer.reusedSchedules > 0 );
+
+			CHECK_ERR( cb_was_called );
+			CHECK_ERR( data_is_correct );
+		}
+
+		DeleteResources( pipeline, src_buffer, dst_buffer );
+
+		FG_LOGI( TEST_NAME << " - passed" );
+		return true;
+	}
+
+}	// FG
@@ -0,0 +1,38 @@
+// Copyright (c) 2018-2020,  Zhirnov Andrey. For more information see 'LICENSE'
+
+#include "../FGApp.h"
+
+namespace FG
+{
+
+	bool FGApp::ImplTest_MemoryReuse1 ()
+	{
+		constexpr uint	count		= 8;
+		const BytesU	buffer_size	= 4_Mb;
+
+		CHECK_ERR( _frameGraph->WaitIdle() );
+
+		// reset statistics
+		IFrameGraph::Statistics		stat;
+		CHECK_ERR( _frameGraph->GetStatistics( OUT stat ));
+
+		// dedicated allocation always creates new memory block
+		for (uint i = 0; i < count; ++i)
+		{
+			BufferID	buffer = _frameGraph->CreateBuffer( BufferDesc{ buffer_size, EBufferUsage::Transfer }, EMemoryType::Dedicated, "Buffer-" + ToString(i) );
+			CHECK_ERR( buffer );
+
+			DeleteResources( buffer );
+		}
+
+		CHECK_ERR( _frameGraph->GetStatistics( OUT stat ));
+
+		// released memory block must be reused by the next buffer
+		CHECK_ERR( stat.resources.memoryBlockAllocations >= 1 );
+		CHECK_ERR( stat.resources.memoryBlockReuses >= count - 1 );
+
+		FG_LOGI( TEST_NAME << " - passed" );
+		return true;
+	}
+
+}	// FG
@@ -0,0 +1,104 @@
+// Copyright (c) 2018-2020,  Zhirnov Andrey. For more information see 'LICENSE'
+
+#include "../FGApp.h"
+#include "VDevice.h"
+#include "VPipelineCache.h"
+#include "stl/Stream/FileStream.h"
+
+namespace FG
+{
+
+	bool FGApp::ImplTest_PipelineCache1 ()
+	{
+		const String	filename	= (FS::temp_directory_path() / "fg_pipeline_cache_test.bin").string();
+		VDevice			dev			{ _vulkanInfo };
+		Array<uint8_t>	file_data;
+
+		// returns 'true' if cache was created and data was loaded from file
+		const auto	Load = [&] (OUT bool &loaded) -> bool
+		{
+			VPipelineCache	cache;
+			CHECK_ERR( cache.Load( dev, filename, OUT loaded ));
+			CHECK_ERR( cache.IsCreated() );
+			cache.Deinitialize( dev );
+			return true;
+		};
+
+		// rewrites file with modified copy of saved data
+		const auto	Damage = [&] (size_t offset, uint8_t value) -> bool
+		{
+			Array<uint8_t>	data = file_data;
+			CHECK_ERR( offset < data.size() );
+			data[offset] ^= value;
+
+			FileWStream		file{ filename };
+			CHECK_ERR( file.IsOpen() );
+			CHECK_ERR( file.Write( ArrayView<uint8_t>{ data }));
+			return true;
+		};
+
+		// save
+		{
+			VPipelineCache	cache;
+			CHECK_ERR( cache.Initialize( dev ));
+			CHECK_ERR( cache.Save( dev, filename ));
+			cache.Deinitialize( dev );
+
+			FileRStream		file{ filename };
+			CHECK_ERR( file.IsOpen() );
+			CHECK_ERR( file.Read( size_t(file.RemainingSize()), OUT file_data ));
+			CHECK_ERR( file_data.size() > 56 );
+		}
+
+		bool	loaded = false;
+
+		// reload
+		CHECK_ERR( Load( OUT loaded ));
+		CHECK_ERR( loaded );
+
+		// header layout: magic, version, vendorID, deviceID, driverVersion, pipelineCacheUUID, padding, dataSize, dataHash
+		const size_t	uuid_offset		= sizeof(uint) * 5;
+		const size_t	padding_offset	= uuid_offset + VK_UUID_SIZE;
+
+		// damaged magic
+		CHECK_ERR( Damage( 0, 0xFF ));
+		CHECK_ERR( Load( OUT loaded ));
+		CHECK_ERR( not loaded );
+
+		// different device UUID
+		CHECK_ERR( Damage( uuid_offset + 3, 0x01 ));
+		CHECK_ERR( Load( OUT loaded ));
+		CHECK_ERR( not loaded );
+
+		// non-zero padding
+		CHECK_ERR( Damage( padding_offset, 0x01 ));
+		CHECK_ERR( Load( OUT loaded ));
+		CHECK_ERR( not loaded );
+
+		// damaged data
+		CHECK_ERR( Damage( file_data.size() - 1, 0xFF ));
+		CHECK_ERR( Load( OUT loaded ));
+		CHECK_ERR( not loaded );
+
+		// truncated header
+		{
+			FileWStream		file{ filename };
+			CHECK_ERR( file.IsOpen() );
+			CHECK_ERR( file.Write( ArrayView<uint8_t>{ file_data.data(), 16 }));
+		}
+		CHECK_ERR( Load( OUT loaded ));
+		CHECK_ERR( not loaded );
+
+		// original file is loaded again
+		CHECK_ERR( Damage( 0, 0 ));
+		CHECK_ERR( Load( OUT loaded ));
+		CHECK_ERR( loaded );
+
+		std::error_code		err;
+		FS::remove( FS::path{ filename }, OUT err );
+
+		FG_LOGI( TEST_NAME << " - passed" );
+		return true;
+	}
+
+}	// FG
@@ -0,0 +1,78 @@
+// Copyright (c) 2018-2020,  Zhirnov Andrey. For more information see 'LICENSE'
+
+#include "../FGApp.h"
+
+namespace FG
+{
+
+	bool FGApp::ImplTest_ReadImageContiguous1 ()
+	{
+		const uint2		image_dim	= {300, 200};
+		const BytesU	bpp			= 4_b;
+		const BytesU	row_pitch	= 2_Kb;
+
+		ImageID		image	= _frameGraph->CreateImage( ImageDesc{}.SetDimension( image_dim ).SetFormat( EPixelFormat::RGBA8_UNorm ).SetUsage( EImageUsage::Transfer ), Default, "Image" );
+		CHECK_ERR( image );
+
+		const auto	GetImageValue = [] (uint x, uint y, uint c) { return uint8_t(c == 3 ? 0xFF : (c == 0 ? x : (c == 1 ? y : x ^ y))); };
+
+		Array<uint8_t>	image_data;		image_data.resize( size_t(image_dim.x * image_dim.y * bpp) );
+
+		for (uint y = 0; y < image_dim.y; ++y)
+		for (uint x = 0; x < image_dim.x; ++x)
+		for (uint c = 0; c < 4; ++c)
+		{
+			image_data[ size_t((y * image_dim.x + x) * bpp) + c ] = GetImageValue( x, y, c );
+		}
+
+		bool	cb_was_called		= false;
+		bool	data_is_correct		= false;
+		bool	pitch_is_correct	= false;
+
+		const auto	OnImageLoaded = [&] (const ImageView &imageData)
+		{
+			cb_was_called		= true;
+			data_is_correct		= true;
+
+			// whole image must be in a single part with specified row pitch
+			pitch_is_correct	= (imageData.Parts().size() == 1);
+			pitch_is_correct	&= (imageData.RowPitch() == row_pitch);
+			pitch_is_correct	&= (imageData.SlicePitch() == row_pitch * image_dim.y);
+			pitch_is_correct	&= (imageData.Parts()[0].data() + size_t(row_pitch) == imageData.GetRow( 1 ).data());
+
+			for (uint y = 0; y < image_dim.y; ++y)
+			{
+				ArrayView<uint8_t>	row = imageData.GetRow( y );
+
+				for (uint x = 0; x < image_dim.x; ++x)
+				for (uint c = 0; c < 4; ++c)
+				{
+					bool	is_equal = (row[ size_t(x * bpp) + c ] == GetImageValue( x, y, c ));
+					ASSERT( is_equal );
+
+					data_is_correct &= is_equal;
+				}
+			}
+		};
+
+		CommandBuffer	cmd = _frameGraph->Begin( CommandBufferDesc{} );
+		CHECK_ERR( cmd );
+
+		Task	t_update	= cmd->AddTask( UpdateImage().SetImage( image ).SetData( image_data, uint3{ image_dim, 1 }));
+		Task	t_read		= cmd->AddTask( ReadImage().SetImage( image, int2(), image_dim ).SetContiguous( row_pitch ).SetCallback( OnImageLoaded ).DependsOn( t_update ));
+		Unused( t_read );
+
+		CHECK_ERR( _frameGraph->Execute( cmd ));
+		CHECK_ERR( _frameGraph->WaitIdle() );
+
+		CHECK_ERR( cb_was_called );
+		CHECK_ERR( data_is_correct );
+		CHECK_ERR( pitch_is_correct );
+
+		DeleteResources( image );
+
+		FG_LOGI( TEST_NAME << " - passed" );
+		return true;
+	}
+
+}	// FG
@@ -0,0 +1,77 @@
+// Copyright (c) 2018-2020,  Zhirnov Andrey. For more information see 'LICENSE'
+
+#include "../FGApp.h"
+
+namespace FG
+{
+
+	bool FGApp::ImplTest_SplitBarriers1 ()
+	{
+		const BytesU	buffer_size		= 1_Kb;
+		const uint		unrelated_count	= FG_MinSplitBarrierDistance + 2;
+
+		BufferID	src_buffer	= _frameGraph->CreateBuffer( BufferDesc{ buffer_size, EBufferUsage::Transfer }, Default, "SrcBuffer" );
+		BufferID	dst_buffer	= _frameGraph->CreateBuffer( BufferDesc{ buffer_size, EBufferUsage::Transfer }, Default, "DstBuffer" );
+		BufferID	tmp_buffer	= _frameGraph->CreateBuffer( BufferDesc{ buffer_size, EBufferUsage::Transfer }, Default, "TempBuffer" );
+		CHECK_ERR( src_buffer and dst_buffer and tmp_buffer );
+
+		// events are reset when the batch is complete and reused in the next frame
+		for (uint frame = 0; frame < 2; ++frame)
+		{
+			const uint	pattern			= 0x12345678 + frame;
+			bool		cb_was_called	= false;
+			bool		data_is_correct	= false;
+
+			const auto	OnLoaded = [&] (BufferView data)
+			{
+				cb_was_called	= true;
+				data_is_correct	= (data.size() == size_t(buffer_size));
+
+				for (size_t i = 0; i < data.size(); ++i)
+				{
+					bool	is_equal = (data[i] == uint8_t( pattern >> ((i % sizeof(pattern)) * 8) ));
+					ASSERT( is_equal );
+
+					data_is_correct &= is_equal;
+				}
+			};
+
+			// reset statistics
+			IFrameGraph::Statistics		stat;
+			CHECK_ERR( _frameGraph->GetStatistics( OUT stat ));
+
+			CommandBuffer	cmd = _frameGraph->Begin( CommandBufferDesc{}.SetSplitBarriers().SetDebugFlags( EDebugFlags::Default ));
+			CHECK_ERR( cmd );
+
+			// producer
+			Task	t_fill	= cmd->AddTask( FillBuffer().SetBuffer( src_buffer, 0_b, buffer_size ).SetPattern( pattern ));
+			Task	t_last	= t_fill;
+
+			// tasks that don't access 'src_buffer', producer and consumer are far enough to use event
+			for (uint i = 0; i < unrelated_count; ++i)
+			{
+				t_last = cmd->AddTask( FillBuffer().SetBuffer( tmp_buffer, 0_b, buffer_size ).SetPattern( i ).DependsOn( t_last ));
+			}
+
+			// consumer
+			Task	t_copy	= cmd->AddTask( CopyBuffer().From( src_buffer ).To( dst_buffer ).AddRegion( 0_b, 0_b, buffer_size ).DependsOn( t_last ));
+			Task	t_read	= cmd->AddTask( ReadBuffer().SetBuffer( dst_buffer, 0_b, buffer_size ).SetCallback( OnLoaded ).DependsOn( t_copy ));
+			Unused( t_read );
+
+			CHECK_ERR( _frameGraph->Execute( cmd ));
+			CHECK_ERR( _frameGraph->WaitIdle() );
+
+			CHECK_ERR( _frameGraph->GetStatistics( OUT stat ));
+
+			CHECK_ERR( cb_was_called );
+			CHECK_ERR( data_is_correct );
+			CHECK_ERR( stat.renderer.splitBarriers > 0 );
+		}
+
+		DeleteResources( src_buffer, dst_buffer, tmp_buffer );
+
+		FG_LOGI( TEST_NAME << " - passed" );
+		return true;
+	}
+
+}	// FG
@@ -0,0 +1,57 @@
+// Copyright (c) 2018-2020,  Zhirnov Andrey. For more information see 'LICENSE'
+
+#include "../FGApp.h"
+
+namespace FG
+{
+
+	bool FGApp::ImplTest_Submission1 ()
+	{
+		constexpr uint	count		= 4;
+		const BytesU	buffer_size	= 256_b;
+
+		BufferID	buffers[count];
+		for (uint i = 0; i < count; ++i)
+		{
+			buffers[i] = _frameGraph->CreateBuffer( BufferDesc{ buffer_size, EBufferUsage::Transfer }, Default, "Buffer-" + ToString(i) );
+			CHECK_ERR( buffers[i] );
+		}
+
+		CHECK_ERR( _frameGraph->WaitIdle() );
+
+		// reset statistics
+		IFrameGraph::Statistics		stat;
+		CHECK_ERR( _frameGraph->GetStatistics( OUT stat ));
+
+		CommandBuffer	prev;
+		for (uint i = 0; i < count; ++i)
+		{
+			CommandBuffer	cmd = _frameGraph->Begin( CommandBufferDesc{ EQueueType::Graphics });
+			CHECK_ERR( cmd );
+
+			if ( prev )
+				cmd->AddDependency( prev );
+
+			Task	t_fill = cmd->AddTask( FillBuffer().SetBuffer( buffers[i] ).SetPattern( i ));
+			Unused( t_fill );
+
+			CHECK_ERR( _frameGraph->Execute( cmd ));
+			prev = cmd;
+		}
+
+		// all batches are ready, they must be submitted together
+		CHECK_ERR( _frameGraph->Flush() );
+		CHECK_ERR( _frameGraph->WaitIdle() );
+
+		CHECK_ERR( _frameGraph->GetStatistics( OUT stat ));
+		CHECK_ERR( stat.renderer.queueSubmits == 1 );
+
+		for (auto& buf : buffers) {
+			DeleteResources( buf );
+		}
+
+		FG_LOGI( TEST_NAME << " - passed" );
+		return true;
+	}
+
+}	// FG
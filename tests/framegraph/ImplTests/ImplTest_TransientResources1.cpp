@@ -0,0 +1,77 @@
+// Copyright (c) 2018-2020,  Zhirnov Andrey. For more information see 'LICENSE'
+
+#include "../FGApp.h"
+
+namespace FG
+{
+
+	bool FGApp::ImplTest_TransientResources1 ()
+	{
+		const BytesU	buffer_size	= 1_Kb;
+		const uint		pattern1	= 0x12345678;
+		const uint		pattern2	= 0xABCDEF01;
+
+		BufferID	dst_buffer	= _frameGraph->CreateBuffer( BufferDesc{ buffer_size * 2, EBufferUsage::Transfer }, Default, "DstBuffer" );
+		CHECK_ERR( dst_buffer );
+
+		// reset statistics
+		IFrameGraph::Statistics		stat;
+		CHECK_ERR( _frameGraph->GetStatistics( OUT stat ));
+
+		bool	cb_was_called	= false;
+		bool	data_is_correct	= false;
+
+		const auto	OnLoaded = [&] (BufferView data)
+		{
+			cb_was_called	= true;
+			data_is_correct	= (data.size() == size_t(buffer_size * 2));
+
+			for (size_t i = 0; i < data.size(); ++i)
+			{
+				const uint	pattern		= (i < size_t(buffer_size) ? pattern1 : pattern2);
+				bool		is_equal	= (data[i] == uint8_t( pattern >> ((i % sizeof(pattern)) * 8) ));
+				ASSERT( is_equal );
+
+				data_is_correct &= is_equal;
+			}
+		};
+
+		CommandBuffer	cmd = _frameGraph->Begin( CommandBufferDesc{}.SetDebugFlags( EDebugFlags::Default ));
+		CHECK_ERR( cmd );
+
+		// first transient buffer
+		RawBufferID		temp1	= cmd->CreateTransientBuffer( BufferDesc{ buffer_size, EBufferUsage::Transfer }, "TempBuffer1" );
+		CHECK_ERR( temp1 );
+
+		Task	t_fill1	= cmd->AddTask( FillBuffer().SetBuffer( temp1 ).SetPattern( pattern1 ));
+		Task	t_copy1	= cmd->AddTask( CopyBuffer().From( temp1 ).To( dst_buffer ).AddRegion( 0_b, 0_b, buffer_size ).DependsOn( t_fill1 ));
+		Unused( t_copy1 );
+
+		CHECK_ERR( cmd->ReleaseTransient( temp1 ));
+
+		// second transient buffer uses the same memory, tasks that are added after it are executed after 't_copy1'
+		RawBufferID		temp2	= cmd->CreateTransientBuffer( BufferDesc{ buffer_size, EBufferUsage::Transfer }, "TempBuffer2" );
+		CHECK_ERR( temp2 );
+
+		Task	t_fill2	= cmd->AddTask( FillBuffer().SetBuffer( temp2 ).SetPattern( pattern2 ));
+		Task	t_copy2	= cmd->AddTask( CopyBuffer().From( temp2 ).To( dst_buffer ).AddRegion( 0_b, buffer_size, buffer_size ).DependsOn( t_fill2 ));
+		Task	t_read	= cmd->AddTask( ReadBuffer().SetBuffer( dst_buffer, 0_b, buffer_size * 2 ).SetCallback( OnLoaded ).DependsOn( t_copy2 ));
+		Unused( t_read );
+
+		CHECK_ERR( cmd->ReleaseTransient( temp2 ));
+		CHECK_ERR( _frameGraph->Execute( cmd ));
+		CHECK_ERR( _frameGraph->WaitIdle() );
+
+		CHECK_ERR( _frameGraph->GetStatistics( OUT stat ));
+
+		CHECK_ERR( cb_was_called );
+		CHECK_ERR( data_is_correct );
+		CHECK_ERR( stat.renderer.aliasingFences > 0 );
+
+		DeleteResources( dst_buffer );
+
+		FG_LOGI( TEST_NAME << " - passed" );
+		return true;
+	}
+
+}	// FG
@@ -0,0 +1,133 @@
+// Copyright (c) 2018-2020,  Zhirnov Andrey. For more information see 'LICENSE'
+
+#include "framegraph/Public/UploadScheduler.h"
+#include "../FGApp.h"
+
+namespace FG
+{
+
+	bool FGApp::ImplTest_UploadScheduler1 ()
+	{
+		const BytesU	buffer_size	= 4_Mb;
+		const BytesU	budget		= 1_Mb;
+		const uint2		image_dim	= {256, 256};
+		const BytesU	bpp			= 4_b;
+
+		UploadScheduler		scheduler;
+		CHECK_ERR( scheduler.Initialize( _frameGraph, budget ));
+
+		const EQueueUsage	queues	= EQueueUsage::Graphics | EQueueUsage(1u << uint(scheduler.GetQueueType()));
+
+		BufferID	buffer	= _frameGraph->CreateBuffer( BufferDesc{ buffer_size, EBufferUsage::Transfer, queues }, Default, "Buffer" );
+		ImageID		image	= _frameGraph->CreateImage( ImageDesc{}.SetDimension( image_dim ).SetFormat( EPixelFormat::RGBA8_UNorm )
+																.SetUsage( EImageUsage::Transfer ).SetQueues( queues ), Default, "Image" );
+		CHECK_ERR( buffer and image );
+
+		Array<uint8_t>	buffer_data;	buffer_data.resize( size_t(buffer_size) );
+
+		for (size_t i = 0; i < buffer_data.size(); ++i) {
+			buffer_data[i] = uint8_t((i * 7) ^ (i >> 12));
+		}
+
+		const auto	GetImageValue = [] (uint x, uint y, uint c) { return uint8_t(c == 3 ? 0xFF : (c == 0 ? x : (c == 1 ? y : x ^ y))); };
+
+		const auto	WriteImage = [&] (void* dst, BytesU offset, BytesU size)
+		{
+			for (size_t i = 0; i < size_t(size); ++i)
+			{
+				const size_t	j = size_t(offset) + i;
+				const uint		x = uint((j / size_t(bpp)) % image_dim.x);
+				const uint		y = uint((j / size_t(bpp)) / image_dim.x);
+
+				Cast<uint8_t>(dst)[i] = GetImageValue( x, y, uint(j % size_t(bpp)) );
+			}
+		};
+
+		auto	buf_future	= scheduler.Upload( buffer, 0_b, buffer_data );
+		auto	img_future	= scheduler.Upload( image, int3(), uint3{ image_dim, 1 }, WriteImage, 0_b, 0_b, Default, Default, UploadScheduler::EPriority::High );
+		CHECK_ERR( buf_future and img_future );
+
+		// upload data over several frames
+		uint	frame_count	= 0;
+		BytesU	last_uploaded;
+
+		for (; buf_future.Uploaded() < buf_future.Size() and frame_count < 100; ++frame_count)
+		{
+			CHECK_ERR( scheduler.Update() );
+
+			// image has higher priority and must be recorded in the first frame
+			CHECK_ERR( img_future.Uploaded() == img_future.Size() );
+
+			CHECK_ERR( buf_future.Uploaded() - last_uploaded <= budget );
+			last_uploaded = buf_future.Uploaded();
+
+			CHECK_ERR( _frameGraph->Flush() );
+		}
+
+		CHECK_ERR( frame_count > uint(buffer_size / budget) );
+
+		// request state is updated in 'Update()'
+		CHECK_ERR( _frameGraph->WaitIdle() );
+		CHECK_ERR( scheduler.Update() );
+
+		CHECK_ERR( not scheduler.HasPendingRequests() );
+		CHECK_ERR( buf_future.IsComplete() and not buf_future.IsFailed() );
+		CHECK_ERR( img_future.IsComplete() and not img_future.IsFailed() );
+
+		// check uploaded data
+		bool	buf_data_is_correct	= false;
+		bool	img_data_is_correct	= false;
+
+		const auto	OnBufferLoaded = [&] (BufferView data)
+		{
+			buf_data_is_correct = (data.size() == buffer_data.size());
+
+			for (size_t i = 0; i < data.size(); ++i)
+			{
+				bool	is_equal = (data[i] == buffer_data[i]);
+				ASSERT( is_equal );
+
+				buf_data_is_correct &= is_equal;
+			}
+		};
+
+		const auto	OnImageLoaded = [&] (const ImageView &imageData)
+		{
+			img_data_is_correct = true;
+
+			for (uint y = 0; y < image_dim.y; ++y)
+			{
+				ArrayView<uint8_t>	row = imageData.GetRow( y );
+
+				for (uint x = 0; x < image_dim.x; ++x)
+				for (uint c = 0; c < 4; ++c)
+				{
+					bool	is_equal = (row[ size_t(x * bpp) + c ] == GetImageValue( x, y, c ));
+					ASSERT( is_equal );
+
+					img_data_is_correct &= is_equal;
+				}
+			}
+		};
+
+		CommandBuffer	cmd = _frameGraph->Begin( CommandBufferDesc{} );
+		CHECK_ERR( cmd );
+
+		Task	t_read_buf	= cmd->AddTask( ReadBuffer().SetBuffer( buffer, 0_b, buffer_size ).SetCallback( OnBufferLoaded ));
+		Task	t_read_img	= cmd->AddTask( ReadImage().SetImage( image, int2(), image_dim ).SetCallback( OnImageLoaded ));
+		Unused( t_read_buf, t_read_img );
+
+		CHECK_ERR( _frameGraph->Execute( cmd ));
+		CHECK_ERR( _frameGraph->WaitIdle() );
+
+		CHECK_ERR( buf_data_is_correct );
+		CHECK_ERR( img_data_is_correct );
+
+		scheduler.Deinitialize();
+		DeleteResources( buffer, image );
+
+		FG_LOGI( TEST_NAME << " - passed" );
+		return true;
+	}
+
+}	// FG
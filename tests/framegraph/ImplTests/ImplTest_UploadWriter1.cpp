@@ -0,0 +1,112 @@
+// Copyright (c) 2018-2020,  Zhirnov Andrey. For more information see 'LICENSE'
+
+#include "../FGApp.h"
+
+namespace FG
+{
+
+	bool FGApp::ImplTest_UploadWriter1 ()
+	{
+		const BytesU	buffer_size	= 3_Mb;
+		const uint2		image_dim	= {256, 256};
+		const BytesU	bpp			= 4_b;
+
+		BufferID	buffer	= _frameGraph->CreateBuffer( BufferDesc{ buffer_size, EBufferUsage::Transfer }, Default, "Buffer" );
+		ImageID		image	= _frameGraph->CreateImage( ImageDesc{}.SetDimension( image_dim ).SetFormat( EPixelFormat::RGBA8_UNorm ).SetUsage( EImageUsage::Transfer ), Default, "Image" );
+		CHECK_ERR( buffer and image );
+
+		const auto	GetBufferValue	= [] (size_t i)				{ return uint8_t((i * 7) ^ (i >> 10)); };
+		const auto	GetImageValue	= [] (uint x, uint y, uint c)	{ return uint8_t(c == 3 ? 0xFF : (c == 0 ? x : (c == 1 ? y : x ^ y))); };
+
+		// data is written directly to the staging memory
+		BytesU	buffer_written;
+		BytesU	image_written;
+
+		const auto	WriteBuffer = [&] (void* dst, BytesU offset, BytesU size)
+		{
+			for (size_t i = 0; i < size_t(size); ++i) {
+				Cast<uint8_t>(dst)[i] = GetBufferValue( size_t(offset) + i );
+			}
+			buffer_written += size;
+		};
+
+		const auto	WriteImage = [&] (void* dst, BytesU offset, BytesU size)
+		{
+			for (size_t i = 0; i < size_t(size); ++i)
+			{
+				const size_t	j = size_t(offset) + i;
+				const uint		x = uint((j / size_t(bpp)) % image_dim.x);
+				const uint		y = uint((j / size_t(bpp)) / image_dim.x);
+
+				Cast<uint8_t>(dst)[i] = GetImageValue( x, y, uint(j % size_t(bpp)) );
+			}
+			image_written += size;
+		};
+
+		bool	buf_cb_was_called	= false;
+		bool	buf_data_is_correct	= false;
+		bool	img_cb_was_called	= false;
+		bool	img_data_is_correct	= false;
+
+		const auto	OnBufferLoaded = [&] (BufferView data)
+		{
+			buf_cb_was_called	= true;
+			buf_data_is_correct	= (data.size() == size_t(buffer_size));
+
+			for (size_t i = 0; i < data.size(); ++i)
+			{
+				bool	is_equal = (data[i] == GetBufferValue( i ));
+				ASSERT( is_equal );
+
+				buf_data_is_correct &= is_equal;
+			}
+		};
+
+		const auto	OnImageLoaded = [&] (const ImageView &imageData)
+		{
+			img_cb_was_called	= true;
+			img_data_is_correct	= true;
+
+			for (uint y = 0; y < image_dim.y; ++y)
+			{
+				ArrayView<uint8_t>	row = imageData.GetRow( y );
+
+				for (uint x = 0; x < image_dim.x; ++x)
+				for (uint c = 0; c < 4; ++c)
+				{
+					bool	is_equal = (row[ size_t(x * bpp) + c ] == GetImageValue( x, y, c ));
+					ASSERT( is_equal );
+
+					img_data_is_correct &= is_equal;
+				}
+			}
+		};
+
+		CommandBuffer	cmd = _frameGraph->Begin( CommandBufferDesc{} );
+		CHECK_ERR( cmd );
+
+		Task	t_update_buf	= cmd->AddTask( UpdateBuffer().SetBuffer( buffer ).AddDataWriter( WriteBuffer, buffer_size ));
+		Task	t_update_img	= cmd->AddTask( UpdateImage().SetImage( image ).SetDataWriter( WriteImage, uint3{ image_dim, 1 }));
+		Task	t_read_buf		= cmd->AddTask( ReadBuffer().SetBuffer( buffer, 0_b, buffer_size ).SetCallback( OnBufferLoaded ).DependsOn( t_update_buf ));
+		Task	t_read_img		= cmd->AddTask( ReadImage().SetImage( image, int2(), image_dim ).SetCallback( OnImageLoaded ).DependsOn( t_update_img ));
+		Unused( t_read_buf, t_read_img );
+
+		// writers are called inside 'AddTask'
+		CHECK_ERR( buffer_written == buffer_size );
+		CHECK_ERR( image_written == image_dim.x * image_dim.y * bpp );
+
+		CHECK_ERR( _frameGraph->Execute( cmd ));
+		CHECK_ERR( _frameGraph->WaitIdle() );
+
+		CHECK_ERR( buf_cb_was_called );
+		CHECK_ERR( buf_data_is_correct );
+		CHECK_ERR( img_cb_was_called );
+		CHECK_ERR( img_data_is_correct );
+
+		DeleteResources( buffer, image );
+
+		FG_LOGI( TEST_NAME << " - passed" );
+		return true;
+	}
+
+}	// FG
@@ -12,6 +12,12 @@ namespace FG
 	//
 	class VFgDummyTask final : public VFrameGraphTask
 	{
+	public:
+		void  DependsOn (VFgDummyTask *input)
+		{
+			_inputs.push_back( input );
+			input->Attach( this );
+		}
 	};
 
 
@@ -24,6 +30,7 @@ namespace FG
 			UniquePtr<VFgDummyTask>		task{ new VFgDummyTask()};
 
 			task->SetExecutionOrder( ExeOrderIndex(size_t(ExeOrderIndex::First) + i) );
+			task->SetIndex( uint(i) );
 
 			result.push_back( std::move(task) );
 		}
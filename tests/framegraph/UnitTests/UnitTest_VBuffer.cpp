@@ -42,13 +42,14 @@ static void VBuffer_Test1 ()
 	const auto			tasks		= GenDummyTasks( 30 );
 	auto				task_iter	= tasks.begin();
 
+	LinearAllocator<>	allocator;
 	VBuffer				global_buffer;
 	VLocalBuffer		local_buffer;
 	VLocalBuffer const*	buf			= &local_buffer;
 
 	TEST( VBufferUnitTest::Create( global_buffer, BufferDesc{ 1024_b, EBufferUsage::All }));
 
-	TEST( local_buffer.Create( &global_buffer ));
+	TEST( local_buffer.Create( &global_buffer, allocator ));
 
 
 	// pass 1
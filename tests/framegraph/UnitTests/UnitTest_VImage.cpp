@@ -21,7 +21,8 @@ namespace FG
 			img._desc	= desc;
 			img._desc.Validate();
 
-			img._defaultLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+			img._defaultLayout	= VK_IMAGE_LAYOUT_UNDEFINED;
+			img._canKeepState	= true;
 			return true;
 		}
 
@@ -57,6 +58,7 @@ static void VImage_Test1 ()
 	const auto			tasks		= GenDummyTasks( 30 );
 	auto				task_iter	= tasks.begin();
 
+	LinearAllocator<>	allocator;
 	VImage				global_image;
 	VLocalImage			local_image;
 	VLocalImage const*	img			= &local_image;
@@ -66,7 +68,7 @@ static void VImage_Test1 ()
 											.SetUsage( EImageUsage::ColorAttachment | EImageUsage::Transfer | EImageUsage::Storage | EImageUsage::Sampled )
 											.SetMaxMipmaps( 11 )));
 
-	TEST( local_image.Create( &global_image ));
+	TEST( local_image.Create( &global_image, allocator ));
 
 	
 	// pass 1
@@ -118,6 +120,7 @@ static void VImage_Test2 ()
 	const auto			tasks		= GenDummyTasks( 30 );
 	auto				task_iter	= tasks.begin();
 	
+	LinearAllocator<>	allocator;
 	VImage				global_image;
 	VLocalImage			local_image;
 	VLocalImage const*	img			= &local_image;
@@ -127,7 +130,7 @@ static void VImage_Test2 ()
 											.SetUsage( EImageUsage::ColorAttachment | EImageUsage::Transfer | EImageUsage::Storage | EImageUsage::Sampled )
 											.SetMaxMipmaps( 11 ).SetArrayLayers( 8 )));
 
-	TEST( local_image.Create( &global_image ));
+	TEST( local_image.Create( &global_image, allocator ));
 
 	// pass 1
 	{
@@ -257,10 +260,229 @@ static void VImage_Test2 ()
 }
 
 
+static void VImage_Test3 ()
+{
+	using Region = ImageRange::RegionU;
+
+	VBarrierManager		barrier_mngr;
+	
+	const auto			tasks		= GenDummyTasks( 30 );
+	auto				task_iter	= tasks.begin();
+	
+	LinearAllocator<>	allocator;
+	VImage				global_image;
+	VLocalImage			local_image;
+	VLocalImage const*	img			= &local_image;
+
+	TEST( VImageUnitTest::Create( global_image,
+								  ImageDesc{}.SetDimension({ 64, 64 }).SetFormat( EPixelFormat::RGBA8_UNorm )
+											.SetUsage( EImageUsage::Transfer | EImageUsage::Sampled )));
+
+	TEST( local_image.Create( &global_image, allocator ));
+
+	// pass 1
+	{
+		img->AddPendingState( ImageState{ EResourceState::TransferDst, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+										  ImageRange{ 0_layer, 1, 0_mipmap, 1, Region{ uint3{0, 0, 0}, uint3{32, 32, 1} }},
+										  VK_IMAGE_ASPECT_COLOR_BIT, (task_iter++)->get() });
+
+		img->CommitBarrier( barrier_mngr, null );
+
+		auto	barriers = VImageUnitTest::GetRWBarriers( img );
+		TEST( barriers.size() == 1 );
+		TEST( barriers[0].region == Region( uint3{0, 0, 0}, uint3{32, 32, 1} ));
+		TEST( barriers[0].index == ExeOrderIndex(1) );
+	}
+
+	// pass 2 - write to non-intersecting region without barrier, records are merged
+	{
+		img->AddPendingState( ImageState{ EResourceState::TransferDst, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+										  ImageRange{ 0_layer, 1, 0_mipmap, 1, Region{ uint3{32, 0, 0}, uint3{64, 32, 1} }},
+										  VK_IMAGE_ASPECT_COLOR_BIT, (task_iter++)->get() });
+
+		img->CommitBarrier( barrier_mngr, null );
+
+		auto	barriers = VImageUnitTest::GetRWBarriers( img );
+		TEST( barriers.size() == 1 );
+		TEST( barriers[0].region == Region( uint3{0, 0, 0}, uint3{64, 32, 1} ));
+		TEST( barriers[0].stages == VK_PIPELINE_STAGE_TRANSFER_BIT );
+		TEST( barriers[0].access == VK_ACCESS_TRANSFER_WRITE_BIT );
+		TEST( barriers[0].isWritable == true );
+		TEST( barriers[0].index == ExeOrderIndex(2) );
+	}
+
+	// pass 3 - write to intersecting region, barrier is required
+	{
+		img->AddPendingState( ImageState{ EResourceState::TransferDst, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+										  ImageRange{ 0_layer, 1, 0_mipmap, 1, Region{ uint3{16, 16, 0}, uint3{48, 48, 1} }},
+										  VK_IMAGE_ASPECT_COLOR_BIT, (task_iter++)->get() });
+
+		img->CommitBarrier( barrier_mngr, null );
+
+		auto	barriers = VImageUnitTest::GetRWBarriers( img );
+		TEST( barriers.size() == 1 );
+		TEST( barriers[0].region == Region( uint3{16, 16, 0}, uint3{48, 48, 1} ));
+		TEST( barriers[0].index == ExeOrderIndex(3) );
+	}
+
+	// pass 4 - layout transition requires barrier for non-intersecting region too
+	{
+		img->AddPendingState( ImageState{ EResourceState::TransferSrc, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+										  ImageRange{ 0_layer, 1, 0_mipmap, 1, Region{ uint3{0, 48, 0}, uint3{16, 64, 1} }},
+										  VK_IMAGE_ASPECT_COLOR_BIT, (task_iter++)->get() });
+
+		img->CommitBarrier( barrier_mngr, null );
+
+		auto	barriers = VImageUnitTest::GetRWBarriers( img );
+		TEST( barriers.size() == 1 );
+		TEST( barriers[0].region == Region( uint3{0, 48, 0}, uint3{16, 64, 1} ));
+		TEST( barriers[0].isWritable == false );
+		TEST( barriers[0].layout == VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL );
+		TEST( barriers[0].index == ExeOrderIndex(4) );
+	}
+
+	local_image.ResetState( ExeOrderIndex::Final, barrier_mngr, null );
+
+	local_image.Destroy();
+}
+
+
+static void VImage_Test4 ()
+{
+	VBarrierManager		barrier_mngr;
+	VDeviceQueueInfo	queue;
+	
+	const auto			tasks		= GenDummyTasks( 30 );
+	auto				task_iter	= tasks.begin();
+	
+	LinearAllocator<>	allocator;
+	VImage				global_image;
+	VLocalImage			local_image;
+	VLocalImage const*	img			= &local_image;
+
+	TEST( VImageUnitTest::Create( global_image,
+								  ImageDesc{}.SetDimension({ 64, 64 }).SetFormat( EPixelFormat::RGBA8_UNorm )
+											.SetUsage( EImageUsage::Transfer | EImageUsage::Sampled )));
+
+	// first command buffer
+	{
+		TEST( local_image.Create( &global_image, allocator ));
+		img->LoadLastState( &queue, null );
+
+		img->AddPendingState( ImageState{ EResourceState::TransferDst, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+										  ImageRange{ 0_layer, 1, 0_mipmap, 1 },
+										  VK_IMAGE_ASPECT_COLOR_BIT, (task_iter++)->get() });
+
+		img->CommitBarrier( barrier_mngr, null );
+		barrier_mngr.ClearBarriers();
+
+		// state is stored without layout transition
+		TEST( img->StoreLastState( &queue, null, barrier_mngr, null ));
+
+		auto	last = global_image.GetLastState();
+		TEST( last.queue == &queue );
+		TEST( last.layout == VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL );
+		TEST( last.stages == VK_PIPELINE_STAGE_TRANSFER_BIT );
+		TEST( last.access == VK_ACCESS_TRANSFER_WRITE_BIT );
+
+		local_image.Destroy();
+	}
+
+	// second command buffer continues from the last state
+	{
+		TEST( local_image.Create( &global_image, allocator ));
+		img->LoadLastState( &queue, null );
+
+		auto	barriers = VImageUnitTest::GetRWBarriers( img );
+		TEST( barriers.size() == 1 );
+		TEST( barriers[0].layout == VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL );
+		TEST( barriers[0].stages == VK_PIPELINE_STAGE_TRANSFER_BIT );
+		TEST( barriers[0].isWritable == true );
+
+		img->AddPendingState( ImageState{ EResourceState::ShaderSample | EResourceState::_FragmentShader, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+										  ImageRange{ 0_layer, 1, 0_mipmap, 1 },
+										  VK_IMAGE_ASPECT_COLOR_BIT, (task_iter++)->get() });
+
+		img->CommitBarrier( barrier_mngr, null );
+		barrier_mngr.ClearBarriers();
+
+		barriers = VImageUnitTest::GetRWBarriers( img );
+		TEST( barriers.size() == 1 );
+		TEST( barriers[0].layout == VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL );
+		TEST( barriers[0].isWritable == false );
+
+		// transition to default layout, so last state is not valid
+		local_image.ResetState( ExeOrderIndex::Final, barrier_mngr, null );
+		TEST( global_image.GetLastState().queue == null );
+
+		local_image.Destroy();
+	}
+}
+
+
+// command buffers that are executed at the same time: state is loaded only after it was stored
+static void VImage_Test5 ()
+{
+	VBarrierManager		barrier_mngr;
+	VDeviceQueueInfo	queue;
+	
+	const auto			tasks		= GenDummyTasks( 30 );
+	
+	LinearAllocator<>	allocator1;
+	LinearAllocator<>	allocator2;
+	VImage				global_image;
+	VLocalImage			local_image1;
+	VLocalImage			local_image2;
+
+	TEST( VImageUnitTest::Create( global_image,
+								  ImageDesc{}.SetDimension({ 64, 64 }).SetFormat( EPixelFormat::RGBA8_UNorm )
+											.SetUsage( EImageUsage::Transfer | EImageUsage::Sampled )));
+
+	TEST( local_image1.Create( &global_image, allocator1 ));
+	TEST( local_image2.Create( &global_image, allocator2 ));
+
+	local_image1.LoadLastState( &queue, null );
+
+	Atomic<bool>	loaded	{false};
+	VkImageLayout	layout	= VK_IMAGE_LAYOUT_UNDEFINED;
+
+	std::thread		thread{ [&] ()
+	{
+		// waits until the first image stores its state
+		local_image2.LoadLastState( &queue, null );
+		layout = VImageUnitTest::GetRWBarriers( &local_image2 )[0].layout;
+		loaded.store( true );
+	}};
+
+	std::this_thread::sleep_for( std::chrono::milliseconds{10} );
+	TEST( not loaded.load() );
+
+	local_image1.AddPendingState( ImageState{ EResourceState::TransferDst, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+											  ImageRange{ 0_layer, 1, 0_mipmap, 1 },
+											  VK_IMAGE_ASPECT_COLOR_BIT, tasks[0].get() });
+	local_image1.CommitBarrier( barrier_mngr, null );
+	barrier_mngr.ClearBarriers();
+
+	TEST( local_image1.StoreLastState( &queue, null, barrier_mngr, null ));
+	local_image1.Destroy();
+
+	thread.join();
+	TEST( loaded.load() );
+	TEST( layout == VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL );
+
+	local_image2.ResetState( ExeOrderIndex::Final, barrier_mngr, null );
+	local_image2.Destroy();
+	TEST( not global_image.HasLastState() );
+}
+
+
 extern void UnitTest_VImage ()
 {
 	VImage_Test1();
 	VImage_Test2();
+	VImage_Test3();
+	VImage_Test4();
+	VImage_Test5();
 	FG_LOGI( "UnitTest_VImage - passed" );
 }
 
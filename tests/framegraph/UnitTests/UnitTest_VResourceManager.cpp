@@ -2,6 +2,7 @@
 
 #include "VFrameGraph.h"
 #include "VResourceManager.h"
+#include "framegraph/Shared/PipelineResourcesHelper.h"
 #include "UnitTest_Common.h"
 
 
@@ -86,12 +87,36 @@ static void PipelineResources_Test1 (const FrameGraph &fg)
 	CPipelineID			ppln = fg->CreatePipeline( desc );
 	TEST( ppln );
 
-	PipelineResources	res;
-
-	//res.BindBuffer( UniformID("un_SSBO"), buffer );
-
-	// TODO
-
+	BufferID	buf1 = fg->CreateBuffer( BufferDesc{ 64_b, EBufferUsage::Storage });
+	BufferID	buf2 = fg->CreateBuffer( BufferDesc{ 64_b, EBufferUsage::Storage });
+	TEST( buf1 and buf2 );
+
+	PipelineResources	res1;
+	PipelineResources	res2;
+	TEST( fg->InitPipelineResources( ppln, DescriptorSetID{"0"}, OUT res1 ));
+	TEST( fg->InitPipelineResources( ppln, DescriptorSetID{"0"}, OUT res2 ));
+
+	// incrementally updated hash must not depend on the history of changes
+	res1.BindBuffer( UniformID("un_SSBO"), buf1 );
+	res1.BindBuffer( UniformID("un_SSBO"), buf2 );
+	res2.BindBuffer( UniformID("un_SSBO"), buf2 );
+	{
+		auto	data1 = PipelineResourcesHelper::CloneDynamicData( res1 );
+		auto	data2 = PipelineResourcesHelper::CloneDynamicData( res2 );
+		TEST( data1->CalcHash() == data2->CalcHash() );
+		TEST( *data1 == *data2 );
+	}
+
+	res2.BindBuffer( UniformID("un_SSBO"), buf1 );
+	{
+		auto	data1 = PipelineResourcesHelper::CloneDynamicData( res1 );
+		auto	data2 = PipelineResourcesHelper::CloneDynamicData( res2 );
+		TEST( data1->CalcHash() != data2->CalcHash() );
+		TEST( not (*data1 == *data2) );
+	}
+
+	fg->ReleaseResource( buf1 );
+	fg->ReleaseResource( buf2 );
 	fg->ReleaseResource( ppln );
 }
 
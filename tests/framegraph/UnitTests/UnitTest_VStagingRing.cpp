@@ -0,0 +1,93 @@
+// Copyright (c) 2018-2020,  Zhirnov Andrey. For more information see 'LICENSE'
+
+#ifdef FG_ENABLE_VULKAN
+
+#include "VStagingRing.h"
+#include "UnitTest_Common.h"
+
+
+static void VStagingRing_Test1 ()
+{
+	VStagingRing			ring;
+	Array<uint8_t>			storage;	storage.resize( 4096 );
+	VMemoryObj::MemoryInfo	info;
+
+	info.flags		= VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+	info.mappedPtr	= storage.data();
+
+	TEST( ring.Create( RawBufferID( 1, 0 ), info, 4_Kb ));
+	TEST( ring.IsCoherent() );
+
+	VStagingRing::Chunk		c1, c2, c3, c4;
+
+	TEST( ring.Alloc( 1_Kb, 1_Kb, OUT c1 ));
+	TEST( c1.offset == 0_b and c1.size == 1_Kb );
+
+	TEST( ring.Alloc( 2_Kb, 1_Kb, OUT c2 ));
+	TEST( c2.offset == 1_Kb and c2.size == 2_Kb );
+
+	// only 1Kb is available
+	TEST( ring.Alloc( 2_Kb, 512_b, OUT c3 ));
+	TEST( c3.offset == 3_Kb and c3.size == 1_Kb );
+
+	// ring is full
+	TEST( not ring.Alloc( 1_Kb, 256_b, OUT c4 ));
+
+	// memory is not available until the first chunk is released
+	ring.Release( c2 );
+	TEST( not ring.Alloc( 1_Kb, 256_b, OUT c4 ));
+
+	ring.Release( c1 );
+	TEST( ring.Alloc( 4_Kb, 1_Kb, OUT c4 ));
+	TEST( c4.offset == 0_b and c4.size == 3_Kb );
+
+	ring.Release( c3 );
+	ring.Release( c4 );
+
+	TEST( ring.Destroy() == RawBufferID( 1, 0 ));
+}
+
+
+static void VStagingRing_Test2 ()
+{
+	VStagingRing			ring;
+	Array<uint8_t>			storage;	storage.resize( 4096 );
+	VMemoryObj::MemoryInfo	info;
+
+	info.mappedPtr	= storage.data();
+
+	TEST( ring.Create( RawBufferID( 2, 0 ), info, 4_Kb ));
+	TEST( not ring.IsCoherent() );
+
+	VStagingRing::Chunk		c1, c2, c3;
+
+	TEST( ring.Alloc( 3_Kb, 3_Kb, OUT c1 ));
+	TEST( ring.Alloc( 512_b, 512_b, OUT c2 ));
+	TEST( c2.offset == 3_Kb );
+	
+	ring.Release( c1 );
+
+	// chunk must be contiguous, so the end of buffer is skipped
+	TEST( ring.Alloc( 1_Kb, 1_Kb, OUT c3 ));
+	TEST( c3.offset == 0_b and c3.size == 1_Kb );
+
+	// padding is released together with the chunk
+	ring.Release( c2 );
+	ring.Release( c3 );
+
+	TEST( ring.Alloc( 4_Kb, 4_Kb, OUT c1 ));
+	TEST( c1.size == 4_Kb );
+	ring.Release( c1 );
+
+	TEST( ring.Destroy() == RawBufferID( 2, 0 ));
+}
+
+
+extern void UnitTest_VStagingRing ()
+{
+	VStagingRing_Test1();
+	VStagingRing_Test2();
+	FG_LOGI( "UnitTest_VStagingRing - passed" );
+}
+
+#endif	// FG_ENABLE_VULKAN
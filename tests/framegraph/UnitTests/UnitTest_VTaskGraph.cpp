@@ -0,0 +1,272 @@
+// Copyright (c) 2018-2020,  Zhirnov Andrey. For more information see 'LICENSE'
+
+#ifdef FG_ENABLE_VULKAN
+
+#include "VTaskGraph.h"
+#include "UnitTest_Common.h"
+#include "DummyTask.h"
+#include "stl/Algorithms/StringUtils.h"
+#include <chrono>
+
+using Tasks_t = Array<UniquePtr<VFgDummyTask>>;
+
+
+static Array<VTask>  GetEntries (const Tasks_t &tasks)
+{
+	Array<VTask>	result;
+
+	for (auto& task : tasks)
+	{
+		task->ResetPendingInputs();
+
+		if ( task->Inputs().empty() )
+			result.push_back( task.get() );
+	}
+	return result;
+}
+
+
+// measures ordering time and checks that every task is visited exactly once and after all of its inputs
+static void  CheckOrdering (StringView name, const Tasks_t &tasks)
+{
+	using Clock_t = std::chrono::high_resolution_clock;
+
+	const auto			entries		= GetEntries( tasks );
+	LinearAllocator<>	allocator;
+	ExeOrderIndex		exe_order	= ExeOrderIndex::First;
+	size_t				counter		= 0;
+
+	const auto	start = Clock_t::now();
+
+	TEST( VisitTasksInOrder( entries, tasks.size(), allocator, [&] (VTask node)
+		{
+			Cast<VFgDummyTask>( node )->SetExecutionOrder( ++exe_order );
+			++counter;
+		}));
+
+	const auto	dt = std::chrono::duration_cast<std::chrono::nanoseconds>( Clock_t::now() - start ).count();
+
+	TEST( counter == tasks.size() );
+
+	for (auto& task : tasks)
+	{
+		TEST( task->PendingInputs() == 0 );
+
+		for (auto in_node : task->Inputs()) {
+			TEST( in_node->ExecutionOrder() < task->ExecutionOrder() );
+		}
+	}
+
+	FG_LOGI( "TaskGraph ordering '"s << name << "': " << ToString( tasks.size() ) << " tasks, "
+			 << ToString( double(dt) / tasks.size() ) << " ns per task" );
+}
+
+
+// deep graph: single chain of tasks
+static void  TaskGraph_Test1 ()
+{
+	auto	tasks = GenDummyTasks( 50'000 );
+
+	for (size_t i = 1; i < tasks.size(); ++i) {
+		tasks[i]->DependsOn( tasks[i-1].get() );
+	}
+
+	CheckOrdering( "deep", tasks );
+}
+
+
+// wide graph: layers of independent tasks, each task depends on two tasks from previous layer
+static void  TaskGraph_Test2 ()
+{
+	const size_t	width	= 1000;
+	const size_t	depth	= 50;
+	auto			tasks	= GenDummyTasks( width * depth );
+
+	for (size_t y = 1; y < depth; ++y)
+	for (size_t x = 0; x < width; ++x)
+	{
+		auto*	task = tasks[ y*width + x ].get();
+
+		task->DependsOn( tasks[ (y-1)*width + x ].get() );
+		task->DependsOn( tasks[ (y-1)*width + (x+1) % width ].get() );
+	}
+
+	CheckOrdering( "wide", tasks );
+}
+
+
+// dependencies are in reverse order to the task array, discovery order must not affect result
+static void  TaskGraph_Test3 ()
+{
+	const size_t	count	= 20'000;
+	auto			tasks	= GenDummyTasks( count );
+
+	for (size_t i = 0; i+1 < count; ++i)
+	{
+		tasks[i]->DependsOn( tasks[i+1].get() );
+
+		if ( i+3 < count and (i & 3) == 0 )
+			tasks[i]->DependsOn( tasks[i+3].get() );
+	}
+
+	CheckOrdering( "reverse", tasks );
+}
+
+
+// batching: tasks with the same key are grouped, tasks in a batch must be independent
+static void  TaskGraph_Test4 ()
+{
+	const size_t	width	= 100;
+	const size_t	depth	= 20;
+	const size_t	window	= 32;
+	auto			tasks	= GenDummyTasks( width * depth );
+
+	for (size_t y = 1; y < depth; ++y)
+	for (size_t x = 0; x < width; ++x)
+	{
+		tasks[ y*width + x ]->DependsOn( tasks[ (y-1)*width + x ].get() );
+	}
+
+	const auto			entries		= GetEntries( tasks );
+	LinearAllocator<>	allocator;
+	ExeOrderIndex		exe_order	= ExeOrderIndex::First;
+	size_t				counter		= 0;
+	size_t				max_batch	= 0;
+	Optional<size_t>	batch_key;
+
+	const auto	GetKey = [&tasks] (VTask node) -> size_t
+	{
+		for (size_t i = 0; i < tasks.size(); ++i) {
+			if ( VTask{ tasks[i].get() } == node )
+				return i % 3;
+		}
+		return UMax;
+	};
+
+	TEST( VisitTaskBatchesInOrder( entries, tasks.size(), window, allocator,
+		[&] (VTask node)
+		{
+			const size_t	key = GetKey( node );
+
+			if ( batch_key.has_value() and *batch_key != key )
+				return false;
+
+			batch_key = key;
+			return true;
+		},
+		[&] (ArrayView<VTask> batch)
+		{
+			++exe_order;
+			for (auto node : batch) {
+				Cast<VFgDummyTask>( node )->SetExecutionOrder( exe_order );
+			}
+			counter		+= batch.size();
+			max_batch	 = Max( max_batch, batch.size() );
+			batch_key.reset();
+		}));
+
+	TEST( counter == tasks.size() );
+	TEST( max_batch > 1 and max_batch <= window );
+
+	for (auto& task : tasks)
+	{
+		TEST( task->PendingInputs() == 0 );
+
+		for (auto in_node : task->Inputs()) {
+			TEST( in_node->ExecutionOrder() < task->ExecutionOrder() );
+		}
+	}
+}
+
+
+// schedule replay: recorded batches are replayed in the same order, invalid schedules are rejected
+static void  TaskGraph_Test5 ()
+{
+	const size_t	width	= 50;
+	const size_t	depth	= 10;
+	auto			tasks	= GenDummyTasks( width * depth );
+
+	for (size_t y = 1; y < depth; ++y)
+	for (size_t x = 0; x < width; ++x)
+	{
+		tasks[ y*width + x ]->DependsOn( tasks[ (y-1)*width + x ].get() );
+	}
+
+	Array<VTask>	nodes;
+	for (auto& task : tasks) {
+		nodes.push_back( task.get() );
+	}
+
+	const auto			entries		= GetEntries( tasks );
+	LinearAllocator<>	allocator;
+	VTaskSchedule		schedule;
+
+	TEST( VisitTaskBatchesInOrder( entries, tasks.size(), 16, allocator,
+		[] (VTask) { return true; },
+		[&] (ArrayView<VTask> batch)
+		{
+			for (auto node : batch) {
+				schedule.order.push_back( node->Index() );
+			}
+			schedule.batches.push_back( uint(batch.size()) );
+		}));
+
+	TEST( schedule.order.size() == tasks.size() );
+
+	// replay
+	size_t	pos = 0;
+	TEST( ReplayTaskSchedule( nodes, schedule, allocator, [&] (ArrayView<VTask> batch)
+		{
+			for (auto node : batch) {
+				TEST( node->Index() == schedule.order[pos++] );
+			}
+		}));
+	TEST( pos == tasks.size() );
+
+	const auto	Fail = [] (ArrayView<VTask>) { TEST( false ); };
+
+	// input is visited after output
+	{
+		VTaskSchedule	invalid = schedule;
+		std::reverse( invalid.order.begin(), invalid.order.end() );
+		std::reverse( invalid.batches.begin(), invalid.batches.end() );
+		TEST( not ReplayTaskSchedule( nodes, invalid, allocator, Fail ));
+	}
+
+	// input and output are in the same batch
+	{
+		VTaskSchedule	invalid;
+		invalid.order	= schedule.order;
+		invalid.batches	= { uint(tasks.size()) };
+		TEST( not ReplayTaskSchedule( nodes, invalid, allocator, Fail ));
+	}
+
+	// task is visited twice
+	{
+		VTaskSchedule	invalid = schedule;
+		invalid.order.back() = invalid.order.front();
+		TEST( not ReplayTaskSchedule( nodes, invalid, allocator, Fail ));
+	}
+
+	// graph is changed
+	{
+		VTaskSchedule	invalid = schedule;
+		invalid.order.pop_back();
+		invalid.batches.back()--;
+		TEST( not ReplayTaskSchedule( nodes, invalid, allocator, Fail ));
+	}
+}
+
+
+extern void UnitTest_VTaskGraph ()
+{
+	TaskGraph_Test1();
+	TaskGraph_Test2();
+	TaskGraph_Test3();
+	TaskGraph_Test4();
+	TaskGraph_Test5();
+
+	FG_LOGI( "UnitTest_VTaskGraph - passed" );
+}
+
+#endif	// FG_ENABLE_VULKAN
@@ -10,6 +10,8 @@ extern void UnitTest_PixelFormat ();
 extern void UnitTest_ID ();
 extern void UnitTest_VBuffer ();
 extern void UnitTest_VImage ();
+extern void UnitTest_VTaskGraph ();
+extern void UnitTest_VStagingRing ();
 extern void UnitTest_ImageDesc ();
 
 
@@ -33,6 +35,8 @@ int main () {
 		#ifdef FG_ENABLE_VULKAN
 		UnitTest_VBuffer();
 		UnitTest_VImage();
+		UnitTest_VTaskGraph();
+		UnitTest_VStagingRing();
 		#endif
 	}
 
@@ -0,0 +1,107 @@
+// Copyright (c) 2018-2020,  Zhirnov Andrey. For more information see 'LICENSE'
+
+#include "stl/ThreadSafe/LfCircularQueue.h"
+#include "UnitTest_Common.h"
+#include <thread>
+
+
+static void LfCircularQueue_Test1 ()
+{
+	LfCircularQueue< uint, 16 >		queue;
+	uint							value;
+
+	TEST( not queue.Pop( OUT value ));
+
+	for (uint k = 0; k < 10; ++k)
+	{
+		for (uint i = 0; i < 16; ++i) {
+			TEST( queue.Push( k * 100 + i ));
+		}
+		TEST( not queue.Push( 0u ));
+
+		for (uint i = 0; i < 16; ++i)
+		{
+			TEST( queue.Pop( OUT value ));
+			TEST( value == k * 100 + i );
+		}
+		TEST( not queue.Pop( OUT value ));
+		TEST( queue.IsEmpty() );
+	}
+}
+
+
+static void LfCircularQueue_Test2 ()
+{
+	using T = DebugInstanceCounter< int, 3 >;
+	
+	T::ClearStatistic();
+	{
+		LfCircularQueue< T, 8 >		queue;
+		T							value;
+
+		for (int i = 0; i < 6; ++i) {
+			TEST( queue.Push( T{i} ));
+		}
+		for (int i = 0; i < 6; ++i) {
+			TEST( queue.Pop( OUT value ));
+		}
+	}
+	TEST( T::CheckStatistic() );
+}
+
+
+static void LfCircularQueue_Test3 ()
+{
+	constexpr uint					thread_count	= 4;
+	constexpr uint					count			= 10'000;
+	LfCircularQueue< uint, 64 >		queue;
+	Array<std::thread>				threads;
+	Array<uint>						last;		last.resize( thread_count );
+	uint							received	= 0;
+
+	for (uint t = 0; t < thread_count; ++t)
+	{
+		threads.emplace_back( [&queue, t] ()
+		{
+			for (uint i = 0; i < count;)
+			{
+				if ( queue.Push( (t << 24) | i ))
+					++i;
+				else
+					std::this_thread::yield();
+			}
+		});
+	}
+
+	// single consumer, values from each producer must be in order
+	for (; received < thread_count * count;)
+	{
+		uint	value;
+		if ( not queue.Pop( OUT value ))
+			continue;
+
+		const uint	t = value >> 24;
+		const uint	i = value & 0xFFFFFF;
+
+		TEST( t < thread_count );
+		TEST( i == last[t] );
+
+		last[t] = i + 1;
+		++received;
+	}
+
+	for (auto& t : threads) {
+		t.join();
+	}
+	TEST( queue.IsEmpty() );
+}
+
+
+extern void UnitTest_LfCircularQueue ()
+{
+	LfCircularQueue_Test1();
+	LfCircularQueue_Test2();
+	LfCircularQueue_Test3();
+
+	FG_LOGI( "UnitTest_LfCircularQueue - passed" );
+}
@@ -1,6 +1,7 @@
 // Copyright (c) 2018-2020,  Zhirnov Andrey. For more information see 'LICENSE'
 
 #include "stl/Memory/LinearAllocator.h"
+#include "stl/Containers/LinearArray.h"
 #include "UnitTest_Common.h"
 
 
@@ -23,9 +24,47 @@ static void LinearAllocator_Test1 ()
 }
 
 
+static void LinearArray_Test1 ()
+{
+	LinearAllocator		pool;
+	pool.SetBlockSize( 4_Kb );
+
+	LinearArray< uint >	arr{ pool };
+
+	arr.push_back( 2 );
+	TEST( arr.size() == 1 );
+	TEST( arr.capacity() == 1 );		// inline storage
+	
+	arr.insert( arr.begin(), 0 );
+	arr.insert( arr.begin()+1, 1 );
+	arr.push_back( 4 );
+	arr.insert( arr.begin()+3, 3 );
+	TEST( arr.size() == 5 );
+
+	for (uint i = 0; i < arr.size(); ++i) {
+		TEST( arr[i] == i );
+	}
+
+	auto	iter = arr.erase( arr.begin()+1 );
+	TEST( *iter == 2 );
+	TEST( arr.size() == 4 );
+	TEST( arr.front() == 0 and arr.back() == 4 );
+
+	const size_t	cap = arr.capacity();
+	arr.clear();
+	TEST( arr.empty() );
+	TEST( arr.capacity() == cap );
+
+	arr.Release();
+	TEST( arr.capacity() == 1 );
+	pool.Discard();
+}
+
+
 
 extern void UnitTest_LinearAllocator ()
 {
 	LinearAllocator_Test1();
+	LinearArray_Test1();
 	FG_LOGI( "UnitTest_LinearAllocator - passed" );
 }
@@ -0,0 +1,61 @@
+// Copyright (c) 2018-2020,  Zhirnov Andrey. For more information see 'LICENSE'
+
+#include "stl/ThreadSafe/ThreadPool.h"
+#include "UnitTest_Common.h"
+
+
+static void ThreadPool_Test1 ()
+{
+	ThreadPool		pool;
+	TEST( pool.Start( 4, "worker" ));
+
+	Array<uint>		values;		values.resize( 1000 );
+
+	for (uint k = 0; k < 100; ++k)
+	{
+		pool.ParallelFor( uint(values.size()), [&values] (uint i) { values[i] += i; });
+	}
+
+	for (uint i = 0; i < values.size(); ++i) {
+		TEST( values[i] == i * 100 );
+	}
+}
+
+
+static void ThreadPool_Test2 ()
+{
+	Atomic<uint>	counter {0};
+	{
+		ThreadPool	pool;
+		TEST( pool.Start( 2, "worker" ));
+
+		for (uint i = 0; i < 1000; ++i) {
+			pool.Enqueue( [&counter] () { counter.fetch_add( 1, memory_order_relaxed ); });
+		}
+	}
+	TEST( counter.load() == 1000 );
+}
+
+
+static void ThreadPool_Test3 ()
+{
+	// thread pool without threads runs all jobs on the calling thread
+	ThreadPool		pool;
+	uint			sum		= 0;
+	const auto		tid		= std::this_thread::get_id();
+
+	pool.ParallelFor( 10, [&] (uint i) { TEST( tid == std::this_thread::get_id() );  sum += i; });
+	pool.Enqueue( [&] () { sum += 100; });
+
+	TEST( sum == 145 );
+}
+
+
+extern void UnitTest_ThreadPool ()
+{
+	ThreadPool_Test1();
+	ThreadPool_Test2();
+	ThreadPool_Test3();
+
+	FG_LOGI( "UnitTest_ThreadPool - passed" );
+}
@@ -16,9 +16,11 @@ extern void UnitTest_Array ();
 extern void UnitTest_StringParser ();
 extern void UnitTest_FixedTupleArray ();
 extern void UnitTest_LfIndexedPool ();
+extern void UnitTest_LfCircularQueue ();
 extern void UnitTest_Rectangle ();
 extern void UnitTest_NtStringView ();
 extern void UnitTest_TypeList ();
+extern void UnitTest_ThreadPool ();
 
 
 #ifdef PLATFORM_ANDROID
@@ -41,9 +43,11 @@ int main ()
 	UnitTest_StringParser();
 	UnitTest_FixedTupleArray();
 	UnitTest_LfIndexedPool();
+	UnitTest_LfCircularQueue();
 	UnitTest_Rectangle();
 	UnitTest_NtStringView();
 	UnitTest_TypeList();
+	UnitTest_ThreadPool();
 	
 	CHECK_FATAL( FG_DUMP_MEMLEAKS() );
 